@@ -22,6 +22,9 @@ macro(root_check_assembler)
          message(STATUS "OS binutils is too old (${_as_version}) for AVX2 instructions.")
          set(ROOT_DEFINITIONS ${ROOT_DEFINITIONS} -DROOT_NO_AVX2)
          set(ZLIB_AVX2_INTRINSICS_BROKEN true)
+      elseif(_as_version VERSION_LESS "2.26")
+         message(STATUS "OS binutils is too old (${_as_version}) for AVX-512 instructions.")
+         set(ROOT_DEFINITIONS ${ROOT_DEFINITIONS} -DROOT_NO_AVX512)
       else()
          message(STATUS "Binutils as version: ${_as_version}")
       endif()
@@ -0,0 +1,60 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RByteSwap
+#define ROOT_RByteSwap
+
+#include "RtypesCore.h"
+
+#include <cstddef>
+
+namespace ROOT {
+namespace Internal {
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Array kernels used to convert primitive arrays between the host and  //
+// the on-file (big endian) byte order.                                 //
+//                                                                      //
+// The kernel set is selected once, at run time, from the instruction   //
+// sets supported by the CPU (AVX-512BW, AVX2 or SSSE3 on x86-64, NEON  //
+// on aarch64), with a portable fallback. All the ByteSwapCopy kernels  //
+// accept `to == from` to swap an array in place; other overlaps are    //
+// not supported. `n` is always a number of elements, not of bytes.     //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+enum class EByteSwapKernel { kScalar, kSSSE3, kAVX2, kAVX512, kNEON };
+
+/// Copy n 2-byte elements from `from` to `to`, reversing the byte order of each element.
+void ByteSwapCopy16(void *to, const void *from, std::size_t n);
+/// Copy n 4-byte elements from `from` to `to`, reversing the byte order of each element.
+void ByteSwapCopy32(void *to, const void *from, std::size_t n);
+/// Copy n 8-byte elements from `from` to `to`, reversing the byte order of each element.
+void ByteSwapCopy64(void *to, const void *from, std::size_t n);
+
+/// Rebuild n floats stored with a truncated mantissa of nbits bits (see TBufferFile::WriteFloat16):
+/// each element takes 3 bytes in `from`, the exponent followed by the big endian mantissa and sign.
+void UnpackTruncatedFloats(Float_t *to, const char *from, std::size_t n, Int_t nbits);
+/// Same as UnpackTruncatedFloats, widening the result to double (see TBufferFile::WriteDouble32).
+void UnpackTruncatedFloats(Double_t *to, const char *from, std::size_t n, Int_t nbits);
+
+/// Return the kernel set currently in use.
+EByteSwapKernel GetByteSwapKernel();
+/// Return a printable name of the given kernel set, e.g. "avx2".
+const char *GetByteSwapKernelName(EByteSwapKernel kernel);
+/// Use the given kernel set from now on. Return false, and leave the current kernel set unchanged,
+/// if it is not supported by this build or by this CPU. Meant for tests and benchmarks.
+bool SetByteSwapKernel(EByteSwapKernel kernel);
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -507,6 +507,7 @@ public:
    virtual void            CloseConnection(int sock, Bool_t force = kFALSE);
    virtual int             RecvRaw(int sock, void *buffer, int length, int flag);
    virtual int             SendRaw(int sock, const void *buffer, int length, int flag);
+   virtual int             SendRawv(int sock, const void *const *buffers, const int *lengths, int nbuffers, int flag);
    virtual int             RecvBuf(int sock, void *buffer, int length);
    virtual int             SendBuf(int sock, const void *buffer, int length);
    virtual int             SetSockOpt(int sock, int kind, int val);
@@ -0,0 +1,381 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RByteSwap.hxx"
+
+#include <atomic>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(ROOT_NO_AVX)
+#define R__BSWAP_X86
+#include <immintrin.h>
+#if !defined(ROOT_NO_AVX2)
+#define R__BSWAP_AVX2
+#if !defined(ROOT_NO_AVX512) && (defined(__clang__) || __GNUC__ >= 6)
+#define R__BSWAP_AVX512
+#endif
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define R__BSWAP_NEON
+#include <arm_neon.h>
+#endif
+
+using ROOT::Internal::EByteSwapKernel;
+
+namespace {
+
+template <std::size_t S>
+struct RUInt;
+template <>
+struct RUInt<2> {
+   using Type = UShort_t;
+};
+template <>
+struct RUInt<4> {
+   using Type = UInt_t;
+};
+template <>
+struct RUInt<8> {
+   using Type = ULong64_t;
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+inline UShort_t Swap(UShort_t x) { return __builtin_bswap16(x); }
+inline UInt_t Swap(UInt_t x) { return __builtin_bswap32(x); }
+inline ULong64_t Swap(ULong64_t x) { return __builtin_bswap64(x); }
+#else
+inline UShort_t Swap(UShort_t x) { return (x >> 8) | (x << 8); }
+inline UInt_t Swap(UInt_t x)
+{
+   return (x >> 24) | ((x >> 8) & 0x0000ff00u) | ((x << 8) & 0x00ff0000u) | (x << 24);
+}
+inline ULong64_t Swap(ULong64_t x) { return (ULong64_t(Swap(UInt_t(x))) << 32) | Swap(UInt_t(x >> 32)); }
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Portable kernel, also used for the tail of the vectorized ones. Going through memcpy makes unaligned buffers and
+/// in-place swapping well defined, compilers turn it into plain loads and stores.
+
+template <std::size_t S>
+void ByteSwapCopyScalar(void *to, const void *from, std::size_t n)
+{
+   using UInt = typename RUInt<S>::Type;
+   char *out = static_cast<char *>(to);
+   const char *in = static_cast<const char *>(from);
+   for (std::size_t i = 0; i < n; ++i) {
+      UInt x;
+      memcpy(&x, in + i * S, S);
+      x = Swap(x);
+      memcpy(out + i * S, &x, S);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Portable kernel rebuilding floats stored with a truncated mantissa, see TBufferFile::WriteFloat16. The sign is
+/// set by flipping the sign bit, like the negation done by TBufferFile::ReadFloat16.
+
+template <typename T>
+void UnpackTruncatedScalar(T *to, const char *from, std::size_t n, Int_t nbits)
+{
+   const UInt_t mask = (1u << (nbits + 1)) - 1;
+   const UChar_t *in = reinterpret_cast<const UChar_t *>(from);
+   for (std::size_t i = 0; i < n; ++i, in += 3) {
+      const UInt_t man = (UInt_t(in[1]) << 8) | in[2];
+      const UInt_t bits = (UInt_t(in[0]) << 23) | ((man & mask) << (23 - nbits)) | (((man >> (nbits + 1)) & 1u) << 31);
+      Float_t f;
+      memcpy(&f, &bits, sizeof(f));
+      to[i] = f;
+   }
+}
+
+#ifdef R__BSWAP_X86
+// pshufb masks reversing the bytes of each element of a 16 byte lane
+#define R__SWAP_LANE16 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+#define R__SWAP_LANE32 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+#define R__SWAP_LANE64 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+alignas(64) const unsigned char kSwapMask16[64] = {R__SWAP_LANE16, R__SWAP_LANE16, R__SWAP_LANE16, R__SWAP_LANE16};
+alignas(64) const unsigned char kSwapMask32[64] = {R__SWAP_LANE32, R__SWAP_LANE32, R__SWAP_LANE32, R__SWAP_LANE32};
+alignas(64) const unsigned char kSwapMask64[64] = {R__SWAP_LANE64, R__SWAP_LANE64, R__SWAP_LANE64, R__SWAP_LANE64};
+#undef R__SWAP_LANE16
+#undef R__SWAP_LANE32
+#undef R__SWAP_LANE64
+
+template <std::size_t S>
+const void *SwapMask()
+{
+   return S == 2 ? kSwapMask16 : (S == 4 ? kSwapMask32 : kSwapMask64);
+}
+
+// Gathers the 4 truncated floats of 12 bytes into 32 bit lanes holding (exponent << 16) | mantissa
+alignas(16) const unsigned char kUnpackMask[16] = {2, 1, 0, 0x80, 5, 4, 3, 0x80, 8, 7, 6, 0x80, 11, 10, 9, 0x80};
+
+template <std::size_t S>
+__attribute__((target("ssse3"))) void ByteSwapCopySSSE3(void *to, const void *from, std::size_t n)
+{
+   char *out = static_cast<char *>(to);
+   const char *in = static_cast<const char *>(from);
+   const __m128i mask = _mm_load_si128(static_cast<const __m128i *>(SwapMask<S>()));
+   const std::size_t nbytes = n * S;
+   std::size_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_shuffle_epi8(v, mask));
+   }
+   ByteSwapCopyScalar<S>(out + i, in + i, (nbytes - i) / S);
+}
+
+/// Rebuild the float bits of the 4 elements gathered in v by kUnpackMask
+__attribute__((target("ssse3"))) inline __m128i
+UnpackLanesSSSE3(__m128i v, __m128i mask, __m128i manShift, __m128i signShift)
+{
+   const __m128i one = _mm_set1_epi32(1);
+   const __m128i exp = _mm_slli_epi32(_mm_srli_epi32(v, 16), 23);
+   const __m128i man = _mm_and_si128(v, _mm_set1_epi32(0xffff));
+   const __m128i sign = _mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(man, signShift), one), 31);
+   return _mm_or_si128(_mm_or_si128(exp, _mm_sll_epi32(_mm_and_si128(man, mask), manShift)), sign);
+}
+
+template <typename T>
+__attribute__((target("ssse3"))) void UnpackTruncatedSSSE3(T *to, const char *from, std::size_t n, Int_t nbits)
+{
+   const __m128i gather = _mm_load_si128(reinterpret_cast<const __m128i *>(kUnpackMask));
+   const __m128i mask = _mm_set1_epi32((1u << (nbits + 1)) - 1);
+   const __m128i manShift = _mm_cvtsi32_si128(23 - nbits);
+   const __m128i signShift = _mm_cvtsi32_si128(nbits + 1);
+   std::size_t i = 0;
+   // each iteration loads 16 bytes but only consumes the 12 bytes of 4 elements
+   for (; 3 * i + 16 <= 3 * n; i += 4) {
+      const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(from + 3 * i)), gather);
+      const __m128 f = _mm_castsi128_ps(UnpackLanesSSSE3(v, mask, manShift, signShift));
+      if (sizeof(T) == sizeof(Float_t)) {
+         _mm_storeu_ps(reinterpret_cast<float *>(to + i), f);
+      } else {
+         _mm_storeu_pd(reinterpret_cast<double *>(to + i), _mm_cvtps_pd(f));
+         _mm_storeu_pd(reinterpret_cast<double *>(to + i + 2), _mm_cvtps_pd(_mm_movehl_ps(f, f)));
+      }
+   }
+   UnpackTruncatedScalar(to + i, from + 3 * i, n - i, nbits);
+}
+
+#ifdef R__BSWAP_AVX2
+template <std::size_t S>
+__attribute__((target("avx2"))) void ByteSwapCopyAVX2(void *to, const void *from, std::size_t n)
+{
+   char *out = static_cast<char *>(to);
+   const char *in = static_cast<const char *>(from);
+   const __m256i mask = _mm256_load_si256(static_cast<const __m256i *>(SwapMask<S>()));
+   const std::size_t nbytes = n * S;
+   std::size_t i = 0;
+   for (; i + 64 <= nbytes; i += 64) {
+      const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+      const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 32));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_shuffle_epi8(v0, mask));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 32), _mm256_shuffle_epi8(v1, mask));
+   }
+   for (; i + 32 <= nbytes; i += 32) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_shuffle_epi8(v, mask));
+   }
+   ByteSwapCopyScalar<S>(out + i, in + i, (nbytes - i) / S);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) void UnpackTruncatedAVX2(T *to, const char *from, std::size_t n, Int_t nbits)
+{
+   const __m256i gather = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(kUnpackMask)));
+   const __m256i one = _mm256_set1_epi32(1);
+   const __m256i mask = _mm256_set1_epi32((1u << (nbits + 1)) - 1);
+   const __m128i manShift = _mm_cvtsi32_si128(23 - nbits);
+   const __m128i signShift = _mm_cvtsi32_si128(nbits + 1);
+   std::size_t i = 0;
+   // the two 128 bit lanes get the 4 elements at from + 3 * i and at from + 3 * i + 12
+   for (; 3 * i + 12 + 16 <= 3 * n; i += 8) {
+      const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + 3 * i));
+      const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + 3 * i + 12));
+      const __m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), gather);
+      const __m256i exp = _mm256_slli_epi32(_mm256_srli_epi32(v, 16), 23);
+      const __m256i man = _mm256_and_si256(v, _mm256_set1_epi32(0xffff));
+      const __m256i sign = _mm256_slli_epi32(_mm256_and_si256(_mm256_srl_epi32(man, signShift), one), 31);
+      const __m256 f = _mm256_castsi256_ps(
+         _mm256_or_si256(_mm256_or_si256(exp, _mm256_sll_epi32(_mm256_and_si256(man, mask), manShift)), sign));
+      if (sizeof(T) == sizeof(Float_t)) {
+         _mm256_storeu_ps(reinterpret_cast<float *>(to + i), f);
+      } else {
+         _mm256_storeu_pd(reinterpret_cast<double *>(to + i), _mm256_cvtps_pd(_mm256_castps256_ps128(f)));
+         _mm256_storeu_pd(reinterpret_cast<double *>(to + i + 4), _mm256_cvtps_pd(_mm256_extractf128_ps(f, 1)));
+      }
+   }
+   UnpackTruncatedScalar(to + i, from + 3 * i, n - i, nbits);
+}
+#endif // R__BSWAP_AVX2
+
+#ifdef R__BSWAP_AVX512
+template <std::size_t S>
+__attribute__((target("avx512bw"))) void ByteSwapCopyAVX512(void *to, const void *from, std::size_t n)
+{
+   char *out = static_cast<char *>(to);
+   const char *in = static_cast<const char *>(from);
+   const __m512i mask = _mm512_load_si512(SwapMask<S>());
+   const std::size_t nbytes = n * S;
+   std::size_t i = 0;
+   for (; i + 64 <= nbytes; i += 64) {
+      const __m512i v = _mm512_loadu_si512(in + i);
+      _mm512_storeu_si512(out + i, _mm512_shuffle_epi8(v, mask));
+   }
+   ByteSwapCopyScalar<S>(out + i, in + i, (nbytes - i) / S);
+}
+#endif // R__BSWAP_AVX512
+#endif // R__BSWAP_X86
+
+#ifdef R__BSWAP_NEON
+template <std::size_t S>
+void ByteSwapCopyNEON(void *to, const void *from, std::size_t n)
+{
+   uint8_t *out = static_cast<uint8_t *>(to);
+   const uint8_t *in = static_cast<const uint8_t *>(from);
+   const std::size_t nbytes = n * S;
+   std::size_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      const uint8x16_t v = vld1q_u8(in + i);
+      vst1q_u8(out + i, S == 2 ? vrev16q_u8(v) : (S == 4 ? vrev32q_u8(v) : vrev64q_u8(v)));
+   }
+   ByteSwapCopyScalar<S>(out + i, in + i, (nbytes - i) / S);
+}
+#endif // R__BSWAP_NEON
+
+struct RKernels {
+   EByteSwapKernel fKind;
+   void (*fSwap16)(void *, const void *, std::size_t);
+   void (*fSwap32)(void *, const void *, std::size_t);
+   void (*fSwap64)(void *, const void *, std::size_t);
+   void (*fUnpackFloat)(Float_t *, const char *, std::size_t, Int_t);
+   void (*fUnpackDouble)(Double_t *, const char *, std::size_t, Int_t);
+};
+
+const RKernels kScalarKernels{EByteSwapKernel::kScalar,        ByteSwapCopyScalar<2>,
+                              ByteSwapCopyScalar<4>,           ByteSwapCopyScalar<8>,
+                              UnpackTruncatedScalar<Float_t>, UnpackTruncatedScalar<Double_t>};
+#ifdef R__BSWAP_X86
+const RKernels kSSSE3Kernels{EByteSwapKernel::kSSSE3,         ByteSwapCopySSSE3<2>,
+                             ByteSwapCopySSSE3<4>,            ByteSwapCopySSSE3<8>,
+                             UnpackTruncatedSSSE3<Float_t>,  UnpackTruncatedSSSE3<Double_t>};
+#ifdef R__BSWAP_AVX2
+const RKernels kAVX2Kernels{EByteSwapKernel::kAVX2,          ByteSwapCopyAVX2<2>,
+                            ByteSwapCopyAVX2<4>,             ByteSwapCopyAVX2<8>,
+                            UnpackTruncatedAVX2<Float_t>,   UnpackTruncatedAVX2<Double_t>};
+#endif
+#ifdef R__BSWAP_AVX512
+// The truncated floats are too narrow to gain from 512 bit registers, use the AVX2 kernels for them
+const RKernels kAVX512Kernels{EByteSwapKernel::kAVX512,      ByteSwapCopyAVX512<2>,
+                              ByteSwapCopyAVX512<4>,         ByteSwapCopyAVX512<8>,
+                              UnpackTruncatedAVX2<Float_t>, UnpackTruncatedAVX2<Double_t>};
+#endif
+#endif
+#ifdef R__BSWAP_NEON
+const RKernels kNEONKernels{EByteSwapKernel::kNEON,           ByteSwapCopyNEON<2>,
+                            ByteSwapCopyNEON<4>,              ByteSwapCopyNEON<8>,
+                            UnpackTruncatedScalar<Float_t>,  UnpackTruncatedScalar<Double_t>};
+#endif
+
+/// Return the kernels of the given kind if they can run on this CPU, nullptr otherwise
+const RKernels *FindKernels(EByteSwapKernel kind)
+{
+#ifdef R__BSWAP_X86
+   __builtin_cpu_init();
+#endif
+   switch (kind) {
+   case EByteSwapKernel::kScalar: return &kScalarKernels;
+#ifdef R__BSWAP_X86
+   case EByteSwapKernel::kSSSE3: return __builtin_cpu_supports("ssse3") ? &kSSSE3Kernels : nullptr;
+#ifdef R__BSWAP_AVX2
+   case EByteSwapKernel::kAVX2: return __builtin_cpu_supports("avx2") ? &kAVX2Kernels : nullptr;
+#endif
+#ifdef R__BSWAP_AVX512
+   case EByteSwapKernel::kAVX512:
+      return __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx2") ? &kAVX512Kernels : nullptr;
+#endif
+#endif
+#ifdef R__BSWAP_NEON
+   case EByteSwapKernel::kNEON: return &kNEONKernels;
+#endif
+   default: return nullptr;
+   }
+}
+
+std::atomic<const RKernels *> gKernels{nullptr};
+
+const RKernels &GetKernels()
+{
+   const RKernels *kernels = gKernels.load(std::memory_order_acquire);
+   if (kernels)
+      return *kernels;
+   // Racing initializations all pick the same kernels
+   for (auto kind : {EByteSwapKernel::kAVX512, EByteSwapKernel::kAVX2, EByteSwapKernel::kSSSE3,
+                     EByteSwapKernel::kNEON, EByteSwapKernel::kScalar}) {
+      if ((kernels = FindKernels(kind)))
+         break;
+   }
+   gKernels.store(kernels, std::memory_order_release);
+   return *kernels;
+}
+
+} // anonymous namespace
+
+void ROOT::Internal::ByteSwapCopy16(void *to, const void *from, std::size_t n)
+{
+   GetKernels().fSwap16(to, from, n);
+}
+
+void ROOT::Internal::ByteSwapCopy32(void *to, const void *from, std::size_t n)
+{
+   GetKernels().fSwap32(to, from, n);
+}
+
+void ROOT::Internal::ByteSwapCopy64(void *to, const void *from, std::size_t n)
+{
+   GetKernels().fSwap64(to, from, n);
+}
+
+void ROOT::Internal::UnpackTruncatedFloats(Float_t *to, const char *from, std::size_t n, Int_t nbits)
+{
+   GetKernels().fUnpackFloat(to, from, n, nbits);
+}
+
+void ROOT::Internal::UnpackTruncatedFloats(Double_t *to, const char *from, std::size_t n, Int_t nbits)
+{
+   GetKernels().fUnpackDouble(to, from, n, nbits);
+}
+
+ROOT::Internal::EByteSwapKernel ROOT::Internal::GetByteSwapKernel()
+{
+   return GetKernels().fKind;
+}
+
+const char *ROOT::Internal::GetByteSwapKernelName(EByteSwapKernel kernel)
+{
+   switch (kernel) {
+   case EByteSwapKernel::kScalar: return "scalar";
+   case EByteSwapKernel::kSSSE3: return "ssse3";
+   case EByteSwapKernel::kAVX2: return "avx2";
+   case EByteSwapKernel::kAVX512: return "avx512";
+   case EByteSwapKernel::kNEON: return "neon";
+   }
+   return "unknown";
+}
+
+bool ROOT::Internal::SetByteSwapKernel(EByteSwapKernel kernel)
+{
+   const RKernels *kernels = FindKernels(kernel);
+   if (!kernels)
+      return false;
+   gKernels.store(kernels, std::memory_order_release);
+   return true;
+}
@@ -2450,6 +2450,26 @@ int TSystem::SendRaw(int, const void *, int, int)
    return -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Send exactly the nbuffers buffers, of lengths lengths, one after the
+/// other. Returns the total number of bytes sent or, as SendRaw, a value
+/// <= 0 in case of error. This implementation calls SendRaw for each buffer,
+/// systems supporting it send all of them with a single gather write.
+
+int TSystem::SendRawv(int sock, const void *const *buffers, const int *lengths, int nbuffers, int opt)
+{
+   int nsent = 0;
+   for (int i = 0; i < nbuffers; ++i) {
+      if (lengths[i] <= 0)
+         continue;
+      int n;
+      if ((n = SendRaw(sock, buffers[i], lengths[i], opt)) <= 0)
+         return n;
+      nsent += n;
+   }
+   return nsent;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Receive a buffer headed by a length indicator.
 
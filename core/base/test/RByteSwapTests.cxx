@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/RByteSwap.hxx"
+#include "Bytes.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using ROOT::Internal::EByteSwapKernel;
+
+namespace {
+const EByteSwapKernel kAllKernels[] = {EByteSwapKernel::kScalar, EByteSwapKernel::kSSSE3, EByteSwapKernel::kAVX2,
+                                       EByteSwapKernel::kAVX512, EByteSwapKernel::kNEON};
+// sizes around the vector widths of all kernels, to cover the main loops and the tails
+const std::size_t kSizes[] = {0, 1, 3, 5, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 1001};
+
+std::vector<char> RandomBytes(std::size_t n)
+{
+   static std::mt19937 gen(42);
+   std::vector<char> v(n);
+   for (auto &c : v)
+      c = static_cast<char>(gen());
+   return v;
+}
+
+// The reference implementation: TBufferFile::ReadFloat16 before the vectorized kernels
+Float_t UnpackTruncatedFloat(char *&buf, Int_t nbits)
+{
+   union {
+      Float_t fFloatValue;
+      Int_t fIntValue;
+   };
+   UChar_t theExp;
+   UShort_t theMan;
+   frombuf(buf, &theExp);
+   frombuf(buf, &theMan);
+   fIntValue = theExp;
+   fIntValue <<= 23;
+   fIntValue |= (theMan & ((1 << (nbits + 1)) - 1)) << (23 - nbits);
+   if (1 << (nbits + 1) & theMan)
+      fFloatValue = -fFloatValue;
+   return fFloatValue;
+}
+
+template <typename T>
+void CheckByteSwapCopy(void (*swap)(void *, const void *, std::size_t))
+{
+   for (auto n : kSizes) {
+      auto in = RandomBytes(n * sizeof(T));
+      std::vector<T> expected(n);
+      char *cur = in.data();
+      for (auto &x : expected)
+         frombuf(cur, &x);
+
+      std::vector<T> out(n);
+      swap(out.data(), in.data(), n);
+      EXPECT_EQ(0, memcmp(out.data(), expected.data(), n * sizeof(T))) << "n = " << n;
+
+      swap(in.data(), in.data(), n); // in place
+      EXPECT_EQ(0, memcmp(in.data(), expected.data(), n * sizeof(T))) << "in place, n = " << n;
+   }
+}
+} // anonymous namespace
+
+TEST(RByteSwap, Kernels)
+{
+   const auto defaultKernel = ROOT::Internal::GetByteSwapKernel();
+   EXPECT_TRUE(ROOT::Internal::SetByteSwapKernel(EByteSwapKernel::kScalar));
+   for (auto kernel : kAllKernels) {
+      if (!ROOT::Internal::SetByteSwapKernel(kernel))
+         continue;
+      SCOPED_TRACE(ROOT::Internal::GetByteSwapKernelName(kernel));
+      EXPECT_EQ(ROOT::Internal::GetByteSwapKernel(), kernel);
+      CheckByteSwapCopy<UShort_t>(ROOT::Internal::ByteSwapCopy16);
+      CheckByteSwapCopy<UInt_t>(ROOT::Internal::ByteSwapCopy32);
+      CheckByteSwapCopy<ULong64_t>(ROOT::Internal::ByteSwapCopy64);
+   }
+   EXPECT_TRUE(ROOT::Internal::SetByteSwapKernel(defaultKernel));
+}
+
+TEST(RByteSwap, TruncatedFloats)
+{
+   const auto defaultKernel = ROOT::Internal::GetByteSwapKernel();
+   for (auto kernel : kAllKernels) {
+      if (!ROOT::Internal::SetByteSwapKernel(kernel))
+         continue;
+      SCOPED_TRACE(ROOT::Internal::GetByteSwapKernelName(kernel));
+      for (auto nbits : {2, 8, 12, 14}) {
+         for (auto n : kSizes) {
+            auto in = RandomBytes(3 * n);
+            std::vector<Float_t> expected(n);
+            char *cur = in.data();
+            for (auto &x : expected)
+               x = UnpackTruncatedFloat(cur, nbits);
+
+            std::vector<Float_t> f(n);
+            ROOT::Internal::UnpackTruncatedFloats(f.data(), in.data(), n, nbits);
+            EXPECT_EQ(0, memcmp(f.data(), expected.data(), n * sizeof(Float_t))) << "nbits = " << nbits << ", n = " << n;
+
+            std::vector<Double_t> d(n);
+            ROOT::Internal::UnpackTruncatedFloats(d.data(), in.data(), n, nbits);
+            for (std::size_t i = 0; i < n; ++i) {
+               if (expected[i] != expected[i]) // NaNs compare unequal
+                  continue;
+               EXPECT_EQ(d[i], Double_t(expected[i])) << "nbits = " << nbits << ", n = " << n << ", i = " << i;
+            }
+         }
+      }
+   }
+   EXPECT_TRUE(ROOT::Internal::SetByteSwapKernel(defaultKernel));
+}
@@ -45,6 +45,7 @@ protected:
    static  Bool_t    fgCanDelete;        //True if ReadBuffer can delete object
    static  Bool_t    fgOptimize;         //True if optimization on
    static  Bool_t    fgStreamMemberWise; //True if the collections are to be stream "member-wise" (when possible).
+   static  Bool_t    fgCompiledStreamers; //True if runs of basic data members are streamed by generated functions.
    static TVirtualStreamerInfo  *fgInfoFactory;
 
    TVirtualStreamerInfo(const TVirtualStreamerInfo& info);
@@ -167,6 +168,7 @@ public:
    virtual void        SetClass(TClass *cl) = 0;
    virtual void        SetClassVersion(Int_t vers) = 0;
    static  Bool_t      SetStreamMemberWise(Bool_t enable = kTRUE);
+   static  Bool_t      SetCompiledStreamers(Bool_t enable = kTRUE);
    virtual void        TagFile(TFile *fFile) = 0;
    virtual void        Update(const TClass *oldClass, TClass *newClass) = 0;
 
@@ -175,6 +177,7 @@ public:
 
    static Bool_t       CanOptimize();
    static Bool_t       GetStreamMemberWise();
+   static Bool_t       GetCompiledStreamers();
    static void         Optimize(Bool_t opt=kTRUE);
    static Bool_t       CanDelete();
    static void         SetCanDelete(Bool_t opt=kTRUE);
@@ -28,6 +28,7 @@ TVirtualStreamerInfo *TVirtualStreamerInfo::fgInfoFactory    = 0;
 Bool_t  TVirtualStreamerInfo::fgCanDelete        = kTRUE;
 Bool_t  TVirtualStreamerInfo::fgOptimize         = kTRUE;
 Bool_t  TVirtualStreamerInfo::fgStreamMemberWise = kTRUE;
+Bool_t  TVirtualStreamerInfo::fgCompiledStreamers = kFALSE;
 
 ClassImp(TVirtualStreamerInfo);
 
@@ -157,6 +158,18 @@ Bool_t TVirtualStreamerInfo::GetStreamMemberWise()
    return fgStreamMemberWise;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the TStreamerInfos compiled from now on stream the runs of
+/// consecutive basic data members (and fixed size arrays of basic types)
+/// with functions generated, at Compile time, for the exact layout of the
+/// class. The default is to use the generic streamer actions.
+/// See SetCompiledStreamers.
+
+Bool_t TVirtualStreamerInfo::GetCompiledStreamers()
+{
+   return fgCompiledStreamers;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///  This is a static function.
 ///  Set optimization option.
@@ -251,6 +264,28 @@ Bool_t TVirtualStreamerInfo::SetStreamMemberWise(Bool_t enable)
    return prev;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set whether the TStreamerInfos compiled from now on stream the runs of
+/// consecutive basic data members with functions generated for the exact
+/// layout of the class (one function per run, just-in-time compiled by the
+/// interpreter), instead of one generic action per data member.
+/// The default is kFALSE.
+///
+/// Only the object-wise streaming of the TStreamerInfo describing the
+/// in-memory layout of a compiled class is affected: on schema evolution
+/// (different class version or checksum, emulated classes, conversions,
+/// read rules) the generic actions are used, as well as for the buffers
+/// overriding the TBufferFile streaming (e.g. TBufferSQL). The on-file
+/// format is unchanged.
+/// This function returns the previous value of fgCompiledStreamers.
+
+Bool_t TVirtualStreamerInfo::SetCompiledStreamers(Bool_t enable)
+{
+   Bool_t prev = fgCompiledStreamers;
+   fgCompiledStreamers = enable;
+   return prev;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Stream an object of class TVirtualStreamerInfo.
 
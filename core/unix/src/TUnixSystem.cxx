@@ -99,6 +99,7 @@
 #include <sys/time.h>
 #include <sys/file.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #if defined(R__AIX)
@@ -3406,6 +3407,28 @@ int TUnixSystem::SendRaw(int sock, const void *buf, int length, int opt)
    return n;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Send exactly the nbuffers buffers, of lengths lengths, one after the
+/// other with gather writes (sendmsg), i.e. without copying them into a
+/// single buffer. Only the kDefault option is supported this way, the
+/// others are handled by sending the buffers one by one with SendRaw.
+/// Returns the total number of bytes sent, -1 in case of error, -5 if
+/// pipe broken or reset by peer.
+
+int TUnixSystem::SendRawv(int sock, const void *const *buffers, const int *lengths, int nbuffers, int opt)
+{
+   if (opt != kDefault)
+      return TSystem::SendRawv(sock, buffers, lengths, nbuffers, opt);
+
+   int n;
+   if ((n = UnixSendv(sock, buffers, lengths, nbuffers, 0)) <= 0) {
+      if (n == -1 && GetErrno() != EINTR)
+         Error("SendRawv", "cannot send buffers");
+      return n;
+   }
+   return n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set socket option.
 
@@ -4570,6 +4593,57 @@ int TUnixSystem::UnixSend(int sock, const void *buffer, int length, int flag)
    return n;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Send exactly the nbuffers buffers, of lengths lengths, one after the
+/// other using sendmsg. Returns the total number of bytes sent, -1 in case
+/// of error, -4 if the socket would block, -5 if pipe broken or reset by peer.
+
+int TUnixSystem::UnixSendv(int sock, const void *const *buffers, const int *lengths, int nbuffers, int flag)
+{
+   if (sock < 0) return -1;
+
+   const int kMaxIov = 64;
+   struct iovec iov[kMaxIov];
+   int ntot = 0;
+   int first = 0, offset = 0;   // first buffer not completely sent and bytes of it already sent
+
+   while (first < nbuffers) {
+      int niov = 0;
+      for (int i = first; i < nbuffers && niov < kMaxIov; ++i, ++niov) {
+         const int skip = (i == first) ? offset : 0;
+         iov[niov].iov_base = (char *)buffers[i] + skip;
+         iov[niov].iov_len  = lengths[i] - skip;
+      }
+      struct msghdr msg;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov    = iov;
+      msg.msg_iovlen = niov;
+
+      ssize_t nsent;
+      if ((nsent = sendmsg(sock, &msg, flag)) <= 0) {
+         if (nsent == 0)
+            break;
+         if (GetErrno() == EWOULDBLOCK)
+            return -4;
+         else {
+            if (GetErrno() != EINTR)
+               ::SysError("TUnixSystem::UnixSendv", "sendmsg");
+            if (GetErrno() == EPIPE || GetErrno() == ECONNRESET)
+               return -5;
+            else
+               return -1;
+         }
+      }
+      ntot   += nsent;
+      offset += nsent;
+      while (first < nbuffers && offset >= lengths[first]) {
+         offset -= lengths[first];
+         ++first;
+      }
+   }
+   return ntot;
+}
+
 //---- Dynamic Loading ---------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -17,6 +17,8 @@
 #ifndef ROOT_RZip
 #define ROOT_RZip
 
+#include <cstddef>
+
 extern "C" unsigned long R__crc32(unsigned long crc, const unsigned char* buf, unsigned int len);
 
 extern "C" unsigned long R__memcompress(char *tgt, unsigned long tgtsize, char *src, unsigned long srcsize);
@@ -33,6 +35,22 @@ extern "C" void R__unzip(int *srcsize, unsigned char *src, int *tgtsize, unsigne
 
 extern "C" int R__unzip_header(int *srcsize, unsigned char *src, int *tgtsize);
 
+/**
+ * ZSTD compression with a dictionary: R__zipZSTDDict compresses with a dictionary created by R__createZSTDDict or
+ * R__createNewZSTDDict, and R__unzipZSTDDict decompresses with it. The compressed buffers only record the ID of their
+ * dictionary (see R__getZSTDDictIDFromBuffer), which is not unique across files: each owner of dictionaries (e.g. a
+ * tree) resolves the IDs of its buffers among its own dictionaries. R__unzip cannot decompress such buffers.
+ */
+struct R__ZSTDDict;
+extern "C" int R__trainZSTDDict(const char *samples, const size_t *samplesizes, unsigned nsamples, char *dict, int dictcapacity);
+extern "C" R__ZSTDDict *R__createZSTDDict(const char *dict, int dictsize);
+extern "C" R__ZSTDDict *R__createNewZSTDDict(char *dict, int dictsize, const unsigned *usedids, int nusedids);
+extern "C" void R__deleteZSTDDict(R__ZSTDDict *dict);
+extern "C" unsigned R__getZSTDDictID(const R__ZSTDDict *dict);
+extern "C" unsigned R__getZSTDDictIDFromBuffer(int srcsize, const unsigned char *src);
+extern "C" void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, R__ZSTDDict *dict);
+extern "C" void R__unzipZSTDDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep, const R__ZSTDDict *dict);
+
 enum { kMAXZIPBUF = 0xffffff };
 
 #endif
@@ -9,12 +9,18 @@
  *************************************************************************/
 
 #include "ZipZSTD.h"
+#include "RZip.h"
 
 #include "ROOT/RConfig.hxx"
 
 #include "zdict.h"
 #include <zstd.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <iostream>
 
@@ -22,17 +28,52 @@ static const int kHeaderSize = 9;
 
 static const size_t errorCodeSmallBuffer = (size_t)-70;
 
-void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+/// A zstd dictionary, digested once for decompression and once per compression level for
+/// compression. It belongs to whoever created it, e.g. the branch that trained it or the tree
+/// that read it from its file, and is passed explicitly to R__zipZSTDDict and R__unzipZSTDDict:
+/// the compressed buffers only record the 31-bit ID of their dictionary, which is unique among
+/// the dictionaries of a tree but not across files.
+struct R__ZSTDDict {
+    std::vector<char> fContent;
+    unsigned fID = 0;
+    std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)> fDDict{nullptr, &ZSTD_freeDDict};
+    /// Protects fCDicts: the baskets of a branch can be compressed concurrently
+    std::mutex fCDictsMutex;
+    std::map<int, std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)>> fCDicts;
+};
+
+namespace {
+
+const ZSTD_CDict *GetCDict(R__ZSTDDict &dict, int level)
+{
+    std::lock_guard<std::mutex> lock(dict.fCDictsMutex);
+    auto &cdict = dict.fCDicts.emplace(level, std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)>{nullptr, &ZSTD_freeCDict}).first->second;
+    if (!cdict)
+        cdict.reset(ZSTD_createCDict(dict.fContent.data(), dict.fContent.size(), level));
+    return cdict.get();
+}
+
+} // anonymous namespace
+
+static void R__zipZSTDImpl(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, const ZSTD_CDict *cdict)
 {
     using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
     Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
 
     *irep = 0;
 
-    size_t retval = ZSTD_compressCCtx(fCtx.get(),
-                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
-                                        src, static_cast<size_t>(*srcsize),
-                                        2*cxlevel);
+    size_t retval;
+    if (cdict) {
+        retval = ZSTD_compress_usingCDict(fCtx.get(),
+                                          &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                          src, static_cast<size_t>(*srcsize),
+                                          cdict);
+    } else {
+        retval = ZSTD_compressCCtx(fCtx.get(),
+                                   &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                   src, static_cast<size_t>(*srcsize),
+                                   2*cxlevel);
+    }
 
     if (R__unlikely(ZSTD_isError(retval))) {
         if (R__unlikely(retval != errorCodeSmallBuffer)) {
@@ -58,7 +99,90 @@ void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
     tgt[8] = (inflate_size >> 16) & 0xff;
 }
 
-void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+    R__zipZSTDImpl(cxlevel, srcsize, src, tgtsize, tgt, irep, nullptr);
+}
+
+/// Compress with the dictionary `dict`, or without dictionary if it is null.
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, R__ZSTDDict *dict)
+{
+    // Same conditions as in R__zipMultipleAlgorithm.
+    if (*srcsize < 1 + kHeaderSize + 1 || cxlevel <= 0) {
+        *irep = 0;
+        return;
+    }
+    R__zipZSTDImpl(cxlevel, srcsize, src, tgtsize, tgt, irep, dict ? GetCDict(*dict, 2*cxlevel) : nullptr);
+}
+
+/// Train a dictionary of at most `dictcapacity` bytes from `nsamples` samples stored one after
+/// the other in `samples`. Returns the size of the dictionary, or 0 if it could not be trained
+/// (e.g. because there are too few samples).
+int R__trainZSTDDict(const char *samples, const size_t *samplesizes, unsigned nsamples, char *dict, int dictcapacity)
+{
+    size_t retval = ZDICT_trainFromBuffer(dict, static_cast<size_t>(dictcapacity), samples, samplesizes, nsamples);
+    if (ZDICT_isError(retval))
+        return 0;
+    return static_cast<int>(retval);
+}
+
+/// Digest the dictionary `dict`. Returns null if it is not a zstd dictionary. The dictionary
+/// must be released with R__deleteZSTDDict.
+R__ZSTDDict *R__createZSTDDict(const char *dict, int dictsize)
+{
+    unsigned dictid = ZSTD_getDictID_fromDict(dict, static_cast<size_t>(dictsize));
+    if (R__unlikely(dictid == 0)) {
+        std::cerr << "R__createZSTDDict: the buffer does not contain a ZSTD dictionary." << std::endl;
+        return nullptr;
+    }
+    auto result = new R__ZSTDDict;
+    result->fContent.assign(dict, dict + dictsize);
+    result->fID = dictid;
+    result->fDDict.reset(ZSTD_createDDict(result->fContent.data(), result->fContent.size()));
+    return result;
+}
+
+/// Digest a dictionary that was just trained, see R__createZSTDDict. If its ID is one of the
+/// `nusedids` IDs in `usedids`, a free ID is written in `dict` first, so that the owner of the
+/// dictionary can tell the buffers compressed with it from those compressed with its other
+/// dictionaries.
+R__ZSTDDict *R__createNewZSTDDict(char *dict, int dictsize, const unsigned *usedids, int nusedids)
+{
+    unsigned dictid = ZSTD_getDictID_fromDict(dict, static_cast<size_t>(dictsize));
+    if (R__unlikely(dictid == 0)) {
+        std::cerr << "R__createNewZSTDDict: the buffer does not contain a ZSTD dictionary." << std::endl;
+        return nullptr;
+    }
+    while (std::find(usedids, usedids + nusedids, dictid) != usedids + nusedids) {
+        // The IDs below 32768 are reserved by the zstd format; the ID is stored little endian
+        // after the 4-byte magic number.
+        dictid = dictid >= 0x7fffffffu ? 32768u : dictid + 1;
+        for (int i = 0; i < 4; ++i)
+            dict[4 + i] = static_cast<char>((dictid >> (8 * i)) & 0xff);
+    }
+    return R__createZSTDDict(dict, dictsize);
+}
+
+void R__deleteZSTDDict(R__ZSTDDict *dict)
+{
+    delete dict;
+}
+
+unsigned R__getZSTDDictID(const R__ZSTDDict *dict)
+{
+    return dict->fID;
+}
+
+/// Return the ID of the dictionary the compressed buffer `src` needs, or 0 if it is not
+/// compressed with ZSTD or was compressed without dictionary.
+unsigned R__getZSTDDictIDFromBuffer(int srcsize, const unsigned char *src)
+{
+    if (srcsize <= kHeaderSize || src[0] != 'Z' || src[1] != 'S')
+        return 0;
+    return ZSTD_getDictID_fromFrame(&src[kHeaderSize], static_cast<size_t>(srcsize - kHeaderSize));
+}
+
+static void R__unzipZSTDImpl(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep, const R__ZSTDDict *dict)
 {
     using Ctx_ptr = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
     Ctx_ptr fCtx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
@@ -77,9 +201,23 @@ void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
       return;
     }
 
-    size_t retval = ZSTD_decompressDCtx(fCtx.get(),
-                                        (char *)tgt, static_cast<size_t>(*tgtsize),
-                                        (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    size_t retval;
+    const unsigned dictid = ZSTD_getDictID_fromFrame(&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    if (dictid) {
+        if (R__unlikely(!dict || dict->fID != dictid)) {
+            std::cerr << "R__unzipZSTD: the buffer was compressed with the ZSTD dictionary " << dictid <<
+            ", which was not provided." << std::endl;
+            return;
+        }
+        retval = ZSTD_decompress_usingDDict(fCtx.get(),
+                                            (char *)tgt, static_cast<size_t>(*tgtsize),
+                                            (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize),
+                                            dict->fDDict.get());
+    } else {
+        retval = ZSTD_decompressDCtx(fCtx.get(),
+                                     (char *)tgt, static_cast<size_t>(*tgtsize),
+                                     (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    }
 
     /* The error code 18446744073709551546 arises when the tgt buffer is too small
      * However this error is already handled outside of the compression algorithm
@@ -95,3 +233,14 @@ void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
         *irep = retval;
     }
 }
+
+void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+{
+    R__unzipZSTDImpl(srcsize, src, tgtsize, tgt, irep, nullptr);
+}
+
+/// Decompress a buffer compressed by R__zipZSTDDict with the dictionary `dict`.
+void R__unzipZSTDDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep, const R__ZSTDDict *dict)
+{
+    R__unzipZSTDImpl(srcsize, src, tgtsize, tgt, irep, dict);
+}
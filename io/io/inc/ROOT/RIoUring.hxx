@@ -9,11 +9,16 @@
 #ifndef ROOT_RIoUring
 #define ROOT_RIoUring
 
+#include <cerrno>
+#include <cstdint>
 #include <cstring>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <liburing.h>
 #include <liburing/io_uring.h>
+#include <sys/uio.h>
 
 #include "TError.h"
 
@@ -21,8 +26,26 @@ namespace ROOT {
 namespace Internal {
 
 class RIoUring {
+public:
+   /// Basic read event composed of the I/O data and a target file descriptor
+   struct RReadEvent {
+      /// The destination for reading
+      void *fBuffer = nullptr;
+      /// The file offset
+      std::uint64_t fOffset = 0;
+      /// The number of desired bytes
+      std::size_t fSize = 0;
+      /// The number of actually read bytes, set by SubmitReadsAndWait()
+      std::size_t fOutBytes = 0;
+      /// The file descriptor to read from
+      int fFileDes = -1;
+   };
+
 private:
    struct io_uring fRing;
+   std::uint32_t fDepth = 0;
+   /// False if the ring could not be set up again after an error
+   bool fHasRing = false;
 
    static bool CheckIsAvailable() {
       try {
@@ -36,19 +59,138 @@ private:
    }
 
 public:
-   explicit RIoUring(size_t size) {
+   explicit RIoUring(size_t size) : fDepth(size) {
       int ret = io_uring_queue_init(size, &fRing, 0 /* no flags */);
       if (ret) {
          throw std::runtime_error("Error initializing io_uring: " + std::string(std::strerror(-ret)));
       }
+      fHasRing = true;
    }
 
    RIoUring(const RIoUring&) = delete;
    RIoUring& operator=(const RIoUring&) = delete;
 
    ~RIoUring() {
-      // todo(max) try submitting any pending events before exiting
+      // SubmitReadsAndWait() never returns with requests in flight
+      if (fHasRing)
+         io_uring_queue_exit(&fRing);
+   }
+
+   std::uint32_t GetQueueDepth() const { return fDepth; }
+
+private:
+   /// Called before an error is propagated: waits for the nInFlight submitted requests so that the kernel does not
+   /// write into the caller's buffers once they are released.  Requests that have been prepared but not submitted,
+   /// or completions that cannot be reaped, are dropped by setting up the ring anew.
+   void Abort(unsigned int nInFlight, unsigned int nPending) {
+      bool isClean = (nPending == 0);
+      while (nInFlight > 0) {
+         struct io_uring_cqe *cqe = nullptr;
+         int ret = io_uring_wait_cqe(&fRing, &cqe);
+         if (ret == -EINTR)
+            continue;
+         if (ret < 0) {
+            isClean = false;
+            break;
+         }
+         io_uring_cqe_seen(&fRing, cqe);
+         nInFlight--;
+      }
+      if (isClean)
+         return;
+
+      // Closing the ring cancels outstanding requests
       io_uring_queue_exit(&fRing);
+      fHasRing = (io_uring_queue_init(fDepth, &fRing, 0 /* no flags */) == 0);
+   }
+
+public:
+   /// Submit the read events and block until all of them completed.  The submission queue is refilled as soon as
+   /// requests complete, so that up to GetQueueDepth() reads are in flight at any time.  Short reads are resubmitted
+   /// for the remaining bytes until the end of the file is reached.  On errors, a std::runtime_error is thrown.
+   void SubmitReadsAndWait(RReadEvent *readEvents, unsigned int nReads) {
+      if (!fHasRing)
+         throw std::runtime_error("io_uring is not set up");
+
+      // The iovec structures need to remain valid until the corresponding request completed
+      std::vector<struct iovec> iovecs(nReads);
+      unsigned int nextToSubmit = 0;
+      unsigned int nCompleted = 0;
+      // Requests passed to the kernel whose completion has not yet been reaped
+      unsigned int nInFlight = 0;
+      // Requests prepared in the submission queue but not yet passed to the kernel
+      unsigned int nPending = 0;
+
+      auto fnFail = [&](const std::string &what) {
+         Abort(nInFlight, nPending);
+         throw std::runtime_error(what);
+      };
+
+      auto fnPrepareRead = [&](unsigned int idx) {
+         struct io_uring_sqe *sqe = io_uring_get_sqe(&fRing);
+         if (!sqe)
+            fnFail("io_uring submission queue unexpectedly full");
+         auto &event = readEvents[idx];
+         iovecs[idx].iov_base = static_cast<unsigned char *>(event.fBuffer) + event.fOutBytes;
+         iovecs[idx].iov_len = event.fSize - event.fOutBytes;
+         io_uring_prep_readv(sqe, event.fFileDes, &iovecs[idx], 1, event.fOffset + event.fOutBytes);
+         io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(static_cast<std::uintptr_t>(idx)));
+         nPending++;
+      };
+
+      for (unsigned int i = 0; i < nReads; ++i)
+         readEvents[i].fOutBytes = 0;
+
+      while (nCompleted < nReads) {
+         while ((nInFlight + nPending < fDepth) && (nextToSubmit < nReads)) {
+            if (readEvents[nextToSubmit].fSize == 0) {
+               nextToSubmit++;
+               nCompleted++;
+               continue;
+            }
+            fnPrepareRead(nextToSubmit++);
+         }
+         if (nInFlight + nPending == 0)
+            break;
+
+         if (nPending > 0) {
+            int ret = io_uring_submit(&fRing);
+            if (ret < 0)
+               fnFail("io_uring submission failed: " + std::string(std::strerror(-ret)));
+            nInFlight += ret;
+            nPending -= ret;
+            if (nInFlight == 0)
+               fnFail("io_uring did not accept any request");
+         }
+
+         struct io_uring_cqe *cqe = nullptr;
+         int ret;
+         do {
+            ret = io_uring_wait_cqe(&fRing, &cqe);
+         } while (ret == -EINTR);
+         if (ret < 0)
+            fnFail("io_uring wait failed: " + std::string(std::strerror(-ret)));
+
+         auto idx = static_cast<unsigned int>(reinterpret_cast<std::uintptr_t>(io_uring_cqe_get_data(cqe)));
+         int res = cqe->res;
+         io_uring_cqe_seen(&fRing, cqe);
+         nInFlight--;
+
+         if (res < 0) {
+            if (res == -EINTR || res == -EAGAIN) {
+               fnPrepareRead(idx);
+               continue;
+            }
+            fnFail("io_uring read failed: " + std::string(std::strerror(-res)));
+         }
+         auto &event = readEvents[idx];
+         event.fOutBytes += res;
+         if ((res > 0) && (event.fOutBytes < event.fSize)) {
+            fnPrepareRead(idx);
+            continue;
+         }
+         nCompleted++;
+      }
    }
 
    /// Check if io_uring is available on this system.
@@ -52,6 +52,9 @@ public:
    /// File supports async IO
    static constexpr int kFeatureHasAsyncIo = 0x04;
 
+   /// Access pattern hints for memory mapped regions, see Advise()
+   enum class EMapAdvice { kNormal, kSequential, kWillNeed, kDontNeed };
+
    /// On construction, an ROptions parameter can customize the RRawFile behavior
    struct ROptions {
       ELineBreaks fLineBreak;
@@ -60,7 +63,33 @@ public:
        * that the protocol-dependent default block size should be used.
        */
       int fBlockSize;
-      ROptions() : fLineBreak(ELineBreaks::kAuto), fBlockSize(-1) {}
+      /**
+       * If set, ReadV() merges byte ranges that are at most fReadVMaxGap bytes apart into a single request, as long as
+       * the extra bytes read in the gaps stay below fReadVMaxWaste times the requested bytes. Merged requests are read
+       * into a temporary buffer and copied to the destinations.
+       */
+      bool fReadVCoalesce;
+      std::uint64_t fReadVMaxGap;
+      float fReadVMaxWaste;
+      /// If larger than zero, ReadV() splits byte ranges larger than fReadVMaxRequestSize into several requests
+      std::size_t fReadVMaxRequestSize;
+      ROptions()
+         : fLineBreak(ELineBreaks::kAuto), fBlockSize(-1), fReadVCoalesce(false), fReadVMaxGap(64 * 1024),
+           fReadVMaxWaste(0.25), fReadVMaxRequestSize(0)
+      {
+      }
+   };
+
+   /// Cumulative statistics of the ReadV() calls, which show the effect of coalescing and splitting byte ranges
+   struct RReadVStats {
+      /// The number of non-empty byte ranges passed to ReadV()
+      std::uint64_t fNRanges = 0;
+      /// The number of requests sent to the storage
+      std::uint64_t fNRequests = 0;
+      /// The sum of the sizes of the requested byte ranges
+      std::uint64_t fSzUsed = 0;
+      /// The number of bytes requested from the storage, including the gaps between merged byte ranges
+      std::uint64_t fSzRead = 0;
    };
 
    /// Used for vector reads from multiple offsets into multiple buffers. This is unlike readv(), which scatters a
@@ -105,6 +134,10 @@ private:
    std::uint64_t fFileSize;
    /// Files are opened lazily and only when required; the open state is kept by this flag
    bool fIsOpen;
+   RReadVStats fReadVStats;
+
+   /// Reads the byte ranges according to the coalescing and splitting parameters in fOptions
+   void ReadVPlanned(RIOVec *ioVec, unsigned int nReq);
 
 protected:
    std::string fUrl;
@@ -131,6 +164,9 @@ protected:
    virtual void *MapImpl(size_t nbytes, std::uint64_t offset, std::uint64_t &mapdOffset);
    /// Derived classes with mmap support must be able to unmap the memory area handed out by Map()
    virtual void UnmapImpl(void *region, size_t nbytes);
+   /// Derived classes with mmap support can forward access pattern hints to the operating system.
+   /// The default implementation ignores the hint.
+   virtual void AdviseImpl(void *region, size_t nbytes, EMapAdvice advice);
 
    /// By default implemented as a loop of ReadAt calls but can be overwritten, e.g. XRootD or DAVIX implementations
    virtual void ReadVImpl(RIOVec *ioVec, unsigned int nReq);
@@ -165,8 +201,9 @@ public:
    /// Returns the url of the file
    std::string GetUrl() const;
 
-   /// Opens the file if necessary and calls ReadVImpl
+   /// Opens the file if necessary and calls ReadVImpl, possibly after coalescing and splitting the byte ranges
    void ReadV(RIOVec *ioVec, unsigned int nReq);
+   const RReadVStats &GetReadVStats() const { return fReadVStats; }
 
    /// Memory mapping according to POSIX standard; in particular, new mappings of the same range replace older ones.
    /// Mappings need to be aligned at page boundaries, therefore the real offset can be smaller than the desired value.
@@ -174,6 +211,9 @@ public:
    void *Map(size_t nbytes, std::uint64_t offset, std::uint64_t &mapdOffset);
    /// Receives a pointer returned by Map() and should have nbytes set to the full length of the mapping
    void Unmap(void *region, size_t nbytes);
+   /// Hints how a part of a region returned by Map() is going to be accessed, e.g. to prefetch it into the page
+   /// cache or to release the resident memory of a range that is not needed anymore.  The hint may be ignored.
+   void Advise(void *region, size_t nbytes, EMapAdvice advice);
 
    /// Derived classes shall inform the user about the supported functionality, which can possibly depend
    /// on the file at hand
@@ -15,12 +15,19 @@
 #include <ROOT/RRawFile.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include "RConfigure.h"
+
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 namespace ROOT {
 namespace Internal {
 
+#ifdef R__HAS_URING
+class RIoUring;
+#endif
+
 /**
  * \class RRawFileUnix RRawFileUnix.hxx
  * \ingroup IO
@@ -31,6 +38,12 @@ namespace Internal {
 class RRawFileUnix : public RRawFile {
 private:
    int fFileDes;
+#ifdef R__HAS_URING
+   /// Number of read requests that are kept in flight by vector reads
+   static constexpr unsigned int kIoUringQueueDepth = 128;
+   /// The ring is created on the first vector read and reused for all following vector reads
+   std::unique_ptr<RIoUring> fIoUring;
+#endif
 
 protected:
    void OpenImpl() final;
@@ -39,6 +52,7 @@ protected:
    std::uint64_t GetSizeImpl() final;
    void *MapImpl(size_t nbytes, std::uint64_t offset, std::uint64_t &mapdOffset) final;
    void UnmapImpl(void *region, size_t nbytes) final;
+   void AdviseImpl(void *region, size_t nbytes, EMapAdvice advice) final;
 
 public:
    RRawFileUnix(std::string_view url, RRawFile::ROptions options);
@@ -0,0 +1,91 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RReadVPlanner
+#define ROOT_RReadVPlanner
+
+#include <ROOT/RRawFile.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+ * \class RReadVPlanner RReadVPlanner.hxx
+ * \ingroup IO
+ *
+ * The RReadVPlanner turns the byte ranges of a vector read into the requests that are actually sent to the storage.
+ * Byte ranges that are close to each other are merged into a single request, such that the number of syscalls or
+ * network round-trips goes down at the price of reading some unused bytes in the gaps.  The tolerated gaps are
+ * limited both by an absolute gap size and by the total number of wasted bytes relative to the requested bytes.
+ * Very large byte ranges are split into several requests, which can then be served in parallel.
+ *
+ * The planned requests ("blocks") are laid out consecutively in a virtual buffer.  Callers can either read the
+ * blocks into a single buffer of that layout or distribute the blocks over several buffers.
+ */
+class RReadVPlanner {
+public:
+   struct RSettings {
+      /// If not set, only overlapping byte ranges are merged
+      bool fCoalesce = true;
+      /// Byte ranges that are at most fMaxGap bytes apart are merged, subject to fMaxWaste
+      std::uint64_t fMaxGap = std::uint64_t(-1);
+      /// The sum of the merged gaps must stay below this fraction of the requested bytes
+      float fMaxWaste = 0.25;
+      /// Blocks are not merged beyond this size and byte ranges larger than this size are split.  Zero turns off
+      /// splitting.
+      std::size_t fMaxRequestSize = 0;
+   };
+
+   /// A contiguous byte range of the file that is read by a single request
+   struct RBlock {
+      std::uint64_t fOffset = 0;
+      std::size_t fSize = 0;
+      /// Position of the block in the concatenation of all the blocks of the plan
+      std::size_t fBufferPos = 0;
+      /// The requested byte ranges that are (partially) contained in the block, as indexes into RPlan::fOrder
+      std::size_t fFirstRange = 0;
+      std::size_t fNRanges = 0;
+   };
+
+   struct RPlan {
+      std::vector<RBlock> fBlocks;
+      /// The indexes of the requested byte ranges, sorted by file offset
+      std::vector<std::size_t> fOrder;
+      /// For every requested byte range in the original order, its position in the concatenation of the blocks
+      std::vector<std::size_t> fRangePos;
+      /// Set if some of the requested byte ranges overlap, in which case the block membership of the ranges is
+      /// incomplete and the ranges need to be taken from the concatenated buffer using fRangePos
+      bool fHasOverlaps = false;
+      /// The sum of the sizes of the requested byte ranges
+      std::size_t fSzRequested = 0;
+      /// The sum of the block sizes, i.e. the bytes used plus the bytes read in the gaps
+      std::size_t fSzRead = 0;
+   };
+
+private:
+   RSettings fSettings;
+
+public:
+   RReadVPlanner() = default;
+   explicit RReadVPlanner(const RSettings &settings) : fSettings(settings) {}
+
+   /// Only the fOffset and fSize members of the ioVec elements are used
+   RPlan Plan(const RRawFile::RIOVec *ioVec, unsigned int nReq) const;
+   const RSettings &GetSettings() const { return fSettings; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
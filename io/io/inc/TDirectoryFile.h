@@ -45,14 +45,24 @@ protected:
    TFile      *fFile{nullptr};           ///< Pointer to current file in memory
    TList      *fKeys{nullptr};           ///< Pointer to keys list in memory
 
+   static Int_t fgKeyIndexMinKeys;       ///< Minimum number of keys for writing a key index
+
    void        CleanTargets();
    void        InitDirectoryFile(TClass *cl = nullptr);
    void        BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir);
 
 private:
+   struct TKeyIndex;
+   TKeyIndex  *fKeyIndex{nullptr};       ///<! Key index of a read-only directory whose keys are read on demand
+
    TDirectoryFile(const TDirectoryFile &directory) = delete;  //Directories cannot be copied
    void operator=(const TDirectoryFile &) = delete; //Directories cannot be copied
 
+   void        DeleteKeyIndex();
+   TKey       *FindIndexedKey(const char *name, Short_t cycle, Bool_t exact) const;
+   TKey       *ReadIndexedKey(Int_t i) const;
+   void        ReadIndexedKeys();
+
 public:
    // TDirectory status bits
    enum EStatusBits { kCloseDirectory = BIT(7) }; // Unused in ROOT, never set. Maybe only in external code.
@@ -90,10 +100,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
            TFile      *GetFile() const override { return fFile; }
            TKey       *GetKey(const char *name, Short_t cycle=9999) const override;
-           TList      *GetListOfKeys() const override { return fKeys; }
+           TList      *GetListOfKeys() const override;
    const TDatime      &GetModificationDate() const { return fDatimeM; }
            Int_t       GetNbytesKeys() const override { return fNbytesKeys; }
-           Int_t       GetNkeys() const override { return fKeys->GetSize(); }
+           Int_t       GetNkeys() const override;
            Long64_t    GetSeekDir() const override { return fSeekDir; }
            Long64_t    GetSeekParent() const override { return fSeekParent; }
            Long64_t    GetSeekKeys() const override { return fSeekKeys; }
@@ -127,6 +137,9 @@ public:
            void        WriteDirHeader() override;
            void        WriteKeys() override;
 
+   static  Int_t       GetKeyIndexMinKeys();
+   static  void        SetKeyIndexMinKeys(Int_t nkeys);
+
    ClassDefOverride(TDirectoryFile,5)  //Describe directory structure in a ROOT file
 };
 
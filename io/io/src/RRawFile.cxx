@@ -11,6 +11,7 @@
 
 #include <ROOT/RConfig.h>
 #include <ROOT/RRawFile.hxx>
+#include <ROOT/RReadVPlanner.hxx>
 #ifdef _WIN32
 #include <ROOT/RRawFileWin.hxx>
 #else
@@ -29,6 +30,7 @@
 #include <cstring>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace {
 const char *kTransportSeparator = "://";
@@ -110,6 +112,17 @@ void ROOT::Internal::RRawFile::UnmapImpl(void * /* region */, size_t /* nbytes *
    throw std::runtime_error("Memory mapping unsupported");
 }
 
+void ROOT::Internal::RRawFile::AdviseImpl(void * /* region */, size_t /* nbytes */, EMapAdvice /* advice */)
+{
+}
+
+void ROOT::Internal::RRawFile::Advise(void *region, size_t nbytes, EMapAdvice advice)
+{
+   if (!fIsOpen)
+      throw std::runtime_error("Cannot advise, file not open");
+   AdviseImpl(region, nbytes, advice);
+}
+
 std::string ROOT::Internal::RRawFile::GetLocation(std::string_view url)
 {
    auto idx = url.find(kTransportSeparator);
@@ -209,7 +222,103 @@ void ROOT::Internal::RRawFile::ReadV(RIOVec *ioVec, unsigned int nReq)
    if (!fIsOpen)
       OpenImpl();
    fIsOpen = true;
+
+   if (fOptions.fReadVCoalesce || (fOptions.fReadVMaxRequestSize > 0)) {
+      ReadVPlanned(ioVec, nReq);
+      return;
+   }
+
    ReadVImpl(ioVec, nReq);
+   for (unsigned int i = 0; i < nReq; ++i) {
+      if (ioVec[i].fSize == 0)
+         continue;
+      fReadVStats.fNRanges++;
+      fReadVStats.fNRequests++;
+      fReadVStats.fSzUsed += ioVec[i].fSize;
+      fReadVStats.fSzRead += ioVec[i].fSize;
+   }
+}
+
+void ROOT::Internal::RRawFile::ReadVPlanned(RIOVec *ioVec, unsigned int nReq)
+{
+   RReadVPlanner::RSettings settings;
+   settings.fCoalesce = fOptions.fReadVCoalesce;
+   settings.fMaxGap = fOptions.fReadVMaxGap;
+   settings.fMaxWaste = fOptions.fReadVMaxWaste;
+   settings.fMaxRequestSize = fOptions.fReadVMaxRequestSize;
+   const auto plan = RReadVPlanner(settings).Plan(ioVec, nReq);
+   const auto nBlocks = plan.fBlocks.size();
+
+   // Blocks that contain a single byte range are read directly into its destination.  All other blocks are read into
+   // a scratch buffer.  If byte ranges overlap, the scratch buffer takes the layout of the plan.
+   constexpr std::size_t kDirect = std::size_t(-1);
+   std::vector<std::size_t> scratchPos(nBlocks, kDirect);
+   std::size_t szScratch = 0;
+   for (std::size_t b = 0; b < nBlocks; ++b) {
+      if (plan.fHasOverlaps) {
+         scratchPos[b] = plan.fBlocks[b].fBufferPos;
+      } else if (plan.fBlocks[b].fNRanges > 1) {
+         scratchPos[b] = szScratch;
+         szScratch += plan.fBlocks[b].fSize;
+      }
+   }
+   if (plan.fHasOverlaps)
+      szScratch = plan.fSzRead;
+   std::unique_ptr<unsigned char[]> scratch(szScratch > 0 ? new unsigned char[szScratch] : nullptr);
+
+   std::vector<RIOVec> requests(nBlocks);
+   for (std::size_t b = 0; b < nBlocks; ++b) {
+      const auto &block = plan.fBlocks[b];
+      requests[b].fOffset = block.fOffset;
+      requests[b].fSize = block.fSize;
+      if (scratchPos[b] == kDirect) {
+         const auto &range = ioVec[plan.fOrder[block.fFirstRange]];
+         requests[b].fBuffer = reinterpret_cast<unsigned char *>(range.fBuffer) + (block.fOffset - range.fOffset);
+      } else {
+         requests[b].fBuffer = scratch.get() + scratchPos[b];
+      }
+   }
+   if (nBlocks > 0)
+      ReadVImpl(requests.data(), nBlocks);
+
+   for (unsigned int i = 0; i < nReq; ++i)
+      ioVec[i].fOutBytes = 0;
+
+   if (plan.fHasOverlaps) {
+      // Short reads only happen at the end of the file, so all the bytes up to the end of the last block are valid
+      std::uint64_t readUpTo = 0;
+      for (std::size_t b = 0; b < nBlocks; ++b)
+         readUpTo = std::max(readUpTo, requests[b].fOffset + requests[b].fOutBytes);
+      for (auto idx : plan.fOrder) {
+         auto &range = ioVec[idx];
+         if (readUpTo <= range.fOffset)
+            continue;
+         range.fOutBytes = std::min(range.fSize, static_cast<std::size_t>(readUpTo - range.fOffset));
+         memcpy(range.fBuffer, scratch.get() + plan.fRangePos[idx], range.fOutBytes);
+      }
+   } else {
+      for (std::size_t b = 0; b < nBlocks; ++b) {
+         const auto &block = plan.fBlocks[b];
+         const auto blockUpTo = block.fOffset + requests[b].fOutBytes;
+         for (auto k = block.fFirstRange; k < block.fFirstRange + block.fNRanges; ++k) {
+            auto &range = ioVec[plan.fOrder[k]];
+            const auto from = std::max(range.fOffset, block.fOffset);
+            const auto to = std::min(range.fOffset + range.fSize, blockUpTo);
+            if (to <= from)
+               continue;
+            if (scratchPos[b] != kDirect) {
+               memcpy(reinterpret_cast<unsigned char *>(range.fBuffer) + (from - range.fOffset),
+                      scratch.get() + scratchPos[b] + (from - block.fOffset), to - from);
+            }
+            range.fOutBytes += to - from;
+         }
+      }
+   }
+
+   fReadVStats.fNRanges += plan.fOrder.size();
+   fReadVStats.fNRequests += nBlocks;
+   fReadVStats.fSzUsed += plan.fSzRequested;
+   fReadVStats.fSzRead += plan.fSzRead;
 }
 
 bool ROOT::Internal::RRawFile::Readln(std::string &line)
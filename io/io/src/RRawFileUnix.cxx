@@ -20,10 +20,12 @@
 #include "TError.h"
 
 #include <cerrno>
+#include <cstdint>
 #include <cstring>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -45,13 +47,37 @@ ROOT::Internal::RRawFileUnix::~RRawFileUnix()
       close(fFileDes);
 }
 
+void ROOT::Internal::RRawFileUnix::AdviseImpl(void *region, size_t nbytes, EMapAdvice advice)
+{
+   int posixAdvice = MADV_NORMAL;
+   switch (advice) {
+   case EMapAdvice::kNormal: posixAdvice = MADV_NORMAL; break;
+   case EMapAdvice::kSequential: posixAdvice = MADV_SEQUENTIAL; break;
+   case EMapAdvice::kWillNeed: posixAdvice = MADV_WILLNEED; break;
+   case EMapAdvice::kDontNeed: posixAdvice = MADV_DONTNEED; break;
+   }
+
+   // madvise() requires the address to be aligned at a page boundary
+   static std::uintptr_t szPageBitmap = sysconf(_SC_PAGESIZE) - 1;
+   auto address = reinterpret_cast<std::uintptr_t>(region);
+   auto alignedAddress = address & ~szPageBitmap;
+   nbytes += address - alignedAddress;
+   // Failures are ignored, the advice is only a hint
+   (void)madvise(reinterpret_cast<void *>(alignedAddress), nbytes, posixAdvice);
+}
+
 std::unique_ptr<ROOT::Internal::RRawFile> ROOT::Internal::RRawFileUnix::Clone() const
 {
    return std::make_unique<RRawFileUnix>(fUrl, fOptions);
 }
 
 int ROOT::Internal::RRawFileUnix::GetFeatures() const {
-   return kFeatureHasSize | kFeatureHasMmap;
+   int features = kFeatureHasSize | kFeatureHasMmap;
+#ifdef R__HAS_URING
+   if (RIoUring::IsAvailable())
+      features |= kFeatureHasAsyncIo;
+#endif
+   return features;
 }
 
 std::uint64_t ROOT::Internal::RRawFileUnix::GetSizeImpl()
@@ -115,8 +141,19 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
 {
 #ifdef R__HAS_URING
    if (RIoUring::IsAvailable()) {
-      // todo(max) actually use the ring
-      RRawFile::ReadVImpl(ioVec, nReq);
+      if (!fIoUring)
+         fIoUring = std::make_unique<RIoUring>(kIoUringQueueDepth);
+
+      std::vector<RIoUring::RReadEvent> readEvents(nReq);
+      for (unsigned int i = 0; i < nReq; ++i) {
+         readEvents[i].fBuffer = ioVec[i].fBuffer;
+         readEvents[i].fOffset = ioVec[i].fOffset;
+         readEvents[i].fSize = ioVec[i].fSize;
+         readEvents[i].fFileDes = fFileDes;
+      }
+      fIoUring->SubmitReadsAndWait(readEvents.data(), nReq);
+      for (unsigned int i = 0; i < nReq; ++i)
+         ioVec[i].fOutBytes = readEvents[i].fOutBytes;
       return;
    }
    Warning("RRawFileUnix",
@@ -0,0 +1,112 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RReadVPlanner.hxx"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+ROOT::Internal::RReadVPlanner::RPlan
+ROOT::Internal::RReadVPlanner::Plan(const RRawFile::RIOVec *ioVec, unsigned int nReq) const
+{
+   RPlan plan;
+   plan.fRangePos.resize(nReq, 0);
+   for (unsigned int i = 0; i < nReq; ++i) {
+      // Empty ranges do not need to be read
+      if (ioVec[i].fSize == 0)
+         continue;
+      plan.fOrder.emplace_back(i);
+      plan.fSzRequested += ioVec[i].fSize;
+   }
+   if (plan.fOrder.empty())
+      return plan;
+
+   std::stable_sort(plan.fOrder.begin(), plan.fOrder.end(), [ioVec](std::size_t a, std::size_t b) {
+      return ioVec[a].fOffset < ioVec[b].fOffset;
+   });
+
+   // In order to coalesce close-by ranges, we collect the sizes of the gaps between them.  We then order the gaps by
+   // size, sum them up and find a cutoff for the largest gap that we tolerate when coalescing.  The size of the cutoff
+   // is given by the fraction of extra bytes we are willing to read in order to reduce the number of requests.
+   // We thus schedule the lowest number of requests given a tolerable fraction of extra bytes.
+   std::vector<std::uint64_t> gaps;
+   std::uint64_t readUpTo = ioVec[plan.fOrder[0]].fOffset + ioVec[plan.fOrder[0]].fSize;
+   for (std::size_t k = 1; k < plan.fOrder.size(); ++k) {
+      const auto &r = ioVec[plan.fOrder[k]];
+      gaps.emplace_back((r.fOffset > readUpTo) ? (r.fOffset - readUpTo) : 0);
+      readUpTo = std::max(readUpTo, r.fOffset + r.fSize);
+   }
+   std::sort(gaps.begin(), gaps.end());
+   const float maxWaste = fSettings.fMaxWaste * float(plan.fSzRequested);
+   std::uint64_t gapCut = 0;
+   float szWaste = 0.0;
+   for (auto g : gaps) {
+      szWaste += g;
+      if (szWaste > maxWaste)
+         break;
+      gapCut = g;
+   }
+   gapCut = std::min(gapCut, fSettings.fMaxGap);
+
+   const auto maxRequestSize = fSettings.fMaxRequestSize;
+   // Opens one or, if the range needs to be split, several blocks for the range with the given sorted index
+   auto fnOpenBlocks = [&plan, maxRequestSize](std::size_t k, std::uint64_t offset, std::size_t size) {
+      do {
+         RBlock block;
+         block.fOffset = offset;
+         block.fSize = ((maxRequestSize > 0) && (size > maxRequestSize)) ? maxRequestSize : size;
+         block.fBufferPos = plan.fBlocks.empty() ? 0 : plan.fBlocks.back().fBufferPos + plan.fBlocks.back().fSize;
+         block.fFirstRange = k;
+         block.fNRanges = 1;
+         plan.fBlocks.emplace_back(block);
+         offset += block.fSize;
+         size -= block.fSize;
+      } while (size > 0);
+   };
+
+   for (std::size_t k = 0; k < plan.fOrder.size(); ++k) {
+      const auto idx = plan.fOrder[k];
+      const auto &r = ioVec[idx];
+      const auto rangeEnd = r.fOffset + r.fSize;
+
+      if (plan.fBlocks.empty()) {
+         fnOpenBlocks(k, r.fOffset, r.fSize);
+         continue;
+      }
+
+      auto &block = plan.fBlocks.back();
+      const auto blockEnd = block.fOffset + block.fSize;
+      if (r.fOffset < blockEnd) {
+         // Overlapping ranges are always merged, also beyond the maximum request size
+         plan.fHasOverlaps = true;
+      } else {
+         const bool isGapTooLarge = !fSettings.fCoalesce || ((r.fOffset - blockEnd) > gapCut);
+         const bool isBlockTooLarge = (maxRequestSize > 0) && (rangeEnd - block.fOffset > maxRequestSize);
+         if (isGapTooLarge || isBlockTooLarge) {
+            const auto firstBlock = plan.fBlocks.size();
+            fnOpenBlocks(k, r.fOffset, r.fSize);
+            plan.fRangePos[idx] = plan.fBlocks[firstBlock].fBufferPos;
+            continue;
+         }
+      }
+
+      // Merge the range into the current block; if the range overlaps with a split range, it may start in one of
+      // the previous blocks, which are contiguous with the current one
+      plan.fRangePos[idx] = (r.fOffset >= block.fOffset) ? (block.fBufferPos + (r.fOffset - block.fOffset))
+                                                         : (block.fBufferPos - (block.fOffset - r.fOffset));
+      block.fSize = std::max(blockEnd, rangeEnd) - block.fOffset;
+      block.fNRanges++;
+   }
+
+   for (const auto &b : plan.fBlocks)
+      plan.fSzRead += b.fSize;
+   return plan;
+}
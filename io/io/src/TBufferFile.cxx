@@ -34,15 +34,8 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "TStreamerInfoActions.h"
 #include "TInterpreter.h"
 #include "TVirtualMutex.h"
+#include "ROOT/RByteSwap.hxx"
 
-#if (defined(__linux) || defined(__APPLE__)) && defined(__i386__) && \
-     defined(__GNUC__)
-#define USE_BSWAPCPY
-#endif
-
-#ifdef USE_BSWAPCPY
-#include "Bswapcpy.h"
-#endif
 
 
 const UInt_t kNewClassTag       = 0xFFFFFFFF;
@@ -761,17 +754,11 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    if (!h) h = new Short_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
 #else
    memcpy(h, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -794,17 +781,11 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    if (!ii) ii = new Int_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
 #else
    memcpy(ii, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -853,12 +834,11 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
 #else
    memcpy(ll, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -881,17 +861,11 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    if (!f) f = new Float_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
 #else
    memcpy(f, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -914,12 +888,11 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
 #else
    memcpy(d, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1034,17 +1007,11 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    if (!h) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
 #else
    memcpy(h, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1066,17 +1033,11 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    if (!ii) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
-   fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
 #else
    memcpy(ii, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1123,12 +1084,11 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
 #else
    memcpy(ll, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1150,17 +1110,11 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    if (!f) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
-   fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
 #else
    memcpy(f, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1182,12 +1136,11 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
 #else
    memcpy(d, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1300,17 +1253,11 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    if (n <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
-   fBufCur += sizeof(Short_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
 #else
    memcpy(h, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1322,17 +1269,11 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
-   fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
 #else
    memcpy(ii, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1360,12 +1301,11 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
 #else
    memcpy(ll, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1377,17 +1317,11 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
-   fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
 #else
    memcpy(f, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1399,12 +1333,11 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
 #else
    memcpy(d, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1423,27 +1356,12 @@ void TBufferFile::ReadFastArrayFloat16(Float_t *f, Int_t n, TStreamerElement *el
          UInt_t aint; *this >> aint; f[j] = (Float_t)(aint/factor + xmin);
       }
    } else {
-      Int_t i;
       Int_t nbits = 0;
       if (ele) nbits = (Int_t)ele->GetXmin();
       if (!nbits) nbits = 12;
-      //we read the exponent and the truncated mantissa of the float
-      //and rebuild the new float.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      UChar_t  theExp;
-      UShort_t theMan;
-      for (i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
-         fIntValue = theExp;
-         fIntValue <<= 23;
-         fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-         if(1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-         f[i] = fFloatValue;
-      }
+      //rebuild the floats from their exponent and truncated mantissa.
+      ROOT::Internal::UnpackTruncatedFloats(f, fBufCur, n, nbits);
+      fBufCur += 3*n;
    }
 }
 
@@ -1470,23 +1388,9 @@ void TBufferFile::ReadFastArrayWithNbits(Float_t *ptr, Int_t n, Int_t nbits)
    if (n <= 0 || 3*n > fBufSize) return;
 
    if (!nbits) nbits = 12;
-   //we read the exponent and the truncated mantissa of the float
-   //and rebuild the new float.
-   union {
-      Float_t fFloatValue;
-      Int_t   fIntValue;
-   };
-   UChar_t  theExp;
-   UShort_t theMan;
-   for (Int_t i = 0; i < n; i++) {
-      *this >> theExp;
-      *this >> theMan;
-      fIntValue = theExp;
-      fIntValue <<= 23;
-      fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-      if(1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-      ptr[i] = fFloatValue;
-   }
+   //rebuild the floats from their exponent and truncated mantissa.
+   ROOT::Internal::UnpackTruncatedFloats(ptr, fBufCur, n, nbits);
+   fBufCur += 3*n;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1516,23 +1420,9 @@ void TBufferFile::ReadFastArrayDouble32(Double_t *d, Int_t n, TStreamerElement *
             d[i] = (Double_t)afloat;
          }
       } else {
-         //we read the exponent and the truncated mantissa of the float
-         //and rebuild the double.
-         union {
-            Float_t fFloatValue;
-            Int_t   fIntValue;
-         };
-         UChar_t  theExp;
-         UShort_t theMan;
-         for (i = 0; i < n; i++) {
-            *this >> theExp;
-            *this >> theMan;
-            fIntValue = theExp;
-            fIntValue <<= 23;
-            fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-            if (1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-            d[i] = (Double_t)fFloatValue;
-         }
+         //rebuild the floats from their exponent and truncated mantissa.
+         ROOT::Internal::UnpackTruncatedFloats(d, fBufCur, n, nbits);
+         fBufCur += 3*n;
       }
    }
 }
@@ -1567,23 +1457,9 @@ void TBufferFile::ReadFastArrayWithNbits(Double_t *d, Int_t n, Int_t nbits)
          d[i] = (Double_t)afloat;
       }
    } else {
-      //we read the exponent and the truncated mantissa of the float
-      //and rebuild the double.
-      union {
-         Float_t fFloatValue;
-         Int_t   fIntValue;
-      };
-      UChar_t  theExp;
-      UShort_t theMan;
-      for (Int_t i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
-         fIntValue = theExp;
-         fIntValue <<= 23;
-         fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
-         if (1<<(nbits+1) & theMan) fFloatValue = -fFloatValue;
-         d[i] = (Double_t)fFloatValue;
-      }
+      //rebuild the floats from their exponent and truncated mantissa.
+      ROOT::Internal::UnpackTruncatedFloats(d, fBufCur, n, nbits);
+      fBufCur += 3*n;
    }
 }
 
@@ -1733,17 +1609,11 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(fBufCur, h, n);
 #else
    memcpy(fBufCur, h, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1763,17 +1633,11 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(fBufCur, ii, n);
 #else
    memcpy(fBufCur, ii, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1831,12 +1695,11 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1856,17 +1719,11 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(fBufCur, f, n);
 #else
    memcpy(fBufCur, f, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1886,12 +1743,11 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1999,17 +1855,11 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(fBufCur, h, n);
 #else
    memcpy(fBufCur, h, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2023,17 +1873,11 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(fBufCur, ii, n);
 #else
    memcpy(fBufCur, ii, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2075,12 +1919,11 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2094,17 +1937,11 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(fBufCur, f, n);
 #else
    memcpy(fBufCur, f, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2118,12 +1955,11 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -49,11 +49,201 @@ End_Macro
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
 
+// Trailer of a key list record holding a key index: position of the index,
+// version of the index format and magic number.
+const Version_t kKeyIndexVersion = 1;
+const UInt_t    kKeyIndexMagic = 0x4b494458; // "KIDX"
+const Int_t     kKeyIndexTrailerSize = sizeof(Int_t) + sizeof(Version_t) + sizeof(UInt_t);
+
+Int_t TDirectoryFile::fgKeyIndexMinKeys = 1000;
+
 ClassImp(TDirectoryFile);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Key index of a directory.
+///
+/// When a directory has at least GetKeyIndexMinKeys() keys, WriteKeys appends
+/// to the key list record an index of the keys sorted by name, followed by a
+/// fixed size trailer. All positions are relative to the start of the key list
+/// (the number of keys):
+/// ~~~
+///    Int_t     nkeys
+///    Int_t     position of each key, in key list order
+///    Int_t     position of each entry, in name order
+///    entries:  Int_t key number, Short_t cycle, Int_t name length, name
+///    ...       padding
+///    Int_t     position of the index
+///    Version_t kKeyIndexVersion
+///    UInt_t    kKeyIndexMagic
+/// ~~~
+/// The entries with the same name keep the order of the key list, so that the
+/// first match is the one found by scanning the list of keys. Readers that do
+/// not know about the index stop after the last key and ignore it.
+///
+/// A read-only directory holding an index keeps the key list record in memory
+/// and creates a TKey only when it is looked up, instead of reading all of
+/// them in ReadKeys.
+
+struct TDirectoryFile::TKeyIndex {
+   std::vector<char>  fRecord;   ///< Key list record, starting at the number of keys
+   Int_t              fNkeys{0}; ///< Number of keys
+   Int_t              fIndex{0}; ///< Position of the index in fRecord
+   std::vector<TKey*> fKeys;     ///< Keys already read, in key list order
+
+   Int_t GetInt(Int_t pos) const
+   {
+      char *buffer = const_cast<char *>(fRecord.data()) + pos;
+      Int_t value;
+      frombuf(buffer, &value);
+      return value;
+   }
+   Int_t GetKeyPos(Int_t i) const { return GetInt(fIndex + (1 + i) * sizeof(Int_t)); }
+   Int_t GetEntryPos(Int_t j) const { return GetInt(fIndex + (1 + fNkeys + j) * sizeof(Int_t)); }
+   Int_t GetEntryKey(Int_t j) const { return GetInt(GetEntryPos(j)); }
+   Short_t GetEntryCycle(Int_t j) const
+   {
+      char *buffer = const_cast<char *>(fRecord.data()) + GetEntryPos(j) + sizeof(Int_t);
+      Short_t cycle;
+      frombuf(buffer, &cycle);
+      return cycle;
+   }
+
+   /// Compare the name of entry j with name, like strcmp.
+   Int_t Compare(Int_t j, const char *name, Int_t len) const
+   {
+      const Int_t pos = GetEntryPos(j) + sizeof(Int_t) + sizeof(Short_t);
+      const Int_t elen = GetInt(pos);
+      const Int_t cmp = memcmp(fRecord.data() + pos + sizeof(Int_t), name, std::min(elen, len));
+      return cmp ? cmp : elen - len;
+   }
+
+   /// Return the first entry whose name is not less than name.
+   Int_t LowerBound(const char *name, Int_t len) const
+   {
+      Int_t first = 0, count = fNkeys;
+      while (count > 0) {
+         const Int_t step = count / 2;
+         if (Compare(first + step, name, len) < 0) {
+            first += step + 1;
+            count -= step + 1;
+         } else {
+            count = step;
+         }
+      }
+      return first;
+   }
+
+   static TKeyIndex *Read(const char *buffer, Int_t nbytes);
+   static Int_t Sizeof(TList *keys);
+   static void Write(const std::vector<TKey *> &keys, const std::vector<Int_t> &keyPos, char *start, char *buffer,
+                     Int_t nbytes);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key index found at the end of the nbytes of the key list record
+/// in buffer, or nullptr if the record has no (valid) index.
+
+TDirectoryFile::TKeyIndex *TDirectoryFile::TKeyIndex::Read(const char *buffer, Int_t nbytes)
+{
+   if (nbytes < Int_t(2 * sizeof(Int_t)) + kKeyIndexTrailerSize)
+      return nullptr;
+   char *trailer = const_cast<char *>(buffer) + nbytes - kKeyIndexTrailerSize;
+   Int_t indexPos;
+   Version_t version;
+   UInt_t magic;
+   frombuf(trailer, &indexPos);
+   frombuf(trailer, &version);
+   frombuf(trailer, &magic);
+   if (magic != kKeyIndexMagic || version != kKeyIndexVersion)
+      return nullptr;
+
+   const Int_t end = nbytes - kKeyIndexTrailerSize;
+   if (indexPos < Int_t(sizeof(Int_t)) || indexPos > end - Int_t(sizeof(Int_t)))
+      return nullptr;
+
+   auto index = new TKeyIndex;
+   index->fRecord.assign(buffer, buffer + nbytes);
+   index->fNkeys = index->GetInt(indexPos);
+   index->fIndex = indexPos;
+   const Int_t nkeys = index->fNkeys;
+   Bool_t valid = nkeys == index->GetInt(0) && nkeys >= 0 && nkeys <= (end - indexPos) / Int_t(2 * sizeof(Int_t));
+   for (Int_t i = 0; valid && i < nkeys; ++i) {
+      const Int_t keyPos = index->GetKeyPos(i);
+      const Int_t entryPos = index->GetEntryPos(i);
+      const Int_t nameEnd = entryPos + 2 * sizeof(Int_t) + sizeof(Short_t);
+      valid = keyPos >= Int_t(sizeof(Int_t)) && keyPos < indexPos && entryPos > indexPos && nameEnd <= end;
+      if (valid) {
+         const Int_t key = index->GetEntryKey(i);
+         const Int_t len = index->GetInt(nameEnd - sizeof(Int_t));
+         valid = key >= 0 && key < nkeys && len >= 0 && len <= end - nameEnd;
+      }
+   }
+   if (!valid) {
+      delete index;
+      return nullptr;
+   }
+   index->fKeys.resize(nkeys, nullptr);
+   return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes of the index of the given keys, trailer included.
+
+Int_t TDirectoryFile::TKeyIndex::Sizeof(TList *keys)
+{
+   const Int_t nkeys = keys->GetSize();
+   Int_t nbytes = (1 + 2 * nkeys) * sizeof(Int_t) + kKeyIndexTrailerSize;
+   TIter next(keys);
+   while (auto key = (TKey *)next())
+      nbytes += 2 * sizeof(Int_t) + sizeof(Short_t) + strlen(key->GetName());
+   return nbytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write at buffer the index of the keys found at positions keyPos of the key
+/// list record starting at start, and the trailer at the end of its nbytes.
+
+void TDirectoryFile::TKeyIndex::Write(const std::vector<TKey *> &keys, const std::vector<Int_t> &keyPos, char *start,
+                                      char *buffer, Int_t nbytes)
+{
+   const Int_t nkeys = keys.size();
+   std::vector<Int_t> order(nkeys);
+   std::iota(order.begin(), order.end(), 0);
+   std::stable_sort(order.begin(), order.end(),
+                    [&keys](Int_t i, Int_t j) { return strcmp(keys[i]->GetName(), keys[j]->GetName()) < 0; });
+
+   const Int_t indexPos = buffer - start;
+   tobuf(buffer, nkeys);
+   for (auto pos : keyPos)
+      tobuf(buffer, pos);
+   char *entryPos = buffer;
+   buffer += nkeys * sizeof(Int_t);
+   for (auto i : order) {
+      tobuf(entryPos, Int_t(buffer - start));
+      const Int_t len = strlen(keys[i]->GetName());
+      tobuf(buffer, i);
+      tobuf(buffer, keys[i]->GetCycle());
+      tobuf(buffer, len);
+      memcpy(buffer, keys[i]->GetName(), len);
+      buffer += len;
+   }
+
+   char *trailer = start + nbytes - kKeyIndexTrailerSize;
+   R__ASSERT(buffer <= trailer);
+   memset(buffer, 0, trailer - buffer);
+   tobuf(trailer, indexPos);
+   tobuf(trailer, kKeyIndexVersion);
+   tobuf(trailer, kKeyIndexMagic);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default TDirectoryFile constructor
@@ -177,6 +367,7 @@ void TDirectoryFile::InitDirectoryFile(TClass *cl)
 
 TDirectoryFile::~TDirectoryFile()
 {
+   DeleteKeyIndex();
    if (fKeys) {
       fKeys->Delete("slow");
       SafeDelete(fKeys);
@@ -230,6 +421,8 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
       return 0;
    }
 
+   ReadIndexedKeys();
+
    fModified = kTRUE;
 
    key->SetMotherDir(this);
@@ -266,7 +459,7 @@ void TDirectoryFile::Browse(TBrowser *b)
       TObject *obj = nullptr;
       TIter nextin(fList);
       TKey *key = nullptr, *keyo = nullptr;
-      TIter next(fKeys);
+      TIter next(GetListOfKeys());
 
       cd();
 
@@ -575,6 +768,7 @@ void TDirectoryFile::Close(Option_t *option)
    }
 
    // Delete keys from key list (but don't delete the list header)
+   DeleteKeyIndex();
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -947,6 +1141,13 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 //*-*---------------------Case of Key---------------------
 //                        ===========
    TKey *key;
+   if (fKeyIndex) {
+      if ((key = FindIndexedKey(namobj, cycle, kTRUE))) {
+         TDirectory::TContext ctxt(this);
+         idcur = key->ReadObj();
+      }
+      return idcur;
+   }
    TIter nextkey(GetListOfKeys());
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
@@ -1067,6 +1268,13 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //                        ===========
    void *idcur = nullptr;
    TKey *key;
+   if (fKeyIndex) {
+      if ((key = FindIndexedKey(namobj, cycle, kTRUE))) {
+         TDirectory::TContext ctxt(this);
+         idcur = key->ReadObjectAny(expectedClass);
+      }
+      return idcur;
+   }
    TIter nextkey(GetListOfKeys());
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
@@ -1101,6 +1309,7 @@ Int_t TDirectoryFile::GetBufferSize() const
 
 TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 {
+   if (fKeyIndex) return FindIndexedKey(name, cycle, kFALSE);
    if (!fKeys) return nullptr;
 
    // TIter::TIter() already checks for null pointers
@@ -1117,6 +1326,117 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of keys of this directory.
+///
+/// If the keys of the directory are read on demand from its key index, all
+/// of them are read first.
+
+TList *TDirectoryFile::GetListOfKeys() const
+{
+   if (fKeyIndex) const_cast<TDirectoryFile *>(this)->ReadIndexedKeys();
+   return fKeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of this directory.
+
+Int_t TDirectoryFile::GetNkeys() const
+{
+   return fKeyIndex ? fKeyIndex->fNkeys : fKeys->GetSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the minimum number of keys of a directory for writing a key index.
+/// See SetKeyIndexMinKeys.
+
+Int_t TDirectoryFile::GetKeyIndexMinKeys()
+{
+   return fgKeyIndexMinKeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the minimum number of keys of a directory for writing a key index
+/// (1000 by default), 0 to never write one.
+///
+/// The key index is stored with the list of keys of the directory. When a
+/// directory holding one is opened in read mode, the keys are not all read
+/// from the list: FindKey, GetKey and Get look the key up in the index and
+/// read only that key. Calling GetListOfKeys, or making the directory
+/// writable, reads all of them. Files without a key index, and readers not
+/// supporting it, read all the keys as before.
+
+void TDirectoryFile::SetKeyIndexMinKeys(Int_t nkeys)
+{
+   fgKeyIndexMinKeys = nkeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the key index, keeping in fKeys the keys read so far.
+
+void TDirectoryFile::DeleteKeyIndex()
+{
+   delete fKeyIndex;
+   fKeyIndex = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the first key of the index named name whose cycle is cycle (exact)
+/// or not larger than cycle, any cycle if cycle is 9999.
+
+TKey *TDirectoryFile::FindIndexedKey(const char *name, Short_t cycle, Bool_t exact) const
+{
+   const Int_t len = strlen(name);
+   for (Int_t j = fKeyIndex->LowerBound(name, len); j < fKeyIndex->fNkeys; ++j) {
+      if (fKeyIndex->Compare(j, name, len) != 0)
+         break;
+      const Short_t keycycle = fKeyIndex->GetEntryCycle(j);
+      if ((cycle == 9999) || (exact ? cycle == keycycle : cycle >= keycycle))
+         return ReadIndexedKey(fKeyIndex->GetEntryKey(j));
+   }
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key number i of the key index, reading it from the key list
+/// record and adding it to fKeys the first time.
+
+TKey *TDirectoryFile::ReadIndexedKey(Int_t i) const
+{
+   TKey *&key = fKeyIndex->fKeys[i];
+   if (key) return key;
+
+   char *buffer = fKeyIndex->fRecord.data() + fKeyIndex->GetKeyPos(i);
+   TKey *newkey = new TKey(const_cast<TDirectoryFile *>(this));
+   newkey->ReadKeyBuffer(buffer);
+   Long64_t fsize = fFile->GetSize();
+   if (newkey->GetSeekKey() < 64 || newkey->GetSeekKey() > fsize ||
+       newkey->GetSeekPdir() < 64 || newkey->GetSeekPdir() > fsize) {
+      Error("ReadIndexedKey","reading illegal key %d",i);
+      newkey->SetMotherDir(nullptr);
+      delete newkey;
+      return nullptr;
+   }
+   fKeys->Add(newkey);
+   key = newkey;
+   return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read all the keys of the key index and release it. The keys read so far are
+/// kept and fKeys ends up in the order of the key list, as after ReadKeys.
+
+void TDirectoryFile::ReadIndexedKeys()
+{
+   if (!fKeyIndex) return;
+   for (Int_t i = 0; i < fKeyIndex->fNkeys; ++i)
+      ReadIndexedKey(i);
+   fKeys->Clear("nodelete");
+   for (auto key : fKeyIndex->fKeys)
+      if (key) fKeys->Add(key);
+   DeleteKeyIndex();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// List Directory contents
 ///
@@ -1164,7 +1484,7 @@ void TDirectoryFile::ls(Option_t *option) const
       }
    }
 
-   if (diskobj && fKeys) {
+   if (diskobj && GetListOfKeys()) {
       //*-* Loop on all the keys
       TObjLink *lnk = fKeys->FirstLink();
       while (lnk) {
@@ -1344,6 +1664,8 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
    TDirectory::TContext ctxt(this);
 
+   DeleteKeyIndex();
+
    char *buffer;
    if (forceRead) {
       fKeys->Delete();
@@ -1386,6 +1708,15 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
       buffer = headerkey->GetBuffer();
       headerkey->ReadKeyBuffer(buffer);
 
+      // A read-only directory with a key index reads its keys on demand
+      Int_t nbytes = std::min(headerkey->GetObjlen(), fNbytesKeys - headerkey->GetKeylen());
+      TKeyIndex *index = IsWritable() ? nullptr : TKeyIndex::Read(buffer, nbytes);
+      if (index) {
+         delete headerkey;
+         fKeyIndex = index;
+         return fKeyIndex->fNkeys;
+      }
+
       TKey *key;
       frombuf(buffer, &nkeys);
       for (Int_t i = 0; i < nkeys; i++) {
@@ -1458,13 +1789,14 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    fSeekParent = 0; // updated by Init
    fSeekKeys = 0;   // updated by Init
    // Does not change: fFile
-   TKey *key = fKeys ? (TKey*)fKeys->FindObject(fName) : nullptr;
+   TKey *key = fKeys ? (TKey*)GetListOfKeys()->FindObject(fName) : nullptr;
    TClass *cl = IsA();
    if (key) {
       cl = TClass::GetClass(key->GetClassName());
    }
    // NOTE: We should check that the content is really mergeable and in
    // the in-mmeory list, before deleting the keys.
+   DeleteKeyIndex();
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -1635,6 +1967,8 @@ void TDirectoryFile::SetWritable(Bool_t writable)
    TDirectory::TContext ctxt(this);
 
    fWritable = writable;
+   if (writable)
+      ReadIndexedKeys();
 
    // recursively set all sub-directories
    if (fList) {
@@ -2130,6 +2464,7 @@ void TDirectoryFile::WriteKeys()
       f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
    }
 //*-* Write new keys record
+   ReadIndexedKeys();
    TIter next(fKeys);
    TKey *key;
    Int_t nkeys  = fKeys->GetSize();
@@ -2138,17 +2473,27 @@ void TDirectoryFile::WriteKeys()
    while ((key = (TKey*)next())) {
       nbytes += key->Sizeof();
    }
+   const Bool_t writeIndex = fgKeyIndexMinKeys > 0 && nkeys >= fgKeyIndexMinKeys;
+   if (writeIndex) nbytes += TKeyIndex::Sizeof(fKeys);
    TKey *headerkey  = new TKey(fName,fTitle,IsA(),nbytes,this);
    if (headerkey->GetSeekKey() == 0) {
       delete headerkey;
       return;
    }
    char *buffer = headerkey->GetBuffer();
+   char *start = buffer;
+   std::vector<TKey*> keys;
+   std::vector<Int_t> keyPos;
    next.Reset();
    tobuf(buffer, nkeys);
    while ((key = (TKey*)next())) {
+      if (writeIndex) {
+         keys.push_back(key);
+         keyPos.push_back(buffer - start);
+      }
       key->FillBuffer(buffer);
    }
+   if (writeIndex) TKeyIndex::Write(keys, keyPos, start, buffer, nbytes);
 
    fSeekKeys     = headerkey->GetSeekKey();
    fNbytesKeys   = headerkey->GetNbytes();
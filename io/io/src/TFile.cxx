@@ -831,7 +831,7 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                Warning("Init","no StreamerInfo found in %s therefore preventing schema evolution when reading this file."
                               " The file was produced with version %d.%02d/%02d of ROOT.",
                               GetName(),  fVersion / 10000, (fVersion / 100) % (100), fVersion  % 100);
@@ -842,10 +842,19 @@ void TFile::Init(Bool_t create)
 
    // Count number of TProcessIDs in this file
    {
-      TIter next(fKeys);
       TKey *key;
-      while ((key = (TKey*)next())) {
-         if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
+      if (fKeys->GetSize() != GetNkeys()) {
+         // The keys are read on demand from the key index (see
+         // TDirectoryFile::SetKeyIndexMinKeys), look the TProcessIDs up by
+         // name: they are written as ProcessID0, ProcessID1, ...
+         while ((key = GetKey(TString::Format("ProcessID%d", fNProcessIDs))) &&
+                !strcmp(key->GetClassName(),"TProcessID"))
+            fNProcessIDs++;
+      } else {
+         TIter next(fKeys);
+         while ((key = (TKey*)next())) {
+            if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
+         }
       }
       fProcessIDs = new TObjArray(fNProcessIDs+1);
    }
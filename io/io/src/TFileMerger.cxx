@@ -20,6 +20,15 @@ any of its remote file access plugins. It is therefore useful in
 a Grid environment where the files might be accessible only remotely.
 The merging interface allows files containing histograms and trees
 to be merged, like the standalone hadd program.
+
+When implicit multi-threading is enabled (see ROOT::EnableImplicitMT and
+SetImplicitMT), the histograms found in many source files are merged by
+tree reduction on the thread pool: the source files are split in groups,
+one task per group reads and merges a batch of histograms from the files
+of its group, and the partial results are then merged in the order of the
+files. The trees that are not fast cloned compress their baskets on the
+thread pool while the entries are copied (see TTree::SetWriteBehind).
+The other objects are merged sequentially.
 */
 
 #include "TFileMerger.h"
@@ -38,6 +47,7 @@ to be merged, like the standalone hadd program.
 #include "TROOT.h"
 #include "TMemFile.h"
 #include "TVirtualMutex.h"
+#include "TError.h"
 
 #ifdef WIN32
 // For _getmaxstdio
@@ -48,7 +58,16 @@ to be merged, like the standalone hadd program.
 #include <sys/resource.h>
 #endif
 
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
 #include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 ClassImp(TFileMerger);
 
@@ -57,6 +76,8 @@ TClassRef R__TTree_Class("TTree");
 
 static const Int_t kCpProgress = BIT(14);
 static const Int_t kCintFileNumber = 100;
+static const Int_t kMinFilesPerThread = 2; // Below this, the histograms are merged sequentially.
+static const size_t kHistogramsPerBatch = 1000; // Number of histograms merged in parallel at once.
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the maximum number of allowed opened files minus some wiggle room
 /// for CINT or at least of the standard library (stdio).
@@ -89,7 +110,7 @@ static Int_t R__GetSystemMaxOpenedFiles()
 
 TFileMerger::TFileMerger(Bool_t isLocal, Bool_t histoOneGo)
             : fMaxOpenedFiles( R__GetSystemMaxOpenedFiles() ),
-              fLocal(isLocal), fHistoOneGo(histoOneGo)
+              fLocal(isLocal), fHistoOneGo(histoOneGo), fIMTEnabled(ROOT::IsImplicitMTEnabled())
 {
    fMergeList.SetOwner(kTRUE);
    fExcessFiles.SetOwner(kTRUE);
@@ -385,6 +406,117 @@ Long64_t MergeRNTuples(TClass* rntupleHandle, const TString& /* target */, const
    return func(static_cast<void*>(rntupleHandle), nullptr, nullptr);
 }
 
+#ifdef R__USE_IMT
+/// Partial results of MergeHistogramsByTreeReduction: for each histogram name, the partial
+/// result of each group of source directories, nullptr if none of them has the histogram.
+using PartialMerges_t = std::unordered_map<std::string, std::vector<TObject *>>;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the histograms with the given names found in the source directories,
+/// by tree reduction on the implicit multi-threading pool: the directories are
+/// split in ngroups contiguous groups, and one task per group reads all the
+/// histograms of the batch in its directories and merges each into the first
+/// one it found. Each source file is thus only ever accessed by one task, and
+/// the number of tasks does not depend on the number of histograms.
+
+PartialMerges_t MergeHistogramsByTreeReduction(const std::vector<std::string> &names,
+                                               const std::vector<TDirectory *> &dirs, Bool_t oneGo,
+                                               const TFileMergeInfo &info, UInt_t ngroups)
+{
+   PartialMerges_t partials;
+   for (const auto &name : names)
+      partials[name].resize(ngroups, nullptr);
+
+   auto mergeGroup = [&](UInt_t group) {
+      const size_t begin = dirs.size() * group / ngroups;
+      const size_t end = dirs.size() * (group + 1) / ngroups;
+      for (const auto &name : names) {
+         TFileMergeInfo groupInfo(info.fOutputDirectory);
+         groupInfo.fOptions = info.fOptions;
+         groupInfo.fIOFeatures = info.fIOFeatures;
+         TObject *result = nullptr;
+         ROOT::MergeFunc_t func = nullptr;
+         TList inputs;
+         for (size_t i = begin; i < end; ++i) {
+            TKey *key = (TKey*)dirs[i]->GetListOfKeys()->FindObject(name.c_str());
+            if (!key) continue;
+            TObject *hobj = key->ReadObj();
+            if (!hobj) {
+               Info("TFileMerger::MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
+                    key->GetName(), key->GetTitle(), dirs[i]->GetFile()->GetName());
+               continue;
+            }
+            hobj->ResetBit(kMustCleanup);
+            if (!result) {
+               // The partial result is deleted by the main thread: detach it from its source directory.
+               if (ROOT::DirAutoAdd_t addfunc = hobj->IsA()->GetDirectoryAutoAdd()) {
+                  addfunc(hobj, nullptr);
+               }
+               result = hobj;
+               func = hobj->IsA()->GetMerge();
+               continue;
+            }
+            inputs.Add(hobj);
+            if (!oneGo) {
+               if (func(result, &inputs, &groupInfo) < 0) {
+                  Error("TFileMerger::MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
+                        name.c_str(), dirs[i]->GetFile()->GetName());
+               }
+               groupInfo.fIsFirst = kFALSE;
+               inputs.Delete();
+            }
+         }
+         if (result && !inputs.IsEmpty()) {
+            func(result, &inputs, &groupInfo);
+            inputs.Delete();
+         }
+         partials[name][group] = result;
+      }
+   };
+
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(mergeGroup, ROOT::TSeqU(ngroups));
+   return partials;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge into obj the partial results of MergeHistogramsByTreeReduction, in
+/// the order of the groups. The partial results are deleted.
+
+void MergePartials(TObject *obj, TClass *cl, std::vector<TObject *> &partials, Bool_t oneGo, TFileMergeInfo &info)
+{
+   ROOT::MergeFunc_t func = cl->GetMerge();
+   TList inputs;
+   for (TObject *partial : partials) {
+      if (!partial) continue;
+      inputs.Add(partial);
+      if (!oneGo) {
+         func(obj, &inputs, &info);
+         info.fIsFirst = kFALSE;
+         inputs.Delete();
+      }
+   }
+   if (oneGo || info.fIsFirst) {
+      func(obj, &inputs, &info);
+      info.fIsFirst = kFALSE;
+      inputs.Delete();
+   }
+   partials.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the partial results that were not merged.
+
+void DeletePartials(PartialMerges_t &partials)
+{
+   for (auto &entry : partials) {
+      for (TObject *partial : entry.second)
+         delete partial;
+   }
+   partials.clear();
+}
+#endif // R__USE_IMT
+
 } // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -426,6 +558,9 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
       info.fOptions.Append(" fast");
    }
 
+#ifdef R__USE_IMT
+   PartialMerges_t partials;
+#endif
    TFile      *current_file;
    TDirectory *current_sourcedir;
    if (type & kIncremental) {
@@ -589,11 +724,51 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
 
                // Loop over all source files and merge same-name object
                TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
+#ifdef R__USE_IMT
+               const UInt_t nthreads = (fIMTEnabled && ROOT::IsImplicitMTEnabled()) ? ROOT::GetThreadPoolSize() : 1;
+#endif
                if (nextsource == 0) {
                   // There is only one file in the list
                   ROOT::MergeFunc_t func = cl->GetMerge();
                   func(obj, &inputs, &info);
                   info.fIsFirst = kFALSE;
+#ifdef R__USE_IMT
+               } else if (nthreads > 1 && cl->InheritsFrom(R__TH1_Class) &&
+                          sourcelist->GetSize() >= 2 * kMinFilesPerThread) {
+                  auto partial = partials.find(key->GetName());
+                  if (partial == partials.end()) {
+                     // Merge in parallel this histogram and the next ones of this directory.
+                     DeletePartials(partials);
+                     std::vector<std::string> names{key->GetName()};
+                     TIter nextbatch(nextkey);
+                     TString lastname = key->GetName();
+                     while (names.size() < kHistogramsPerBatch) {
+                        TKey *bkey = (TKey*)nextbatch();
+                        if (!bkey) break;
+                        if (lastname == bkey->GetName() || allNames.FindObject(bkey->GetName())) continue;
+                        lastname = bkey->GetName();
+                        TClass *bcl = TClass::GetClass(bkey->GetClassName());
+                        if (!bcl || !bcl->InheritsFrom(R__TH1_Class) || !bcl->GetMerge()) continue;
+                        if ((type & kOnlyListed) && !fObjectNames.Contains(lastname + " ")) continue;
+                        if ((type & kResetable) && !(type & kNonResetable) && !bcl->GetResetAfterMerge()) continue;
+                        if ((type & kNonResetable) && !(type & kResetable) && bcl->GetResetAfterMerge()) continue;
+                        names.emplace_back(lastname.Data());
+                     }
+                     // The histograms do not write to the target directory while merging and
+                     // can be merged in parallel; the source directories are looked up here,
+                     // on the main thread, as that can create new TDirectoryFile objects.
+                     std::vector<TDirectory*> dirs;
+                     for (; nextsource; nextsource = (TFile*)sourcelist->After(nextsource)) {
+                        if (TDirectory *ndir = nextsource->GetDirectory(path))
+                           dirs.push_back(ndir);
+                     }
+                     const UInt_t ngroups = std::min<UInt_t>(nthreads, dirs.size() / kMinFilesPerThread);
+                     partials = MergeHistogramsByTreeReduction(names, dirs, oneGo, info, std::max<UInt_t>(ngroups, 1));
+                     partial = partials.find(key->GetName());
+                  }
+                  MergePartials(obj, cl, partial->second, oneGo, info);
+                  partials.erase(partial);
+#endif
                } else {
                   do {
                      // make sure we are at the correct directory level by cd'ing to path
@@ -778,6 +953,10 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
             }
             info.Reset();
          } // while ( ( TKey *key = (TKey*)nextkey() ) )
+#ifdef R__USE_IMT
+         // Histograms of the last batch that were not merged, e.g. because they could not be read.
+         DeletePartials(partials);
+#endif
       }
       current_file = current_file ? (TFile*)sourcelist->After(current_file) : (TFile*)sourcelist->First();
       if (current_file) {
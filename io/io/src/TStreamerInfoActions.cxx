@@ -25,6 +25,8 @@
 #include "TProcessID.h"
 #include "TFile.h"
 
+#include <unordered_map>
+
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
 // More possible optimizations:
@@ -2966,6 +2968,248 @@ static TConfiguredAction GetCollectionWriteAction(TVirtualStreamerInfo *info, TS
 }
 
 
+namespace TStreamerInfoActions
+{
+   class TCompiledStreamerConfiguration : public TConfiguration {
+      // Configuration object for a run of basic data members streamed by a generated function.
+   public:
+      typedef void (*Function_t)(TBuffer &b, char *obj);
+
+      Function_t       fFunction; ///< Generated function streaming the whole run, with the offsets relative to the object.
+      TActionSequence *fFallback; ///< The actions replaced by fFunction, used when the generated function cannot be.
+
+      TCompiledStreamerConfiguration(TVirtualStreamerInfo *info, UInt_t id, TCompInfo_t *compinfo, Function_t function, TActionSequence *fallback) :
+         TConfiguration(info,id,compinfo,0),fFunction(function),fFallback(fallback) {};
+      virtual ~TCompiledStreamerConfiguration() { delete fFallback; }
+
+      virtual void AddToOffset(Int_t delta)
+      {
+         TConfiguration::AddToOffset(delta);
+         fFallback->AddToOffset(delta);
+      }
+
+      virtual void SetMissing()
+      {
+         TConfiguration::SetMissing();
+         fFallback->SetMissing();
+      }
+
+      virtual TConfiguration *Copy()
+      {
+         TCompiledStreamerConfiguration *copy = new TCompiledStreamerConfiguration(fInfo,fElemId,fCompInfo,fFunction,fFallback->CreateCopy());
+         copy->fOffset = fOffset;
+         return copy;
+      }
+
+      virtual void Print() const
+      {
+         TStreamerInfo *info = (TStreamerInfo*)fInfo;
+         printf("StreamerInfoAction, class:%s, compiled streamer of %d elements, offset=%d\n",
+                info->GetClass()->GetName(), (Int_t)fFallback->fActions.size(), fOffset);
+         for (const auto &action : fFallback->fActions) {
+            printf("   ");
+            action.fConfiguration->Print();
+         }
+      }
+   };
+
+   Int_t CompiledStreamerAction(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      // The generated functions access the buffer directly, exactly like TBufferFile does;
+      // the buffers overriding its streaming operators (TBufferSQL) use the original actions.
+
+      const TCompiledStreamerConfiguration *conf = (const TCompiledStreamerConfiguration*)config;
+      if (conf->fOffset == TVirtualStreamerInfo::kMissing || buf.IsA() != TBufferFile::Class()) {
+         for (const auto &action : conf->fFallback->fActions) {
+            action(buf, addr);
+         }
+         return 0;
+      }
+      conf->fFunction(buf, ((char*)addr) + conf->fOffset);
+      return 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name and the size of the basic type streamed by the element, or
+/// nullptr if the element can not be streamed by a generated function.
+
+static const char *GetCompiledStreamerType(const TStreamerInfo::TCompInfo_t *compinfo, Int_t &size)
+{
+   TStreamerElement *element = compinfo->fElem;
+   if (!element || element->TestBit(TStreamerElement::kCache) || element->TestBit(TStreamerElement::kWrite)) {
+      return nullptr;
+   }
+   Int_t type = compinfo->fType;
+   if (type == TStreamerInfo::kCounter) {
+      size = sizeof(Int_t);
+      return "Int_t";
+   }
+   if (type > TStreamerInfo::kOffsetL && type < TStreamerInfo::kOffsetP) {
+      type -= TStreamerInfo::kOffsetL; // fixed size arrays and regrouped data members
+   }
+   switch (type) {
+      // Long_t, Double32_t and Float16_t have their own on-file representation, see TBufferFile.
+      case TStreamerInfo::kBool:    size = sizeof(Bool_t);    return "Bool_t";
+      case TStreamerInfo::kChar:    size = sizeof(Char_t);    return "Char_t";
+      case TStreamerInfo::kUChar:   size = sizeof(UChar_t);   return "UChar_t";
+      case TStreamerInfo::kShort:   size = sizeof(Short_t);   return "Short_t";
+      case TStreamerInfo::kUShort:  size = sizeof(UShort_t);  return "UShort_t";
+      case TStreamerInfo::kInt:     size = sizeof(Int_t);     return "Int_t";
+      case TStreamerInfo::kUInt:    size = sizeof(UInt_t);    return "UInt_t";
+      case TStreamerInfo::kFloat:   size = sizeof(Float_t);   return "Float_t";
+      case TStreamerInfo::kLong64:  size = sizeof(Long64_t);  return "Long64_t";
+      case TStreamerInfo::kULong64: size = sizeof(ULong64_t); return "ULong64_t";
+      case TStreamerInfo::kDouble:  size = sizeof(Double_t);  return "Double_t";
+      default: return nullptr;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append to code the statements streaming one element, 'cur' being the
+/// current position in the buffer and 'obj' the address of the object.
+
+static void AddCompiledStreamerStatements(std::string &code, const TStreamerInfo::TCompInfo_t *compinfo, const char *typeName, Int_t size, Bool_t read)
+{
+   const Int_t offset = compinfo->fOffset;
+   const UInt_t length = compinfo->fLength;
+   if (length <= 1) {
+      if (read) {
+         code += TString::Format("   frombuf(cur, reinterpret_cast<%s *>(obj + %d));\n", typeName, offset).Data();
+      } else {
+         code += TString::Format("   tobuf(cur, *reinterpret_cast<%s *>(obj + %d));\n", typeName, offset).Data();
+      }
+      return;
+   }
+   // Fixed size arrays and regrouped data members: same as TBufferFile::ReadFastArray/WriteFastArray.
+   TString member = TString::Format("obj + %d", offset);
+   const char *to = read ? member.Data() : "cur";
+   const char *from = read ? "cur" : member.Data();
+#ifdef R__BYTESWAP
+   if (size > 1) {
+      code += TString::Format("   ROOT::Internal::ByteSwapCopy%d(%s, %s, %u);\n", 8 * size, to, from, length).Data();
+   } else
+#endif
+   {
+      code += TString::Format("   memcpy(%s, %s, %u);\n", to, from, length * size).Data();
+   }
+   code += TString::Format("   cur += %u;\n", length * size).Data();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the function streaming a run of elements, declaring it to the
+/// interpreter on first use; the functions are shared by all the runs with the
+/// same layout. Return nullptr if the interpreter failed to compile it.
+
+static TCompiledStreamerConfiguration::Function_t GetCompiledStreamerFunction(const std::string &body, Bool_t read)
+{
+   // Always called from TStreamerInfo::Compile, with gInterpreterMutex taken.
+   static std::unordered_map<std::string, TCompiledStreamerConfiguration::Function_t> functions;
+
+   auto iter = functions.find(body);
+   if (iter != functions.end()) {
+      return iter->second;
+   }
+   if (!gInterpreter) {
+      return nullptr;
+   }
+   if (functions.empty()) {
+      gInterpreter->Declare("#include \"TBuffer.h\"\n#include \"Bytes.h\"\n#include \"ROOT/RByteSwap.hxx\"\n#include <cstring>\n");
+   }
+   TString name = TString::Format("%s%d", read ? "Read" : "Write", (Int_t)functions.size());
+   std::string code = "namespace ROOT { namespace Internal { namespace CompiledStreamers {\nvoid ";
+   code += name.Data();
+   code += "(TBuffer &b, char *obj)\n{\n";
+   code += body;
+   code += "}\n} } }\n";
+
+   TCompiledStreamerConfiguration::Function_t function = nullptr;
+   if (gInterpreter->Declare(code.c_str())) {
+      TInterpreter::EErrorCode error = TInterpreter::kNoError;
+      Long_t address = gInterpreter->Calc(TString::Format("(Long_t)&ROOT::Internal::CompiledStreamers::%s", name.Data()), &error);
+      if (error == TInterpreter::kNoError && address) {
+         function = reinterpret_cast<TCompiledStreamerConfiguration::Function_t>(address);
+      }
+   }
+   if (!function) {
+      Warning("TStreamerInfo::Compile", "Could not compile the streamer function:\n%s", code.c_str());
+   }
+   functions[body] = function; // Do not retry a failed compilation.
+   return function;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace each run of at least two consecutive basic data members (or of a
+/// fixed size array of basic types) of the object-wise sequence by a single
+/// action calling a function generated for this run, see
+/// TVirtualStreamerInfo::SetCompiledStreamers.
+
+static void AddCompiledStreamerActions(TStreamerInfo *info, TStreamerInfoActions::TActionSequence *sequence, Bool_t read)
+{
+   TStreamerInfoActions::ActionContainer_t actions;
+   actions.swap(sequence->fActions);
+   sequence->fActions.reserve(actions.size());
+
+   size_t i = 0;
+   while (i < actions.size()) {
+      std::string body;
+      UInt_t nbytes = 0;
+      size_t end = i;
+      for (; end < actions.size(); ++end) {
+         const TStreamerInfo::TCompInfo_t *compinfo = actions[end].fConfiguration->fCompInfo;
+         Int_t size = 0;
+         const char *typeName = compinfo ? GetCompiledStreamerType(compinfo, size) : nullptr;
+         if (!typeName) {
+            break;
+         }
+         nbytes += size * compinfo->fLength;
+         AddCompiledStreamerStatements(body, compinfo, typeName, size, read);
+      }
+
+      TCompiledStreamerConfiguration::Function_t function = nullptr;
+      if (end > i && (end - i > 1 || actions[i].fConfiguration->fCompInfo->fLength > 1)) {
+         if (read) {
+            body = "   char *cur = b.GetCurrent();\n" + body;
+         } else {
+            body = TString::Format("   if (b.Length() + %u > b.BufferSize())\n      b.AutoExpand(b.Length() + %u);\n"
+                                   "   char *cur = b.GetCurrent();\n", nbytes, nbytes).Data() + body;
+         }
+         body += "   b.SetBufferOffset(cur - b.Buffer());\n";
+         function = GetCompiledStreamerFunction(body, read);
+      }
+      if (!function) {
+         // Nothing to gain, or not compilable: keep the original action.
+         end = (end > i) ? end : i + 1;
+         for (; i < end; ++i) {
+            sequence->AddAction(actions[i]);
+         }
+         continue;
+      }
+
+      TStreamerInfoActions::TConfiguration *first = actions[i].fConfiguration;
+      TStreamerInfoActions::TActionSequence *fallback = new TStreamerInfoActions::TActionSequence(info, end - i);
+      TCompiledStreamerConfiguration *conf = new TCompiledStreamerConfiguration(info, first->fElemId, first->fCompInfo, function, fallback);
+      for (; i < end; ++i) {
+         fallback->AddAction(actions[i]); // Moves the action.
+      }
+      sequence->AddAction(CompiledStreamerAction, conf);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the object-wise actions of the TStreamerInfo can use
+/// generated functions: it must describe the in-memory layout of a class
+/// known to the interpreter, without any schema evolution.
+
+static Bool_t CanUseCompiledStreamers(TStreamerInfo *info)
+{
+   TClass *cl = info->GetClass();
+   if (!cl || cl->TestBit(TClass::kIsEmulation) || !cl->GetClassInfo()) {
+      return kFALSE;
+   }
+   return info->GetClassVersion() == cl->GetClassVersion() && cl->MatchLegacyCheckSum(info->GetCheckSum());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// loop on the TStreamerElement list
 /// regroup members with same type
@@ -3191,6 +3435,10 @@ void TStreamerInfo::Compile()
       AddReadAction(fReadObjectWise, i, fCompOpt[i]);
       AddWriteAction(fWriteObjectWise, i, fCompOpt[i]);
    }
+   if (GetCompiledStreamers() && CanUseCompiledStreamers(this)) {
+      AddCompiledStreamerActions(this, fReadObjectWise, kTRUE);
+      AddCompiledStreamerActions(this, fWriteObjectWise, kFALSE);
+   }
    for (i = 0; i < fNfulldata; ++i) {
       if (!fCompFull[i]->fElem || fCompFull[i]->fElem->GetType()< 0) {
          continue;
@@ -0,0 +1,28 @@
+#ifndef ROOT_CompiledStreamersStruct
+#define ROOT_CompiledStreamersStruct
+
+#include "Rtypes.h"
+#include "TString.h"
+
+/**
+ * The CompiledStreamersStruct has no purpose except to provide
+ * inputs to the test cases: two runs of basic data members,
+ * including a fixed size array, separated by a TString.
+ */
+
+class CompiledStreamersStruct {
+public:
+   Int_t     fI = 0;
+   Float_t   fF[4] = {0, 0, 0, 0};
+   Double_t  fD = 0;
+   Bool_t    fB = kFALSE;
+   TString   fName;
+   Short_t   fS = 0;
+   Long64_t  fL = 0;
+   UChar_t   fC[3] = {0, 0, 0};
+   ULong64_t fU = 0;
+
+   ClassDef(CompiledStreamersStruct, 1);
+};
+
+#endif
@@ -0,0 +1,138 @@
+#include "gtest/gtest.h"
+
+#include "CompiledStreamersStruct.h"
+
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TStreamerInfo.h"
+#include "TStreamerInfoActions.h"
+
+#include <cstring>
+
+namespace {
+void Fill(CompiledStreamersStruct &obj)
+{
+   obj.fI = -42;
+   for (int i = 0; i < 4; ++i)
+      obj.fF[i] = 1.5f * (i + 1);
+   obj.fD = 3.14159;
+   obj.fB = kTRUE;
+   obj.fName = "compiled";
+   obj.fS = -7;
+   obj.fL = 1234567890123LL;
+   for (int i = 0; i < 3; ++i)
+      obj.fC[i] = 200 + i;
+   obj.fU = 0xFEDCBA9876543210ULL;
+}
+
+void ExpectEqual(const CompiledStreamersStruct &expected, const CompiledStreamersStruct &obj)
+{
+   EXPECT_EQ(expected.fI, obj.fI);
+   for (int i = 0; i < 4; ++i)
+      EXPECT_EQ(expected.fF[i], obj.fF[i]);
+   EXPECT_EQ(expected.fD, obj.fD);
+   EXPECT_EQ(expected.fB, obj.fB);
+   EXPECT_EQ(expected.fName, obj.fName);
+   EXPECT_EQ(expected.fS, obj.fS);
+   EXPECT_EQ(expected.fL, obj.fL);
+   for (int i = 0; i < 3; ++i)
+      EXPECT_EQ(expected.fC[i], obj.fC[i]);
+   EXPECT_EQ(expected.fU, obj.fU);
+}
+} // anonymous namespace
+
+TEST(TStreamerInfo, CompiledStreamers)
+{
+   // Must be set before the TStreamerInfo of the class is compiled.
+   const Bool_t previous = TVirtualStreamerInfo::SetCompiledStreamers(kTRUE);
+   EXPECT_TRUE(TVirtualStreamerInfo::GetCompiledStreamers());
+
+   auto info = static_cast<TStreamerInfo *>(TClass::GetClass("CompiledStreamersStruct")->GetStreamerInfo());
+   ASSERT_NE(nullptr, info);
+   // The two runs of basic data members and the TString.
+   EXPECT_EQ(3u, info->GetReadObjectWiseActions()->fActions.size());
+   EXPECT_EQ(3u, info->GetWriteObjectWiseActions()->fActions.size());
+   // The member-wise actions (used by the split branches) are unchanged.
+   EXPECT_EQ(9u, info->GetWriteMemberWiseActions(kFALSE)->fActions.size());
+
+   CompiledStreamersStruct obj;
+   Fill(obj);
+
+   // The on-file format is the same as the one of the generic actions.
+   TBufferFile compiled(TBuffer::kWrite, 16); // small, to check the buffer expansion
+   compiled.ApplySequence(*info->GetWriteObjectWiseActions(), &obj);
+   TBufferFile generic(TBuffer::kWrite);
+   generic.ApplySequence(*info->GetWriteMemberWiseActions(kFALSE), &obj);
+   ASSERT_EQ(generic.Length(), compiled.Length());
+   EXPECT_EQ(0, memcmp(generic.Buffer(), compiled.Buffer(), generic.Length()));
+
+   CompiledStreamersStruct read;
+   TBufferFile rbuf(TBuffer::kRead, generic.Length(), generic.Buffer(), kFALSE);
+   rbuf.ApplySequence(*info->GetReadObjectWiseActions(), &read);
+   EXPECT_EQ(generic.Length(), rbuf.Length());
+   ExpectEqual(obj, read);
+
+   // Full round trip, through the version and byte count of the class.
+   TBufferFile wbuf(TBuffer::kWrite);
+   wbuf.WriteObjectAny(&obj, CompiledStreamersStruct::Class());
+   wbuf.SetReadMode();
+   wbuf.SetBufferOffset(0);
+   auto copy = static_cast<CompiledStreamersStruct *>(wbuf.ReadObjectAny(CompiledStreamersStruct::Class()));
+   ASSERT_NE(nullptr, copy);
+   ExpectEqual(obj, *copy);
+   delete copy;
+
+   // A copy of the sequence, with the offsets shifted as done for a data member
+   // of type CompiledStreamersStruct inside another object.
+   struct Outer {
+      Int_t fBefore = 0;
+      CompiledStreamersStruct fInner;
+   } outer;
+   const Int_t delta = (char *)&outer.fInner - (char *)&outer;
+   auto shifted = info->GetReadObjectWiseActions()->CreateCopy();
+   shifted->AddToOffset(delta);
+   TBufferFile rbuf2(TBuffer::kRead, generic.Length(), generic.Buffer(), kFALSE);
+   rbuf2.ApplySequence(*shifted, &outer);
+   delete shifted;
+   EXPECT_EQ(0, outer.fBefore);
+   ExpectEqual(obj, outer.fInner);
+
+   TVirtualStreamerInfo::SetCompiledStreamers(previous);
+}
+
+TEST(TStreamerInfo, CompiledStreamersFallback)
+{
+   const Bool_t previous = TVirtualStreamerInfo::SetCompiledStreamers(kTRUE);
+
+   TClass *cl = TClass::GetClass("CompiledStreamersStruct");
+   auto info = static_cast<TStreamerInfo *>(cl->GetStreamerInfo());
+   ASSERT_NE(nullptr, info);
+
+   CompiledStreamersStruct obj;
+   Fill(obj);
+   TBufferFile generic(TBuffer::kWrite);
+   generic.ApplySequence(*info->GetWriteMemberWiseActions(kFALSE), &obj);
+
+   // A TStreamerInfo as read from a file written with another version of the class, or with the same version
+   // but another layout: it needs schema evolution, hence the generic actions.
+   auto checkFallback = [&](Int_t version, UInt_t checksum) {
+      auto onfile = static_cast<TStreamerInfo *>(info->Clone());
+      onfile->SetClass(cl);
+      onfile->SetClassVersion(version);
+      onfile->SetCheckSum(checksum);
+      onfile->BuildOld();
+      ASSERT_TRUE(onfile->IsCompiled());
+      // One action per data member, as without compiled streamers.
+      EXPECT_EQ(9u, onfile->GetReadObjectWiseActions()->fActions.size());
+
+      CompiledStreamersStruct read;
+      TBufferFile rbuf(TBuffer::kRead, generic.Length(), generic.Buffer(), kFALSE);
+      rbuf.ApplySequence(*onfile->GetReadObjectWiseActions(), &read);
+      EXPECT_EQ(generic.Length(), rbuf.Length());
+      ExpectEqual(obj, read);
+   };
+   checkFallback(cl->GetClassVersion() + 1, info->GetCheckSum());
+   checkFallback(cl->GetClassVersion(), info->GetCheckSum() + 1);
+
+   TVirtualStreamerInfo::SetCompiledStreamers(previous);
+}
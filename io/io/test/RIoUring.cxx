@@ -1,6 +1,14 @@
 #include "ROOT/RIoUring.hxx"
 using RIoUring = ROOT::Internal::RIoUring;
 
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "gtest/gtest.h"
 
 TEST(RIoUring, Basics)
@@ -49,3 +57,81 @@ TEST(RawUring, NopRoundTrip)
    io_uring_cqe_seen(&ring, cqe);
    io_uring_queue_exit(&ring);
 }
+
+TEST(RIoUring, SubmitReadsAndWait)
+{
+   std::string path = "test_iouring_readv";
+   std::string content;
+   for (unsigned int i = 0; i < 1000; ++i)
+      content += std::to_string(i % 10);
+   {
+      std::ofstream ostrm(path, std::ios::binary | std::ios::out | std::ios::trunc);
+      ostrm << content;
+   }
+   int fd = open(path.c_str(), O_RDONLY);
+   ASSERT_GE(fd, 0);
+
+   // More requests than the queue depth, including an empty one and one that hits the end of the file
+   RIoUring ring(4);
+   constexpr unsigned int nReads = 11;
+   std::vector<std::string> buffers(nReads, std::string(10, 'x'));
+   std::vector<RIoUring::RReadEvent> events(nReads);
+   for (unsigned int i = 0; i < nReads; ++i) {
+      events[i].fBuffer = &buffers[i][0];
+      events[i].fOffset = i * 93;
+      events[i].fSize = (i == 3) ? 0 : 10;
+      events[i].fFileDes = fd;
+   }
+   events[nReads - 1].fOffset = 995;
+   ring.SubmitReadsAndWait(events.data(), nReads);
+
+   for (unsigned int i = 0; i < nReads - 1; ++i) {
+      if (i == 3) {
+         EXPECT_EQ(0u, events[i].fOutBytes);
+         continue;
+      }
+      EXPECT_EQ(10u, events[i].fOutBytes);
+      EXPECT_EQ(content.substr(i * 93, 10), buffers[i]);
+   }
+   EXPECT_EQ(5u, events[nReads - 1].fOutBytes);
+   EXPECT_EQ("56789", buffers[nReads - 1].substr(0, 5));
+
+   close(fd);
+   std::remove(path.c_str());
+}
+
+TEST(RIoUring, SubmitReadsAndWaitError)
+{
+   std::string path = "test_iouring_readv_error";
+   std::string content(1000, 'a');
+   {
+      std::ofstream ostrm(path, std::ios::binary | std::ios::out | std::ios::trunc);
+      ostrm << content;
+   }
+   int fd = open(path.c_str(), O_RDONLY);
+   ASSERT_GE(fd, 0);
+
+   // A failing request among valid ones: the valid requests in flight are reaped before the exception propagates
+   RIoUring ring(4);
+   constexpr unsigned int nReads = 8;
+   std::vector<std::string> buffers(nReads, std::string(10, 'x'));
+   std::vector<RIoUring::RReadEvent> events(nReads);
+   for (unsigned int i = 0; i < nReads; ++i) {
+      events[i].fBuffer = &buffers[i][0];
+      events[i].fOffset = i * 100;
+      events[i].fSize = 10;
+      events[i].fFileDes = (i == 1) ? -1 : fd;
+   }
+   EXPECT_THROW(ring.SubmitReadsAndWait(events.data(), nReads), std::runtime_error);
+
+   // No stale completions are left in the ring
+   events[1].fFileDes = fd;
+   ring.SubmitReadsAndWait(events.data(), nReads);
+   for (unsigned int i = 0; i < nReads; ++i) {
+      EXPECT_EQ(10u, events[i].fOutBytes);
+      EXPECT_EQ(content.substr(i * 100, 10), buffers[i]);
+   }
+
+   close(fd);
+   std::remove(path.c_str());
+}
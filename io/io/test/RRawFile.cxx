@@ -1,5 +1,6 @@
 #include "RConfigure.h"
 #include "ROOT/RRawFile.hxx"
+#include "ROOT/RReadVPlanner.hxx"
 #include "ROOT/RMakeUnique.hxx"
 
 #include <algorithm>
@@ -14,6 +15,7 @@
 #include "gtest/gtest.h"
 
 using RRawFile = ROOT::Internal::RRawFile;
+using RReadVPlanner = ROOT::Internal::RReadVPlanner;
 
 namespace {
 
@@ -168,6 +170,128 @@ TEST(RRawFile, ReadV)
 }
 
 
+TEST(RRawFile, ReadVPlanner)
+{
+   RRawFile::RIOVec iovec[4];
+   iovec[0].fOffset = 100;
+   iovec[0].fSize = 10;
+   iovec[1].fOffset = 0;
+   iovec[1].fSize = 10;
+   iovec[2].fOffset = 12;
+   iovec[2].fSize = 10;
+   iovec[3].fOffset = 50;
+   iovec[3].fSize = 0;
+
+   // The gap of 2 bytes is within the waste budget of 30% but the gap of 78 bytes is not
+   RReadVPlanner::RSettings settings;
+   settings.fMaxWaste = 0.3;
+   auto plan = RReadVPlanner(settings).Plan(iovec, 4);
+   EXPECT_FALSE(plan.fHasOverlaps);
+   EXPECT_EQ(30U, plan.fSzRequested);
+   EXPECT_EQ(32U, plan.fSzRead);
+   ASSERT_EQ(2U, plan.fBlocks.size());
+   EXPECT_EQ(0U, plan.fBlocks[0].fOffset);
+   EXPECT_EQ(22U, plan.fBlocks[0].fSize);
+   EXPECT_EQ(2U, plan.fBlocks[0].fNRanges);
+   EXPECT_EQ(100U, plan.fBlocks[1].fOffset);
+   EXPECT_EQ(22U, plan.fBlocks[1].fBufferPos);
+   EXPECT_EQ(22U, plan.fRangePos[0]);
+   EXPECT_EQ(0U, plan.fRangePos[1]);
+   EXPECT_EQ(12U, plan.fRangePos[2]);
+
+   // The absolute gap limit takes precedence
+   settings.fMaxGap = 1;
+   plan = RReadVPlanner(settings).Plan(iovec, 4);
+   EXPECT_EQ(3U, plan.fBlocks.size());
+   EXPECT_EQ(30U, plan.fSzRead);
+
+   // Large ranges are split
+   settings.fMaxRequestSize = 4;
+   plan = RReadVPlanner(settings).Plan(iovec, 4);
+   EXPECT_EQ(9U, plan.fBlocks.size());
+   EXPECT_EQ(30U, plan.fSzRead);
+   EXPECT_EQ(20U, plan.fRangePos[0]);
+   for (const auto &b : plan.fBlocks)
+      EXPECT_GE(4U, b.fSize);
+}
+
+
+TEST(RRawFile, ReadVCoalesce)
+{
+   RRawFile::ROptions options;
+   options.fBlockSize = 0;
+   options.fReadVCoalesce = true;
+   options.fReadVMaxWaste = 1.0;
+   RRawFileMock m("abcdefghijklmnopqrstuvwxyz", options);
+
+   char buffer[8];
+   RRawFile::RIOVec iovec[4];
+   iovec[0].fBuffer = &buffer[0];
+   iovec[0].fOffset = 0;
+   iovec[0].fSize = 2;
+   iovec[1].fBuffer = &buffer[2];
+   iovec[1].fOffset = 20;
+   iovec[1].fSize = 2;
+   iovec[2].fBuffer = &buffer[4];
+   iovec[2].fOffset = 3;
+   iovec[2].fSize = 2;
+   iovec[3].fBuffer = &buffer[6];
+   iovec[3].fOffset = 25;
+   iovec[3].fSize = 2;
+   m.ReadV(iovec, 4);
+
+   // "ab" and "de" are read in one go, as are "uv" and "z"
+   EXPECT_EQ(2u, m.fNumReadAt);
+   EXPECT_EQ("abuvdez", std::string(buffer, 7));
+   EXPECT_EQ(2U, iovec[0].fOutBytes);
+   EXPECT_EQ(2U, iovec[1].fOutBytes);
+   EXPECT_EQ(2U, iovec[2].fOutBytes);
+   EXPECT_EQ(1U, iovec[3].fOutBytes);
+   EXPECT_EQ(4U, m.GetReadVStats().fNRanges);
+   EXPECT_EQ(2U, m.GetReadVStats().fNRequests);
+   EXPECT_EQ(8U, m.GetReadVStats().fSzUsed);
+   EXPECT_EQ(12U, m.GetReadVStats().fSzRead);
+
+   // Overlapping ranges
+   m.fNumReadAt = 0;
+   iovec[0].fOffset = 2;
+   iovec[0].fSize = 4;
+   iovec[1].fBuffer = &buffer[4];
+   iovec[1].fOffset = 4;
+   iovec[1].fSize = 4;
+   m.ReadV(iovec, 2);
+   EXPECT_EQ(1u, m.fNumReadAt);
+   EXPECT_EQ("cdefefgh", std::string(buffer, 8));
+   EXPECT_EQ(4U, iovec[0].fOutBytes);
+   EXPECT_EQ(4U, iovec[1].fOutBytes);
+}
+
+
+TEST(RRawFile, ReadVSplit)
+{
+   RRawFile::ROptions options;
+   options.fBlockSize = 0;
+   options.fReadVMaxRequestSize = 4;
+   RRawFileMock m("abcdefghijklmnopqrstuvwxyz", options);
+
+   char buffer[10];
+   RRawFile::RIOVec iovec[2];
+   iovec[0].fBuffer = &buffer[0];
+   iovec[0].fOffset = 0;
+   iovec[0].fSize = 10;
+   iovec[1].fBuffer = &buffer[0];
+   iovec[1].fOffset = 50;
+   iovec[1].fSize = 0;
+   m.ReadV(iovec, 2);
+   EXPECT_EQ(3u, m.fNumReadAt);
+   EXPECT_EQ(10U, iovec[0].fOutBytes);
+   EXPECT_EQ(0U, iovec[1].fOutBytes);
+   EXPECT_EQ("abcdefghij", std::string(buffer, 10));
+   EXPECT_EQ(3U, m.GetReadVStats().fNRequests);
+   EXPECT_EQ(10U, m.GetReadVStats().fSzRead);
+}
+
+
 TEST(RRawFile, SplitUrl)
 {
    EXPECT_STREQ("C:\\Data\\events.root", RRawFile::GetLocation("C:\\Data\\events.root").c_str());
@@ -255,6 +379,10 @@ TEST(RRawFile, Mmap)
    auto innerOffset = 1 - mapdOffset;
    ASSERT_NE(region, nullptr);
    EXPECT_EQ("oo", std::string(reinterpret_cast<char *>(region) + innerOffset, 2));
+   // Advice does not change the content of the mapping, also not when resident memory is released
+   f->Advise(reinterpret_cast<char *>(region) + innerOffset, 2, RRawFile::EMapAdvice::kWillNeed);
+   f->Advise(reinterpret_cast<char *>(region) + innerOffset, 2, RRawFile::EMapAdvice::kDontNeed);
+   EXPECT_EQ("oo", std::string(reinterpret_cast<char *>(region) + innerOffset, 2));
    auto mapdLength = 2 + innerOffset;
    f->Unmap(region, mapdLength);
 }
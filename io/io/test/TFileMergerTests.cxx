@@ -2,9 +2,14 @@
 
 #include "TFileMerger.h"
 
+#include "TH1D.h"
 #include "TMemFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 
+#include <memory>
+#include <vector>
+
 static void CreateATuple(TMemFile &file, const char *name, double value)
 {
    auto mytree = new TTree(name, "A tree");
@@ -68,3 +73,108 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    ROOT_EXPECT_ERROR(merger.OutputFile(std::move(output)), "TFileMerger::OutputFile",
                      "output file output.root is not writable");
 }
+
+static std::unique_ptr<TH1D> MergeHistograms(std::vector<std::unique_ptr<TMemFile>> &inputs, bool imt)
+{
+   TFileMerger merger(kFALSE, kFALSE);
+   merger.SetImplicitMT(imt);
+   EXPECT_TRUE(merger.OutputFile(std::unique_ptr<TMemFile>(new TMemFile("hmerged.root", "CREATE"))));
+   for (auto &input : inputs)
+      merger.AddFile(input.get(), false);
+   EXPECT_TRUE(merger.PartialMerge());
+
+   auto h = merger.GetOutputFile()->Get<TH1D>("h");
+   EXPECT_TRUE(h != nullptr);
+   if (!h)
+      return nullptr;
+   h->SetDirectory(nullptr);
+   return std::unique_ptr<TH1D>(h);
+}
+
+TEST(TFileMerger, MergeHistogramsInParallel)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   std::vector<std::unique_ptr<TMemFile>> inputs;
+   for (int i = 0; i < 17; ++i) {
+      inputs.emplace_back(new TMemFile(TString::Format("h%d.root", i), "RECREATE"));
+      auto h = new TH1D("h", "h", 10, 0, 10);
+      h->SetDirectory(inputs.back().get());
+      for (int j = 0; j <= i; ++j)
+         h->Fill(j % 10);
+      inputs.back()->Write();
+   }
+
+   auto sequential = MergeHistograms(inputs, false);
+   auto parallel = MergeHistograms(inputs, true);
+   ASSERT_TRUE(sequential && parallel);
+   EXPECT_EQ(17 * 18 / 2, sequential->GetEntries());
+   EXPECT_EQ(sequential->GetEntries(), parallel->GetEntries());
+   for (int bin = 0; bin <= 11; ++bin)
+      EXPECT_EQ(sequential->GetBinContent(bin), parallel->GetBinContent(bin)) << "bin " << bin;
+
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
+
+TEST(TFileMerger, MergeManyKeysInParallel)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   // More histograms than are merged in one batch, and a tree merged entry by entry.
+   const int nfiles = 8;
+   const int nhistos = 2100;
+   std::vector<std::unique_ptr<TMemFile>> inputs;
+   for (int i = 0; i < nfiles; ++i) {
+      inputs.emplace_back(new TMemFile(TString::Format("many%d.root", i), "RECREATE"));
+      for (int k = 0; k < nhistos; ++k) {
+         auto h = new TH1D(TString::Format("h%d", k), "h", 10, 0, 10);
+         h->SetDirectory(inputs.back().get());
+         h->Fill((k + i) % 10);
+      }
+      auto t = new TTree("t", "t");
+      t->SetDirectory(inputs.back().get());
+      int value = 0;
+      t->Branch("value", &value);
+      for (int j = 0; j < 1000; ++j) {
+         value = i * 1000 + j;
+         t->Fill();
+      }
+      inputs.back()->Write();
+   }
+
+   TFileMerger merger(kFALSE, kFALSE);
+   merger.SetImplicitMT(true);
+   merger.SetFastMethod(kFALSE);
+   ASSERT_TRUE(merger.OutputFile(std::unique_ptr<TMemFile>(new TMemFile("manymerged.root", "CREATE"))));
+   for (auto &input : inputs)
+      merger.AddFile(input.get(), false);
+   ASSERT_TRUE(merger.PartialMerge());
+
+   auto output = merger.GetOutputFile();
+   for (int k = 0; k < nhistos; ++k) {
+      auto h = output->Get<TH1D>(TString::Format("h%d", k));
+      ASSERT_TRUE(h != nullptr) << "h" << k;
+      EXPECT_EQ(nfiles, h->GetEntries()) << "h" << k;
+      for (int i = 0; i < nfiles; ++i)
+         EXPECT_LE(1, h->GetBinContent(1 + (k + i) % 10)) << "h" << k;
+   }
+
+   auto t = output->Get<TTree>("t");
+   ASSERT_TRUE(t != nullptr);
+   ASSERT_EQ(nfiles * 1000, t->GetEntries());
+   int value = -1;
+   t->SetBranchAddress("value", &value);
+   for (Long64_t j = 0; j < t->GetEntries(); ++j) {
+      t->GetEntry(j);
+      EXPECT_EQ(j, value);
+   }
+   t->ResetBranchAddresses();
+
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
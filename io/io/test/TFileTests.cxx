@@ -1,7 +1,14 @@
+#include "TDirectoryFile.h"
 #include "TFile.h"
+#include "TKey.h"
+#include "TNamed.h"
+#include "TSystem.h"
 
 #include "gtest/gtest.h"
 
+#include <string>
+#include <vector>
+
 // Tests ROOT-9857
 TEST(TFile, ReadFromSameFile)
 {
@@ -21,4 +28,141 @@ TEST(TFile, ReadFromSameFile)
    auto o2 = f2.Get(objpath);
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
-}
\ No newline at end of file
+}
+
+namespace {
+void WriteKeyIndexFile(const char *filename, Int_t minKeys)
+{
+   const auto oldMinKeys = TDirectoryFile::GetKeyIndexMinKeys();
+   TDirectoryFile::SetKeyIndexMinKeys(minKeys);
+   {
+      TFile f(filename, "RECREATE");
+      auto dir = f.mkdir("dir");
+      for (auto d : {(TDirectory *)&f, dir}) {
+         for (int i = 0; i < 100; ++i) {
+            const auto name = "obj" + std::to_string((i * 37) % 100);
+            TNamed obj(name.c_str(), "cycle 1");
+            d->WriteTObject(&obj);
+            if (i % 10 == 0) {
+               obj.SetTitle("cycle 2");
+               d->WriteTObject(&obj);
+            }
+         }
+      }
+   }
+   TDirectoryFile::SetKeyIndexMinKeys(oldMinKeys);
+}
+
+std::vector<std::string> GetKeyNames(TDirectory *dir)
+{
+   std::vector<std::string> names;
+   for (auto key : *dir->GetListOfKeys())
+      names.push_back(std::string(key->GetName()) + ";" + std::to_string(((TKey *)key)->GetCycle()));
+   return names;
+}
+
+// Number of keys of the directory that are in memory, which is less than GetNkeys()
+// while the keys are read on demand from the key index.
+struct TDirectoryFileKeys : TDirectoryFile {
+   static Int_t GetNkeysInMemory(TDirectory *dir)
+   {
+      return (static_cast<TDirectoryFile *>(dir)->*(&TDirectoryFileKeys::fKeys))->GetSize();
+   }
+};
+} // anonymous namespace
+
+TEST(TFile, KeyIndex)
+{
+   const auto filename = "KeyIndex.root";
+   const auto refname = "KeyIndexRef.root";
+   WriteKeyIndexFile(filename, 10);
+   WriteKeyIndexFile(refname, 0);
+
+   TFile ref(refname);
+   TFile f(filename);
+   for (auto sub : {false, true}) {
+      TDirectory *refdir = sub ? ref.Get<TDirectory>("dir") : &ref;
+      TDirectory *dir = sub ? f.Get<TDirectory>("dir") : &f;
+      ASSERT_NE(refdir, nullptr);
+      ASSERT_NE(dir, nullptr);
+      // 100 objects, 10 of them with 2 cycles, and the subdirectory
+      EXPECT_EQ(dir->GetNkeys(), sub ? 110 : 111);
+      EXPECT_GT(dir->GetNbytesKeys(), refdir->GetNbytesKeys());
+      const auto nkeysInMemory = TDirectoryFileKeys::GetNkeysInMemory(dir);
+      EXPECT_LT(nkeysInMemory, 5);
+
+      // Lookups through the index
+      auto obj = dir->Get<TNamed>("obj42");
+      ASSERT_NE(obj, nullptr);
+      EXPECT_STREQ(obj->GetTitle(), "cycle 1");
+      obj = dir->Get<TNamed>("obj70");
+      ASSERT_NE(obj, nullptr);
+      EXPECT_STREQ(obj->GetTitle(), "cycle 2");
+      obj = dir->Get<TNamed>("obj70;1");
+      ASSERT_NE(obj, nullptr);
+      EXPECT_STREQ(obj->GetTitle(), "cycle 1");
+      EXPECT_EQ(dir->Get("obj70;3"), nullptr);
+      EXPECT_EQ(dir->Get("obj100"), nullptr);
+      EXPECT_EQ(dir->Get("obj"), nullptr);
+      ASSERT_NE(dir->GetKey("obj70"), nullptr);
+      EXPECT_EQ(dir->GetKey("obj70")->GetCycle(), 2);
+      EXPECT_EQ(dir->GetKey("obj70", 1)->GetCycle(), 1);
+      EXPECT_EQ(dir->FindKey("obj70;2"), dir->GetKey("obj70"));
+      // Only the keys looked up were read: obj42;1, obj70;2 and obj70;1
+      EXPECT_EQ(TDirectoryFileKeys::GetNkeysInMemory(dir), nkeysInMemory + 3);
+
+      // Reading all the keys gives the same list as without index
+      EXPECT_EQ(GetKeyNames(dir), GetKeyNames(refdir));
+      EXPECT_EQ(TDirectoryFileKeys::GetNkeysInMemory(dir), dir->GetNkeys());
+      EXPECT_EQ(dir->GetKey("obj70")->GetCycle(), 2);
+   }
+
+   // Switching to UPDATE reads all the keys, which are written back with the
+   // index when the file is closed.
+   const auto oldMinKeys = TDirectoryFile::GetKeyIndexMinKeys();
+   TDirectoryFile::SetKeyIndexMinKeys(10);
+   Int_t nkeysTop = 0;
+   Int_t nkeysDir = 0;
+   {
+      TFile upd(filename);
+      auto dir = upd.Get<TDirectory>("dir");
+      ASSERT_NE(dir, nullptr);
+      ASSERT_NE(dir->Get<TNamed>("obj42"), nullptr);
+      EXPECT_LT(TDirectoryFileKeys::GetNkeysInMemory(dir), dir->GetNkeys());
+      nkeysTop = upd.GetNkeys();
+      nkeysDir = dir->GetNkeys();
+
+      ASSERT_EQ(upd.ReOpen("UPDATE"), 0);
+      EXPECT_EQ(TDirectoryFileKeys::GetNkeysInMemory(&upd), nkeysTop);
+      EXPECT_EQ(TDirectoryFileKeys::GetNkeysInMemory(dir), nkeysDir);
+      TNamed added("added", "added");
+      upd.WriteTObject(&added);
+      dir->WriteTObject(&added);
+      TNamed obj("obj42", "cycle 2");
+      dir->WriteTObject(&obj);
+   }
+   TDirectoryFile::SetKeyIndexMinKeys(oldMinKeys);
+   {
+      TFile updated(filename);
+      auto dir = updated.Get<TDirectory>("dir");
+      ASSERT_NE(dir, nullptr);
+      EXPECT_EQ(updated.GetNkeys(), nkeysTop + 1);
+      EXPECT_EQ(dir->GetNkeys(), nkeysDir + 2);
+      for (auto d : {(TDirectory *)&updated, dir}) {
+         auto added = d->Get<TNamed>("added");
+         ASSERT_NE(added, nullptr);
+         EXPECT_STREQ(added->GetTitle(), "added");
+         EXPECT_LT(TDirectoryFileKeys::GetNkeysInMemory(d), d->GetNkeys());
+      }
+      auto obj = dir->Get<TNamed>("obj42");
+      ASSERT_NE(obj, nullptr);
+      EXPECT_STREQ(obj->GetTitle(), "cycle 2");
+      obj = dir->Get<TNamed>("obj42;1");
+      ASSERT_NE(obj, nullptr);
+      EXPECT_STREQ(obj->GetTitle(), "cycle 1");
+      EXPECT_EQ(dir->Get<TNamed>("obj70")->GetTitle(), std::string("cycle 2"));
+   }
+
+   gSystem->Unlink(filename);
+   gSystem->Unlink(refname);
+}
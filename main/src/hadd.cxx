@@ -27,6 +27,7 @@
   \param -O   Re-optimize basket size when merging TTree
   \param -v   Explicitly set the verbosity level: 0 request no output, 99 is the default
   \param -j   Parallelise the execution in multiple processes
+  \param -mt  Merge the histograms with multiple threads, in a single process (tree reduction over the input files)
   \param -dbg  Parallelise the execution in multiple processes in debug mode (Does not delete  partial  files  stored
               inside working directory)
   \param -d   Carry out the partial multiprocess execution in the specified directory
@@ -80,6 +81,12 @@
   (i.e. direct copy of the raw byte on disk). The "fast" mode is typically
   5 times faster than the mode unzipping and unstreaming the baskets.
 
+  With the option -mt [nthreads], the histograms of the source files are merged
+  in the hadd process by several threads (see TFileMerger::SetImplicitMT): each
+  thread reads and merges the histograms of a group of input files, then the
+  partial sums are added together. Unlike -j, this does not write intermediate
+  files. The trees are still merged sequentially.
+
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
@@ -101,6 +108,7 @@
 #include "ROOT/TIOFeatures.hxx"
 #include "TFile.h"
 #include "THashList.h"
+#include "TROOT.h"
 #include "TKey.h"
 #include "TClass.h"
 #include "TSystem.h"
@@ -139,6 +147,8 @@ int main( int argc, char **argv )
    Bool_t keepCompressionAsIs = kFALSE;
    Bool_t useFirstInputCompression = kFALSE;
    Bool_t multiproc = kFALSE;
+   Bool_t multithread = kFALSE;
+   Int_t nThreads = 0;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
    Int_t verbosity = 99;
@@ -213,6 +223,28 @@ int main( int argc, char **argv )
          }
          multiproc = kTRUE;
          ++ffirst;
+      } else if (strcmp(argv[a], "-mt") == 0) {
+         // If the number of threads is not specified, use the default.
+         if (a + 1 != argc && argv[a + 1][0] != '-') {
+            Bool_t isNumber = kTRUE;
+            for (char *c = argv[a + 1]; *c != '\0'; ++c) {
+               if (!isdigit(*c)) {
+                  isNumber = kFALSE;
+                  break;
+               }
+            }
+            Long_t request = isNumber ? strtol(argv[a + 1], 0, 10) : -1;
+            if (request < kMaxInt && request >= 0) {
+               nThreads = (Int_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the number of threads passed after -mt: " << argv[a + 1]
+                         << ". We will use the default value (number of logical cores).\n";
+            }
+         }
+         multithread = kTRUE;
+         ++ffirst;
       } else if ( strcmp(argv[a],"-cachesize=") == 0 ) {
          int size;
          static const size_t arglen = strlen("-cachesize=");
@@ -363,6 +395,17 @@ int main( int argc, char **argv )
 
    gSystem->Load("libTreePlayer");
 
+   if (multithread) {
+#ifdef R__USE_IMT
+      // Must be done before creating the TFileMerger, which picks up the setting.
+      ROOT::EnableImplicitMT(nThreads);
+      if (verbosity > 1)
+         std::cout << "hadd merging with " << ROOT::GetThreadPoolSize() << " threads.\n";
+#else
+      std::cerr << "Warning: hadd was built without multi-threading support, -mt is ignored.\n";
+#endif
+   }
+
    const char *targetname = 0;
    if (outputPlace) {
       targetname = argv[outputPlace];
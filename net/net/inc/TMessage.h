@@ -27,6 +27,8 @@
 #include "MessageTypes.h"
 #include "TBits.h"
 
+#include <vector>
+
 class TList;
 class TVirtualStreamerInfo;
 
@@ -49,6 +51,14 @@ private:
    char    *fCompPos{nullptr};    // Position of fBufCur when message was compressed
    Bool_t   fEvolution{kFALSE};   // True if support for schema evolution required
 
+   struct BorrowedBuffer_t {
+      Int_t       fOffset;          // Position in the message buffer where the buffer is inserted
+      const char *fBuffer;          // Borrowed buffer
+      Int_t       fLength;          // Length of the borrowed buffer
+   };
+   std::vector<BorrowedBuffer_t> fBorrowed; //! Buffers sent with the message without being copied into it
+   Int_t    fBorrowedLength{0};   // Total length of the borrowed buffers
+
    static Bool_t fgEvolution;  //True if global support for schema evolution required
 
    // TMessage objects cannot be copied or assigned
@@ -88,6 +98,9 @@ public:
    Int_t    Uncompress();
    char    *CompBuffer() const { return fBufComp; }
    Int_t    CompLength() const { return (Int_t)(fBufCompCur - fBufComp); }
+   void     AddBorrowedBuffer(const char *buf, Int_t len);
+   void     CopyBorrowedBuffers();
+   Int_t    BorrowedLength() const { return fBorrowedLength; }
    UShort_t WriteProcessID(TProcessID *pid) override;
 
    static void   EnableSchemaEvolutionForAll(Bool_t enable = kTRUE);
@@ -27,8 +27,13 @@
 #include "TProcessID.h"
 #include "RZip.h"
 
+#include <cstring>
+
 Bool_t TMessage::fgEvolution = kFALSE;
 
+// Buffers smaller than this are copied into the message by AddBorrowedBuffer
+const Int_t kMinBorrowedLength = 4096;
+
 
 ClassImp(TMessage);
 
@@ -193,15 +198,79 @@ void TMessage::Reset()
          fInfos->Clear();
    }
    fBitsPIDs.ResetAllBits();
+
+   fBorrowed.clear();
+   fBorrowedLength = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add len bytes starting at buf to the message without copying them.
+///
+/// For the receiver this is the same as WriteFastArray(buf, len): the bytes
+/// are inserted in the message at the current position. TSocket::Send sends
+/// them directly from buf, with a single gather write for the whole message,
+/// which avoids copying large payloads (e.g. the blocks of a TMemFile) into
+/// the message buffer. The buffer must therefore stay valid and unchanged
+/// until the message is sent; Reset() forgets the borrowed buffers.
+///
+/// The borrowed buffers are copied into the message when it is compressed
+/// or sent by a socket not supporting them, and buffers smaller than 4 kB are
+/// always copied. Since the objects written to a message refer to each other
+/// by their position in it, borrowed buffers should be added after the
+/// objects, typically at the end of the message.
+
+void TMessage::AddBorrowedBuffer(const char *buf, Int_t len)
+{
+   if (len <= 0)
+      return;
+   if (len < kMinBorrowedLength) {
+      WriteFastArray(buf, len);
+      return;
+   }
+   fBorrowed.push_back({Length(), buf, len});
+   fBorrowedLength += len;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the borrowed buffers (see AddBorrowedBuffer) into the message buffer,
+/// at the positions where they were added.
+
+void TMessage::CopyBorrowedBuffers()
+{
+   if (fBorrowed.empty())
+      return;
+
+   const Int_t length = Length();
+   const Int_t total = length + fBorrowedLength;
+   AutoExpand(total);
+
+   // Move the data following each borrowed buffer, starting from the last one
+   char *buf = Buffer();
+   Int_t end = length, dest = total;
+   for (auto b = fBorrowed.rbegin(); b != fBorrowed.rend(); ++b) {
+      const Int_t n = end - b->fOffset;
+      dest -= n;
+      memmove(buf + dest, buf + b->fOffset, n);
+      dest -= b->fLength;
+      memcpy(buf + dest, b->fBuffer, b->fLength);
+      end = b->fOffset;
+   }
+   SetBufferOffset(total);
+
+   fBorrowed.clear();
+   fBorrowedLength = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the message length at the beginning of the message buffer.
-/// This method is only called by TSocket::Send().
+/// This method is only called by TSocket::Send(). The borrowed buffers, if
+/// any, are copied into the message buffer first.
 
 void TMessage::SetLength() const
 {
    if (IsWriting()) {
+      const_cast<TMessage *>(this)->CopyBorrowedBuffers();
+
       char *buf = Buffer();
       if (buf)
          tobuf(buf, (UInt_t)(Length() - sizeof(UInt_t)));
@@ -318,6 +387,8 @@ Int_t TMessage::Compress()
       return 0;
    }
 
+   CopyBorrowedBuffers();
+
    if (fBufComp && fCompPos == fBufCur) {
       // the message was already compressed
       return 0;
@@ -118,7 +118,9 @@ Bool_t TParallelMergingFile::UploadAndReset()
    fMessage.WriteInt(fServerIdx);
    fMessage.WriteTString(GetName());
    fMessage.WriteLong64(GetEND());
-   CopyTo(fMessage);
+   // Send the memory blocks of the file without copying them into the message
+   for (const TMemBlock *current = &fBlockList; current; current = current->fNext)
+      fMessage.AddBorrowedBuffer((const char *)current->fBuffer, current->fSize);
 
    // FIXME: CXX17: Use init-statement in if to declare `error` variable
    int error;
@@ -518,6 +518,8 @@ Int_t TSocket::Send(const char *str, Int_t kind)
 /// Returns -5 if pipe broken or reset by peer (EPIPE || ECONNRESET).
 /// support for streaming TStreamerInfo added by Rene Brun May 2008
 /// support for streaming TProcessID added by Rene Brun June 2008
+/// The borrowed buffers of an uncompressed message are sent without being
+/// copied into it (see TMessage::AddBorrowedBuffer).
 
 Int_t TSocket::Send(const TMessage &mess)
 {
@@ -536,24 +538,48 @@ Int_t TSocket::Send(const TMessage &mess)
    // send the process id's so TRefs work
    SendProcessIDs(mess);
 
-   mess.SetLength();   //write length in first word of buffer
-
    if (GetCompressionLevel() > 0 && mess.GetCompressionLevel() == 0)
       const_cast<TMessage&>(mess).SetCompressionSettings(fCompress);
 
-   if (mess.GetCompressionLevel() > 0)
-      const_cast<TMessage&>(mess).Compress();
+   Int_t nsent;
+   if (mess.BorrowedLength() > 0 && mess.GetCompressionLevel() <= 0) {
+      // send the borrowed buffers from where they are, with a single
+      // gather write of the message (see TMessage::AddBorrowedBuffer)
+      std::vector<const void *> buffers;
+      std::vector<int> lengths;
+      Int_t pos = 0;
+      for (const auto &b : mess.fBorrowed) {
+         buffers.push_back(mess.Buffer() + pos);
+         lengths.push_back(b.fOffset - pos);
+         buffers.push_back(b.fBuffer);
+         lengths.push_back(b.fLength);
+         pos = b.fOffset;
+      }
+      buffers.push_back(mess.Buffer() + pos);
+      lengths.push_back(mess.Length() - pos);
 
-   char *mbuf = mess.Buffer();
-   Int_t mlen = mess.Length();
-   if (mess.CompBuffer()) {
-      mbuf = mess.CompBuffer();
-      mlen = mess.CompLength();
-   }
+      char *mbuf = mess.Buffer();
+      tobuf(mbuf, (UInt_t)(mess.Length() + mess.BorrowedLength() - sizeof(UInt_t)));
 
-   ResetBit(TSocket::kBrokenConn);
-   Int_t nsent;
-   if ((nsent = gSystem->SendRaw(fSocket, mbuf, mlen, 0)) <= 0) {
+      ResetBit(TSocket::kBrokenConn);
+      nsent = gSystem->SendRawv(fSocket, buffers.data(), lengths.data(), buffers.size(), 0);
+   } else {
+      mess.SetLength();   //write length in first word of buffer
+
+      if (mess.GetCompressionLevel() > 0)
+         const_cast<TMessage&>(mess).Compress();
+
+      char *mbuf = mess.Buffer();
+      Int_t mlen = mess.Length();
+      if (mess.CompBuffer()) {
+         mbuf = mess.CompBuffer();
+         mlen = mess.CompLength();
+      }
+
+      ResetBit(TSocket::kBrokenConn);
+      nsent = gSystem->SendRaw(fSocket, mbuf, mlen, 0);
+   }
+   if (nsent <= 0) {
       if (nsent == -5) {
          // Connection reset by peer or broken
          MarkBrokenConnection();
@@ -0,0 +1,150 @@
+#include "TMessage.h"
+#include "TSocket.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#ifdef R__UNIX
+#include <chrono>
+#include <csignal>
+#include <thread>
+#include <pthread.h>
+#include <sys/socket.h>
+#endif
+
+namespace {
+// Borrowed buffers of different sizes, the first ones below the size from which
+// the buffers are not copied into the message
+std::vector<std::vector<char>> MakeBuffers(int nbuffers)
+{
+   std::vector<std::vector<char>> buffers;
+   for (int i = 0; i < nbuffers; ++i) {
+      buffers.emplace_back(1000 + 1500 * i);
+      for (std::size_t j = 0; j < buffers.back().size(); ++j)
+         buffers.back()[j] = char(i * 7 + j);
+   }
+   return buffers;
+}
+
+// Interleave normal writes and the buffers, either borrowed or written with WriteFastArray
+void FillMessage(TMessage &mess, const std::vector<std::vector<char>> &buffers, bool borrow)
+{
+   for (std::size_t i = 0; i < buffers.size(); ++i) {
+      mess.WriteInt(i);
+      mess.WriteInt(buffers[i].size());
+      if (borrow)
+         mess.AddBorrowedBuffer(buffers[i].data(), buffers[i].size());
+      else
+         mess.WriteFastArray(buffers[i].data(), buffers[i].size());
+      if (i % 2)
+         mess.WriteDouble(i / 3.);
+   }
+   mess.WriteInt(-1);
+}
+} // anonymous namespace
+
+TEST(TMessage, CopyBorrowedBuffers)
+{
+   const auto buffers = MakeBuffers(8);
+   TMessage borrowed(kMESS_ANY);
+   TMessage copied(kMESS_ANY);
+   FillMessage(borrowed, buffers, true);
+   FillMessage(copied, buffers, false);
+
+   // The buffers of at least 4 kB are not copied
+   Int_t nborrowed = 0;
+   for (const auto &b : buffers)
+      if (b.size() >= 4096)
+         nborrowed += b.size();
+   EXPECT_GT(nborrowed, 0);
+   EXPECT_EQ(borrowed.BorrowedLength(), nborrowed);
+   EXPECT_EQ(borrowed.Length() + borrowed.BorrowedLength(), copied.Length());
+
+   borrowed.CopyBorrowedBuffers();
+   EXPECT_EQ(borrowed.BorrowedLength(), 0);
+   ASSERT_EQ(borrowed.Length(), copied.Length());
+   EXPECT_EQ(memcmp(borrowed.Buffer(), copied.Buffer(), copied.Length()), 0);
+}
+
+#ifdef R__UNIX
+namespace {
+void IgnoreSignal(int) {}
+} // anonymous namespace
+
+TEST(TMessage, SendBorrowedBuffers)
+{
+   // More buffers than sent by one gather write, interleaved with normal writes,
+   // i.e. more than 64 pieces
+   const auto buffers = MakeBuffers(40);
+   TMessage borrowed(kMESS_ANY);
+   TMessage copied(kMESS_ANY);
+   FillMessage(borrowed, buffers, true);
+   FillMessage(copied, buffers, false);
+
+   int fds[2];
+   ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+   // A send buffer much smaller than the message, so that it is sent in many writes
+   int sndbuf = 4096;
+   ASSERT_EQ(setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)), 0);
+   TSocket sender(fds[0], "sender");
+   TSocket receiver(fds[1], "receiver");
+   ASSERT_TRUE(sender.IsValid());
+   ASSERT_TRUE(receiver.IsValid());
+
+   // A signal interrupting the blocked gather write makes it return the number of
+   // bytes sent so far, in the middle of a buffer: the remaining ones must be sent.
+   struct sigaction action, oldaction;
+   memset(&action, 0, sizeof(action));
+   action.sa_handler = IgnoreSignal;
+   action.sa_flags = SA_RESTART;
+   sigemptyset(&action.sa_mask);
+   ASSERT_EQ(sigaction(SIGUSR2, &action, &oldaction), 0);
+
+   Int_t nsent = 0;
+   std::thread sending([&] { nsent = sender.Send(borrowed); });
+   for (int i = 0; i < 3; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      pthread_kill(sending.native_handle(), SIGUSR2);
+   }
+   TMessage *received = nullptr;
+   const Int_t nrecv = receiver.Recv(received);
+   sending.join();
+   sigaction(SIGUSR2, &oldaction, nullptr);
+   std::unique_ptr<TMessage> guard(received);
+
+   // The length word is not part of the received bytes
+   const Int_t nbytes = copied.Length() - sizeof(UInt_t);
+   EXPECT_EQ(nsent, copied.Length());
+   EXPECT_EQ(nrecv, nbytes);
+   ASSERT_NE(received, nullptr);
+   EXPECT_EQ(received->What(), (UInt_t)kMESS_ANY);
+   ASSERT_EQ(received->BufferSize(), copied.Length());
+   EXPECT_EQ(memcmp(received->Buffer() + sizeof(UInt_t), copied.Buffer() + sizeof(UInt_t), nbytes), 0);
+
+   // The message is read back as written
+   for (std::size_t i = 0; i < buffers.size(); ++i) {
+      Int_t index = -1, size = -1;
+      received->ReadInt(index);
+      received->ReadInt(size);
+      ASSERT_EQ(index, (Int_t)i);
+      ASSERT_EQ(size, (Int_t)buffers[i].size());
+      std::vector<char> buffer(size);
+      received->ReadFastArray(buffer.data(), size);
+      EXPECT_EQ(buffer, buffers[i]) << "buffer " << i;
+      if (i % 2) {
+         Double_t d = 0;
+         received->ReadDouble(d);
+         EXPECT_EQ(d, i / 3.);
+      }
+   }
+   Int_t last = 0;
+   received->ReadInt(last);
+   EXPECT_EQ(last, -1);
+
+   sender.Close();
+   receiver.Close();
+}
+#endif // R__UNIX
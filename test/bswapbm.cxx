@@ -0,0 +1,104 @@
+// @(#)root/test:$Id$
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "snprintf.h"
+#include "TBufferFile.h"
+#include "TStopwatch.h"
+#include "ROOT/RByteSwap.hxx"
+//
+// This program benchmarks the kernels converting primitive arrays between
+// the host and the on-file byte order (see ROOT::Internal::ByteSwapCopy32
+// and friends), for every kernel set supported by the CPU, and the
+// TBufferFile array streaming built on top of them.
+//
+// Usage: bswapbm [nelements] [ntimes]
+//
+// parameters:
+//       nelements     - number of elements of the arrays (default 4096)
+//       ntimes        - number of conversions of each array (default 20000)
+//
+// The throughput is printed in MB/s of converted data.
+
+using ROOT::Internal::EByteSwapKernel;
+
+int nelements = 4096;
+int ntimes = 20000;
+
+//_____________________________________________________________
+
+template <typename F>
+void Measure(const char *what, std::size_t nbytes, F &&convert)
+{
+   TStopwatch timer;
+   timer.Start();
+   for (int i = 0; i < ntimes; ++i)
+      convert();
+   timer.Stop();
+   const Double_t mb = 1e-6 * nbytes * ntimes;
+   const Double_t rt = timer.RealTime();
+   char line[128];
+   snprintf(line, sizeof(line), "   %-28s %10.1f MB/s", what, rt > 0 ? mb / rt : 0.);
+   std::cout << line << std::endl;
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1 && !strcmp(argv[1], "-h")) {
+      std::cout << "Usage: bswapbm [nelements] [ntimes]" << std::endl;
+      return 0;
+   }
+   if (argc > 1)
+      nelements = atoi(argv[1]);
+   if (argc > 2)
+      ntimes = atoi(argv[2]);
+   if (nelements <= 0 || ntimes <= 0) {
+      std::cout << "nelements and ntimes must be positive" << std::endl;
+      return 1;
+   }
+
+   const std::size_t n = nelements;
+   std::vector<char> in(8 * n);
+   for (std::size_t i = 0; i < in.size(); ++i)
+      in[i] = char(i * 7 + 3);
+   std::vector<char> out(8 * n);
+   std::vector<Float_t> floats(n);
+   std::vector<Double_t> doubles(n);
+
+   // The same input, streamed with TBufferFile
+   TBufferFile wbuf(TBuffer::kWrite, 8 * n + 64);
+   wbuf.WriteFastArray(floats.data(), nelements);
+   TBufferFile wbufD(TBuffer::kWrite, 8 * n + 64);
+   wbufD.WriteFastArray(doubles.data(), nelements);
+
+   const auto defaultKernel = ROOT::Internal::GetByteSwapKernel();
+   const EByteSwapKernel kernels[] = {EByteSwapKernel::kScalar, EByteSwapKernel::kSSSE3, EByteSwapKernel::kAVX2,
+                                      EByteSwapKernel::kAVX512, EByteSwapKernel::kNEON};
+   for (auto kernel : kernels) {
+      if (!ROOT::Internal::SetByteSwapKernel(kernel))
+         continue;
+      std::cout << "Kernel " << ROOT::Internal::GetByteSwapKernelName(kernel)
+                << (kernel == defaultKernel ? " (default)" : "") << ", " << nelements << " elements" << std::endl;
+      Measure("ByteSwapCopy16", 2 * n, [&] { ROOT::Internal::ByteSwapCopy16(out.data(), in.data(), n); });
+      Measure("ByteSwapCopy32", 4 * n, [&] { ROOT::Internal::ByteSwapCopy32(out.data(), in.data(), n); });
+      Measure("ByteSwapCopy64", 8 * n, [&] { ROOT::Internal::ByteSwapCopy64(out.data(), in.data(), n); });
+      Measure("UnpackTruncatedFloats(F)", 3 * n,
+              [&] { ROOT::Internal::UnpackTruncatedFloats(floats.data(), in.data(), n, 12); });
+      Measure("UnpackTruncatedFloats(D)", 3 * n,
+              [&] { ROOT::Internal::UnpackTruncatedFloats(doubles.data(), in.data(), n, 12); });
+      Measure("TBufferFile::ReadFastArray(F)", 4 * n, [&] {
+         TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+         rbuf.ReadFastArray(floats.data(), nelements);
+      });
+      Measure("TBufferFile::ReadFastArray(D)", 8 * n, [&] {
+         TBufferFile rbuf(TBuffer::kRead, wbufD.Length(), wbufD.Buffer(), kFALSE);
+         rbuf.ReadFastArray(doubles.data(), nelements);
+      });
+   }
+   ROOT::Internal::SetByteSwapKernel(defaultKernel);
+   return 0;
+}
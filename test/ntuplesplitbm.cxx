@@ -0,0 +1,138 @@
+// @(#)root/test:$Id$
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "snprintf.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "ROOT/RColumnElement.hxx"
+#include "ROOT/RColumnModel.hxx"
+#include "ROOT/RNTupleZip.hxx"
+//
+// This program benchmarks the byte-split RNTuple column encodings against
+// the plain encodings (see ROOT::Experimental::EColumnType): the packing
+// and unpacking of pages, their compressed size, and the compression and
+// decompression speed, for typical floating point, integer and offset data.
+//
+// Usage: ntuplesplitbm [nelements] [ntimes] [compression]
+//
+// parameters:
+//       nelements     - number of elements of a page (default 8192)
+//       ntimes        - number of times each page is processed (default 2000)
+//       compression   - compression settings of the pages (default 505)
+//
+// The throughput is printed in MB/s of in-memory page data.
+
+using ROOT::Experimental::ClusterSize_t;
+using ROOT::Experimental::EColumnType;
+using ROOT::Experimental::Detail::RColumnElementBase;
+using ROOT::Experimental::Detail::RNTupleCompressor;
+using ROOT::Experimental::Detail::RNTupleDecompressor;
+
+int nelements = 8192;
+int ntimes = 2000;
+int compression = 505;
+
+//_____________________________________________________________
+
+template <typename F>
+void Measure(const char *what, std::size_t nbytes, F &&process)
+{
+   TStopwatch timer;
+   timer.Start();
+   for (int i = 0; i < ntimes; ++i)
+      process();
+   timer.Stop();
+   const Double_t mb = 1e-6 * nbytes * ntimes;
+   const Double_t rt = timer.RealTime();
+   char line[128];
+   snprintf(line, sizeof(line), "   %-28s %10.1f MB/s", what, rt > 0 ? mb / rt : 0.);
+   std::cout << line << std::endl;
+}
+
+//_____________________________________________________________
+
+template <typename T>
+void Compare(const char *name, const std::vector<T> &page, EColumnType plainType, EColumnType splitType)
+{
+   const std::size_t nbytes = page.size() * sizeof(T);
+   std::vector<T> input(page);
+   std::vector<T> output(page.size());
+   std::vector<unsigned char> packed(nbytes);
+   std::vector<unsigned char> zipped(nbytes);
+
+   std::cout << name << ", " << page.size() << " elements" << std::endl;
+   for (auto type : {plainType, splitType}) {
+      const bool isSplit = (type == splitType);
+      auto element = RColumnElementBase::Generate(type);
+      if (isSplit) {
+         Measure("Pack", nbytes, [&] { element->Pack(packed.data(), input.data(), page.size()); });
+         Measure("Unpack", nbytes, [&] { element->Unpack(output.data(), packed.data(), page.size()); });
+         if (memcmp(output.data(), page.data(), nbytes) != 0) {
+            std::cout << "   unpacked page differs from the input" << std::endl;
+            exit(1);
+         }
+      } else {
+         memcpy(packed.data(), input.data(), nbytes);
+      }
+
+      std::size_t szZip = 0;
+      Measure(isSplit ? "Zip (split)" : "Zip (plain)", nbytes,
+              [&] { szZip = RNTupleCompressor::Zip(packed.data(), nbytes, compression, zipped.data()); });
+      if (szZip < nbytes) {
+         Measure(isSplit ? "Unzip (split)" : "Unzip (plain)", nbytes,
+                 [&] { RNTupleDecompressor::Unzip(zipped.data(), szZip, nbytes, packed.data()); });
+      }
+      char line[128];
+      snprintf(line, sizeof(line), "   %-28s %10.3f",
+               isSplit ? "Compression factor (split)" : "Compression factor (plain)", Double_t(nbytes) / szZip);
+      std::cout << line << std::endl;
+   }
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1 && !strcmp(argv[1], "-h")) {
+      std::cout << "Usage: ntuplesplitbm [nelements] [ntimes] [compression]" << std::endl;
+      return 0;
+   }
+   if (argc > 1)
+      nelements = atoi(argv[1]);
+   if (argc > 2)
+      ntimes = atoi(argv[2]);
+   if (argc > 3)
+      compression = atoi(argv[3]);
+   if (nelements <= 0 || ntimes <= 0) {
+      std::cout << "nelements and ntimes must be positive" << std::endl;
+      return 1;
+   }
+
+   // Typical physics data: exponentially falling energies, angles, counters and the offsets of a collection with
+   // a small number of items per entry
+   TRandom3 rnd(42);
+   std::vector<double> energies(nelements);
+   std::vector<float> angles(nelements);
+   std::vector<std::int64_t> counters(nelements);
+   std::vector<ClusterSize_t> offsets(nelements);
+   std::uint32_t offset = 0;
+   for (int i = 0; i < nelements; ++i) {
+      energies[i] = rnd.Exp(10.);
+      angles[i] = rnd.Uniform(-3.14159, 3.14159);
+      counters[i] = 1000000 + rnd.Integer(1000);
+      offset += rnd.Integer(10);
+      offsets[i] = offset;
+   }
+
+   std::cout << "Compression settings " << compression << std::endl;
+   Compare("double", energies, EColumnType::kReal64, EColumnType::kSplitReal64);
+   Compare("float", angles, EColumnType::kReal32, EColumnType::kSplitReal32);
+   Compare("int64", counters, EColumnType::kInt64, EColumnType::kSplitInt64);
+   Compare("index", offsets, EColumnType::kIndex, EColumnType::kSplitIndex);
+   return 0;
+}
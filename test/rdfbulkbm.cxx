@@ -0,0 +1,111 @@
+// @(#)root/test:$Id$
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "snprintf.h"
+#include "TFile.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "ROOT/RDataFrame.hxx"
+//
+// This program benchmarks the bulk processing mode of RDataFrame (see
+// RDataFrame::SetBulkSize) against entry by entry processing, for a simple
+// analysis of numeric branches: a filter, a defined column, a histogram
+// and a sum.
+//
+// Usage: rdfbulkbm [nentries] [ntimes] [bulksize]
+//
+// parameters:
+//       nentries      - number of entries of the tree (default 2000000)
+//       ntimes        - number of event loops per configuration (default 5)
+//       bulksize      - number of entries per bulk (default 1024)
+//
+// The throughput is printed in millions of entries per second.
+
+int nentries = 2000000;
+int ntimes = 5;
+int bulksize = 1024;
+const char *filename = "rdfbulkbm.root";
+
+//_____________________________________________________________
+
+void MakeTree()
+{
+   TFile f(filename, "RECREATE");
+   TTree t("t", "t");
+   float pt = 0.f;
+   float eta = 0.f;
+   double weight = 0.;
+   int nhits = 0;
+   t.Branch("pt", &pt);
+   t.Branch("eta", &eta);
+   t.Branch("weight", &weight);
+   t.Branch("nhits", &nhits);
+   TRandom3 rnd(42);
+   for (int i = 0; i < nentries; ++i) {
+      pt = rnd.Exp(20.);
+      eta = rnd.Uniform(-5., 5.);
+      weight = rnd.Gaus(1., 0.1);
+      nhits = rnd.Poisson(12.);
+      t.Fill();
+   }
+   t.Write();
+}
+
+//_____________________________________________________________
+
+void Measure(const char *what, std::size_t bulkSize)
+{
+   ROOT::RDataFrame df("t", filename);
+   df.SetBulkSize(bulkSize);
+   auto sel = df.Filter([](float eta, int nhits) { return eta > -2.5f && eta < 2.5f && nhits > 8; }, {"eta", "nhits"})
+                 .Define("wpt", [](float pt, double w) { return pt * w; }, {"pt", "weight"});
+
+   TStopwatch timer;
+   timer.Start();
+   double sum = 0.;
+   for (int i = 0; i < ntimes; ++i) {
+      // each iteration books the actions again and runs a new event loop
+      auto h = sel.Histo1D<float>({"h", "pt", 100, 0., 200.}, "pt");
+      auto s = sel.Sum<double>("wpt");
+      sum = *s;
+   }
+   timer.Stop();
+   const Double_t rt = timer.RealTime();
+   char line[128];
+   snprintf(line, sizeof(line), "   %-28s %10.2f Mentries/s  (sum %.6g)", what,
+            rt > 0 ? 1e-6 * nentries * ntimes / rt : 0., sum);
+   std::cout << line << std::endl;
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1 && !strcmp(argv[1], "-h")) {
+      std::cout << "Usage: rdfbulkbm [nentries] [ntimes] [bulksize]" << std::endl;
+      return 0;
+   }
+   if (argc > 1)
+      nentries = atoi(argv[1]);
+   if (argc > 2)
+      ntimes = atoi(argv[2]);
+   if (argc > 3)
+      bulksize = atoi(argv[3]);
+   if (nentries <= 0 || ntimes <= 0 || bulksize <= 0) {
+      std::cout << "nentries, ntimes and bulksize must be positive" << std::endl;
+      return 1;
+   }
+
+   MakeTree();
+   std::cout << nentries << " entries" << std::endl;
+   Measure("Entry by entry", 1);
+   char what[64];
+   snprintf(what, sizeof(what), "Bulks of %d entries", bulksize);
+   Measure(what, bulksize);
+   gSystem->Unlink(filename);
+   return 0;
+}
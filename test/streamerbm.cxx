@@ -0,0 +1,94 @@
+// @(#)root/test:$Id$
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "snprintf.h"
+#include "TBufferFile.h"
+#include "TClonesArray.h"
+#include "TStopwatch.h"
+#include "TVirtualStreamerInfo.h"
+#include "Event.h"
+//
+// This program benchmarks the object-wise streaming of the Track objects
+// of the test Event (see Event.h) into and out of a TBufferFile, with the
+// generic streamer actions or with the compiled streamers (see
+// TVirtualStreamerInfo::SetCompiledStreamers).
+//
+// Usage: streamerbm [compiled] [ntracks] [ntimes]
+//
+// parameters:
+//       compiled      - 1 to use the compiled streamers (default 0)
+//       ntracks       - number of tracks of the event (default 600)
+//       ntimes        - number of times the tracks are streamed (default 2000)
+//
+// The throughput is printed in MB/s of streamed data. Run the program
+// twice, with and without compiled streamers, to compare them: the choice
+// is made once, when the TStreamerInfo of Track is compiled.
+
+int compiled = 0;
+int ntracks = 600;
+int ntimes = 2000;
+
+//_____________________________________________________________
+
+template <typename F>
+void Measure(const char *what, Long64_t nbytes, F &&stream)
+{
+   TStopwatch timer;
+   timer.Start();
+   for (int i = 0; i < ntimes; ++i)
+      stream();
+   timer.Stop();
+   const Double_t mb = 1e-6 * nbytes * ntimes;
+   const Double_t rt = timer.RealTime();
+   char line[128];
+   snprintf(line, sizeof(line), "   %-28s %10.1f MB/s", what, rt > 0 ? mb / rt : 0.);
+   std::cout << line << std::endl;
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1 && !strcmp(argv[1], "-h")) {
+      std::cout << "Usage: streamerbm [compiled] [ntracks] [ntimes]" << std::endl;
+      return 0;
+   }
+   if (argc > 1)
+      compiled = atoi(argv[1]);
+   if (argc > 2)
+      ntracks = atoi(argv[2]);
+   if (argc > 3)
+      ntimes = atoi(argv[3]);
+   if (ntracks <= 0 || ntimes <= 0) {
+      std::cout << "ntracks and ntimes must be positive" << std::endl;
+      return 1;
+   }
+
+   TVirtualStreamerInfo::SetCompiledStreamers(compiled != 0);
+
+   Event event;
+   event.Build(0, ntracks);
+   TClonesArray *tracks = event.GetTracks();
+   const Int_t n = tracks->GetEntriesFast();
+
+   TBufferFile wbuf(TBuffer::kWrite);
+   auto write = [&] {
+      wbuf.SetBufferOffset(0);
+      for (Int_t i = 0; i < n; ++i)
+         tracks->UncheckedAt(i)->Streamer(wbuf);
+   };
+   write(); // compiles the TStreamerInfo of Track
+   const Long64_t nbytes = wbuf.Length();
+
+   std::cout << (compiled ? "Compiled" : "Generic") << " streamers, " << n << " tracks, " << nbytes << " bytes"
+             << std::endl;
+   Measure("Track::Streamer (write)", nbytes, write);
+   Measure("Track::Streamer (read)", nbytes, [&] {
+      TBufferFile rbuf(TBuffer::kRead, nbytes, wbuf.Buffer(), kFALSE);
+      for (Int_t i = 0; i < n; ++i)
+         tracks->UncheckedAt(i)->Streamer(rbuf);
+   });
+   return 0;
+}
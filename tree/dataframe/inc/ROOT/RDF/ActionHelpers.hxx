@@ -25,6 +25,7 @@
 #include "ROOT/RVec.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
 #include "ROOT/RDF/RCutFlowReport.hxx"
+#include "ROOT/RDF/RMaskedEntryRange.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
@@ -57,6 +58,8 @@
 /// \cond HIDDEN_SYMBOLS
 
 namespace ROOT {
+class RDataFrame;
+
 namespace Detail {
 namespace RDF {
 template <typename Helper>
@@ -78,6 +81,13 @@ public:
    {
       throw std::logic_error("`GetMergeableValue` is not implemented for this type of action.");
    }
+
+   /// Overwrite the final result with the merge of the given RMergeableValues, produced by GetMergeableValue in
+   /// several processes, see RLoopManager::SetNProcesses. The values are merged into the first element.
+   virtual void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &)
+   {
+      throw std::logic_error("`SetMergedValue` is not implemented for this type of action.");
+   }
 };
 
 } // namespace RDF
@@ -92,6 +102,16 @@ using namespace ROOT::Detail::RDF;
 
 using Hist_t = ::TH1D;
 
+/// Merge the RMergeableValues holding values of type T into the first one and return the merged value
+template <typename T>
+const T &MergeAll(std::vector<std::unique_ptr<RMergeableValueBase>> &values)
+{
+   auto &out = static_cast<RMergeableValue<T> &>(*values[0]);
+   for (auto i = 1u; i < values.size(); ++i)
+      MergeValues(out, static_cast<const RMergeableValue<T> &>(*values[i]));
+   return out.GetValue();
+}
+
 /// The container type for each thread's partial result in an action helper
 // We have to avoid to instantiate std::vector<bool> as that makes it impossible to return a reference to one of
 // the thread-local results. In addition, a common definition for the type of the container makes it easy to swap
@@ -137,6 +157,7 @@ public:
    CountHelper(const CountHelper &) = delete;
    void InitTask(TTreeReader *, unsigned int) {}
    void Exec(unsigned int slot);
+   void ExecBulk(unsigned int slot, const RMaskedEntryRange &mask) { fCounts[slot] += mask.Count(); }
    void Initialize() { /* noop */}
    void Finalize();
 
@@ -146,8 +167,19 @@ public:
       return std::make_unique<RMergeableCount>(*fResultCount);
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) final
+   {
+      *fResultCount = MergeAll<ULong64_t>(values);
+   }
+
    ULong64_t &PartialUpdate(unsigned int slot);
 
+   CountHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ULong64_t> *>(newResult);
+      return CountHelper(result, fCounts.size());
+   }
+
    std::string GetActionName() { return "Count"; }
 };
 
@@ -256,6 +288,40 @@ public:
         "Cannot fill object if the type of the first column is a scalar and the one of the second a container.");
    }
 
+   /// Bulk counterpart of Exec for scalar columns, used in bulk mode
+   template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+   void ExecBulk(unsigned int slot, const RMaskedEntryRange &mask, const T *vs)
+   {
+      auto &thisBuf = fBuffers[slot];
+      auto thisMin = fMin[slot];
+      auto thisMax = fMax[slot];
+      const auto bulkSize = mask.Size();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i]) {
+            const BufEl_t v = vs[i];
+            thisMin = std::min(thisMin, v);
+            thisMax = std::max(thisMax, v);
+            thisBuf.emplace_back(v);
+         }
+      }
+      fMin[slot] = thisMin;
+      fMax[slot] = thisMax;
+   }
+
+   /// Bulk counterpart of Exec for weighted scalar columns, used in bulk mode
+   template <typename T, typename W,
+             typename std::enable_if<std::is_arithmetic<T>::value && std::is_arithmetic<W>::value, int>::type = 0>
+   void ExecBulk(unsigned int slot, const RMaskedEntryRange &mask, const T *vs, const W *ws)
+   {
+      auto &thisWBuf = fWBuffers[slot];
+      const auto bulkSize = mask.Size();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i])
+            thisWBuf.emplace_back(ws[i]);
+      }
+      ExecBulk(slot, mask, vs);
+   }
+
    Hist_t &PartialUpdate(unsigned int);
 
    void Initialize() { /* noop */}
@@ -268,6 +334,17 @@ public:
       return std::make_unique<RMergeableFill<Hist_t>>(*fResultHist);
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) final
+   {
+      *fResultHist = MergeAll<Hist_t>(values);
+   }
+
+   FillHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<Hist_t> *>(newResult);
+      return FillHelper(result, fNSlots);
+   }
+
    std::string GetActionName() { return "Fill"; }
 };
 
@@ -286,12 +363,16 @@ FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vec
 template <typename HIST = Hist_t>
 class FillParHelper : public RActionImpl<FillParHelper<HIST>> {
    std::vector<HIST *> fObjects;
+   /// Per-slot scratch buffers for the values and the weights of the selected entries of a bulk, see ExecBulk
+   std::vector<std::vector<double>> fBulkXs;
+   std::vector<std::vector<double>> fBulkWs;
 
 public:
    FillParHelper(FillParHelper &&) = default;
    FillParHelper(const FillParHelper &) = delete;
 
-   FillParHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots) : fObjects(nSlots, nullptr)
+   FillParHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fObjects(nSlots, nullptr), fBulkXs(nSlots), fBulkWs(nSlots)
    {
       fObjects[0] = h.get();
       // Initialise all other slots
@@ -325,6 +406,43 @@ public:
       fObjects[slot]->Fill(x0, x1, x2, x3);
    }
 
+   /// Bulk counterpart of Exec for 1D histograms, used in bulk mode: the values of the selected entries are gathered
+   /// in a contiguous buffer and the histogram is filled with a single TH1::FillN call
+   template <typename X0, typename H = HIST,
+             typename std::enable_if<std::is_same<H, ::TH1D>::value && std::is_arithmetic<X0>::value, int>::type = 0>
+   void ExecBulk(unsigned int slot, const RMaskedEntryRange &mask, const X0 *x0s)
+   {
+      auto &xs = fBulkXs[slot];
+      xs.clear();
+      const auto bulkSize = mask.Size();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i])
+            xs.emplace_back(x0s[i]);
+      }
+      fObjects[slot]->FillN(xs.size(), xs.data(), nullptr);
+   }
+
+   /// Bulk counterpart of Exec for weighted 1D histograms, used in bulk mode
+   template <typename X0, typename W, typename H = HIST,
+             typename std::enable_if<std::is_same<H, ::TH1D>::value && std::is_arithmetic<X0>::value &&
+                                        std::is_arithmetic<W>::value,
+                                     int>::type = 0>
+   void ExecBulk(unsigned int slot, const RMaskedEntryRange &mask, const X0 *x0s, const W *ws)
+   {
+      auto &xs = fBulkXs[slot];
+      auto &weights = fBulkWs[slot];
+      xs.clear();
+      weights.clear();
+      const auto bulkSize = mask.Size();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i]) {
+            xs.emplace_back(x0s[i]);
+            weights.emplace_back(ws[i]);
+         }
+      }
+      fObjects[slot]->FillN(xs.size(), xs.data(), weights.data());
+   }
+
    template <typename X0, typename std::enable_if<IsDataContainer<X0>::value || std::is_same<X0, std::string>::value, int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s)
    {
@@ -466,6 +584,17 @@ public:
       return std::make_unique<RMergeableFill<HIST>>(*fObjects[0]);
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) final
+   {
+      *fObjects[0] = MergeAll<HIST>(values);
+   }
+
+   FillParHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<HIST> *>(newResult);
+      return FillParHelper(result, fObjects.size());
+   }
+
    std::string GetActionName() { return "FillPar"; }
 };
 
@@ -535,6 +664,17 @@ public:
       return std::make_unique<RMergeableFill<Result_t>>(*fGraphs[0]);
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) final
+   {
+      *fGraphs[0] = MergeAll<Result_t>(values);
+   }
+
+   FillTGraphHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<::TGraph> *>(newResult);
+      return FillTGraphHelper(result, fGraphs.size());
+   }
+
    std::string GetActionName() { return "Graph"; }
 
    Result_t &PartialUpdate(unsigned int slot) { return *fGraphs[slot]; }
@@ -596,6 +736,12 @@ public:
 
    COLL &PartialUpdate(unsigned int slot) { return *fColls[slot].get(); }
 
+   TakeHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<COLL> *>(newResult);
+      return TakeHelper(result, fColls.size());
+   }
+
    std::string GetActionName() { return "Take"; }
 };
 
@@ -641,6 +787,12 @@ public:
 
    std::vector<T> &PartialUpdate(unsigned int slot) { return *fColls[slot]; }
 
+   TakeHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<std::vector<T>> *>(newResult);
+      return TakeHelper(result, fColls.size());
+   }
+
    std::string GetActionName() { return "Take"; }
 };
 
@@ -678,6 +830,12 @@ public:
       }
    }
 
+   TakeHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<COLL> *>(newResult);
+      return TakeHelper(result, fColls.size());
+   }
+
    std::string GetActionName() { return "Take"; }
 };
 
@@ -723,6 +881,12 @@ public:
       }
    }
 
+   TakeHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<std::vector<std::vector<RealT_t>>> *>(newResult);
+      return TakeHelper(result, fColls.size());
+   }
+
    std::string GetActionName() { return "Take"; }
 };
 
@@ -790,8 +954,19 @@ public:
       return std::make_unique<RMergeableMin<ResultType>>(*fResultMin);
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) final
+   {
+      *fResultMin = MergeAll<ResultType>(values);
+   }
+
    ResultType &PartialUpdate(unsigned int slot) { return fMins[slot]; }
 
+   MinHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ResultType> *>(newResult);
+      return MinHelper(result, fMins.size());
+   }
+
    std::string GetActionName() { return "Min"; }
 };
 
@@ -841,8 +1016,19 @@ public:
       return std::make_unique<RMergeableMax<ResultType>>(*fResultMax);
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) final
+   {
+      *fResultMax = MergeAll<ResultType>(values);
+   }
+
    ResultType &PartialUpdate(unsigned int slot) { return fMaxs[slot]; }
 
+   MaxHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ResultType> *>(newResult);
+      return MaxHelper(result, fMaxs.size());
+   }
+
    std::string GetActionName() { return "Max"; }
 };
 
@@ -884,6 +1070,21 @@ public:
    void InitTask(TTreeReader *, unsigned int) {}
    void Exec(unsigned int slot, ResultType v) { fSums[slot] += v; }
 
+   /// Bulk counterpart of Exec for scalar columns, used in bulk mode. Entries are summed in the same order as by
+   /// Exec, so results are identical.
+   template <typename T, typename R = ResultType,
+             typename std::enable_if<std::is_arithmetic<T>::value && std::is_arithmetic<R>::value, int>::type = 0>
+   void ExecBulk(unsigned int slot, const RMaskedEntryRange &mask, const T *vs)
+   {
+      auto sum = fSums[slot];
+      const auto bulkSize = mask.Size();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i])
+            sum += static_cast<ResultType>(vs[i]);
+      }
+      fSums[slot] = sum;
+   }
+
    template <typename T, typename std::enable_if<IsDataContainer<T>::value, int>::type = 0>
    void Exec(unsigned int slot, const T &vs)
    {
@@ -905,8 +1106,19 @@ public:
       return std::make_unique<RMergeableSum<ResultType>>(*fResultSum);
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) final
+   {
+      *fResultSum = MergeAll<ResultType>(values);
+   }
+
    ResultType &PartialUpdate(unsigned int slot) { return fSums[slot]; }
 
+   SumHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ResultType> *>(newResult);
+      return SumHelper(result, fSums.size());
+   }
+
    std::string GetActionName() { return "Sum"; }
 };
 
@@ -943,8 +1155,19 @@ public:
       return std::make_unique<RMergeableMean>(*fResultMean, counts);
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) final
+   {
+      *fResultMean = MergeAll<Double_t>(values);
+   }
+
    double &PartialUpdate(unsigned int slot);
 
+   MeanHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<double> *>(newResult);
+      return MeanHelper(result, fCounts.size());
+   }
+
    std::string GetActionName() { return "Mean"; }
 };
 
@@ -993,6 +1216,17 @@ public:
       return std::make_unique<RMergeableStdDev>(*fResultStdDev, counts, mean);
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) final
+   {
+      *fResultStdDev = MergeAll<Double_t>(values);
+   }
+
+   StdDevHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<double> *>(newResult);
+      return StdDevHelper(result, fNSlots);
+   }
+
    std::string GetActionName() { return "StdDev"; }
 };
 
@@ -1533,6 +1767,54 @@ public:
    std::string GetActionName() { return "Snapshot"; }
 };
 
+/// The writer of the RNTuple produced by a SnapshotHelperRNTuple. The column values are passed as type-erased
+/// addresses, so that the RNTuple classes are only needed by the implementation, see MakeSnapshotNTupleSink.
+class RSnapshotNTupleSink {
+public:
+   virtual ~RSnapshotNTupleSink() = default;
+   /// Create the output file and the RNTuple
+   virtual void Initialize() = 0;
+   /// Write one entry, given the addresses of the values of all the columns
+   virtual void Fill(unsigned int slot, void *const *values) = 0;
+   /// Commit the data written by all slots and close the output file
+   virtual void Finalize() = 0;
+   /// The RDataFrame that reads the output RNTuple. It is valid after Finalize.
+   virtual std::shared_ptr<ROOT::RDataFrame> GetSnapshotRDF() = 0;
+};
+
+/// Create the writer of the RNTuple produced by a Snapshot action. If nSlots is larger than one, the slots fill
+/// their own clusters concurrently. Throws if the column types or the options are not supported.
+std::shared_ptr<RSnapshotNTupleSink>
+MakeSnapshotNTupleSink(unsigned int nSlots, const std::string &fileName, const std::string &dirName,
+                       const std::string &ntupleName, const ColumnNames_t &fieldNames,
+                       const std::vector<std::string> &typeNames, const RSnapshotOptions &options);
+
+/// Helper object for a Snapshot action that writes an RNTuple, both single- and multi-thread
+template <typename... ColTypes>
+class SnapshotHelperRNTuple : public RActionImpl<SnapshotHelperRNTuple<ColTypes...>> {
+   std::shared_ptr<RSnapshotNTupleSink> fSink;
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   SnapshotHelperRNTuple(const std::shared_ptr<RSnapshotNTupleSink> &sink) : fSink(sink) {}
+   SnapshotHelperRNTuple(const SnapshotHelperRNTuple &) = delete;
+   SnapshotHelperRNTuple(SnapshotHelperRNTuple &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, ColTypes &... values)
+   {
+      void *const addresses[] = {&values...};
+      fSink->Fill(slot, addresses);
+   }
+
+   void Initialize() { fSink->Initialize(); }
+
+   void Finalize() { fSink->Finalize(); }
+
+   std::string GetActionName() { return "Snapshot"; }
+};
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class AggregateHelper : public RActionImpl<AggregateHelper<Acc, Merge, R, T, U, MustCopyAssign>> {
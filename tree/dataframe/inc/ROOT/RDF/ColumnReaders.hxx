@@ -12,6 +12,8 @@
 #define ROOT_RDF_COLUMNREADERS
 
 #include <ROOT/RDF/RDefineBase.hxx>
+#include <ROOT/RDF/RMaskedEntryRange.hxx>
+#include <ROOT/RDF/Utils.hxx> // TypeID2TypeName
 #include <ROOT/RMakeUnique.hxx>
 #include <ROOT/RVec.hxx>
 #include <ROOT/TypeTraits.hxx>
@@ -20,14 +22,20 @@
 #include <TTreeReaderArray.h>
 
 #include <cassert>
+#include <cstddef> // std::size_t
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <typeinfo>
 #include <vector>
 
+class TBranch;
+class TBufferFile;
+
 namespace ROOT {
 namespace Internal {
 namespace RDF {
@@ -37,6 +45,56 @@ namespace RDFDetail = ROOT::Detail::RDF;
 
 void CheckDefine(RDFDetail::RDefineBase &define, const std::type_info &tid);
 
+/**
+\class ROOT::Internal::RDF::RBulkBranchReader
+\ingroup dataframe
+\brief Reads the values of a TTree branch of fundamental type basket by basket, with TBranch::GetBulkEntries.
+
+Used by RTreeColumnReader in bulk mode to load the values of consecutive entries in one go, bypassing TTreeReader.
+**/
+class RBulkBranchReader {
+   TBranch *fBranch = nullptr;
+   /// The deserialized values of the last basket read
+   std::unique_ptr<TBufferFile> fBuffer;
+   Long64_t fBasketFirstEntry = 0;
+   Long64_t fNBasketEntries = 0;
+   std::size_t fValueSize = 0;
+
+public:
+   RBulkBranchReader();
+   ~RBulkBranchReader();
+   bool Init(TTree &tree, const char *branchName, const std::type_info &valueType);
+   void Read(Long64_t firstEntry, std::size_t nEntries, void *values);
+};
+
+/**
+\class ROOT::Internal::RDF::RColumnReaderBulkLoader
+\ingroup dataframe
+\brief Type-erased interface used by the RLoopManager to fill the bulk buffers of column readers in bulk mode.
+
+In bulk mode, the loop manager reads entries one by one as usual but it only runs the computation graph once per bulk
+of entries. At the beginning of a bulk, it asks the column readers that support it to load the values of a range of
+consecutive entries in one go (LoadBulkRange), e.g. basket by basket with TBranch::GetBulkEntries or directly from the
+pages of a data source. The other column readers store the value of each entry in a contiguous buffer as the entries
+are read (LoadBulkEntry). The nodes then access the values via RColumnReaderBase::GetBulk.
+**/
+class RColumnReaderBulkLoader {
+public:
+   virtual ~RColumnReaderBulkLoader() = default;
+   /// Allocate the buffer for the values of a bulk of entries. Called at the beginning of a processing task.
+   virtual void AllocateBulk(std::size_t capacity) = 0;
+   /// Store the value of the current entry at position idx of the bulk buffer.
+   virtual void LoadBulkEntry(std::size_t idx, Long64_t entry) = 0;
+   /// Prepare the reader to load ranges of entries of the given tree, or of the data source if tree is null.
+   /// Return false if the values can only be loaded one entry at a time with LoadBulkEntry.
+   virtual bool InitBulkRange(TTree * /*tree*/) { return false; }
+   /// Load the values of nEntries consecutive entries, where firstEntry is the current entry of the tree (local to
+   /// the tree for chains) or of the data source. Only called if InitBulkRange returned true.
+   virtual void LoadBulkRange(Long64_t /*firstEntry*/, std::size_t /*nEntries*/) {}
+   /// Return the name of the branch read through the TTreeReader of the task, null if the reader does not read one.
+   virtual const char *GetTreeBranchName() const { return nullptr; }
+};
+
 /**
 \class ROOT::Internal::RDF::RColumnReaderBase
 \ingroup dataframe
@@ -47,13 +105,52 @@ This pure virtual class provides a common base class for the different column re
 RDSColumnReader.
 **/
 template <typename T>
-class RColumnReaderBase {
+class RColumnReaderBase : public RColumnReaderBulkLoader {
+   /// Bulk processing requires to store the values of several entries in a contiguous buffer
+   using IsBulkCapable_t =
+      std::integral_constant<bool, std::is_default_constructible<T>::value && std::is_copy_assignable<T>::value>;
+
+   /// The values of the entries of the current bulk, see RLoopManager::SetBulkSize
+   std::unique_ptr<T[]> fBulkValues;
+   /// The values returned by GetBulk: either fBulkValues or memory of the data source, see LoadBulkRange
+   T *fBulkPtr = nullptr;
+
+   void AllocateBulkImpl(std::size_t capacity, std::true_type) { fBulkValues.reset(new T[capacity]); }
+
+   void AllocateBulkImpl(std::size_t, std::false_type)
+   {
+      throw std::runtime_error("Bulk processing requires that all column types are default-constructible and "
+                               "copy-assignable, but column type " +
+                               TypeID2TypeName(typeid(T)) + " is not.");
+   }
+
+   void LoadBulkEntryImpl(std::size_t idx, Long64_t entry, std::true_type)
+   {
+      fBulkValues[idx] = Get(entry);
+      fBulkPtr = fBulkValues.get();
+   }
+
+   void LoadBulkEntryImpl(std::size_t, Long64_t, std::false_type) {}
+
+protected:
+   /// The buffer in which LoadBulkRange implementations store the values of the bulk
+   T *GetBulkBuffer() { return fBulkValues.get(); }
+   /// Make GetBulk return the given values, which must stay valid until the bulk has been processed
+   void SetBulkValues(T *values) { fBulkPtr = values; }
+
 public:
    virtual ~RColumnReaderBase() = default;
    /// Return the column value for the given entry. Called at most once per entry.
    virtual T &Get(Long64_t entry) = 0;
    /// Perform clean-up operations if needed. Called at the end of a processing task.
    virtual void Reset() {}
+
+   void AllocateBulk(std::size_t capacity) override { AllocateBulkImpl(capacity, IsBulkCapable_t{}); }
+   void LoadBulkEntry(std::size_t idx, Long64_t entry) override { LoadBulkEntryImpl(idx, entry, IsBulkCapable_t{}); }
+   /// Return the values of the column for the entries of the bulk. Only values of selected entries are valid.
+   virtual T *GetBulk(const RMaskedEntryRange &) { return fBulkPtr; }
+   /// Add the readers that must be loaded by the RLoopManager in bulk mode for this reader to work.
+   virtual void CollectBulkLoaders(std::vector<RColumnReaderBulkLoader *> &loaders) { loaders.emplace_back(this); }
 };
 
 /// Column reader for defined (aka custom) columns.
@@ -79,12 +176,40 @@ public:
       fDefine.Update(fSlot, entry);
       return *fCustomValuePtr;
    }
+
+   // The values of defined columns are computed by the RDefine node, on demand and only for the selected entries
+   void AllocateBulk(std::size_t) final {}
+   void LoadBulkEntry(std::size_t, Long64_t) final {}
+
+   T *GetBulk(const RMaskedEntryRange &mask) final
+   {
+      fDefine.UpdateBulk(fSlot, mask);
+      return static_cast<T *>(fDefine.GetBulkValuePtr(fSlot));
+   }
+
+   void CollectBulkLoaders(std::vector<RColumnReaderBulkLoader *> &loaders) final
+   {
+      fDefine.CollectBulkLoaders(fSlot, loaders);
+   }
 };
 
 /// RTreeColumnReader specialization for TTree values read via TTreeReaderValues
 template <typename T>
 class R__CLING_PTRCHECK(off) RTreeColumnReader final : public RColumnReaderBase<T> {
    std::unique_ptr<TTreeReaderValue<T>> fTreeValue;
+   /// Reads the branch in bulk mode, for columns of fundamental type
+   std::unique_ptr<RBulkBranchReader> fBulkBranchReader;
+
+   bool InitBulkRangeImpl(TTree *tree, std::true_type)
+   {
+      if (!tree)
+         return false;
+      if (!fBulkBranchReader)
+         fBulkBranchReader = std::make_unique<RBulkBranchReader>();
+      return fBulkBranchReader->Init(*tree, fTreeValue->GetBranchName(), typeid(T));
+   }
+
+   bool InitBulkRangeImpl(TTree *, std::false_type) { return false; }
 
 public:
    /// Construct the RTreeColumnReader. Actual initialization is performed lazily by the Init method.
@@ -95,6 +220,17 @@ public:
 
    T &Get(Long64_t) final { return **fTreeValue; }
 
+   bool InitBulkRange(TTree *tree) final { return InitBulkRangeImpl(tree, std::is_arithmetic<T>{}); }
+
+   /// Read the values directly from the baskets of the branch, instead of going through TTreeReaderValue::Get.
+   void LoadBulkRange(Long64_t firstEntry, std::size_t nEntries) final
+   {
+      fBulkBranchReader->Read(firstEntry, nEntries, this->GetBulkBuffer());
+      this->SetBulkValues(this->GetBulkBuffer());
+   }
+
+   const char *GetTreeBranchName() const final { return fTreeValue->GetBranchName(); }
+
    /// Delete the TTreeReaderValue object.
    //
    // Without this call, a race condition is present in which a TTreeReader
@@ -103,7 +239,11 @@ public:
    // - Thread #2) a task starts and overwrites thread-local TTreeReaderValues
    // - Thread #1) first task deletes TTreeReader
    // See https://github.com/root-project/root/commit/26e8ace6e47de6794ac9ec770c3bbff9b7f2e945
-   void Reset() final { fTreeValue.reset(); }
+   void Reset() final
+   {
+      fTreeValue.reset();
+      fBulkBranchReader.reset();
+   }
 };
 
 /// RTreeColumnReader specialization for TTree values read via TTreeReaderArrays.
@@ -189,6 +329,8 @@ public:
       return fRVec;
    }
 
+   const char *GetTreeBranchName() const final { return fTreeArray->GetBranchName(); }
+
    /// Delete the TTreeReaderArray object.
    void Reset() final { fTreeArray.reset(); }
 };
@@ -230,6 +372,8 @@ public:
       return fRVec;
    }
 
+   const char *GetTreeBranchName() const final { return fTreeArray->GetBranchName(); }
+
    /// Delete the TTreeReaderArray object.
    void Reset() final { fTreeArray.reset(); }
 };
@@ -243,6 +387,11 @@ public:
    RDSColumnReader(void * DSValuePtr) : fDSValuePtr(static_cast<T **>(DSValuePtr)) {}
 
    T &Get(Long64_t) final { return **fDSValuePtr; }
+
+   bool InitBulkRange(TTree *tree) final { return tree == nullptr; }
+
+   /// The data source guarantees that the values of the range are contiguous, see RDataSource::GetNContiguousEntries
+   void LoadBulkRange(Long64_t, std::size_t) final { this->SetBulkValues(*fDSValuePtr); }
 };
 
 template <typename ColTypeList>
@@ -335,6 +484,17 @@ void ResetColumnReaders(ValueTuple &values, std::index_sequence<S...>)
    (void)expander; // avoid "unused variable" warnings
 }
 
+/// Collect the readers that the RLoopManager must load in bulk mode for a tuple of column readers to work
+template <typename ValueTuple, std::size_t... S>
+void CollectBulkLoaders(ValueTuple &values, std::vector<RColumnReaderBulkLoader *> &loaders,
+                        std::index_sequence<S...>)
+{
+   // hack to expand a parameter pack without c++17 fold expressions.
+   int expander[] = {(std::get<S>(values)->CollectBulkLoaders(loaders), 0)..., 0};
+   (void)expander; // avoid "unused variable" warnings
+   (void)loaders;  // avoid "unused variable" warnings for nodes without input columns
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
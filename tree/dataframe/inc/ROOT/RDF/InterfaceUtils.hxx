@@ -18,6 +18,7 @@
 #include <ROOT/RDF/RFilter.hxx>
 #include <ROOT/RDF/Utils.hxx>
 #include <ROOT/RIntegerSequence.hxx>
+#include <ROOT/RDF/RJitCache.hxx>
 #include <ROOT/RDF/RJittedAction.hxx>
 #include <ROOT/RDF/RJittedDefine.hxx>
 #include <ROOT/RDF/RJittedFilter.hxx>
@@ -75,6 +76,9 @@ HeadNode_t CreateSnapshotRDF(const ColumnNames_t &validCols,
                             RLoopManager &loopManager,
                             std::unique_ptr<RDFInternal::RActionBase> actionPtr);
 
+HeadNode_t CreateSnapshotRDF(const std::shared_ptr<ROOT::RDataFrame> &snapshotRDF, bool isLazy,
+                             RLoopManager &loopManager, std::unique_ptr<RDFInternal::RActionBase> actionPtr);
+
 std::string DemangleTypeIdName(const std::type_info &typeInfo);
 
 ColumnNames_t ConvertRegexToColumns(const RDFInternal::RBookedDefines &defines, TTree *tree,
@@ -259,7 +263,7 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
                                                    const ColumnNames_t &branches,
                                                    std::shared_ptr<RNodeBase> *prevNodeOnHeap);
 
-std::string JitBuildAction(const ColumnNames_t &bl, std::shared_ptr<RDFDetail::RNodeBase> *prevNode,
+RJitSnippet JitBuildAction(const ColumnNames_t &bl, std::shared_ptr<RDFDetail::RNodeBase> *prevNode,
                            const std::type_info &art, const std::type_info &at, void *rOnHeap, TTree *tree,
                            const unsigned int nSlots, const RDFInternal::RBookedDefines &defines,
                            RDataSource *ds, std::weak_ptr<RJittedAction> *jittedActionOnHeap);
@@ -19,7 +19,9 @@
 
 #include <cstddef> // std::size_t
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace ROOT {
@@ -101,6 +103,9 @@ class SnapshotHelper;
 template <typename... ColTypes>
 class SnapshotHelperMT;
 
+template <typename... ColTypes>
+class SnapshotHelperRNTuple;
+
 namespace RDFDetail = ROOT::Detail::RDF;
 namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 
@@ -115,6 +120,9 @@ inline constexpr bool IsSnapshotHelper(SnapshotHelper<ColTypes...> *) { return t
 template <typename... ColTypes>
 inline constexpr bool IsSnapshotHelper(SnapshotHelperMT<ColTypes...> *) { return true; }
 
+template <typename... ColTypes>
+inline constexpr bool IsSnapshotHelper(SnapshotHelperRNTuple<ColTypes...> *) { return true; }
+
 template <typename T>
 inline constexpr bool IsSnapshotHelper(T *) { return false; }
 
@@ -144,7 +152,44 @@ struct ActionImpl {
       CallExec(slot, entry, helper, values, TypeInd_t{});
    }
 
+   // this overload is SFINAE'd out if Helper does not implement a suitable `ExecBulk`
+   // the template parameter H is required to defer the check to SFINAE time
+   template <typename H, std::size_t... S>
+   static auto CallExecBulk(unsigned int slot, const RMaskedEntryRange &mask, H &helper, Values_t &values,
+                            std::index_sequence<S...>, int)
+      -> decltype(helper.ExecBulk(slot, mask, std::get<S>(values)->GetBulk(mask)...), void())
+   {
+      helper.ExecBulk(slot, mask, std::get<S>(values)->GetBulk(mask)...);
+      (void)values; // avoid bogus unused parameter warnings
+   }
+
+   // fallback: call Exec for each selected entry, with values taken from the bulk buffers
+   template <typename H, std::size_t... S>
+   static void CallExecBulk(unsigned int slot, const RMaskedEntryRange &mask, H &helper, Values_t &values,
+                            std::index_sequence<S...>, long)
+   {
+      auto columns = std::make_tuple(std::get<S>(values)->GetBulk(mask)...);
+      (void)columns; // avoid bogus unused variable warnings for actions without input columns
+      const auto bulkSize = mask.Size();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i])
+            helper.Exec(slot, std::get<S>(columns)[i]...);
+      }
+   }
+
+   static void ExecBulk(unsigned int slot, const RMaskedEntryRange &mask, Helper &helper, Values_t &values)
+   {
+      CallExecBulk(slot, mask, helper, values, TypeInd_t{}, 0);
+   }
+
+   static void CollectBulkLoaders(Values_t &values, std::vector<RColumnReaderBulkLoader *> &loaders)
+   {
+      RDFInternal::CollectBulkLoaders(values, loaders, TypeInd_t{});
+   }
+
    static void ResetColumnReaders(Values_t &values) { RDFInternal::ResetColumnReaders(values, TypeInd_t{}); }
+
+   static constexpr bool kSupportsBulk = true;
 };
 
 template <typename Helper, typename ColumnTypes>
@@ -174,7 +219,18 @@ struct ActionImpl<Helper, ColumnTypes, true> {
       CallExec(slot, entry, helper, values, TypeInd_t{}, ColumnTypes{});
    }
 
+   // Snapshot writes entries one by one, so it does not support bulk processing: the RLoopManager falls back to
+   // processing entries one by one whenever a Snapshot is booked
+   static void ExecBulk(unsigned int, const RMaskedEntryRange &, Helper &, Values_t &)
+   {
+      throw std::logic_error("Snapshot does not support bulk processing.");
+   }
+
+   static void CollectBulkLoaders(Values_t &, std::vector<RColumnReaderBulkLoader *> &) {}
+
    static void ResetColumnReaders(Values_t &values) { RDFInternal::ResetColumnReaders(values, ColumnTypes{}); }
+
+   static constexpr bool kSupportsBulk = false;
 };
 
 // clang-format off
@@ -210,6 +266,7 @@ public:
       const auto &customCols = GetDefines();
       for (auto i = 0u; i < nColumns; ++i)
          fIsDefine[i] = customCols.HasName(columns[i]);
+      fVariations = RDFInternal::Union(fPrevData.GetVariations(), customCols.GetVariationDeps(columns));
    }
 
    RAction(const RAction &) = delete;
@@ -227,6 +284,13 @@ public:
       return fHelper.GetMergeableValue();
    }
 
+   void SetMergedValue(std::vector<std::unique_ptr<RDFDetail::RMergeableValueBase>> &values) final
+   {
+      fHelper.SetMergedValue(values);
+   }
+
+   std::string GetActionName() final { return fHelper.GetActionName(); }
+
    void Initialize() final { fHelper.Initialize(); }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final
@@ -241,8 +305,24 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
+      if (fPrevData.CheckFilters(slot, entry)) {
+         RNodeTimer timer(fTiming, slot);
          ActionImpl_t::Exec(slot, entry, fHelper, fValues[slot]);
+      }
+   }
+
+   void RunBulk(unsigned int slot, const RMaskedEntryRange &bulk) final
+   {
+      const auto &mask = fPrevData.CheckFiltersBulk(slot, bulk);
+      RNodeTimer timer(fTiming, slot);
+      ActionImpl_t::ExecBulk(slot, mask, fHelper, fValues[slot]);
+   }
+
+   bool SupportsBulk() const final { return ActionImpl_t::kSupportsBulk; }
+
+   void CollectBulkLoaders(unsigned int slot, std::vector<RColumnReaderBulkLoader *> &loaders) final
+   {
+      ActionImpl_t::CollectBulkLoaders(fValues[slot], loaders);
    }
 
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
@@ -295,7 +375,29 @@ public:
    /// user-defined callback registered via RResultPtr::RegisterCallback
    void *PartialUpdate(unsigned int slot) final { return PartialUpdateImpl(slot); }
 
+   std::unique_ptr<RActionBase>
+   MakeVariedAction(const std::string &variationName, unsigned int tagIdx, void *newResult) final
+   {
+      return MakeVariedActionImpl(variationName, tagIdx, newResult);
+   }
+
 private:
+   // this overload is SFINAE'd out if Helper does not implement `MakeNew`
+   template <typename H = Helper>
+   auto MakeVariedActionImpl(const std::string &variationName, unsigned int tagIdx, void *newResult)
+      -> decltype(std::declval<H>().MakeNew(newResult), std::unique_ptr<RActionBase>())
+   {
+      return std::make_unique<RAction>(fHelper.MakeNew(newResult), GetColumnNames(),
+                                       GetVariedPrevNode(fPrevDataPtr, variationName, tagIdx),
+                                       GetDefines().GetVaried(variationName, tagIdx));
+   }
+
+   // this one is always available but has lower precedence thanks to `...`
+   std::unique_ptr<RActionBase> MakeVariedActionImpl(const std::string &, unsigned int, ...)
+   {
+      throw std::logic_error("The " + fHelper.GetActionName() + " action does not support systematic variations.");
+   }
+
    // this overload is SFINAE'd out if Helper does not implement `PartialUpdate`
    // the template parameter is required to defer instantiation of the method to SFINAE time
    template <typename H = Helper>
@@ -12,11 +12,13 @@
 #define ROOT_RACTIONBASE
 
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RTimingReport.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ROOT {
 
@@ -34,6 +36,9 @@ namespace GraphDrawing {
 class GraphNode;
 }
 
+class RColumnReaderBulkLoader;
+class RMaskedEntryRange;
+
 using namespace ROOT::Detail::RDF;
 
 class RActionBase {
@@ -41,6 +46,10 @@ protected:
    /// A raw pointer to the RLoopManager at the root of this functional graph.
    /// Never null: children nodes have shared ownership of parent nodes in the graph.
    RLoopManager *fLoopManager;
+   /// The sorted names of the systematic variations that affect the inputs of this action, see RInterface::Vary
+   std::vector<std::string> fVariations;
+   /// Where to record the time spent in this action, see RLoopManager::SetTimingEnabled
+   RNodeTimingHandle fTiming;
 
 private:
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
@@ -60,6 +69,12 @@ public:
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
+   /// Bulk counterpart of Run: process the entries of the bulk that pass the upstream filters.
+   virtual void RunBulk(unsigned int slot, const RMaskedEntryRange &bulk) = 0;
+   /// Whether this action can be run in bulk mode, see RLoopManager::SetBulkSize
+   virtual bool SupportsBulk() const = 0;
+   /// Add the column readers that the RLoopManager must load in bulk mode for this action to run.
+   virtual void CollectBulkLoaders(unsigned int slot, std::vector<RColumnReaderBulkLoader *> &loaders) = 0;
    virtual void Initialize() = 0;
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
@@ -73,6 +88,8 @@ public:
    // overridden by RJittedAction
    virtual bool HasRun() const { return fHasRun; }
    virtual void SetHasRun() { fHasRun = true; }
+   virtual void SetTimingHandle(const RNodeTimingHandle &handle) { fTiming = handle; }
+   virtual std::string GetActionName() = 0;
 
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
 
@@ -81,6 +98,20 @@ public:
       with others of the same type.
    */
    virtual std::unique_ptr<RMergeableValueBase> GetMergeableValue() const = 0;
+   /// Overwrite the result with the merge of the RMergeableValues of this action produced in several processes.
+   virtual void SetMergedValue(std::vector<std::unique_ptr<RMergeableValueBase>> &values) = 0;
+
+   // overridden by RJittedAction
+   virtual const std::vector<std::string> &GetVariations() const { return fVariations; }
+   virtual const std::vector<std::string> &GetVariationTags(const std::string &variationName) const
+   {
+      return fDefines.GetVariations().at(variationName).fTags;
+   }
+
+   /// Create an action of the same type that fills a new result from the given variation tag of its inputs.
+   /// `newResult` points to a shared_ptr to an object of the same type as the result of this action.
+   virtual std::unique_ptr<RActionBase>
+   MakeVariedAction(const std::string &variationName, unsigned int tagIdx, void *newResult) = 0;
 };
 } // namespace RDF
 } // namespace Internal
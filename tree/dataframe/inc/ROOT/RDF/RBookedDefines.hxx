@@ -30,6 +30,20 @@ namespace RDF {
 
 namespace RDFDetail = ROOT::Detail::RDF;
 
+/**
+ * \struct ROOT::Internal::RDF::RVariationInfo
+ * \ingroup dataframe
+ * \brief The alternative values of a column, as registered by RInterface::Vary
+ */
+struct RVariationInfo {
+   /// The name of the varied column
+   std::string fColumnName;
+   /// The names of the alternative values, e.g. "up" and "down"
+   std::vector<std::string> fTags;
+   /// For each tag, the node that computes the corresponding value of the column
+   std::vector<std::shared_ptr<RDFDetail::RDefineBase>> fVariedColumns;
+};
+
 /**
  * \class ROOT::Internal::RDF::RBookedDefines
  * \ingroup dataframe
@@ -39,14 +53,17 @@ namespace RDFDetail = ROOT::Detail::RDF;
 class RBookedDefines {
    using RDefineBasePtrMap_t = std::map<std::string, std::shared_ptr<RDFDetail::RDefineBase>>;
    using ColumnNames_t = std::vector<std::string>;
+   using RVariationsMap_t = std::map<std::string, RVariationInfo>;
 
    // Since RBookedDefines is meant to be an immutable, copy-on-write object, the actual values are set as const
    using RDefineBasePtrMapPtr_t = std::shared_ptr<const RDefineBasePtrMap_t>;
    using ColumnNamesPtr_t = std::shared_ptr<const ColumnNames_t>;
+   using RVariationsMapPtr_t = std::shared_ptr<const RVariationsMap_t>;
 
 private:
    RDefineBasePtrMapPtr_t fDefines;
    ColumnNamesPtr_t fDefinesNames;
+   RVariationsMapPtr_t fVariations; ///< The systematic variations, indexed by variation name
 
 public:
    ////////////////////////////////////////////////////////////////////////////
@@ -63,8 +80,9 @@ public:
 
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates the object starting from the provided maps
-   RBookedDefines(RDefineBasePtrMapPtr_t defines, ColumnNamesPtr_t defineNames)
-      : fDefines(defines), fDefinesNames(defineNames)
+   RBookedDefines(RDefineBasePtrMapPtr_t defines, ColumnNamesPtr_t defineNames,
+                  RVariationsMapPtr_t variations = std::make_shared<RVariationsMap_t>())
+      : fDefines(defines), fDefinesNames(defineNames), fVariations(variations)
    {
    }
 
@@ -72,7 +90,8 @@ public:
    /// \brief Creates a new wrapper with empty maps
    RBookedDefines()
       : fDefines(std::make_shared<RDefineBasePtrMap_t>()),
-        fDefinesNames(std::make_shared<ColumnNames_t>())
+        fDefinesNames(std::make_shared<ColumnNames_t>()),
+        fVariations(std::make_shared<RVariationsMap_t>())
    {
    }
 
@@ -95,6 +114,25 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Internally it recreates the map with the new column name, and swaps with the old one.
    void AddName(std::string_view name);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Internally it recreates the map of variations with the new variation, and swaps with the old one.
+   void AddVariation(std::string_view variationName, const RVariationInfo &variation);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Returns the map of the booked variations, indexed by variation name
+   const RVariationsMap_t &GetVariations() const { return *fVariations; }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Returns the sorted names of the variations that affect the values of any of the given columns
+   ColumnNames_t GetVariationDeps(const ColumnNames_t &columns) const;
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Returns a copy in which the defined columns are replaced by their values for the given variation tag
+   ///
+   /// The varied column itself is replaced by (or, for dataset columns, added as) the define that computes its
+   /// alternative value. Defines that depend on the varied column are replaced by their varied counterparts.
+   RBookedDefines GetVaried(const std::string &variationName, unsigned int tagIdx) const;
 };
 
 } // Namespace RDF
@@ -13,13 +13,20 @@
 
 #include "ROOT/RDF/ColumnReaders.hxx"
 #include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/RMaskedEntryRange.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RIntegerSequence.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "RtypesCore.h"
 
+#include <algorithm>
+#include <cstddef> // std::size_t
 #include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -66,6 +73,34 @@ class RDefine final : public RDefineBase {
    /// The nth flag signals whether the nth input column is a custom column or not.
    std::array<bool, ColumnTypes_t::list_size> fIsDefine;
 
+   /// The values of the column for the entries of the current bulk, per slot (bulk mode only)
+   std::vector<std::unique_ptr<ret_type[]>> fBulkResults;
+   /// The first entry of the bulk that fBulkResults refers to, per slot
+   std::vector<Long64_t> fLastBulkEntry;
+   /// Flags the entries of the current bulk whose value has already been computed, per slot
+   std::vector<std::vector<char>> fBulkIsComputed;
+   /// The entries of the current bulk whose value must be computed by the ongoing UpdateBulk call, per slot
+   std::vector<RDFInternal::RMaskedEntryRange> fBulkToCompute;
+
+   template <typename G = F, typename std::enable_if<std::is_copy_constructible<G>::value, int>::type = 0>
+   std::shared_ptr<RDefineBase> MakeVariedDefineImpl(const std::string &variationName, unsigned int tagIdx)
+   {
+      return std::make_shared<RDefine>(fName, fType, fExpression, fColumnNames, fNSlots,
+                                       fDefines.GetVaried(variationName, tagIdx), fDSValuePtrs);
+   }
+
+   template <typename G = F, typename std::enable_if<!std::is_copy_constructible<G>::value, int>::type = 0>
+   std::shared_ptr<RDefineBase> MakeVariedDefineImpl(const std::string &, unsigned int)
+   {
+      throw std::logic_error("Column \"" + fName +
+                             "\" depends on a systematic variation but its expression cannot be copied.");
+   }
+
+   std::shared_ptr<RDefineBase> MakeVariedDefine(const std::string &variationName, unsigned int tagIdx) final
+   {
+      return MakeVariedDefineImpl(variationName, tagIdx);
+   }
+
    template <std::size_t... S>
    void UpdateHelper(unsigned int slot, Long64_t entry, std::index_sequence<S...>, NoneTag)
    {
@@ -93,16 +128,60 @@ class RDefine final : public RDefineBase {
       (void)entry;
    }
 
+   template <typename ColumnPtrs_t, std::size_t... S>
+   ret_type EvalBulkEntry(unsigned int, Long64_t, ColumnPtrs_t &columns, std::size_t idx, std::index_sequence<S...>,
+                          NoneTag)
+   {
+      (void)columns; // silence "unused parameter" warnings in gcc for expressions without input columns
+      (void)idx;
+      return fExpression(std::get<S>(columns)[idx]...);
+   }
+
+   template <typename ColumnPtrs_t, std::size_t... S>
+   ret_type EvalBulkEntry(unsigned int slot, Long64_t, ColumnPtrs_t &columns, std::size_t idx,
+                          std::index_sequence<S...>, SlotTag)
+   {
+      (void)columns; // silence "unused parameter" warnings in gcc for expressions without input columns
+      (void)idx;
+      return fExpression(slot, std::get<S>(columns)[idx]...);
+   }
+
+   template <typename ColumnPtrs_t, std::size_t... S>
+   ret_type EvalBulkEntry(unsigned int slot, Long64_t entry, ColumnPtrs_t &columns, std::size_t idx,
+                          std::index_sequence<S...>, SlotAndEntryTag)
+   {
+      (void)columns; // silence "unused parameter" warnings in gcc for expressions without input columns
+      (void)idx;
+      return fExpression(slot, entry, std::get<S>(columns)[idx]...);
+   }
+
+   template <std::size_t... S>
+   void UpdateBulkHelper(unsigned int slot, const RDFInternal::RMaskedEntryRange &mask, std::index_sequence<S...> s)
+   {
+      auto columns = std::make_tuple(std::get<S>(fValues[slot])->GetBulk(mask)...);
+      auto *results = fBulkResults[slot].get();
+      auto &isComputed = fBulkIsComputed[slot];
+      const auto bulkSize = mask.Size();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i]) {
+            results[i] = EvalBulkEntry(slot, mask.GetEntry(i), columns, i, s, ExtraArgsTag{});
+            isComputed[i] = 1;
+         }
+      }
+   }
+
 public:
    RDefine(std::string_view name, std::string_view type, F expression, const ColumnNames_t &columns,
                  unsigned int nSlots, const RDFInternal::RBookedDefines &defines,
                  const std::map<std::string, std::vector<void *>> &DSValuePtrs)
       : RDefineBase(name, type, nSlots, defines, DSValuePtrs), fExpression(std::move(expression)),
-        fColumnNames(columns), fLastResults(fNSlots), fValues(fNSlots), fIsDefine()
+        fColumnNames(columns), fLastResults(fNSlots), fValues(fNSlots), fIsDefine(), fBulkResults(fNSlots),
+        fLastBulkEntry(fNSlots, -1), fBulkIsComputed(fNSlots), fBulkToCompute(fNSlots)
    {
       const auto nColumns = fColumnNames.size();
       for (auto i = 0u; i < nColumns; ++i)
          fIsDefine[i] = fDefines.HasName(fColumnNames[i]);
+      fVariations = fDefines.GetVariationDeps(fColumnNames);
    }
 
    RDefine(const RDefine &) = delete;
@@ -115,6 +194,7 @@ public:
          RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), fDSValuePtrs};
          RDFInternal::InitColumnReaders(slot, fValues[slot], r, TypeInd_t(), info);
          fLastCheckedEntry[slot] = -1;
+         fLastBulkEntry[slot] = -1;
       }
    }
 
@@ -124,11 +204,48 @@ public:
    {
       if (entry != fLastCheckedEntry[slot]) {
          // evaluate this filter, cache the result
+         RDFInternal::RNodeTimer timer(fTiming, slot);
          UpdateHelper(slot, entry, TypeInd_t(), ExtraArgsTag{});
          fLastCheckedEntry[slot] = entry;
       }
    }
 
+   void UpdateBulk(unsigned int slot, const RDFInternal::RMaskedEntryRange &mask) final
+   {
+      auto &isComputed = fBulkIsComputed[slot];
+      if (isComputed.size() < mask.Capacity()) {
+         fBulkResults[slot].reset(new ret_type[mask.Capacity()]);
+         isComputed.resize(mask.Capacity());
+         fLastBulkEntry[slot] = -1;
+      }
+      if (mask.FirstEntry() != fLastBulkEntry[slot]) {
+         std::fill(isComputed.begin(), isComputed.end(), 0);
+         fLastBulkEntry[slot] = mask.FirstEntry();
+      }
+
+      // several nodes might request values of this column for different selections of the same bulk:
+      // only compute the values that have not been computed yet
+      auto &toCompute = fBulkToCompute[slot];
+      toCompute.Assign(mask);
+      bool computeAny = false;
+      for (std::size_t i = 0u; i < mask.Size(); ++i) {
+         const bool compute = mask[i] && !isComputed[i];
+         toCompute.Set(i, compute);
+         computeAny |= compute;
+      }
+      if (computeAny) {
+         RDFInternal::RNodeTimer timer(fTiming, slot);
+         UpdateBulkHelper(slot, toCompute, TypeInd_t());
+      }
+   }
+
+   void *GetBulkValuePtr(unsigned int slot) final { return static_cast<void *>(fBulkResults[slot].get()); }
+
+   void CollectBulkLoaders(unsigned int slot, std::vector<RDFInternal::RColumnReaderBulkLoader *> &loaders) final
+   {
+      RDFInternal::CollectBulkLoaders(fValues[slot], loaders, TypeInd_t());
+   }
+
    const std::type_info &GetTypeId() const { return typeid(ret_type); }
 
    void ClearValueReaders(unsigned int slot) final
@@ -13,16 +13,25 @@
 
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RTimingReport.hxx"
 
 #include <deque>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility> // std::pair
 #include <vector>
 
 class TTreeReader;
 
 namespace ROOT {
+namespace Internal {
+namespace RDF {
+class RColumnReaderBulkLoader;
+class RMaskedEntryRange;
+} // ns RDF
+} // ns Internal
+
 namespace Detail {
 namespace RDF {
 
@@ -42,9 +51,18 @@ protected:
    RDFInternal::RBookedDefines fDefines;
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
    const std::map<std::string, std::vector<void *>> &fDSValuePtrs; // reference to RLoopManager's data member
+   /// The sorted names of the systematic variations that affect the value of this column, see RInterface::Vary
+   std::vector<std::string> fVariations;
+   /// The varied counterparts of this column that have been requested so far, indexed by variation name and tag
+   std::map<std::pair<std::string, unsigned int>, std::shared_ptr<RDefineBase>> fVariedDefines;
+   /// Where to record the time spent computing the values of this column, see RLoopManager::SetTimingEnabled
+   RDFInternal::RNodeTimingHandle fTiming;
 
    static unsigned int GetNextID();
 
+   /// Create a new column of the same kind that computes its value from the given variation of its inputs
+   virtual std::shared_ptr<RDefineBase> MakeVariedDefine(const std::string &variationName, unsigned int tagIdx);
+
 public:
    RDefineBase(std::string_view name, std::string_view type, unsigned int nSlots,
                      const RDFInternal::RBookedDefines &defines,
@@ -60,8 +78,21 @@ public:
    std::string GetTypeName() const;
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
    virtual void ClearValueReaders(unsigned int slot) = 0;
+   /// Compute the values of the column for the selected entries of the bulk that have not been computed yet.
+   virtual void UpdateBulk(unsigned int slot, const RDFInternal::RMaskedEntryRange &mask) = 0;
+   /// Return the address of the buffer with the values of the column for the current bulk of entries.
+   virtual void *GetBulkValuePtr(unsigned int slot) = 0;
+   /// Add the column readers that the RLoopManager must load in bulk mode for this column to be computed.
+   virtual void
+   CollectBulkLoaders(unsigned int slot, std::vector<RDFInternal::RColumnReaderBulkLoader *> &loaders) = 0;
    /// Return the unique identifier of this RDefineBase.
    unsigned int GetID() const { return fID; }
+   const std::vector<std::string> &GetVariations() const { return fVariations; }
+   // overridden by RJittedDefine
+   virtual void SetTimingHandle(const RDFInternal::RNodeTimingHandle &handle) { fTiming = handle; }
+   /// Return the column that computes the value of this column for the given variation tag of its inputs.
+   /// Varied columns are created on first use and shared by all the nodes that need them.
+   std::shared_ptr<RDefineBase> GetVariedDefine(const std::string &variationName, unsigned int tagIdx);
 };
 
 } // ns RDF
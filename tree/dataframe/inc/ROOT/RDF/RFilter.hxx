@@ -22,7 +22,10 @@
 
 #include <algorithm>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace ROOT {
@@ -60,6 +63,28 @@ class RFilter final : public RFilterBase {
    /// The nth flag signals whether the nth input column is a custom column or not.
    std::array<bool, ColumnTypes_t::list_size> fIsDefine;
 
+   template <typename G = FilterF, typename std::enable_if<std::is_copy_constructible<G>::value, int>::type = 0>
+   std::shared_ptr<RNodeBase> MakeVariedFilterImpl(const std::string &variationName, unsigned int tagIdx)
+   {
+      // The varied filter is unnamed: it does not show up in cut flow reports and it is only evaluated on demand
+      auto variedFilter = std::make_shared<RFilter>(
+         fFilter, fColumnNames, RDFInternal::GetVariedPrevNode(fPrevDataPtr, variationName, tagIdx),
+         fDefines.GetVaried(variationName, tagIdx));
+      fLoopManager->Book(variedFilter.get());
+      return variedFilter;
+   }
+
+   template <typename G = FilterF, typename std::enable_if<!std::is_copy_constructible<G>::value, int>::type = 0>
+   std::shared_ptr<RNodeBase> MakeVariedFilterImpl(const std::string &, unsigned int)
+   {
+      throw std::logic_error("A filter depends on a systematic variation but its expression cannot be copied.");
+   }
+
+   std::shared_ptr<RNodeBase> MakeVariedFilter(const std::string &variationName, unsigned int tagIdx) final
+   {
+      return MakeVariedFilterImpl(variationName, tagIdx);
+   }
+
 public:
    RFilter(FilterF f, const ColumnNames_t &columns, std::shared_ptr<PrevDataFrame> pd,
            const RDFInternal::RBookedDefines &defines, std::string_view name = "")
@@ -70,6 +95,7 @@ public:
       const auto nColumns = fColumnNames.size();
       for (auto i = 0u; i < nColumns; ++i)
          fIsDefine[i] = fDefines.HasName(fColumnNames[i]);
+      fVariations = RDFInternal::Union(fPrevData.GetVariations(), fDefines.GetVariationDeps(fColumnNames));
    }
 
    RFilter(const RFilter &) = delete;
@@ -86,7 +112,11 @@ public:
             fLastResult[slot] = false;
          } else {
             // evaluate this filter, cache the result
-            auto passed = CheckFilterHelper(slot, entry, TypeInd_t());
+            bool passed;
+            {
+               RDFInternal::RNodeTimer timer(fTiming, slot);
+               passed = CheckFilterHelper(slot, entry, TypeInd_t());
+            }
             passed ? ++fAccepted[slot] : ++fRejected[slot];
             fLastResult[slot] = passed;
          }
@@ -95,6 +125,39 @@ public:
       return fLastResult[slot];
    }
 
+   const RDFInternal::RMaskedEntryRange &
+   CheckFiltersBulk(unsigned int slot, const RDFInternal::RMaskedEntryRange &bulk) final
+   {
+      auto &mask = fBulkMasks[slot];
+      if (bulk.FirstEntry() != fLastBulkEntry[slot]) {
+         mask.Assign(fPrevData.CheckFiltersBulk(slot, bulk));
+         RDFInternal::RNodeTimer timer(fTiming, slot);
+         CheckFilterBulkHelper(slot, mask, TypeInd_t());
+         fLastBulkEntry[slot] = bulk.FirstEntry();
+      }
+      return mask;
+   }
+
+   template <std::size_t... S>
+   void CheckFilterBulkHelper(unsigned int slot, RDFInternal::RMaskedEntryRange &mask, std::index_sequence<S...>)
+   {
+      // column values are only valid for the entries selected upstream, i.e. the ones that are selected in mask
+      auto columns = std::make_tuple(std::get<S>(fValues[slot])->GetBulk(mask)...);
+      (void)columns; // silence "unused variable" warnings in gcc for filters without input columns
+      ULong64_t nAccepted = 0ull;
+      ULong64_t nRejected = 0ull;
+      const auto bulkSize = mask.Size();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i]) {
+            const bool passed = fFilter(std::get<S>(columns)[i]...);
+            passed ? ++nAccepted : ++nRejected;
+            mask.Set(i, passed);
+         }
+      }
+      fAccepted[slot] += nAccepted;
+      fRejected[slot] += nRejected;
+   }
+
    template <std::size_t... S>
    bool CheckFilterHelper(unsigned int slot, Long64_t entry, std::index_sequence<S...>)
    {
@@ -154,6 +217,11 @@ public:
       filters.push_back(name);
    }
 
+   void CollectBulkLoaders(unsigned int slot, std::vector<RDFInternal::RColumnReaderBulkLoader *> &loaders) final
+   {
+      RDFInternal::CollectBulkLoaders(fValues[slot], loaders, TypeInd_t());
+   }
+
    virtual void ClearTask(unsigned int slot) final
    {
       for (auto &column : fDefines.GetColumns()) {
@@ -12,7 +12,9 @@
 #define ROOT_RFILTERBASE
 
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RMaskedEntryRange.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RTimingReport.hxx"
 #include "RtypesCore.h"
 #include "TError.h" // R_ASSERT
 
@@ -27,6 +29,12 @@ namespace RDF {
 class RCutFlowReport;
 } // ns RDF
 
+namespace Internal {
+namespace RDF {
+class RColumnReaderBulkLoader;
+} // ns RDF
+} // ns Internal
+
 namespace Detail {
 namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
@@ -41,6 +49,12 @@ protected:
    std::vector<ULong64_t> fRejected = {0};
    const std::string fName;
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
+   /// The first entry of the last bulk processed by each slot, see CheckFiltersBulk
+   std::vector<Long64_t> fLastBulkEntry;
+   /// The selection of the entries of the last bulk processed by each slot
+   std::vector<RDFInternal::RMaskedEntryRange> fBulkMasks;
+   /// Where to record the time spent evaluating this filter, see RLoopManager::SetTimingEnabled
+   RDFInternal::RNodeTimingHandle fTiming;
 
    RDFInternal::RBookedDefines fDefines;
 
@@ -67,6 +81,11 @@ public:
    virtual void ClearTask(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   // overridden by RJittedFilter
+   virtual void SetTimingHandle(const RDFInternal::RNodeTimingHandle &handle) { fTiming = handle; }
+   /// Add the column readers that the RLoopManager must load in bulk mode for this filter to be evaluated.
+   virtual void
+   CollectBulkLoaders(unsigned int slot, std::vector<RDFInternal::RColumnReaderBulkLoader *> &loaders) = 0;
 };
 
 } // ns RDF
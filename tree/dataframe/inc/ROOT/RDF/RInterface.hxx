@@ -423,6 +423,107 @@ public:
       return newInterface;
    }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations for an existing column.
+   /// \param[in] colName The name of the column whose values are varied.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object returning an RVec with the varied values of the column, one per variation tag.
+   /// \param[in] inputColumns Names of the columns/branches in input to the expression.
+   /// \param[in] variationTags The names of the varied values, e.g. {"down", "up"}.
+   /// \param[in] variationName The name of the variation. If empty, the name of the varied column is used.
+   /// \return the first node of the computation graph for which the variations are registered.
+   ///
+   /// The nominal results of the computation graph are not affected. The varied results of any action that (directly or
+   /// through Define and Filter nodes) depends on the varied column are obtained with VariationsFor: they are
+   /// computed in the same event loop as the nominal results, and the parts of the computation graph that do not
+   /// depend on the variation are evaluated only once per entry.
+   ///
+   /// The elements of the RVec returned by `expression` must have the same type as the varied column, and the RVec
+   /// must have exactly one element per variation tag.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto nominal_hx =
+   ///     df.Vary("pt", [] (double pt) { return RVec<double>{pt*0.9, pt*1.1}; }, {"pt"}, {"down", "up"})
+   ///       .Filter("pt > k")
+   ///       .Define("x", someFunc, {"pt"})
+   ///       .Histo1D("x");
+   ///
+   /// auto hx = ROOT::RDF::Experimental::VariationsFor(nominal_hx);
+   /// hx["nominal"].Draw();
+   /// hx["pt:down"].Draw("SAME");
+   /// hx["pt:up"].Draw("SAME");
+   /// ~~~
+   template <typename F>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F &&expression, const ColumnNames_t &inputColumns,
+                                  const std::vector<std::string> &variationTags, std::string_view variationName = "")
+   {
+      using RetType_t = typename TTraits::CallableTraits<F>::ret_type;
+      static_assert(RDFInternal::IsRVec_t<RetType_t>::value,
+                    "Vary expressions must return an RVec with one element per variation tag.");
+      using T = typename RetType_t::value_type;
+      using ColTypes_t = typename TTraits::CallableTraits<F>::arg_types;
+      constexpr auto nColumns = ColTypes_t::list_size;
+
+      const auto validColName = GetValidatedColumnNames(1, {std::string(colName)})[0];
+      const std::string varName = variationName.empty() ? validColName : std::string(variationName);
+      if (variationTags.empty())
+         throw std::runtime_error("Vary: at least one variation tag is required for variation \"" + varName + "\".");
+      if (fDefines.GetVariations().count(varName) > 0)
+         throw std::runtime_error("Vary: a variation named \"" + varName + "\" is already registered.");
+
+      const auto validColumnNames = GetValidatedColumnNames(nColumns, inputColumns);
+      CheckAndFillDSColumns(validColumnNames, ColTypes_t());
+
+      // The expression is evaluated once per entry, in a hidden column that holds the values for all tags. Each
+      // variation tag then reads its value from the hidden column.
+      const auto nSlots = fLoopManager->GetNSlots();
+      const auto &DSValuePtrs = fLoopManager->GetDSValuePtrs();
+      const std::string allValuesName = "rdfvariation_" + varName + "_";
+      auto allValues = std::make_shared<RDFDetail::RDefine<typename std::decay<F>::type>>(
+         allValuesName, RDFInternal::TypeID2TypeName(typeid(RetType_t)), std::forward<F>(expression),
+         validColumnNames, nSlots, fDefines, DSValuePtrs);
+
+      RDFInternal::RBookedDefines newCols(fDefines);
+      newCols.AddName(allValuesName);
+      newCols.AddColumn(allValues, allValuesName);
+
+      const auto nTags = variationTags.size();
+      const auto typeName = RDFInternal::TypeID2TypeName(typeid(T));
+      RDFInternal::RVariationInfo info{validColName, variationTags, {}};
+      for (auto i = 0u; i < nTags; ++i) {
+         auto getTag = [i, nTags, varName](const ROOT::VecOps::RVec<T> &values) {
+            if (values.size() != nTags)
+               throw std::runtime_error("Vary: the expression for variation \"" + varName + "\" returned " +
+                                        std::to_string(values.size()) + " values but " + std::to_string(nTags) +
+                                        " variation tags were registered.");
+            return values[i];
+         };
+         info.fVariedColumns.emplace_back(std::make_shared<RDFDetail::RDefine<decltype(getTag)>>(
+            validColName, typeName, std::move(getTag), ColumnNames_t{allValuesName}, nSlots, newCols, DSValuePtrs));
+      }
+      newCols.AddVariation(varName, info);
+
+      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      return newInterface;
+   }
+   // clang-format on
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations for an existing column, with tags "0", "1", ..., "nVariations-1".
+   ///
+   /// Refer to the first overload of this method for the full documentation.
+   template <typename F>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F &&expression, const ColumnNames_t &inputColumns,
+                                  std::size_t nVariations, std::string_view variationName = "")
+   {
+      std::vector<std::string> variationTags;
+      variationTags.reserve(nVariations);
+      for (std::size_t i = 0u; i < nVariations; ++i)
+         variationTags.emplace_back(std::to_string(i));
+      return Vary(colName, std::forward<F>(expression), inputColumns, variationTags, variationName);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns to disk, in a new TTree `treename` in file `filename`.
    /// \tparam ColumnTypes variadic list of branch/column types.
@@ -454,6 +555,16 @@ public:
    /// opts.fLazy = true;
    /// df.Snapshot("outputTree", "outputFile.root", {"x"}, opts);
    /// ~~~
+   ///
+   /// To write an RNTuple instead of a TTree (requires ROOT to be built with `root7=ON`):
+   /// ~~~{.cpp}
+   /// RSnapshotOptions opts;
+   /// opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   /// df.Snapshot("outputNTuple", "outputFile.root", {"x"}, opts);
+   /// ~~~
+   /// With multi-threading enabled, each thread fills its own clusters of the RNTuple and commits them directly to
+   /// the output file, so the order of the entries in the output is not the order of the input. RNTuples cannot be
+   /// written in a subdirectory of the output file, and the column types must be supported by RNTuple.
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>>
    Snapshot(std::string_view treename, std::string_view filename, const ColumnNames_t &columnList,
@@ -1970,6 +2081,89 @@ public:
    /// ~~~
    unsigned int GetNRuns() const { return fLoopManager->GetNRuns(); }
 
+   /// \brief Set the number of entries that the computation graph processes together
+   /// \param[in] bulkSize The number of entries per bulk. 1, the default, means that entries are processed one by one.
+   ///
+   /// The setting applies to the whole computation graph, i.e. to all the event loops run by this RDataFrame
+   /// instance after the call. In bulk mode, the values of the input columns of a bulk of entries are stored in
+   /// contiguous buffers, filters compute a selection mask for the whole bulk and actions process all the selected
+   /// entries in one go. This removes most of the per-entry overhead of the computation graph, which can dominate
+   /// the runtime of simple analyses of numeric columns. Defined columns are only computed for the entries that
+   /// are selected by the nodes that use them. Results are the same as when processing entries one by one.
+   ///
+   /// In bulk mode, the values of all the columns used by the computation graph are read for every entry, and
+   /// column types must be default-constructible and copy-assignable. Branches of fundamental type are read basket
+   /// by basket (see TBranch::GetBulkEntries) and data sources can expose the values of several entries in place
+   /// (see RDataSource::GetNContiguousEntries); other columns are read entry by entry. Snapshot does not support bulk processing:
+   /// if a Snapshot is booked, the event loop processes entries one by one.
+   ///
+   /// Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDataFrame df("tree", "file.root");
+   /// df.SetBulkSize(1024);
+   /// auto h = df.Filter("x > 0").Histo1D({"h", "h", 100, 0., 10.}, "x");
+   /// ~~~
+   void SetBulkSize(std::size_t bulkSize) { fLoopManager->SetBulkSize(bulkSize); }
+
+   /// \brief Gets the number of entries that the computation graph processes together, see SetBulkSize
+   std::size_t GetBulkSize() const { return fLoopManager->GetBulkSize(); }
+
+   /// \brief Set the number of processes that run the event loop
+   /// \param[in] nProcesses The number of worker processes. 1, the default, means that the event loop runs in this
+   /// process.
+   ///
+   /// The setting applies to all the event loops run by this RDataFrame instance after the call. With more than one
+   /// process, each event loop runs in `nProcesses` worker processes forked from this one with
+   /// ROOT::TProcessExecutor. The dataset is split in as many parts as there are workers, each worker processes its
+   /// part sequentially and sends the partial results back to this process, where they are merged with the
+   /// RMergeableValue machinery. This avoids the contention on shared resources (e.g. the memory allocator) of
+   /// multi-threaded event loops with many threads, and isolates the workers from each other: if one of them crashes,
+   /// the event loop throws an exception in this process, which keeps running.
+   ///
+   /// All the booked actions must produce mergeable results: Count, Sum, Mean, StdDev, Min, Max, Histo1D, Histo2D,
+   /// Histo3D, Profile1D, Profile2D and Graph are supported. Range, friend trees and entry lists are not supported.
+   /// The side effects of the event loop, e.g. the invocation of callbacks registered with
+   /// RResultPtr::OnPartialResult, take place in the worker processes. Not available on Windows.
+   ///
+   /// Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDataFrame df("tree", "file.root");
+   /// df.SetNProcesses(32);
+   /// auto h = df.Filter("x > 0").Histo1D({"h", "h", 100, 0., 10.}, "x");
+   /// h->Draw(); // runs the event loop in 32 processes
+   /// ~~~
+   void SetNProcesses(unsigned int nProcesses) { fLoopManager->SetNProcesses(nProcesses); }
+
+   /// \brief Gets the number of processes that run the event loop, see SetNProcesses
+   unsigned int GetNProcesses() const { return fLoopManager->GetNProcesses(); }
+
+   /// \brief Enable or disable the timing of the event loops
+   /// \param[in] enable Whether the event loops run by this RDataFrame instance after the call are timed.
+   ///
+   /// When timing is enabled, each event loop records the wall-clock time spent in each filter, defined column and
+   /// action, the number of times each of them is evaluated, and how each processing slot spent its time: processing
+   /// tasks, waiting for them, and reading and decompressing data. The time spent in a node does not include the time
+   /// spent in the nodes it depends on. The timings of the last timed event loop are returned by GetTimingReport.
+   /// Timing is disabled by default, and costs close to nothing in that case. Event loops that run in several
+   /// processes (see SetNProcesses) are not timed.
+   ///
+   /// Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDataFrame df("tree", "file.root");
+   /// df.SetTimingEnabled();
+   /// auto h = df.Filter("x > 0", "xCut").Histo1D({"h", "h", 100, 0., 10.}, "x");
+   /// h->Draw();
+   /// df.GetTimingReport().Print();
+   /// df.GetTimingReport().WriteChromeTrace("trace.json"); // to be loaded in chrome://tracing or Perfetto
+   /// ~~~
+   void SetTimingEnabled(bool enable = true) { fLoopManager->SetTimingEnabled(enable); }
+
+   /// \brief Whether the event loops are timed, see SetTimingEnabled
+   bool IsTimingEnabled() const { return fLoopManager->IsTimingEnabled(); }
+
+   /// \brief Gets the timings of the last timed event loop, see SetTimingEnabled
+   const RTimingReport &GetTimingReport() const { return fLoopManager->GetTimingReport(); }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Execute a user-defined accumulation operation on the processed column values in each processing slot
@@ -2388,6 +2582,21 @@ private:
          treename = treename.substr(lastSlash + 1, treename.size());
       }
 
+      if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple) {
+         const unsigned int nSlots = ROOT::IsImplicitMTEnabled() ? fLoopManager->GetNSlots() : 1u;
+         auto sink = RDFInternal::MakeSnapshotNTupleSink(
+            nSlots, std::string(filename), std::string(dirname), std::string(treename),
+            RDFInternal::ReplaceDotWithUnderscore(columnList),
+            {RDFInternal::TypeID2TypeName(typeid(ColumnTypes))...}, options);
+         using Helper_t = RDFInternal::SnapshotHelperRNTuple<ColumnTypes...>;
+         using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+         std::unique_ptr<RDFInternal::RActionBase> actionPtr(
+            new Action_t(Helper_t(sink), validCols, fProxiedPtr, fDefines));
+         fLoopManager->Book(actionPtr.get());
+         return RDFInternal::CreateSnapshotRDF(sink->GetSnapshotRDF(), options.fLazy, *fLoopManager,
+                                               std::move(actionPtr));
+      }
+
       // add action node to functional graph and run event loop
       std::unique_ptr<RDFInternal::RActionBase> actionPtr;
       if (!ROOT::IsImplicitMTEnabled()) {
@@ -0,0 +1,123 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RJITCACHE
+#define ROOT_RDF_RJITCACHE
+
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+/// Statistics of the usage of the on-disk cache of jitted RDataFrame code, see EnableJitCache
+struct RJitCacheStats {
+   ULong64_t fNHits = 0;   ///< Number of times jitted code was found in the cache
+   ULong64_t fNMisses = 0; ///< Number of times jitted code had to be compiled by the interpreter
+   /// Total just-in-time compilation time saved thanks to the cache, in seconds. For each cache hit, this is the time
+   /// it took to compile the code with the interpreter when the cache entry was created, minus the time it took to
+   /// load the cached code.
+   double fJitTimeSaved = 0.;
+};
+
+void EnableJitCache(std::string_view directory);
+void DisableJitCache();
+RJitCacheStats GetJitCacheStats();
+
+} // namespace Experimental
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+
+/**
+\class ROOT::Internal::RDF::RJitSnippet
+\ingroup dataframe
+\brief A piece of code scheduled for just-in-time compilation, with the addresses of the objects it acts on kept apart.
+
+The code generated when booking jitted Filters, Defines and actions refers to objects of the current process (the
+nodes of the computation graph, the results...). Keeping those addresses out of the code text makes the code
+identical across processes that run the same analysis, so that it can be compiled once and cached, see RJitCache.
+*/
+class RJitSnippet {
+   /// The code, split at the positions of the addresses: fCode.size() == fAddrs.size() + 1
+   std::vector<std::string> fCode{""};
+   std::vector<const void *> fAddrs;
+   /// The declarations the code depends on, e.g. the jitted lambda of a Filter. They are already known to the
+   /// interpreter, they are only needed to compile the code outside of it.
+   std::string fDeclarations;
+
+public:
+   RJitSnippet &AppendCode(const std::string &code);
+   /// Append the address of an object to the code. It will be inserted as a `void *` expression.
+   RJitSnippet &AppendAddr(const void *addr);
+   void SetDeclarations(const std::string &declarations) { fDeclarations = declarations; }
+   const std::string &GetDeclarations() const { return fDeclarations; }
+   const std::vector<const void *> &GetAddrs() const { return fAddrs; }
+
+   /// Return the code with the addresses printed as hexadecimal literals, ready to be passed to the interpreter.
+   std::string Render() const;
+   /// Return the code with the addresses read from array `argsName`, starting at index `firstArg`.
+   std::string RenderWithArgs(const std::string &argsName, std::size_t firstArg) const;
+};
+
+/**
+\class ROOT::Internal::RDF::RJitCache
+\ingroup dataframe
+\brief An on-disk, content-addressed cache of compiled jitted RDataFrame code.
+
+The code of all the snippets jitted by one RLoopManager::Jit call is compiled with ACLiC into a shared library
+whose name is the hash of the code, of the declarations it depends on and of the ROOT version. The jitted lambdas
+are renumbered in the order they are used, so that the hash does not depend on the expressions jitted before.
+Processes that jit the same code load the library instead of compiling the code with the interpreter again.
+The library is compiled in the background by a separate ROOT process.
+*/
+class RJitCache {
+   std::string fDirectory; ///< The cache directory. The cache is disabled if empty.
+   ROOT::RDF::Experimental::RJitCacheStats fStats;
+   /// Protects fDirectory and fStats: event loops started concurrently by RunGraphs may jit at the same time
+   mutable std::mutex fMutex;
+
+   static std::string GetLibraryPath(const std::string &directory, const std::string &key);
+   std::string GetDirectory() const;
+   void CountMiss();
+
+public:
+   RJitCache();
+
+   /// Return the key of the cache entry of the snippets
+   static std::string GetKey(const std::vector<RJitSnippet> &snippets);
+   /// Compile the source written by Store in `tmpDir` and move the library to the cache `directory`. This is run by
+   /// the ROOT process that Store starts in the background.
+   static void BuildLibrary(const std::string &directory, const std::string &tmpDir, const std::string &key);
+
+   void SetDirectory(const std::string &directory);
+   bool IsEnabled() const { return !GetDirectory().empty(); }
+   ROOT::RDF::Experimental::RJitCacheStats GetStats() const;
+
+   /// Run the compiled code of the snippets if it is in the cache. Return false if it is not.
+   bool Run(const std::vector<RJitSnippet> &snippets);
+   /// Start the compilation of the code of the snippets into the cache, recording the time the interpreter took to
+   /// jit it. The library is not available in the cache until the compilation is complete.
+   void Store(const std::vector<RJitSnippet> &snippets, double jitTime);
+};
+
+/// Return the process-wide cache of jitted code. It is enabled at startup if the ROOT_RDF_JITCACHE environment
+/// variable contains the path of a cache directory.
+RJitCache &GetJitCache();
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RJITCACHE
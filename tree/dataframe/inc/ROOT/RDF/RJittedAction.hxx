@@ -47,6 +47,9 @@ public:
    void SetAction(std::unique_ptr<RActionBase> a) { fConcreteAction = std::move(a); }
 
    void Run(unsigned int slot, Long64_t entry) final;
+   void RunBulk(unsigned int slot, const RMaskedEntryRange &bulk) final;
+   bool SupportsBulk() const final;
+   void CollectBulkLoaders(unsigned int slot, std::vector<RColumnReaderBulkLoader *> &loaders) final;
    void Initialize() final;
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void TriggerChildrenCount() final;
@@ -56,11 +59,19 @@ public:
    bool HasRun() const final;
    void SetHasRun() final;
    void ClearValueReaders(unsigned int slot) final;
+   void SetTimingHandle(const RNodeTimingHandle &handle) final;
+   std::string GetActionName() final;
 
    std::shared_ptr<GraphDrawing::GraphNode> GetGraph();
 
    // Helper for RMergeableValue
    std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> GetMergeableValue() const final;
+   void SetMergedValue(std::vector<std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase>> &values) final;
+
+   const std::vector<std::string> &GetVariations() const final;
+   const std::vector<std::string> &GetVariationTags(const std::string &variationName) const final;
+   std::unique_ptr<RActionBase>
+   MakeVariedAction(const std::string &variationName, unsigned int tagIdx, void *newResult) final;
 };
 
 } // ns RDF
@@ -16,7 +16,9 @@
 #include "RtypesCore.h"
 
 #include <memory>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 class TTreeReader;
 
@@ -31,6 +33,8 @@ namespace RDF {
 class RJittedDefine : public RDefineBase {
    std::unique_ptr<RDefineBase> fConcreteDefine = nullptr;
 
+   std::shared_ptr<RDefineBase> MakeVariedDefine(const std::string &variationName, unsigned int tagIdx) final;
+
 public:
    RJittedDefine(std::string_view name, std::string_view type, unsigned int nSlots,
                        const std::map<std::string, std::vector<void *>> &DSValuePtrs)
@@ -39,12 +43,18 @@ public:
    }
 
    void SetDefine(std::unique_ptr<RDefineBase> c) { fConcreteDefine = std::move(c); }
+   /// The variations are known at booking time, when the input columns of the jitted expression are parsed
+   void SetVariations(const std::vector<std::string> &variations) { fVariations = variations; }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void *GetValuePtr(unsigned int slot) final;
    const std::type_info &GetTypeId() const final;
    void Update(unsigned int slot, Long64_t entry) final;
    void ClearValueReaders(unsigned int slot) final;
+   void UpdateBulk(unsigned int slot, const RDFInternal::RMaskedEntryRange &mask) final;
+   void *GetBulkValuePtr(unsigned int slot) final;
+   void CollectBulkLoaders(unsigned int slot, std::vector<RDFInternal::RColumnReaderBulkLoader *> &loaders) final;
+   void SetTimingHandle(const RDFInternal::RNodeTimingHandle &handle) final;
 };
 
 } // ns RDF
@@ -37,16 +37,22 @@ namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 /// RJittedFilter is the type of the node returned by jitted Filter calls: the concrete filter can be created and set
 /// at a later time, from jitted code.
 class RJittedFilter final : public RFilterBase {
-   std::unique_ptr<RFilterBase> fConcreteFilter = nullptr;
+   std::shared_ptr<RFilterBase> fConcreteFilter = nullptr;
+
+   std::shared_ptr<RNodeBase> MakeVariedFilter(const std::string &variationName, unsigned int tagIdx) final;
 
 public:
    RJittedFilter(RLoopManager *lm, std::string_view name);
    ~RJittedFilter() { fLoopManager->Deregister(this); }
 
    void SetFilter(std::unique_ptr<RFilterBase> f);
+   /// The variations are known at booking time, when the input columns of the jitted expression are parsed
+   void SetVariations(const std::vector<std::string> &variations) { fVariations = variations; }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    bool CheckFilters(unsigned int slot, Long64_t entry) final;
+   const RDFInternal::RMaskedEntryRange &
+   CheckFiltersBulk(unsigned int slot, const RDFInternal::RMaskedEntryRange &bulk) final;
    void Report(ROOT::RDF::RCutFlowReport &) const final;
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final;
    void FillReport(ROOT::RDF::RCutFlowReport &) const final;
@@ -58,7 +64,9 @@ public:
    void ClearValueReaders(unsigned int slot) final;
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
+   void SetTimingHandle(const RDFInternal::RNodeTimingHandle &handle) final;
    void ClearTask(unsigned int slot) final;
+   void CollectBulkLoaders(unsigned int slot, std::vector<RDFInternal::RColumnReaderBulkLoader *> &loaders) final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
 
@@ -11,12 +11,16 @@
 #ifndef ROOT_RLOOPMANAGER
 #define ROOT_RLOOPMANAGER
 
+#include "ROOT/RDF/RMaskedEntryRange.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RTimingReport.hxx"
 
+#include <cstddef> // std::size_t
 #include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility> // std::pair
 #include <vector>
 
 // forward declarations
@@ -35,6 +39,8 @@ namespace RDF {
 std::vector<std::string> GetBranchNames(TTree &t, bool allowDuplicates = true);
 
 class RActionBase;
+class RColumnReaderBulkLoader;
+class RJitSnippet;
 class GraphNode;
 
 namespace GraphDrawing {
@@ -48,6 +54,7 @@ namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
 
 class RFilterBase;
+class RMergeableValueBase;
 class RRangeBase;
 using ROOT::RDF::RDataSource;
 using ColumnNames_t = std::vector<std::string>;
@@ -121,6 +128,37 @@ class RLoopManager : public RNodeBase {
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
+   /// The entries read by a processing slot in bulk mode, waiting to be processed by the computation graph
+   struct RBulkSlot {
+      RDFInternal::RMaskedEntryRange fBulk;
+      /// The column readers that have to store the values of each entry of the bulk, see SetBulkSize
+      std::vector<RDFInternal::RColumnReaderBulkLoader *> fLoaders;
+      /// The loaders that can load the values of a range of entries of the current tree or data source in one go
+      std::vector<RDFInternal::RColumnReaderBulkLoader *> fRangeLoaders;
+      /// The loaders that store the values of each entry as it is read
+      std::vector<RDFInternal::RColumnReaderBulkLoader *> fEntryLoaders;
+      TTreeReader *fReader = nullptr; ///< The reader of the task, null for data sources and empty sources
+      Int_t fTreeNumber = -1;         ///< The number of the tree read by the range loaders in the chain of fReader
+      /// Number of entries, from the beginning of the bulk, loaded in one go by fRangeLoaders; 0 if the bulk is loaded
+      /// entry by entry by all loaders
+      std::size_t fNRangeEntries = 0;
+      /// The entry, in the current tree or data source, that follows the last entry of the bulk
+      Long64_t fNextEntry = -1;
+   };
+   std::size_t fBulkSize{1}; ///< Number of entries processed together by the computation graph, see SetBulkSize
+   bool fIsBulkRun{false};   ///< Whether the current event loop processes the entries in bulks
+   std::vector<RBulkSlot> fBulkSlots;
+
+   unsigned int fNProcesses{1}; ///< Number of processes that run the event loop, see SetNProcesses
+   /// The part of the dataset processed by this process and the number of parts, see SetNProcesses.
+   /// In the worker processes of a multi-process event loop, the first element is the index of the worker.
+   std::pair<unsigned int, unsigned int> fProcessChunk{0u, 1u};
+
+   bool fIsTimingEnabled{false}; ///< Whether the event loops are timed, see SetTimingEnabled
+   /// Collects the timings of the current event loop. Null if the event loop is not timed.
+   std::shared_ptr<RDFInternal::RTimingCollector> fTimingCollector;
+   ROOT::RDF::RTimingReport fTimingReport; ///< The timings of the last timed event loop
+
    void CheckIndexedFriends();
    void RunEmptySourceMT();
    void RunEmptySource();
@@ -129,11 +167,20 @@ class RLoopManager : public RNodeBase {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   void SplitBulkLoaders(unsigned int slot, TTree *tree);
+   void LoadBulkValues(unsigned int slot, Long64_t entry);
+   void RunBulkAndCheckFilters(unsigned int slot);
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
    void CleanUpNodes();
    void CleanUpTask(unsigned int slot);
    void EvalChildrenCounts();
+   std::pair<ULong64_t, ULong64_t> GetProcessEntryRange(ULong64_t nEntries) const;
+   void CheckMultiProcessRun() const;
+   std::vector<std::vector<std::unique_ptr<RMergeableValueBase>>> RunMultiProcess();
+   std::vector<char> RunProcessChunk(unsigned int chunk);
+   void SetUpTiming(double jitTime);
+   bool SetDataSourceEntry(unsigned int slot, ULong64_t entry);
 
 public:
    RLoopManager(TTree *tree, const ColumnNames_t &defaultBranches);
@@ -158,6 +205,12 @@ public:
    void Book(RRangeBase *rangePtr);
    void Deregister(RRangeBase *rangePtr);
    bool CheckFilters(unsigned int, Long64_t) final;
+   /// End of recursive chain of calls: all entries of the bulk are selected
+   const RDFInternal::RMaskedEntryRange &
+   CheckFiltersBulk(unsigned int, const RDFInternal::RMaskedEntryRange &bulk) final
+   {
+      return bulk;
+   }
    unsigned int GetNSlots() const { return fNSlots; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
@@ -166,10 +219,18 @@ public:
    void IncrChildrenCount() final { ++fNChildren; }
    void StopProcessing() final { ++fNStopsReceived; }
    void ToJitExec(const std::string &) const;
+   void ToJitExec(const ROOT::Internal::RDF::RJitSnippet &) const;
    void AddColumnAlias(const std::string &alias, const std::string &colName) { fAliasColumnNameMap[alias] = colName; }
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
    unsigned int GetNRuns() const { return fNRuns; }
+   void SetBulkSize(std::size_t bulkSize);
+   std::size_t GetBulkSize() const { return fBulkSize; }
+   void SetNProcesses(unsigned int nProcesses);
+   unsigned int GetNProcesses() const { return fNProcesses; }
+   void SetTimingEnabled(bool enable) { fIsTimingEnabled = enable; }
+   bool IsTimingEnabled() const { return fIsTimingEnabled; }
+   const ROOT::RDF::RTimingReport &GetTimingReport() const { return fTimingReport; }
    bool HasDSValuePtrs(const std::string &col) const;
    const std::map<std::string, std::vector<void *>> &GetDSValuePtrs() const { return fDSValuePtrMap; }
    void AddDSValuePtrs(const std::string &col, const std::vector<void *> ptrs);
@@ -0,0 +1,78 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RMASKEDENTRYRANGE
+#define ROOT_RDF_RMASKEDENTRYRANGE
+
+#include "RtypesCore.h"
+
+#include <algorithm>
+#include <cstddef> // std::size_t
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/**
+\class ROOT::Internal::RDF::RMaskedEntryRange
+\ingroup dataframe
+\brief A bulk of entries processed together in bulk mode, with a flag per entry that tells whether it is selected.
+
+The loop manager fills one bulk per slot with the entries it reads. Filters and ranges copy the bulk of their upstream
+node and unset the flags of the entries they reject. Column readers and defines only need to provide valid values for
+the selected entries.
+*/
+class RMaskedEntryRange {
+   std::vector<Long64_t> fEntries; ///< The entry numbers of the bulk
+   std::vector<char> fMask;        ///< One flag per entry, set if the entry is selected (std::vector<bool> is slow)
+   std::size_t fSize = 0;          ///< Number of entries in the bulk
+
+public:
+   RMaskedEntryRange() = default;
+   explicit RMaskedEntryRange(std::size_t capacity) : fEntries(capacity), fMask(capacity, 0) {}
+
+   std::size_t Capacity() const { return fEntries.size(); }
+   std::size_t Size() const { return fSize; }
+   /// The first entry identifies the bulk: within an event loop, every slot processes each entry at most once
+   Long64_t FirstEntry() const { return fSize > 0 ? fEntries[0] : -1; }
+   Long64_t GetEntry(std::size_t idx) const { return fEntries[idx]; }
+   bool operator[](std::size_t idx) const { return fMask[idx] != 0; }
+   void Set(std::size_t idx, bool isSelected) { fMask[idx] = isSelected; }
+
+   /// Append a selected entry to the bulk
+   void Push(Long64_t entry)
+   {
+      fEntries[fSize] = entry;
+      fMask[fSize] = 1;
+      ++fSize;
+   }
+
+   void Clear() { fSize = 0; }
+
+   /// Copy the entries and the selection flags of another bulk, reusing the memory of this one
+   void Assign(const RMaskedEntryRange &other)
+   {
+      if (Capacity() < other.Capacity()) {
+         fEntries.resize(other.Capacity());
+         fMask.resize(other.Capacity());
+      }
+      std::copy(other.fEntries.begin(), other.fEntries.begin() + other.fSize, fEntries.begin());
+      std::copy(other.fMask.begin(), other.fMask.begin() + other.fSize, fMask.begin());
+      fSize = other.fSize;
+   }
+
+   /// Number of selected entries
+   std::size_t Count() const { return std::count(fMask.begin(), fMask.begin() + fSize, 1); }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RMASKEDENTRYRANGE
@@ -13,8 +13,12 @@
 
 #include "RtypesCore.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <utility> // std::pair
 #include <vector>
 
 namespace ROOT {
@@ -27,6 +31,7 @@ namespace RDF {
 namespace GraphDrawing {
 class GraphNode;
 }
+class RMaskedEntryRange;
 }
 }
 
@@ -43,11 +48,25 @@ protected:
    RLoopManager *fLoopManager;
    unsigned int fNChildren{0};      ///< Number of nodes of the functional graph hanging from this object
    unsigned int fNStopsReceived{0}; ///< Number of times that a children node signaled to stop processing entries.
+   /// The sorted names of the systematic variations that affect the entries selected by this node, see RInterface::Vary
+   std::vector<std::string> fVariations;
+   /// The varied counterparts of this node that have been requested so far, indexed by variation name and tag
+   std::map<std::pair<std::string, unsigned int>, std::shared_ptr<RNodeBase>> fVariedFilters;
+
+   /// Create a new node of the same type that selects entries based on the given variation of its inputs
+   virtual std::shared_ptr<RNodeBase> MakeVariedFilter(const std::string &, unsigned int)
+   {
+      throw std::logic_error("This node does not support systematic variations.");
+   }
 
 public:
    RNodeBase(RLoopManager *lm = nullptr) : fLoopManager(lm) {}
    virtual ~RNodeBase() {}
    virtual bool CheckFilters(unsigned int, Long64_t) = 0;
+   /// Bulk counterpart of CheckFilters: return the selection of the entries of the bulk that pass this node and all
+   /// the upstream nodes. The returned object is owned by the node and it is valid until the next call.
+   virtual const ROOT::Internal::RDF::RMaskedEntryRange &
+   CheckFiltersBulk(unsigned int slot, const ROOT::Internal::RDF::RMaskedEntryRange &bulk) = 0;
    virtual void Report(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void PartialReport(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void IncrChildrenCount() = 0;
@@ -62,9 +81,39 @@ public:
    }
 
    virtual RLoopManager *GetLoopManagerUnchecked() { return fLoopManager; }
+
+   const std::vector<std::string> &GetVariations() const { return fVariations; }
+
+   /// Return the node that selects entries based on the given variation tag of the upstream columns.
+   /// The varied node has the same type as this node. Varied nodes are created on first use and shared by all the
+   /// varied nodes downstream.
+   std::shared_ptr<RNodeBase> GetVariedFilter(const std::string &variationName, unsigned int tagIdx)
+   {
+      auto &varied = fVariedFilters[{variationName, tagIdx}];
+      if (!varied)
+         varied = MakeVariedFilter(variationName, tagIdx);
+      return varied;
+   }
 };
 } // ns RDF
 } // ns Detail
+
+namespace Internal {
+namespace RDF {
+
+/// Return the varied counterpart of the given node if the node is affected by the variation, the node itself otherwise
+template <typename PrevNode>
+std::shared_ptr<PrevNode>
+GetVariedPrevNode(const std::shared_ptr<PrevNode> &prevNode, const std::string &variationName, unsigned int tagIdx)
+{
+   const auto &variations = prevNode->GetVariations();
+   if (std::find(variations.begin(), variations.end(), variationName) == variations.end())
+      return prevNode;
+   return std::static_pointer_cast<PrevNode>(prevNode->GetVariedFilter(variationName, tagIdx));
+}
+
+} // ns RDF
+} // ns Internal
 } // ns ROOT
 
 #endif
@@ -37,10 +37,21 @@ class RRange final : public RRangeBase {
    const std::shared_ptr<PrevData> fPrevDataPtr;
    PrevData &fPrevData;
 
+   std::shared_ptr<RNodeBase> MakeVariedFilter(const std::string &variationName, unsigned int tagIdx) final
+   {
+      auto variedRange = std::make_shared<RRange>(
+         fStart, fStop, fStride, ROOT::Internal::RDF::GetVariedPrevNode(fPrevDataPtr, variationName, tagIdx));
+      fLoopManager->Book(variedRange.get());
+      return variedRange;
+   }
+
 public:
    RRange(unsigned int start, unsigned int stop, unsigned int stride, std::shared_ptr<PrevData> pd)
       : RRangeBase(pd->GetLoopManagerUnchecked(), start, stop, stride, pd->GetLoopManagerUnchecked()->GetNSlots()),
-        fPrevDataPtr(std::move(pd)), fPrevData(*fPrevDataPtr) {}
+        fPrevDataPtr(std::move(pd)), fPrevData(*fPrevDataPtr)
+   {
+      fVariations = fPrevData.GetVariations();
+   }
 
    RRange(const RRange &) = delete;
    RRange &operator=(const RRange &) = delete;
@@ -75,6 +86,42 @@ public:
       return fLastResult;
    }
 
+   /// Bulk counterpart of CheckFilters: the range logic is applied to the entries selected upstream, in order
+   const ROOT::Internal::RDF::RMaskedEntryRange &
+   CheckFiltersBulk(unsigned int slot, const ROOT::Internal::RDF::RMaskedEntryRange &bulk) final
+   {
+      if (bulk.FirstEntry() == fLastBulkEntry)
+         return fBulkMask;
+      fLastBulkEntry = bulk.FirstEntry();
+      const auto bulkSize = bulk.Size();
+      if (fHasStopped) {
+         fBulkMask.Assign(bulk);
+         for (std::size_t i = 0u; i < bulkSize; ++i)
+            fBulkMask.Set(i, false);
+         return fBulkMask;
+      }
+
+      fBulkMask.Assign(fPrevData.CheckFiltersBulk(slot, bulk));
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (!fBulkMask[i])
+            continue;
+         if (fHasStopped) {
+            // the end of the range was reached within this bulk
+            fBulkMask.Set(i, false);
+            continue;
+         }
+         ++fNProcessedEntries;
+         const bool passed = !(fNProcessedEntries <= fStart || (fStop > 0 && fNProcessedEntries > fStop) ||
+                               (fStride != 1 && fNProcessedEntries % fStride != 0));
+         fBulkMask.Set(i, passed);
+         if (fNProcessedEntries == fStop) {
+            fHasStopped = true;
+            fPrevData.StopProcessing();
+         }
+      }
+      return fBulkMask;
+   }
+
    // recursive chain of `Report`s
    // RRange simply forwards these calls to the previous node
    void Report(ROOT::RDF::RCutFlowReport &rep) const final { fPrevData.PartialReport(rep); }
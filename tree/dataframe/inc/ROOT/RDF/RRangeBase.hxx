@@ -11,6 +11,7 @@
 #ifndef ROOT_RRANGEBASE
 #define ROOT_RRANGEBASE
 
+#include "ROOT/RDF/RMaskedEntryRange.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "RtypesCore.h"
 
@@ -38,6 +39,8 @@ protected:
    bool fLastResult{true};
    ULong64_t fNProcessedEntries{0};
    bool fHasStopped{false};    ///< True if the end of the range has been reached
+   Long64_t fLastBulkEntry{-1}; ///< The first entry of the last bulk processed, see CheckFiltersBulk
+   ROOT::Internal::RDF::RMaskedEntryRange fBulkMask; ///< The selection of the entries of the last bulk processed
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
 
    void ResetCounters();
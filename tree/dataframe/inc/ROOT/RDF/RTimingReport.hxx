@@ -0,0 +1,190 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RTIMINGREPORT
+#define ROOT_RDF_RTIMINGREPORT
+
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility> // std::pair
+#include <vector>
+
+class TVirtualPerfStats;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+class RTimingCollector;
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+/// The time spent in a node of the computation graph during an event loop, see RTimingReport
+struct RNodeTiming {
+   std::string fName; ///< The name of the filter, of the defined column or of the action
+   std::string fKind; ///< "Filter", "Define" or "Action"
+   /// Number of evaluations of the node. In bulk mode, a node is evaluated once per bulk of entries.
+   ULong64_t fNCalls = 0;
+   /// Time spent in the node summed over all slots, in seconds. It includes the time spent reading the input columns
+   /// of the node from the data source, but not the time spent in the other nodes it depends on (e.g. the Defines
+   /// that compute its input columns).
+   double fTime = 0.;
+};
+
+/// How a processing slot spent the time of an event loop, see RTimingReport
+struct RSlotTiming {
+   ULong64_t fNTasks = 0; ///< Number of tasks, i.e. of ranges of entries, processed by the slot
+   double fBusyTime = 0.; ///< Time spent processing tasks, in seconds
+   double fIdleTime = 0.; ///< Time spent waiting for tasks during the event loop, in seconds
+   /// Time spent reading and decompressing data from files (TTree inputs) or loading entries (data sources), in
+   /// seconds. It is part of the busy time.
+   double fIOTime = 0.;
+};
+
+/**
+\class ROOT::RDF::RTimingReport
+\ingroup dataframe
+\brief Where the time of an RDataFrame event loop went: per node, per processing slot and per task.
+
+See RInterface::SetTimingEnabled.
+*/
+class RTimingReport {
+   friend class ROOT::Internal::RDF::RTimingCollector;
+
+   /// A task processed by a slot, with its start and end time in seconds since the start of the event loop
+   struct RTask {
+      unsigned int fSlot;
+      double fStart;
+      double fEnd;
+   };
+
+   std::vector<RNodeTiming> fNodes;
+   std::vector<RSlotTiming> fSlots;
+   std::vector<RTask> fTasks;
+   double fJitTime = 0.;       ///< Time spent jitting code before the event loop, in seconds
+   double fEventLoopTime = 0.; ///< Wall-clock duration of the event loop, in seconds
+
+public:
+   const std::vector<RNodeTiming> &GetNodes() const { return fNodes; }
+   const std::vector<RSlotTiming> &GetSlots() const { return fSlots; }
+   double GetJitTime() const { return fJitTime; }
+   double GetEventLoopTime() const { return fEventLoopTime; }
+   /// Return the timing of the node with the given name, e.g. the name of a named filter or of a defined column.
+   /// Throws if there is no such node.
+   const RNodeTiming &operator[](std::string_view nodeName) const;
+   void Print() const;
+   /// Return the report in the Chrome trace event format, which can be loaded in chrome://tracing or Perfetto
+   std::string ToChromeTrace() const;
+   void WriteChromeTrace(std::string_view fileName) const;
+};
+
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+
+/// Identifies the counters of a node in an RTimingCollector. The node is not timed if fCollector is null.
+/// Nodes share the ownership of the collector, as they can outlive the event loop it was created for.
+struct RNodeTimingHandle {
+   std::shared_ptr<RTimingCollector> fCollector;
+   unsigned int fId = 0;
+};
+
+/**
+\class ROOT::Internal::RDF::RTimingCollector
+\ingroup dataframe
+\brief Collects the timing information of an event loop, see ROOT::RDF::RTimingReport.
+
+Each slot only updates its own counters, so no synchronization is needed while the event loop runs.
+*/
+class RTimingCollector {
+public:
+   using Clock_t = std::chrono::steady_clock;
+
+   struct RSlotTimes {
+      std::vector<double> fNodeTime;
+      std::vector<ULong64_t> fNodeCalls;
+      /// The time spent in the nodes evaluated by the node that is currently being evaluated, see RNodeTimer
+      double fChildTime = 0.;
+      double fIOTime = 0.;
+      Clock_t::time_point fTaskStart;
+      std::vector<std::pair<double, double>> fTasks;
+      std::unique_ptr<TVirtualPerfStats> fIOStats; ///< Measures the time spent in file reads, see StartTask
+      TVirtualPerfStats *fPrevIOStats = nullptr;   ///< The gPerfStats of the thread before the task started
+
+      RSlotTimes();
+      RSlotTimes(RSlotTimes &&);
+      ~RSlotTimes();
+   };
+
+private:
+   const Clock_t::time_point fStart = Clock_t::now();
+   const double fJitTime;
+   double fEventLoopTime = 0.;
+   std::vector<std::pair<std::string, std::string>> fNodes; ///< Names and kinds of the nodes
+   std::vector<RSlotTimes> fSlots;
+
+public:
+   RTimingCollector(unsigned int nSlots, double jitTime);
+   RTimingCollector(const RTimingCollector &) = delete;
+   RTimingCollector &operator=(const RTimingCollector &) = delete;
+
+   static RNodeTimingHandle AddNode(const std::shared_ptr<RTimingCollector> &collector, const std::string &name,
+                                    const std::string &kind);
+   RSlotTimes &GetSlot(unsigned int slot) { return fSlots[slot]; }
+   void StartTask(unsigned int slot);
+   void StopTask(unsigned int slot);
+   void AddIOTime(unsigned int slot, double time) { fSlots[slot].fIOTime += time; }
+   /// Mark the end of the event loop
+   void Stop();
+   ROOT::RDF::RTimingReport MakeReport() const;
+};
+
+/// Measures the time spent in a node of the computation graph, from construction to destruction, minus the time
+/// spent in the other nodes timed in the meantime by the same slot. Does nothing if the node is not timed.
+class RNodeTimer {
+   RTimingCollector::RSlotTimes *fSlot = nullptr;
+   unsigned int fId = 0;
+   double fOuterChildTime = 0.;
+   RTimingCollector::Clock_t::time_point fStart;
+
+public:
+   RNodeTimer(const RNodeTimingHandle &handle, unsigned int slot)
+   {
+      if (handle.fCollector == nullptr)
+         return;
+      fSlot = &handle.fCollector->GetSlot(slot);
+      fId = handle.fId;
+      fOuterChildTime = fSlot->fChildTime;
+      fSlot->fChildTime = 0.;
+      fStart = RTimingCollector::Clock_t::now();
+   }
+   RNodeTimer(const RNodeTimer &) = delete;
+   RNodeTimer &operator=(const RNodeTimer &) = delete;
+
+   ~RNodeTimer()
+   {
+      if (fSlot == nullptr)
+         return;
+      const std::chrono::duration<double> elapsed = RTimingCollector::Clock_t::now() - fStart;
+      fSlot->fNodeTime[fId] += elapsed.count() - fSlot->fChildTime;
+      ++fSlot->fNodeCalls[fId];
+      fSlot->fChildTime = fOuterChildTime + elapsed.count();
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RTIMINGREPORT
@@ -180,6 +180,9 @@ void Erase(const T &that, std::vector<T> &v)
    v.erase(std::remove(v.begin(), v.end(), that), v.end());
 }
 
+/// Return the sorted union of the elements of the two vectors, without duplicates
+std::vector<std::string> Union(const std::vector<std::string> &v1, const std::vector<std::string> &v2);
+
 /// Declare code in the interpreter via the TInterpreter::Declare method, throw in case of errors
 void InterpreterDeclare(const std::string &code);
 
@@ -15,6 +15,9 @@
 
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RDF/GraphUtils.hxx>
+#include <ROOT/RDF/RJitCache.hxx>
+#include <ROOT/RResultHandle.hxx>
+#include <ROOT/RResultMap.hxx>
 #include <ROOT/RIntegerSequence.hxx>
 #include <ROOT/TypeTraits.hxx>
 
@@ -143,6 +146,33 @@ RNode AsRNode(NodeType node)
    return node;
 }
 
+// clang-format off
+/// Trigger the event loop of multiple RDataFrames concurrently
+/// \param[in] handles A vector of RResultHandles
+///
+/// This function triggers the event loop of all computation graphs which relate to the
+/// given RResultHandles. The advantage compared to running the event loop implicitly by accessing the
+/// RResultPtr is that the event loops will run concurrently. Therefore, the overall
+/// computation of all results is generally more efficient.
+/// It should be noted that user-defined operations (e.g., Filters and Defines) of the different RDataFrame graphs are assumed to be safe to call concurrently.
+///
+/// The code required by all computation graphs is just-in-time compiled in a single interpreter call before any
+/// event loop starts. With implicit multi-threading enabled, the event loops are then scheduled as tasks on the
+/// shared task arena, such that the tail of one event loop overlaps with the other event loops.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df1("tree1", "file1.root");
+/// auto r1 = df1.Histo1D("var1");
+///
+/// ROOT::RDataFrame df2("tree2", "file2.root");
+/// auto r2 = df2.Sum("var2");
+///
+/// // RResultPtr -> RResultHandle conversion is automatic
+/// ROOT::RDF::RunGraphs({r1, r2});
+/// ~~~
+// clang-format on
+void RunGraphs(std::vector<RResultHandle> handles);
+
 } // namespace RDF
 } // namespace ROOT
 #endif
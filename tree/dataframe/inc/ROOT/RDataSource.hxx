@@ -16,6 +16,7 @@
 #include "TString.h"
 
 #include <algorithm> // std::transform
+#include <cstddef>   // std::size_t
 #include <string>
 #include <typeinfo>
 #include <vector>
@@ -174,6 +175,17 @@ public:
    // clang-format on
    virtual bool SetEntry(unsigned int slot, ULong64_t entry) = 0;
 
+   // clang-format off
+   /// \brief Number of consecutive entries, starting from the last one passed to SetEntry for the slot, whose values
+   /// are stored contiguously at the addresses currently pointed to by the readers of the slot.
+   /// \param[in] slot The data processing slot that needs to be considered
+   /// In bulk mode (see RDataFrame::SetBulkSize), RDataFrame then accesses the values of these entries in place, which
+   /// requires that they stay valid while SetEntry is called for the following entries of the range.
+   /// The default, 1, means that the values of an entry are only valid until the next call to SetEntry: RDataFrame
+   /// copies them.
+   // clang-format on
+   virtual std::size_t GetNContiguousEntries(unsigned int /*slot*/) { return 1; }
+
    // clang-format off
    /// \brief Convenience method called before starting an event-loop.
    /// This method might be called multiple times over the lifetime of a RDataSource, since
@@ -20,6 +20,7 @@
 #include <ROOT/RDataSource.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -30,21 +31,44 @@ namespace Experimental {
 
 class RNTupleReader;
 class REntry;
+namespace Detail {
+class RFieldBase;
+}
 
 
 class RNTupleDS final : public ROOT::RDF::RDataSource {
+   /// Values of simple fields are not copied into the entry but mapped directly from the page buffers.  The window
+   /// keeps the entry range of the currently mapped page so that the field is only consulted on page boundaries.
+   struct RMappedWindow {
+      /// Null for fields that are not simple; those are read into the entry
+      ROOT::Experimental::Detail::RFieldBase *fField = nullptr;
+      std::size_t fValueSize = 0;
+      unsigned char *fBase = nullptr;
+      ULong64_t fFirstEntry = 0;
+      ULong64_t fNEntries = 0;
+   };
+
    /// Clones of the first reader, one for each slot
    std::vector<std::unique_ptr<ROOT::Experimental::RNTupleReader>> fReaders;
    std::vector<std::unique_ptr<ROOT::Experimental::REntry>> fEntries;
-   /// The raw pointers wrapped by the RValue items of fEntries
+   /// The raw pointers wrapped by the RValue items of fEntries or, for simple fields, pointers into the page buffers
    std::vector<std::vector<void*>> fValuePtrs;
+   /// For every slot, the mapped page windows of the columns in the order of fColumnNames
+   std::vector<std::vector<RMappedWindow>> fMappedWindows;
    unsigned fNSlots = 0;
    bool fHasSeenAllRanges = false;
    std::vector<std::string> fColumnNames;
    std::vector<std::string> fColumnTypes;
+   /// Name and file of an RNTuple that is opened on first use, empty if the data source got a reader
+   std::string fNTupleName;
+   std::string fFileName;
+
+   void Open();
+   void SetupSlots();
 
 public:
    explicit RNTupleDS(std::unique_ptr<ROOT::Experimental::RNTupleReader> ntuple);
+   RNTupleDS(std::string_view ntupleName, std::string_view fileName);
    ~RNTupleDS() = default;
    void SetNSlots(unsigned int nSlots) final;
    const std::vector<std::string> &GetColumnNames() const final;
@@ -53,6 +77,7 @@ public:
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
 
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
+   std::size_t GetNContiguousEntries(unsigned int slot) final;
 
    void Initialise() final;
 
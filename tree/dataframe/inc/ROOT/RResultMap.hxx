@@ -0,0 +1,128 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RRESULTMAP
+#define ROOT_RRESULTMAP
+
+#include "ROOT/RResultPtr.hxx"
+#include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+template <typename T>
+class RResultMap;
+
+template <typename T>
+RResultMap<T> VariationsFor(RResultPtr<T> resPtr);
+
+// clang-format off
+/**
+\class ROOT::RDF::Experimental::RResultMap
+\ingroup dataframe
+\brief The nominal and varied results of an RDataFrame action, as returned by VariationsFor.
+\tparam T Type of the action result
+
+The results are indexed by "nominal" and by keys of the form "variationName:tag".
+Accessing any of the results triggers the event loop if needed: all the results are computed in the same event loop.
+*/
+// clang-format on
+template <typename T>
+class RResultMap {
+   friend RResultMap<T> VariationsFor<T>(RResultPtr<T> resPtr);
+
+   /// Non-owning pointer to the RLoopManager at the root of the computation graph
+   ROOT::Detail::RDF::RLoopManager *fLoopManager = nullptr;
+   std::vector<std::string> fKeys; ///< The keys of the results, in booking order, "nominal" first
+   std::unordered_map<std::string, std::shared_ptr<T>> fResults;
+   /// Owning pointers to the actions that produce the results
+   std::unordered_map<std::string, std::shared_ptr<ROOT::Internal::RDF::RActionBase>> fActions;
+
+   RResultMap(ROOT::Detail::RDF::RLoopManager *lm) : fLoopManager(lm) {}
+
+   void Add(const std::string &key, std::shared_ptr<T> result,
+            std::shared_ptr<ROOT::Internal::RDF::RActionBase> action)
+   {
+      fKeys.emplace_back(key);
+      fResults[key] = std::move(result);
+      fActions[key] = std::move(action);
+   }
+
+public:
+   /// Return the result with the given key, triggering the event loop if needed.
+   /// Throws if the key is unknown.
+   T &operator[](const std::string &key)
+   {
+      auto it = fResults.find(key);
+      if (it == fResults.end())
+         throw std::runtime_error("RResultMap: no result with key \"" + key + "\".");
+      if (!fActions[key]->HasRun())
+         fLoopManager->Run();
+      return *it->second;
+   }
+
+   /// The keys of the results, in booking order: "nominal" first, then "variationName:tag" for every variation tag
+   const std::vector<std::string> &GetKeys() const { return fKeys; }
+};
+
+// clang-format off
+/// Book the varied counterparts of the given action result for all the systematic variations that affect it.
+/// \param[in] resPtr The nominal result of an action, which must not have been computed yet.
+/// \return An RResultMap with the nominal result under key "nominal" and the varied results under keys
+/// "variationName:tag".
+///
+/// The varied results are computed in the same event loop as the nominal result. Nodes of the computation graph
+/// that do not depend on a variation are shared between the nominal and the varied results.
+/// See RInterface::Vary for an example usage.
+// clang-format on
+template <typename T>
+RResultMap<T> VariationsFor(RResultPtr<T> resPtr)
+{
+   if (resPtr.fLoopManager == nullptr)
+      throw std::runtime_error("VariationsFor: the RResultPtr is invalid.");
+
+   auto &lm = *resPtr.fLoopManager;
+   // variations of the nodes created by jitted code can only be retrieved after jitting
+   lm.Jit();
+
+   const auto &action = resPtr.fActionPtr;
+   if (action->HasRun())
+      throw std::runtime_error("VariationsFor: the nominal result has already been computed. VariationsFor must be "
+                               "called before the event loop runs.");
+
+   RResultMap<T> results(&lm);
+   results.Add("nominal", resPtr.fObjPtr, action);
+
+   for (const auto &variationName : action->GetVariations()) {
+      const auto &tags = action->GetVariationTags(variationName);
+      for (auto i = 0u; i < tags.size(); ++i) {
+         // the varied result starts from a copy of the nominal result, e.g. to inherit the binning of histograms
+         auto variedResult = std::make_shared<T>(*resPtr.fObjPtr);
+         std::shared_ptr<ROOT::Internal::RDF::RActionBase> variedAction =
+            action->MakeVariedAction(variationName, i, &variedResult);
+         lm.Book(variedAction.get());
+         results.Add(variationName + ":" + tags[i], std::move(variedResult), std::move(variedAction));
+      }
+   }
+
+   return results;
+}
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RRESULTMAP
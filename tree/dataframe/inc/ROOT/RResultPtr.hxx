@@ -33,6 +33,13 @@ namespace RDF {
 // Fwd decl for MakeResultPtr
 template <typename T>
 class RResultPtr;
+class RResultHandle;
+namespace Experimental {
+template <typename T>
+class RResultMap;
+template <typename T>
+RResultMap<T> VariationsFor(RResultPtr<T> resPtr);
+} // namespace Experimental
 } // namespace RDF
 
 namespace Detail {
@@ -103,6 +110,10 @@ class RResultPtr {
 
    friend class ROOT::Internal::RDF::GraphDrawing::GraphCreatorHelper;
 
+   friend class RResultHandle;
+
+   friend Experimental::RResultMap<T> Experimental::VariationsFor<T>(RResultPtr<T> resPtr);
+
    /// \cond HIDDEN_SYMBOLS
    template <typename V, bool hasBeginEnd = TTraits::HasBeginAndEnd<V>::value>
    struct RIterationHelper {
@@ -9,6 +9,21 @@
  *************************************************************************/
 
 #include "ROOT/RDF/ActionHelpers.hxx"
+#include "RConfigure.h" // R__HAS_ROOT7
+
+#ifdef R__HAS_ROOT7
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/REntry.hxx"
+#include "ROOT/RField.hxx"
+#include "ROOT/RNTuple.hxx"
+#include "ROOT/RNTupleDS.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleOptions.hxx"
+#include "ROOT/RPageStorageFile.hxx"
+#include "TClass.h"
+
+#include <unordered_map>
+#endif
 
 namespace ROOT {
 namespace Internal {
@@ -264,6 +279,165 @@ void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &tre
    }
 }
 
+#ifdef R__HAS_ROOT7
+namespace {
+
+namespace RNTupleExp = ROOT::Experimental;
+
+/// Return the type of the RNTuple field that stores a column of the given type. Throw if there is none.
+std::string GetNTupleFieldType(const std::string &colName, const std::string &typeName)
+{
+   static const std::unordered_map<std::string, std::string> fundamentalTypes{
+      {"bool", "bool"},
+      {"float", "float"},
+      {"double", "double"},
+      {"unsigned char", "std::uint8_t"},
+      {"int", "std::int32_t"},
+      {"unsigned int", "std::uint32_t"},
+      {"ULong64_t", "std::uint64_t"},
+      {"unsigned long", sizeof(unsigned long) == 8 ? "std::uint64_t" : ""},
+      {"string", "std::string"},
+      {"std::string", "std::string"}};
+
+   const auto fundamentalIt = fundamentalTypes.find(typeName);
+   if (fundamentalIt != fundamentalTypes.end() && !fundamentalIt->second.empty())
+      return fundamentalIt->second;
+
+   // collections: the item type must be supported as well
+   for (const std::string prefix : {"ROOT::VecOps::RVec<", "std::vector<", "vector<"}) {
+      if (typeName.compare(0, prefix.size(), prefix) == 0 && typeName.back() == '>') {
+         const auto itemType = GetNTupleFieldType(colName, typeName.substr(prefix.size(), typeName.size() - prefix.size() - 1));
+         return (prefix[0] == 'R' ? "ROOT::VecOps::RVec<" : "std::vector<") + itemType + ">";
+      }
+   }
+
+   auto *cl = TClass::GetClass(typeName.c_str());
+   if (fundamentalIt == fundamentalTypes.end() && cl != nullptr && cl->HasDictionary() && !cl->GetCollectionProxy())
+      return typeName;
+
+   throw std::runtime_error("Snapshot: column \"" + colName + "\" of type " + typeName +
+                            " cannot be written to RNTuple.");
+}
+
+/// Writes the RNTuple of a Snapshot action with an RNTupleParallelWriter. Each slot fills its own clusters through
+/// its own fill context, hence slots do not need to synchronize except when committing a complete cluster.
+class RSnapshotNTupleSinkImpl final : public ROOT::Internal::RDF::RSnapshotNTupleSink {
+   const std::string fFileName;
+   const std::string fNTupleName;
+   const ColumnNames_t fFieldNames;
+   const std::vector<std::string> fFieldTypes;
+   const ROOT::RDF::RSnapshotOptions fOptions;
+   std::unique_ptr<TFile> fOutputFile; ///< Only used in "UPDATE" mode, must be destructed after fWriter
+   std::unique_ptr<RNTupleExp::RNTupleParallelWriter> fWriter;
+   std::vector<std::shared_ptr<RNTupleExp::RNTupleFillContext>> fFillContexts;
+   /// Per-slot entries that capture the values of the columns, must be destructed before fFillContexts
+   std::vector<std::unique_ptr<RNTupleExp::REntry>> fEntries;
+   /// Per-slot addresses of the values captured by fEntries, which change e.g. when a new TTree is read
+   std::vector<std::vector<void *>> fEntryAddresses;
+   /// Reads the RNTuple once it is written: its data source only opens the RNTuple on first use
+   std::shared_ptr<ROOT::RDataFrame> fSnapshotRDF;
+
+   void ResetEntry(unsigned int slot, void *const *values)
+   {
+      auto entry = std::make_unique<RNTupleExp::REntry>();
+      std::size_t i = 0;
+      for (auto &value : *fFillContexts[slot]->GetModel()->GetDefaultEntry())
+         entry->CaptureValue(value.GetField()->CaptureValue(values[i++]));
+      fEntries[slot] = std::move(entry);
+      fEntryAddresses[slot].assign(values, values + fFieldNames.size());
+   }
+
+public:
+   RSnapshotNTupleSinkImpl(unsigned int nSlots, const std::string &fileName, const std::string &ntupleName,
+                           const ColumnNames_t &fieldNames, const std::vector<std::string> &fieldTypes,
+                           const ROOT::RDF::RSnapshotOptions &options)
+      : fFileName(fileName), fNTupleName(ntupleName), fFieldNames(fieldNames), fFieldTypes(fieldTypes),
+        fOptions(options), fFillContexts(nSlots), fEntries(nSlots), fEntryAddresses(nSlots),
+        fSnapshotRDF(std::make_shared<ROOT::RDataFrame>(std::make_unique<RNTupleExp::RNTupleDS>(ntupleName, fileName)))
+   {
+   }
+
+   void Initialize() final
+   {
+      auto model = RNTupleExp::RNTupleModel::Create();
+      for (auto i = 0u; i < fFieldNames.size(); ++i) {
+         model->AddField(std::unique_ptr<RNTupleExp::Detail::RFieldBase>(
+            RNTupleExp::Detail::RFieldBase::Create(fFieldNames[i], fFieldTypes[i])));
+      }
+
+      RNTupleExp::RNTupleWriteOptions writeOptions;
+      writeOptions.SetCompression(ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel));
+
+      TString mode = fOptions.fMode;
+      mode.ToLower();
+      if (mode == "update") {
+         fOutputFile.reset(TFile::Open(fFileName.c_str(), "UPDATE"));
+         if (!fOutputFile || fOutputFile->IsZombie())
+            throw std::runtime_error("Snapshot: could not open output file " + fFileName);
+         fWriter = std::make_unique<RNTupleExp::RNTupleParallelWriter>(
+            std::move(model), std::make_unique<RNTupleExp::Detail::RPageSinkFile>(fNTupleName, *fOutputFile, writeOptions));
+      } else {
+         fWriter = RNTupleExp::RNTupleParallelWriter::Recreate(std::move(model), fNTupleName, fFileName, writeOptions);
+      }
+   }
+
+   void Fill(unsigned int slot, void *const *values) final
+   {
+      if (!fFillContexts[slot])
+         fFillContexts[slot] = fWriter->CreateFillContext();
+      const auto &addresses = fEntryAddresses[slot];
+      if (!fEntries[slot] || !std::equal(addresses.begin(), addresses.end(), values))
+         ResetEntry(slot, values);
+      fFillContexts[slot]->Fill(*fEntries[slot]);
+   }
+
+   void Finalize() final
+   {
+      fEntries.clear();
+      // destructing the fill contexts commits their last clusters, destructing the writer commits the RNTuple
+      fFillContexts.clear();
+      fWriter.reset();
+      if (fOutputFile)
+         fOutputFile->Close();
+      fOutputFile.reset();
+   }
+
+   std::shared_ptr<ROOT::RDataFrame> GetSnapshotRDF() final { return fSnapshotRDF; }
+};
+
+} // anonymous namespace
+#endif // R__HAS_ROOT7
+
+std::shared_ptr<RSnapshotNTupleSink>
+MakeSnapshotNTupleSink(unsigned int nSlots, const std::string &fileName, const std::string &dirName,
+                       const std::string &ntupleName, const ColumnNames_t &fieldNames,
+                       const std::vector<std::string> &typeNames, const RSnapshotOptions &options)
+{
+#ifdef R__HAS_ROOT7
+   if (!dirName.empty())
+      throw std::runtime_error("Snapshot: RNTuples cannot be written in a subdirectory of the output file.");
+   if (options.fAutoFlush != 0)
+      Warning("Snapshot", "RSnapshotOptions::fAutoFlush is ignored when writing RNTuple.");
+
+   std::vector<std::string> fieldTypes;
+   for (auto i = 0u; i < typeNames.size(); ++i)
+      fieldTypes.emplace_back(GetNTupleFieldType(fieldNames[i], typeNames[i]));
+
+   ValidateSnapshotOutput(options, ntupleName, fileName);
+
+   return std::make_shared<RSnapshotNTupleSinkImpl>(nSlots, fileName, ntupleName, fieldNames, fieldTypes, options);
+#else
+   (void)nSlots;
+   (void)fileName;
+   (void)dirName;
+   (void)ntupleName;
+   (void)fieldNames;
+   (void)typeNames;
+   (void)options;
+   throw std::runtime_error("Snapshot: writing RNTuple requires ROOT to be built with root7=ON.");
+#endif
+}
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
@@ -1,4 +1,7 @@
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/Utils.hxx" // Union
+#include "TError.h"           // R__ASSERT
 
 namespace ROOT {
 namespace Internal {
@@ -24,6 +27,53 @@ void RBookedDefines::AddName(std::string_view name)
    fDefinesNames = newColsNames;
 }
 
+void RBookedDefines::AddVariation(std::string_view variationName, const RVariationInfo &variation)
+{
+   auto newVariations = std::make_shared<RVariationsMap_t>(GetVariations());
+   (*newVariations)[std::string(variationName)] = variation;
+   fVariations = newVariations;
+}
+
+RBookedDefines::ColumnNames_t RBookedDefines::GetVariationDeps(const ColumnNames_t &columns) const
+{
+   ColumnNames_t deps;
+   for (const auto &col : columns) {
+      for (const auto &v : *fVariations) {
+         if (v.second.fColumnName == col)
+            deps = Union(deps, {v.first});
+      }
+      const auto it = fDefines->find(col);
+      if (it != fDefines->end())
+         deps = Union(deps, it->second->GetVariations());
+   }
+   return deps;
+}
+
+RBookedDefines RBookedDefines::GetVaried(const std::string &variationName, unsigned int tagIdx) const
+{
+   const auto itVariation = fVariations->find(variationName);
+   R__ASSERT(itVariation != fVariations->end());
+   const auto &variation = itVariation->second;
+   R__ASSERT(tagIdx < variation.fVariedColumns.size());
+
+   auto newCols = std::make_shared<RDefineBasePtrMap_t>(GetColumns());
+   for (auto &col : *newCols) {
+      const auto &deps = col.second->GetVariations();
+      if (std::find(deps.begin(), deps.end(), variationName) != deps.end())
+         col.second = col.second->GetVariedDefine(variationName, tagIdx);
+   }
+   (*newCols)[variation.fColumnName] = variation.fVariedColumns[tagIdx];
+
+   auto newNames = fDefinesNames;
+   if (!HasName(variation.fColumnName)) {
+      auto names = std::make_shared<ColumnNames_t>(GetNames());
+      names->emplace_back(variation.fColumnName);
+      newNames = names;
+   }
+
+   return RBookedDefines(newCols, newNames, fVariations);
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -11,8 +11,16 @@
 #include <ROOT/RDF/ColumnReaders.hxx>
 #include <ROOT/RDF/RDefineBase.hxx>
 #include <ROOT/RDF/Utils.hxx> // TypeID2TypeName
+#include <TBranch.h>
+#include <TBufferFile.h>
 #include <TClass.h>
+#include <TDataType.h>
+#include <TLeaf.h>
+#include <TMath.h> // BinarySearch
+#include <TTree.h>
 
+#include <algorithm>
+#include <cstring>   // std::memcpy
 #include <stdexcept> // std::runtime_error
 #include <string>
 #include <typeinfo>
@@ -50,3 +58,62 @@ void ROOT::Internal::RDF::CheckDefine(RDefineBase &define, const std::type_info
       throw std::runtime_error(errMsg);
    }
 }
+
+ROOT::Internal::RDF::RBulkBranchReader::RBulkBranchReader() = default;
+
+ROOT::Internal::RDF::RBulkBranchReader::~RBulkBranchReader() = default;
+
+/// Look up the branch in the tree. Return false if it cannot be read in bulk as values of the given type, e.g. because
+/// the type on disk is different, the branch holds arrays or it belongs to a friend tree.
+bool ROOT::Internal::RDF::RBulkBranchReader::Init(TTree &tree, const char *branchName, const std::type_info &valueType)
+{
+   fBranch = nullptr;
+   fBasketFirstEntry = 0;
+   fNBasketEntries = 0;
+
+   auto *branch = tree.GetBranch(branchName);
+   // the entries of friend trees are not necessarily the ones of the tree
+   if (!branch || branch->GetTree() != &tree || !branch->SupportsBulkRead())
+      return false;
+   auto *leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   if (leaf->GetLeafCount() || leaf->GetLenStatic() != 1)
+      return false;
+   // GetBulkEntries takes the baskets it reads away from the branch: all the entries must be in baskets on disk
+   if (branch->GetBasketEntry()[branch->GetWriteBasket()] != branch->GetEntries())
+      return false;
+   TClass *cl = nullptr;
+   EDataType type = kOther_t;
+   if (branch->GetExpectedType(cl, type) != 0 || cl || type != TDataType::GetType(valueType))
+      return false;
+
+   fBranch = branch;
+   fValueSize = TDataType::GetDataType(type)->Size();
+   if (!fBuffer)
+      fBuffer = std::make_unique<TBufferFile>(TBuffer::kWrite, 32 * 1024);
+   return true;
+}
+
+/// Copy the values of nEntries consecutive entries in the values array, reading the baskets that hold them.
+void ROOT::Internal::RDF::RBulkBranchReader::Read(Long64_t firstEntry, std::size_t nEntries, void *values)
+{
+   auto dest = static_cast<char *>(values);
+   const Long64_t endEntry = firstEntry + nEntries;
+   for (auto entry = firstEntry; entry < endEntry;) {
+      if (entry < fBasketFirstEntry || entry >= fBasketFirstEntry + fNBasketEntries) {
+         // GetBulkEntries only reads whole baskets
+         const auto *basketEntries = fBranch->GetBasketEntry();
+         const auto basket = TMath::BinarySearch(fBranch->GetWriteBasket() + 1, basketEntries, entry);
+         fBasketFirstEntry = basketEntries[basket];
+         fNBasketEntries = fBranch->GetBulkRead().GetBulkEntries(fBasketFirstEntry, *fBuffer);
+         if (fNBasketEntries <= 0 || entry >= fBasketFirstEntry + fNBasketEntries) {
+            fNBasketEntries = 0;
+            throw std::runtime_error(std::string("RDataFrame: could not read the entries of branch ") +
+                                     fBranch->GetName() + " in bulk.");
+         }
+      }
+      const auto n = std::min(endEntry, fBasketFirstEntry + fNBasketEntries) - entry;
+      std::memcpy(dest, fBuffer->GetCurrent() + (entry - fBasketFirstEntry) * fValueSize, n * fValueSize);
+      dest += n * fValueSize;
+      entry += n;
+   }
+}
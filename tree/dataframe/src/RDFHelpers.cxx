@@ -0,0 +1,65 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDFHelpers.hxx"
+
+#include "RConfigure.h" // R__USE_IMT
+#include "TError.h"     // Warning
+#include "TROOT.h"      // IsImplicitMTEnabled
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <set>
+
+void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
+{
+   if (handles.empty()) {
+      Warning("RunGraphs", "Got an empty list of handles");
+      return;
+   }
+
+   // Check that there are results which have not yet been run
+   const unsigned int nToRun =
+      std::count_if(handles.begin(), handles.end(), [](const auto &h) { return !h.IsReady(); });
+   if (nToRun < handles.size()) {
+      Warning("RunGraphs", "Got %lu handles from which %u link to results which are already ready.", handles.size(),
+              static_cast<unsigned int>(handles.size()) - nToRun);
+   }
+   if (nToRun == 0u)
+      return;
+
+   // Find the unique event loops that still have to run
+   auto sameGraph = [](const RResultHandle &a, const RResultHandle &b) { return a.fLoopManager < b.fLoopManager; };
+   std::set<RResultHandle, decltype(sameGraph)> s(sameGraph);
+   for (const auto &h : handles) {
+      if (!h.IsReady())
+         s.insert(h);
+   }
+   std::vector<RResultHandle> uniqueLoops(s.begin(), s.end());
+
+   // Trigger jitting. The code of all computation graphs is collected in a single global string, so one call is
+   // enough to compile the code required by all of them; the event loops below then find nothing left to jit.
+   uniqueLoops[0].fLoopManager->Jit();
+
+   // Trigger the unique event loops
+   auto run = [](RResultHandle &h) { h.TriggerRun(); };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && uniqueLoops.size() > 1) {
+      // Each event loop schedules its own tasks on the same task arena, so that idle workers at the end of an event
+      // loop pick up work from the other event loops
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(run, uniqueLoops);
+      return;
+   }
+#endif
+   for (auto &h : uniqueLoops)
+      run(h);
+}
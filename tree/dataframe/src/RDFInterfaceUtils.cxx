@@ -216,9 +216,19 @@ BuildLambdaString(const std::string &expr, const ColumnNames_t &vars, const Colu
    return ss.str();
 }
 
+/// Return the code that declares the jitted lambda `lambdaBaseName` in namespace __rdf, with its return type alias.
+static std::string LambdaDeclaration(const std::string &lambdaBaseName, const std::string &lambdaExpr)
+{
+   return "namespace __rdf {\nauto " + lambdaBaseName + " = " + lambdaExpr + ";\nusing " + lambdaBaseName +
+          "_ret_t = typename ROOT::TypeTraits::CallableTraits<decltype(" + lambdaBaseName + ")>::ret_type;\n}";
+}
+
 /// Declare a lambda expression to the interpreter in namespace __rdf, return the name of the jitted lambda.
 /// If the lambda expression is already in GetJittedExprs, return the name for the lambda that has already been jitted.
-static std::string DeclareLambda(const std::string &expr, const ColumnNames_t &vars, const ColumnNames_t &varTypes)
+/// The code of the declaration is written in `declaration`, so that jitted code that uses the lambda can be compiled
+/// outside of the interpreter (see RJitCache).
+static std::string DeclareLambda(const std::string &expr, const ColumnNames_t &vars, const ColumnNames_t &varTypes,
+                                 std::string &declaration)
 {
    const auto lambdaExpr = BuildLambdaString(expr, vars, varTypes);
    auto &exprMap = GetJittedExprs();
@@ -226,6 +236,7 @@ static std::string DeclareLambda(const std::string &expr, const ColumnNames_t &v
    if (exprIt != exprMap.end()) {
       // expression already there
       const auto lambdaName = exprIt->second;
+      declaration = LambdaDeclaration(lambdaName.substr(std::string("__rdf::").size()), lambdaExpr);
       return lambdaName;
    }
 
@@ -233,10 +244,8 @@ static std::string DeclareLambda(const std::string &expr, const ColumnNames_t &v
    const auto lambdaBaseName = "lambda" + std::to_string(exprMap.size());
    const auto lambdaFullName = "__rdf::" + lambdaBaseName;
 
-   const auto toDeclare = "namespace __rdf {\nauto " + lambdaBaseName + " = " + lambdaExpr + ";\nusing " +
-                          lambdaBaseName + "_ret_t = typename ROOT::TypeTraits::CallableTraits<decltype(" +
-                          lambdaBaseName + ")>::ret_type;\n}";
-   ROOT::Internal::RDF::InterpreterDeclare(toDeclare.c_str());
+   declaration = LambdaDeclaration(lambdaBaseName, lambdaExpr);
+   ROOT::Internal::RDF::InterpreterDeclare(declaration.c_str());
 
    // InterpreterDeclare could throw. If it doesn't, mark the lambda as already jitted
    exprMap.insert({lambdaExpr, lambdaFullName});
@@ -336,6 +345,12 @@ HeadNode_t CreateSnapshotRDF(const ColumnNames_t &validCols,
    // create new RDF
    ::TDirectory::TContext ctxt;
    auto snapshotRDF = std::make_shared<ROOT::RDataFrame>(treeName, fileName, validCols);
+   return CreateSnapshotRDF(snapshotRDF, isLazy, loopManager, std::move(actionPtr));
+}
+
+HeadNode_t CreateSnapshotRDF(const std::shared_ptr<ROOT::RDataFrame> &snapshotRDF, bool isLazy,
+                             RLoopManager &loopManager, std::unique_ptr<RDFInternal::RActionBase> actionPtr)
+{
    auto snapshotRDFResPtr = MakeResultPtr(snapshotRDF, loopManager, std::move(actionPtr));
 
    if (!isLazy) {
@@ -535,18 +550,20 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
       ParseRDFExpression(std::string(expression), branches, customCols.GetNames(), dsColumns, aliasMap);
    const auto exprVarTypes =
       GetValidatedArgTypes(parsedExpr.fUsedCols, customCols, tree, ds, "Filter", /*vector2rvec=*/true);
-   const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
+   std::string lambdaDeclaration;
+   const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes, lambdaDeclaration);
    const auto type = RetTypeOfLambda(lambdaName);
    if (type != "bool")
       std::runtime_error("Filter: the following expression does not evaluate to bool:\n" + std::string(expression));
 
+   // the concrete filter only exists after jitting, but downstream nodes need to know the variations that affect it
+   jittedFilter->SetVariations(
+      Union((*prevNodeOnHeap)->GetVariations(), customCols.GetVariationDeps(parsedExpr.fUsedCols)));
+
    // definesOnHeap is deleted by the jitted call to JitFilterHelper
    ROOT::Internal::RDF::RBookedDefines *definesOnHeap = new ROOT::Internal::RDF::RBookedDefines(customCols);
-   const auto definesOnHeapAddr = PrettyPrintAddr(definesOnHeap);
-   const auto prevNodeAddr = PrettyPrintAddr(prevNodeOnHeap);
 
    // Produce code snippet that creates the filter and registers it with the corresponding RJittedFilter
-   // Windows requires std::hex << std::showbase << (size_t)pointer to produce notation "0x1234"
    std::stringstream filterInvocation;
    filterInvocation << "ROOT::Internal::RDF::JitFilterHelper(" << lambdaName << ", {";
    for (const auto &col : parsedExpr.fUsedCols)
@@ -558,14 +575,19 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
    // - prevNodeOnHeap: heap-allocated shared_ptr to the actual previous node that will be deleted by JitFilterHelper
    // - definesOnHeap: heap-allocated, will be deleted by JitFilterHelper
    filterInvocation << "}, \"" << name << "\", "
-                    << "reinterpret_cast<std::weak_ptr<ROOT::Detail::RDF::RJittedFilter>*>("
-                    << PrettyPrintAddr(MakeWeakOnHeap(jittedFilter)) << "), "
-                    << "reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>(" << prevNodeAddr << "),"
-                    << "reinterpret_cast<ROOT::Internal::RDF::RBookedDefines*>(" << definesOnHeapAddr << ")"
-                    << ");\n";
+                    << "reinterpret_cast<std::weak_ptr<ROOT::Detail::RDF::RJittedFilter>*>(";
+   RJitSnippet snippet;
+   snippet.SetDeclarations(lambdaDeclaration);
+   snippet.AppendCode(filterInvocation.str())
+      .AppendAddr(MakeWeakOnHeap(jittedFilter))
+      .AppendCode("), reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>(")
+      .AppendAddr(prevNodeOnHeap)
+      .AppendCode("),reinterpret_cast<ROOT::Internal::RDF::RBookedDefines*>(")
+      .AppendAddr(definesOnHeap)
+      .AppendCode("));\n");
 
    auto lm = jittedFilter->GetLoopManagerUnchecked();
-   lm->ToJitExec(filterInvocation.str());
+   lm->ToJitExec(snippet);
 }
 
 // Jit a Define call
@@ -582,12 +604,13 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
       ParseRDFExpression(std::string(expression), branches, customCols.GetNames(), dsColumns, aliasMap);
    const auto exprVarTypes =
       GetValidatedArgTypes(parsedExpr.fUsedCols, customCols, tree, ds, "Define", /*vector2rvec=*/true);
-   const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
+   std::string lambdaDeclaration;
+   const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes, lambdaDeclaration);
    const auto type = RetTypeOfLambda(lambdaName);
 
    auto definesCopy = new RDFInternal::RBookedDefines(customCols);
-   auto definesAddr = PrettyPrintAddr(definesCopy);
    auto jittedDefine = std::make_shared<RDFDetail::RJittedDefine>(name, type, lm.GetNSlots(), lm.GetDSValuePtrs());
+   jittedDefine->SetVariations(customCols.GetVariationDeps(parsedExpr.fUsedCols));
 
    std::stringstream defineInvocation;
    defineInvocation << "ROOT::Internal::RDF::JitDefineHelper(" << lambdaName << ", {";
@@ -599,21 +622,27 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
    // lifetime of pointees:
    // - lm is the loop manager, and if that goes out of scope jitting does not happen at all (i.e. will always be valid)
    // - jittedDefine: heap-allocated weak_ptr that will be deleted by JitDefineHelper after usage
-   // - definesAddr: heap-allocated, will be deleted by JitDefineHelper after usage
-   defineInvocation << "}, \"" << name << "\", reinterpret_cast<ROOT::Detail::RDF::RLoopManager*>("
-                    << PrettyPrintAddr(&lm) << "), reinterpret_cast<std::weak_ptr<ROOT::Detail::RDF::RJittedDefine>*>("
-                    << PrettyPrintAddr(MakeWeakOnHeap(jittedDefine))
-                    << "), reinterpret_cast<ROOT::Internal::RDF::RBookedDefines*>(" << definesAddr
-                    << "), reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>("
-                    << PrettyPrintAddr(upcastNodeOnHeap) << "));\n";
-
-   lm.ToJitExec(defineInvocation.str());
+   // - definesCopy: heap-allocated, will be deleted by JitDefineHelper after usage
+   defineInvocation << "}, \"" << name << "\", reinterpret_cast<ROOT::Detail::RDF::RLoopManager*>(";
+   RJitSnippet snippet;
+   snippet.SetDeclarations(lambdaDeclaration);
+   snippet.AppendCode(defineInvocation.str())
+      .AppendAddr(&lm)
+      .AppendCode("), reinterpret_cast<std::weak_ptr<ROOT::Detail::RDF::RJittedDefine>*>(")
+      .AppendAddr(MakeWeakOnHeap(jittedDefine))
+      .AppendCode("), reinterpret_cast<ROOT::Internal::RDF::RBookedDefines*>(")
+      .AppendAddr(definesCopy)
+      .AppendCode("), reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>(")
+      .AppendAddr(upcastNodeOnHeap)
+      .AppendCode("));\n");
+
+   lm.ToJitExec(snippet);
    return jittedDefine;
 }
 
 // Jit and call something equivalent to "this->BuildAndBook<ColTypes...>(params...)"
 // (see comments in the body for actual jitted code)
-std::string JitBuildAction(const ColumnNames_t &bl, std::shared_ptr<RDFDetail::RNodeBase> *prevNode,
+RJitSnippet JitBuildAction(const ColumnNames_t &bl, std::shared_ptr<RDFDetail::RNodeBase> *prevNode,
                            const std::type_info &art, const std::type_info &at, void *rOnHeap, TTree *tree,
                            const unsigned int nSlots, const RDFInternal::RBookedDefines &customCols, RDataSource *ds,
                            std::weak_ptr<RJittedAction> *jittedActionOnHeap)
@@ -635,7 +664,6 @@ std::string JitBuildAction(const ColumnNames_t &bl, std::shared_ptr<RDFDetail::R
    const auto actionTypeName = actionTypeClass->GetName();
 
    auto definesCopy = new RDFInternal::RBookedDefines(customCols); // deleted in jitted CallBuildAction
-   auto definesAddr = PrettyPrintAddr(definesCopy);
 
    // Build a call to CallBuildAction with the appropriate argument. When run through the interpreter, this code will
    // just-in-time create an RAction object and it will assign it to its corresponding RJittedAction.
@@ -644,21 +672,27 @@ std::string JitBuildAction(const ColumnNames_t &bl, std::shared_ptr<RDFDetail::R
    const auto columnTypeNames = GetValidatedArgTypes(bl, customCols, tree, ds, actionTypeName, /*vector2rvec=*/true);
    for (auto &colType : columnTypeNames)
       createAction_str << ", " << colType;
-   // on Windows, to prefix the hexadecimal value of a pointer with '0x',
-   // one need to write: std::hex << std::showbase << (size_t)pointer
-   createAction_str << ">(reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>("
-                    << PrettyPrintAddr(prevNode) << "), {";
+   createAction_str << ">(reinterpret_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase>*>(";
+   std::stringstream columnsAndSlots_str;
+   columnsAndSlots_str << "), {";
    for (auto i = 0u; i < bl.size(); ++i) {
       if (i != 0u)
-         createAction_str << ", ";
-      createAction_str << '"' << bl[i] << '"';
+         columnsAndSlots_str << ", ";
+      columnsAndSlots_str << '"' << bl[i] << '"';
    }
-   createAction_str << "}, " << nSlots << ", reinterpret_cast<" << actionResultTypeName << "*>("
-                    << PrettyPrintAddr(rOnHeap)
-                    << "), reinterpret_cast<std::weak_ptr<ROOT::Internal::RDF::RJittedAction>*>("
-                    << PrettyPrintAddr(jittedActionOnHeap)
-                    << "), reinterpret_cast<ROOT::Internal::RDF::RBookedDefines*>(" << definesAddr << "));";
-   return createAction_str.str();
+   columnsAndSlots_str << "}, " << nSlots << ", reinterpret_cast<" << actionResultTypeName << "*>(";
+
+   RJitSnippet snippet;
+   snippet.AppendCode(createAction_str.str())
+      .AppendAddr(prevNode)
+      .AppendCode(columnsAndSlots_str.str())
+      .AppendAddr(rOnHeap)
+      .AppendCode("), reinterpret_cast<std::weak_ptr<ROOT::Internal::RDF::RJittedAction>*>(")
+      .AppendAddr(jittedActionOnHeap)
+      .AppendCode("), reinterpret_cast<ROOT::Internal::RDF::RBookedDefines*>(")
+      .AppendAddr(definesCopy)
+      .AppendCode("));");
+   return snippet;
 }
 
 bool AtLeastOneEmptyString(const std::vector<std::string_view> strings)
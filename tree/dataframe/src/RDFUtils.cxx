@@ -24,6 +24,7 @@
 #include "TROOT.h" // IsImplicitMTEnabled, GetThreadPoolSize
 #include "TTree.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <cstring>
@@ -325,6 +326,15 @@ Long64_t InterpreterCalc(const std::string &code, const std::string &context)
    return res;
 }
 
+std::vector<std::string> Union(const std::vector<std::string> &v1, const std::vector<std::string> &v2)
+{
+   std::vector<std::string> res = v1;
+   res.insert(res.end(), v2.begin(), v2.end());
+   std::sort(res.begin(), res.end());
+   res.erase(std::unique(res.begin(), res.end()), res.end());
+   return res;
+}
+
 bool IsInternalColumn(std::string_view colName)
 {
    const auto str = colName.data();
@@ -12,6 +12,7 @@
 #include "ROOT/RStringView.hxx"
 #include "RtypesCore.h" // Long64_t
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -45,3 +46,16 @@ std::string RDefineBase::GetTypeName() const
 {
    return fType;
 }
+
+std::shared_ptr<RDefineBase> RDefineBase::GetVariedDefine(const std::string &variationName, unsigned int tagIdx)
+{
+   auto &varied = fVariedDefines[{variationName, tagIdx}];
+   if (!varied)
+      varied = MakeVariedDefine(variationName, tagIdx);
+   return varied;
+}
+
+std::shared_ptr<RDefineBase> RDefineBase::MakeVariedDefine(const std::string &, unsigned int)
+{
+   throw std::logic_error("Column \"" + fName + "\" does not support systematic variations.");
+}
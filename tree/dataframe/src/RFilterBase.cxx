@@ -17,7 +17,7 @@ using namespace ROOT::Detail::RDF;
 RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const unsigned int nSlots,
                          const RDFInternal::RBookedDefines &defines)
    : RNodeBase(implPtr), fLastResult(nSlots), fAccepted(nSlots), fRejected(nSlots), fName(name), fNSlots(nSlots),
-     fDefines(defines) {}
+     fBulkMasks(nSlots), fDefines(defines) {}
 
 // outlined to pin virtual table
 RFilterBase::~RFilterBase() {}
@@ -44,6 +44,7 @@ void RFilterBase::FillReport(ROOT::RDF::RCutFlowReport &rep) const
 void RFilterBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
+   fLastBulkEntry = std::vector<Long64_t>(fNSlots, -1);
    if (!fName.empty()) // if this is a named filter we care about its report count
       ResetReportCount();
 }
@@ -0,0 +1,440 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RJitCache.hxx"
+#include "ROOT/RDF/InterfaceUtils.hxx" // PrettyPrintAddr
+#include "TError.h"                    // Warning
+#include "TMD5.h"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ROOT::Internal::RDF::RJitCache;
+using ROOT::Internal::RDF::RJitSnippet;
+
+namespace {
+
+/// The signature of the function that runs the cached code, taking the addresses of all snippets in one array
+using JitCacheEntryPoint_t = void (*)(void *const *);
+using JitCacheJitTime_t = double (*)();
+
+std::string GetEntryPointName(const std::string &key)
+{
+   return "rdfjit_" + key;
+}
+
+bool Exists(const std::string &path)
+{
+   // AccessPathName returns false if the path exists
+   return !gSystem->AccessPathName(path.c_str());
+}
+
+/// The declarations and the code of a snippet as they are compiled into the cached library, see NormalizeSnippets
+struct RNormalizedSnippet {
+   std::string fDeclarations;
+   std::string fCode;
+};
+
+/// Renames the jitted lambdas `__rdf::lambdaN` after the order in which they are first used. Their number otherwise
+/// depends on all the expressions jitted before in the process, which would give different cache keys to the same
+/// code.
+class RLambdaRenamer {
+   std::map<std::string, std::string> fNames;
+
+   const std::string &GetName(const std::string &name)
+   {
+      auto it = fNames.find(name);
+      if (it == fNames.end())
+         it = fNames.emplace(name, "lambda" + std::to_string(fNames.size())).first;
+      return it->second;
+   }
+
+   /// The declaration of a jitted lambda and of its return type, see LambdaDeclaration in RDFInterfaceUtils.cxx
+   static std::string DeclarationPrefix() { return "namespace __rdf {\nauto "; }
+   static std::string DeclarationSuffix(const std::string &name)
+   {
+      return ";\nusing " + name + "_ret_t = typename ROOT::TypeTraits::CallableTraits<decltype(" + name +
+             ")>::ret_type;\n}";
+   }
+
+public:
+   /// Rename the lambda declared by the declarations of a snippet. Only the name of the lambda is replaced: the
+   /// expression, which may contain the same characters, is left as is.
+   std::string RenameInDeclarations(const std::string &declarations)
+   {
+      const auto prefix = DeclarationPrefix();
+      if (declarations.compare(0, prefix.size(), prefix) != 0)
+         return declarations;
+      const auto nameEnd = declarations.find(" = ", prefix.size());
+      if (nameEnd == std::string::npos)
+         return declarations;
+      const auto name = declarations.substr(prefix.size(), nameEnd - prefix.size());
+      const auto suffix = DeclarationSuffix(name);
+      if (declarations.size() < nameEnd + suffix.size() ||
+          declarations.compare(declarations.size() - suffix.size(), suffix.size(), suffix) != 0)
+         return declarations;
+      const auto &newName = GetName(name);
+      return prefix + newName + declarations.substr(nameEnd, declarations.size() - suffix.size() - nameEnd) +
+             DeclarationSuffix(newName);
+   }
+
+   /// Rename the lambdas used by the code of a snippet
+   std::string RenameInCode(const std::string &code)
+   {
+      const std::string nsPrefix = "__rdf::";
+      const std::string lambdaPrefix = nsPrefix + "lambda";
+      std::string result;
+      std::size_t pos = 0;
+      while (true) {
+         const auto start = code.find(lambdaPrefix, pos);
+         if (start == std::string::npos)
+            break;
+         auto end = start + lambdaPrefix.size();
+         while (end < code.size() && code[end] >= '0' && code[end] <= '9')
+            ++end;
+         result += code.substr(pos, start - pos);
+         result += nsPrefix + GetName(code.substr(start + nsPrefix.size(), end - start - nsPrefix.size()));
+         pos = end;
+      }
+      return result + code.substr(pos);
+   }
+};
+
+/// Return the declarations and the code of the snippets as compiled into the cached library: the addresses are read
+/// from the array of arguments of the entry point, and the jitted lambdas are renamed by RLambdaRenamer.
+std::vector<RNormalizedSnippet> NormalizeSnippets(const std::vector<RJitSnippet> &snippets)
+{
+   RLambdaRenamer renamer;
+   std::vector<RNormalizedSnippet> normalized;
+   std::size_t nArgs = 0;
+   for (const auto &s : snippets) {
+      auto declarations = renamer.RenameInDeclarations(s.GetDeclarations());
+      auto code = renamer.RenameInCode(s.RenderWithArgs("args", nArgs));
+      normalized.push_back({std::move(declarations), std::move(code)});
+      nArgs += s.GetAddrs().size();
+   }
+   return normalized;
+}
+
+/// Escape a string to be written as a C++ string literal
+std::string EscapeString(const std::string &s)
+{
+   std::string escaped;
+   for (const char c : s) {
+      if (c == '\\' || c == '"')
+         escaped += '\\';
+      escaped += c;
+   }
+   return escaped;
+}
+
+/// Return the source code of the shared library stored in the cache for the given snippets.
+/// The declarations the snippets depend on are repeated in a namespace of their own, which hides them from the
+/// declarations with the same names that the interpreter already knows. The whole code is hidden from rootcling so
+/// that the dictionary generated by ACLiC stays empty.
+std::string MakeLibrarySource(const std::vector<RNormalizedSnippet> &snippets, const std::string &key, double jitTime)
+{
+   const auto entryPoint = GetEntryPointName(key);
+   std::string code = "#if !defined(__CLING__)\n#include \"ROOT/RDataFrame.hxx\"\n#include \"ROOT/RVec.hxx\"\n"
+                      "#include \"TMath.h\"\n\nnamespace " +
+                      entryPoint + " {\n";
+
+   // the same lambda can be used by several snippets, but must be declared once
+   std::set<std::string> declared;
+   for (const auto &s : snippets) {
+      if (!s.fDeclarations.empty() && declared.insert(s.fDeclarations).second)
+         code += s.fDeclarations + "\n";
+   }
+
+   code += "void Run(void *const *args)\n{\n";
+   for (const auto &s : snippets)
+      code += s.fCode + "\n";
+   code += "}\n} // namespace " + entryPoint + "\n\n";
+
+   code += "extern \"C\" void " + entryPoint + "(void *const *args)\n{\n   " + entryPoint + "::Run(args);\n}\n\n";
+   code += "extern \"C\" double " + entryPoint + "_jittime()\n{\n   return " + std::to_string(jitTime) + ";\n}\n";
+   code += "#endif\n";
+   return code;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+RJitSnippet &RJitSnippet::AppendCode(const std::string &code)
+{
+   fCode.back() += code;
+   return *this;
+}
+
+RJitSnippet &RJitSnippet::AppendAddr(const void *addr)
+{
+   fAddrs.emplace_back(addr);
+   fCode.emplace_back();
+   return *this;
+}
+
+std::string RJitSnippet::Render() const
+{
+   std::string code = fCode[0];
+   for (auto i = 0u; i < fAddrs.size(); ++i)
+      code += PrettyPrintAddr(fAddrs[i]) + fCode[i + 1];
+   return code;
+}
+
+std::string RJitSnippet::RenderWithArgs(const std::string &argsName, std::size_t firstArg) const
+{
+   std::string code = fCode[0];
+   for (auto i = 0u; i < fAddrs.size(); ++i)
+      code += argsName + "[" + std::to_string(firstArg + i) + "]" + fCode[i + 1];
+   return code;
+}
+
+RJitCache::RJitCache()
+{
+   const char *dir = gSystem->Getenv("ROOT_RDF_JITCACHE");
+   if (dir == nullptr || dir[0] == '\0')
+      return;
+   if (!Exists(dir) && gSystem->mkdir(dir, /*recursive=*/true) != 0) {
+      Warning("RJitCache", "Cannot create the jit cache directory %s, the jit cache is disabled.", dir);
+      return;
+   }
+   fDirectory = dir;
+}
+
+/// The key identifies the compiled code: it must change whenever the code, the declarations it uses (which also
+/// encode the column types) or the ROOT build change. It does not depend on the numbering of the jitted lambdas,
+/// so that the same expressions booked in a different order or after other expressions share a cache entry.
+std::string RJitCache::GetKey(const std::vector<RJitSnippet> &snippets)
+{
+   TMD5 md5;
+   auto update = [&md5](const std::string &s) {
+      md5.Update(reinterpret_cast<const UChar_t *>(s.data()), s.size());
+      // separator, so that different splits of the same text produce different keys
+      md5.Update(reinterpret_cast<const UChar_t *>("\n"), 1);
+   };
+   update(gROOT->GetVersion());
+   update(gROOT->GetGitCommit());
+   update(gSystem->GetBuildArch());
+   update(gSystem->GetBuildCompilerVersion());
+   for (const auto &s : NormalizeSnippets(snippets)) {
+      update(s.fDeclarations);
+      update(s.fCode);
+   }
+   md5.Final();
+   return md5.AsString();
+}
+
+std::string RJitCache::GetLibraryPath(const std::string &directory, const std::string &key)
+{
+   return directory + "/" + GetEntryPointName(key) + "." + gSystem->GetSoExt();
+}
+
+std::string RJitCache::GetDirectory() const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fDirectory;
+}
+
+void RJitCache::SetDirectory(const std::string &directory)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   fDirectory = directory;
+}
+
+ROOT::RDF::Experimental::RJitCacheStats RJitCache::GetStats() const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fStats;
+}
+
+void RJitCache::CountMiss()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   ++fStats.fNMisses;
+}
+
+bool RJitCache::Run(const std::vector<RJitSnippet> &snippets)
+{
+   const auto start = std::chrono::steady_clock::now();
+
+   const auto directory = GetDirectory();
+   if (directory.empty())
+      return false;
+   const auto key = GetKey(snippets);
+   const auto libPath = GetLibraryPath(directory, key);
+   if (!Exists(libPath)) {
+      CountMiss();
+      return false;
+   }
+
+   if (gSystem->Load(libPath.c_str()) < 0) {
+      Warning("RJitCache::Run", "Cannot load %s, falling back to just-in-time compilation.", libPath.c_str());
+      CountMiss();
+      return false;
+   }
+   const auto entryPointName = GetEntryPointName(key);
+   auto entryPoint = reinterpret_cast<JitCacheEntryPoint_t>(gSystem->DynFindSymbol(libPath.c_str(), entryPointName.c_str()));
+   auto jitTime =
+      reinterpret_cast<JitCacheJitTime_t>(gSystem->DynFindSymbol(libPath.c_str(), (entryPointName + "_jittime").c_str()));
+   if (entryPoint == nullptr || jitTime == nullptr) {
+      Warning("RJitCache::Run", "Cannot find the entry point of %s, falling back to just-in-time compilation.",
+              libPath.c_str());
+      CountMiss();
+      return false;
+   }
+
+   std::vector<void *> args;
+   for (const auto &s : snippets)
+      for (const auto *addr : s.GetAddrs())
+         args.emplace_back(const_cast<void *>(addr));
+   entryPoint(args.data());
+
+   const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+   std::lock_guard<std::mutex> lock(fMutex);
+   ++fStats.fNHits;
+   fStats.fJitTimeSaved += jitTime() - elapsed.count();
+   return true;
+}
+
+/// The source of the library is written to a temporary directory, and it is compiled there by a separate ROOT
+/// process, see BuildLibrary, so that the event loop that just jitted the code does not wait for the compilation.
+void RJitCache::Store(const std::vector<RJitSnippet> &snippets, double jitTime)
+{
+   const auto directory = GetDirectory();
+   if (directory.empty())
+      return;
+   const auto key = GetKey(snippets);
+   const auto libPath = GetLibraryPath(directory, key);
+   const auto failPath = directory + "/" + GetEntryPointName(key) + ".fail";
+   if (Exists(libPath) || Exists(failPath))
+      return;
+
+   const auto tmpDir = directory + "/tmp_" + key + "_" + std::to_string(gSystem->GetPid());
+   if (gSystem->mkdir(tmpDir.c_str(), /*recursive=*/true) != 0) {
+      Warning("RJitCache::Store", "Cannot create directory %s, the jitted code is not cached.", tmpDir.c_str());
+      return;
+   }
+   {
+      std::ofstream src(tmpDir + "/" + GetEntryPointName(key) + ".cxx");
+      src << MakeLibrarySource(NormalizeSnippets(snippets), key, jitTime);
+   }
+
+#ifdef R__WIN32
+   BuildLibrary(directory, tmpDir, key);
+#else
+   const auto driverPath = tmpDir + "/build.C";
+   {
+      std::ofstream driver(driverPath);
+      driver << "R__LOAD_LIBRARY(ROOTDataFrame)\n#include \"ROOT/RDF/RJitCache.hxx\"\n#include \"TSystem.h\"\n\n"
+             << "void build()\n{\n   gSystem->SetIncludePath(\"" << EscapeString(gSystem->GetIncludePath())
+             << "\");\n   ROOT::Internal::RDF::RJitCache::BuildLibrary(\"" << EscapeString(directory) << "\", \""
+             << EscapeString(tmpDir) << "\", \"" << key << "\");\n}\n";
+   }
+   const std::string rootExe = std::string(TROOT::GetBinDir().Data()) + "/root.exe";
+   const auto command = "\"" + rootExe + "\" -l -b -q \"" + driverPath + "\" > /dev/null 2>&1 &";
+   if (gSystem->Exec(command.c_str()) != 0)
+      BuildLibrary(directory, tmpDir, key);
+#endif
+}
+
+/// The library is compiled in a temporary directory and moved to the cache directory when complete, so that
+/// processes sharing the cache directory never load a partially written library. If the compilation fails, e.g.
+/// because the code uses functions that were only declared to the interpreter, a marker file prevents further
+/// attempts for the same code.
+void RJitCache::BuildLibrary(const std::string &directory, const std::string &tmpDir, const std::string &key)
+{
+   const auto baseName = GetEntryPointName(key);
+   const auto srcPath = tmpDir + "/" + baseName + ".cxx";
+   const auto libPath = GetLibraryPath(directory, key);
+   const auto failPath = directory + "/" + baseName + ".fail";
+
+   // k: keep the library, O: optimize, c: compile but do not load, s: silent, -: do not create subdirectories
+   const auto tmpLibName = tmpDir + "/" + baseName;
+   const bool compiled = gSystem->CompileMacro(srcPath.c_str(), "kOcs-", tmpLibName.c_str(), tmpDir.c_str()) == 1;
+
+   // move the auxiliary files (e.g. the dictionary pcm) first and the library last
+   const auto tmpLibPath = tmpLibName + "." + gSystem->GetSoExt();
+   if (compiled && Exists(tmpLibPath)) {
+      if (void *dirp = gSystem->OpenDirectory(tmpDir.c_str())) {
+         while (const char *entry = gSystem->GetDirEntry(dirp)) {
+            const std::string fileName = entry;
+            if (fileName == "." || fileName == ".." || fileName == "build.C" || tmpDir + "/" + fileName == tmpLibPath)
+               continue;
+            gSystem->Rename((tmpDir + "/" + fileName).c_str(), (directory + "/" + fileName).c_str());
+         }
+         gSystem->FreeDirectory(dirp);
+      }
+      gSystem->Rename(tmpLibPath.c_str(), libPath.c_str());
+   } else {
+      std::ofstream fail(failPath);
+   }
+
+   // clean up whatever is left in the temporary directory
+   if (void *dirp = gSystem->OpenDirectory(tmpDir.c_str())) {
+      while (const char *entry = gSystem->GetDirEntry(dirp)) {
+         const std::string fileName = entry;
+         if (fileName != "." && fileName != "..")
+            gSystem->Unlink((tmpDir + "/" + fileName).c_str());
+      }
+      gSystem->FreeDirectory(dirp);
+   }
+   gSystem->Unlink(tmpDir.c_str());
+}
+
+RJitCache &GetJitCache()
+{
+   static RJitCache cache;
+   return cache;
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+/// Enable the on-disk cache of jitted RDataFrame code in the given directory, which is created if needed.
+/// The code that RDataFrame compiles just-in-time to build the nodes of computation graphs that use string
+/// expressions or jitted actions (e.g. `Filter("x > 0")` or `Histo1D("x")`) is compiled once into a shared library
+/// stored in the cache directory. Processes that jit the same code, with the same column types and the same ROOT
+/// version, load that library instead of invoking the interpreter.
+///
+/// Code missing from the cache is compiled in the background by a separate ROOT process, so the first process that
+/// jits it is not slowed down; the library is used by the processes started after it is built. Code that uses
+/// functions or types only known to the interpreter (e.g. declared with `gInterpreter->Declare`) cannot be cached
+/// and is always jitted. The cache can also be enabled by setting the `ROOT_RDF_JITCACHE` environment variable to the
+/// path of the cache directory. Throws if the directory cannot be created.
+void ROOT::RDF::Experimental::EnableJitCache(std::string_view directory)
+{
+   const std::string dir(directory);
+   if (dir.empty())
+      throw std::runtime_error("EnableJitCache: the cache directory must not be empty.");
+   if (!Exists(dir) && gSystem->mkdir(dir.c_str(), /*recursive=*/true) != 0)
+      throw std::runtime_error("EnableJitCache: cannot create directory " + dir + ".");
+   ROOT::Internal::RDF::GetJitCache().SetDirectory(dir);
+}
+
+/// Disable the on-disk cache of jitted RDataFrame code, see EnableJitCache.
+void ROOT::RDF::Experimental::DisableJitCache()
+{
+   ROOT::Internal::RDF::GetJitCache().SetDirectory("");
+}
+
+/// Return the statistics of the usage of the on-disk cache of jitted RDataFrame code in this process.
+ROOT::RDF::Experimental::RJitCacheStats ROOT::RDF::Experimental::GetJitCacheStats()
+{
+   return ROOT::Internal::RDF::GetJitCache().GetStats();
+}
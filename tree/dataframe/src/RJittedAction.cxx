@@ -15,7 +15,9 @@
 #include "ROOT/RDF/RMergeableValue.hxx"
 #include "TError.h"
 
+using ROOT::Internal::RDF::RColumnReaderBulkLoader;
 using ROOT::Internal::RDF::RJittedAction;
+using ROOT::Internal::RDF::RMaskedEntryRange;
 using ROOT::Detail::RDF::RLoopManager;
 
 RJittedAction::RJittedAction(RLoopManager &lm) : RActionBase(&lm, {}, ROOT::Internal::RDF::RBookedDefines{}) {}
@@ -26,6 +28,24 @@ void RJittedAction::Run(unsigned int slot, Long64_t entry)
    fConcreteAction->Run(slot, entry);
 }
 
+void RJittedAction::RunBulk(unsigned int slot, const RMaskedEntryRange &bulk)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->RunBulk(slot, bulk);
+}
+
+bool RJittedAction::SupportsBulk() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->SupportsBulk();
+}
+
+void RJittedAction::CollectBulkLoaders(unsigned int slot, std::vector<RColumnReaderBulkLoader *> &loaders)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->CollectBulkLoaders(slot, loaders);
+}
+
 void RJittedAction::Initialize()
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -84,6 +104,18 @@ void RJittedAction::ClearValueReaders(unsigned int slot)
    return fConcreteAction->ClearValueReaders(slot);
 }
 
+void RJittedAction::SetTimingHandle(const RNodeTimingHandle &handle)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->SetTimingHandle(handle);
+}
+
+std::string RJittedAction::GetActionName()
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->GetActionName();
+}
+
 std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::GetGraph()
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -99,3 +131,28 @@ std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> RJittedAction::GetMergea
    R__ASSERT(fConcreteAction != nullptr);
    return fConcreteAction->GetMergeableValue();
 }
+
+void RJittedAction::SetMergedValue(std::vector<std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase>> &values)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->SetMergedValue(values);
+}
+
+const std::vector<std::string> &RJittedAction::GetVariations() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->GetVariations();
+}
+
+const std::vector<std::string> &RJittedAction::GetVariationTags(const std::string &variationName) const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->GetVariationTags(variationName);
+}
+
+std::unique_ptr<ROOT::Internal::RDF::RActionBase>
+RJittedAction::MakeVariedAction(const std::string &variationName, unsigned int tagIdx, void *newResult)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->MakeVariedAction(variationName, tagIdx, newResult);
+}
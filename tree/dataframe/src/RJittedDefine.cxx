@@ -42,3 +42,34 @@ void RJittedDefine::ClearValueReaders(unsigned int slot)
    R__ASSERT(fConcreteDefine != nullptr);
    fConcreteDefine->ClearValueReaders(slot);
 }
+
+void RJittedDefine::UpdateBulk(unsigned int slot, const RDFInternal::RMaskedEntryRange &mask)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   fConcreteDefine->UpdateBulk(slot, mask);
+}
+
+void *RJittedDefine::GetBulkValuePtr(unsigned int slot)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetBulkValuePtr(slot);
+}
+
+void RJittedDefine::CollectBulkLoaders(unsigned int slot,
+                                       std::vector<RDFInternal::RColumnReaderBulkLoader *> &loaders)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   fConcreteDefine->CollectBulkLoaders(slot, loaders);
+}
+
+void RJittedDefine::SetTimingHandle(const RDFInternal::RNodeTimingHandle &handle)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   fConcreteDefine->SetTimingHandle(handle);
+}
+
+std::shared_ptr<RDefineBase> RJittedDefine::MakeVariedDefine(const std::string &variationName, unsigned int tagIdx)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetVariedDefine(variationName, tagIdx);
+}
@@ -23,6 +23,17 @@ void RJittedFilter::SetFilter(std::unique_ptr<RFilterBase> f)
    fConcreteFilter = std::move(f);
 }
 
+std::shared_ptr<RNodeBase> RJittedFilter::MakeVariedFilter(const std::string &variationName, unsigned int tagIdx)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   // The varied concrete filter is booked with the loop manager by the concrete filter itself, the wrapper only
+   // provides the node type that the downstream nodes expect
+   auto variedFilter = std::make_shared<RJittedFilter>(fLoopManager, "");
+   variedFilter->fConcreteFilter =
+      std::static_pointer_cast<RFilterBase>(fConcreteFilter->GetVariedFilter(variationName, tagIdx));
+   return variedFilter;
+}
+
 void RJittedFilter::InitSlot(TTreeReader *r, unsigned int slot)
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -35,6 +46,13 @@ bool RJittedFilter::CheckFilters(unsigned int slot, Long64_t entry)
    return fConcreteFilter->CheckFilters(slot, entry);
 }
 
+const ROOT::Internal::RDF::RMaskedEntryRange &
+RJittedFilter::CheckFiltersBulk(unsigned int slot, const RDFInternal::RMaskedEntryRange &bulk)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->CheckFiltersBulk(slot, bulk);
+}
+
 void RJittedFilter::Report(ROOT::RDF::RCutFlowReport &cr) const
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -95,6 +113,13 @@ void RJittedFilter::ClearTask(unsigned int slot)
    fConcreteFilter->ClearTask(slot);
 }
 
+void RJittedFilter::CollectBulkLoaders(unsigned int slot,
+                                       std::vector<RDFInternal::RColumnReaderBulkLoader *> &loaders)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   fConcreteFilter->CollectBulkLoaders(slot, loaders);
+}
+
 void RJittedFilter::InitNode()
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -110,6 +135,12 @@ void RJittedFilter::AddFilterName(std::vector<std::string> &filters)
    fConcreteFilter->AddFilterName(filters);
 }
 
+void RJittedFilter::SetTimingHandle(const RDFInternal::RNodeTimingHandle &handle)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   fConcreteFilter->SetTimingHandle(handle);
+}
+
 std::shared_ptr<RDFGraphDrawing::GraphNode> RJittedFilter::GetGraph()
 {
    if (fConcreteFilter != nullptr) {
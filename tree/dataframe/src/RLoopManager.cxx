@@ -1,17 +1,25 @@
 #include "RConfigure.h" // R__USE_IMT
+#include "ROOT/RDF/ColumnReaders.hxx"
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RJitCache.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RMergeableValue.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RSlotStack.hxx"
 #include "RtypesCore.h" // Long64_t
 #include "TBranchElement.h"
 #include "TBranchObject.h"
+#include "TBufferFile.h"
+#include "TChain.h"
+#include "TClass.h"
 #include "TEntryList.h"
 #include "TFriendElement.h"
 #include "TInterpreter.h"
 #include "TROOT.h" // IsImplicitMTEnabled
+#include "TError.h" // Warning
 #include "TTreeReader.h"
 
 #ifdef R__USE_IMT
@@ -19,11 +27,19 @@
 #include "ROOT/TTreeProcessorMT.hxx"
 #endif
 
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <exception>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -39,12 +55,28 @@ namespace {
 /// We want RLoopManagers to be able to add their code to a global "code to execute via cling",
 /// so that, lazily, we can jit everything that's needed by all RDFs in one go, which is potentially
 /// much faster than jitting each RLoopManager's code separately.
-static std::string &GetCodeToJit()
+/// The code is kept as a list of snippets, in the order in which it was booked, so that it can be looked up in the
+/// cache of jitted code.
+static std::vector<RJitSnippet> &GetCodeToJit()
 {
-   static std::string code;
+   static std::vector<RJitSnippet> code;
    return code;
 }
 
+/// Protects GetCodeToJit(). It is only held while the code is appended or taken, never while jitting.
+static std::mutex &GetCodeToJitMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+/// Held from taking the code to jit until it is compiled, see RLoopManager::Jit().
+static std::mutex &GetJitMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
 static bool ContainsLeaf(const std::set<TLeaf *> &leaves, TLeaf *leaf)
 {
    return (leaves.find(leaf) != leaves.end());
@@ -204,6 +236,35 @@ static void ThrowIfPoolSizeChanged(unsigned int nSlots)
    }
 }
 
+/// Return a TChain that reads the same trees as `tree` from newly opened files, or the tree itself if it is not read
+/// from a file. The worker processes of a multi-process event loop share the file descriptors of the parent process,
+/// so they have to open the input files again to read them independently of each other. The thread pool of the
+/// parent process is not usable in the worker processes, hence implicit multi-threading is disabled for the tree.
+static std::shared_ptr<TTree> MakeWorkerTree(const std::shared_ptr<TTree> &tree)
+{
+   if (tree->IsA() != TChain::Class() && tree->GetCurrentFile() == nullptr) {
+      tree->SetImplicitMT(false);
+      return tree;
+   }
+
+   auto chain = std::make_shared<TChain>();
+   if (tree->IsA() == TChain::Class()) {
+      // for each file of the chain, GetTitle returns the file name and GetName the name of the tree in that file
+      for (TObject *f : *static_cast<TChain &>(*tree).GetListOfFiles())
+         chain->Add((std::string(f->GetTitle()) + "?#" + f->GetName()).c_str());
+   } else {
+      std::string treePath = tree->GetDirectory()->GetPath(); // e.g. "file.root:/dir"
+      treePath = treePath.substr(treePath.find(":/") + 2);   // e.g. "dir"
+      if (!treePath.empty())
+         treePath += "/";
+      treePath += tree->GetName();
+      chain->Add((std::string(tree->GetCurrentFile()->GetName()) + "?#" + treePath).c_str(), tree->GetEntries());
+   }
+   chain->ResetBit(TObject::kMustCleanup);
+   chain->SetImplicitMT(false);
+   return chain;
+}
+
 } // anonymous namespace
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -287,6 +348,7 @@ void RLoopManager::RunEmptySourceMT()
          for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
             RunAndCheckFilters(slot, currEntry);
          }
+         RunBulkAndCheckFilters(slot);
       } catch (...) {
          CleanUpTask(slot);
          // Error might throw in experiment frameworks like CMSSW
@@ -306,11 +368,13 @@ void RLoopManager::RunEmptySourceMT()
 /// Run event loop with no source files, in sequence.
 void RLoopManager::RunEmptySource()
 {
+   const auto range = GetProcessEntryRange(fNEmptyEntries);
    InitNodeSlots(nullptr, 0);
    try {
-      for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
+      for (ULong64_t currEntry = range.first; currEntry < range.second && fNStopsReceived < fNChildren; ++currEntry) {
          RunAndCheckFilters(0, currEntry);
       }
+      RunBulkAndCheckFilters(0u);
    } catch (...) {
       CleanUpTask(0u);
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -341,6 +405,7 @@ void RLoopManager::RunTreeProcessorMT()
          while (r.Next()) {
             RunAndCheckFilters(slot, count++);
          }
+         RunBulkAndCheckFilters(slot);
       } catch (...) {
          CleanUpTask(slot);
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -359,6 +424,12 @@ void RLoopManager::RunTreeReader()
    TTreeReader r(fTree.get(), fTree->GetEntryList());
    if (0 == fTree->GetEntriesFast())
       return;
+   if (fProcessChunk.second > 1) {
+      const auto range = GetProcessEntryRange(fTree->GetEntries());
+      if (range.first == range.second)
+         return;
+      r.SetEntriesRange(range.first, range.second);
+   }
    InitNodeSlots(&r, 0);
 
    // recursive call to check filters and conditionally execute actions
@@ -367,12 +438,15 @@ void RLoopManager::RunTreeReader()
       while (r.Next() && fNStopsReceived < fNChildren) {
          RunAndCheckFilters(0, r.GetCurrentEntry());
       }
+      RunBulkAndCheckFilters(0u);
    } catch (...) {
       CleanUpTask(0u);
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
    }
-   if (r.GetEntryStatus() != TTreeReader::kEntryNotFound && fNStopsReceived < fNChildren) {
+   // the status is kEntryBeyondEnd if the reader stopped at the end of the range of entries of this process
+   if (r.GetEntryStatus() != TTreeReader::kEntryNotFound && r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd &&
+       fNStopsReceived < fNChildren) {
       // something went wrong in the TTreeReader event loop
       throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
                                std::to_string(r.GetEntryStatus()));
@@ -386,18 +460,23 @@ void RLoopManager::RunDataSource()
    R__ASSERT(fDataSource != nullptr);
    fDataSource->Initialise();
    auto ranges = fDataSource->GetEntryRanges();
+   // in multi-process mode, the ranges of entries are assigned to the processes in a round-robin fashion
+   ULong64_t rangeIdx = 0ull;
    while (!ranges.empty()) {
       InitNodeSlots(nullptr, 0u);
       fDataSource->InitSlot(0u, 0ull);
       try {
          for (const auto &range : ranges) {
+            if (rangeIdx++ % fProcessChunk.second != fProcessChunk.first)
+               continue;
             auto end = range.second;
             for (auto entry = range.first; entry < end; ++entry) {
-               if (fDataSource->SetEntry(0u, entry)) {
+               if (SetDataSourceEntry(0u, entry)) {
                   RunAndCheckFilters(0u, entry);
                }
             }
          }
+         RunBulkAndCheckFilters(0u);
       } catch (...) {
          CleanUpTask(0u);
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -426,10 +505,11 @@ void RLoopManager::RunDataSourceMT()
       const auto end = range.second;
       try {
          for (auto entry = range.first; entry < end; ++entry) {
-            if (fDataSource->SetEntry(slot, entry)) {
+            if (SetDataSourceEntry(slot, entry)) {
                RunAndCheckFilters(slot, entry);
             }
          }
+         RunBulkAndCheckFilters(slot);
       } catch (...) {
          CleanUpTask(slot);
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -452,8 +532,20 @@ void RLoopManager::RunDataSourceMT()
 
 /// Execute actions and make sure named filters are called for each event.
 /// Named filters must be called even if the analysis logic would not require it, lest they report confusing results.
+/// In bulk mode, the values of the entry are loaded by the column readers and the computation graph only runs when
+/// the bulk of the slot is full.
 void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
+   if (fIsBulkRun) {
+      LoadBulkValues(slot, entry);
+      auto &bulkSlot = fBulkSlots[slot];
+      const auto bulkSize = bulkSlot.fBulk.Size();
+      // the values of the entries after the ones loaded in one go are not available yet
+      if (bulkSize == fBulkSize || bulkSize == bulkSlot.fNRangeEntries)
+         RunBulkAndCheckFilters(slot);
+      return;
+   }
+
    for (auto &actionPtr : fBookedActions)
       actionPtr->Run(slot, entry);
    for (auto &namedFilterPtr : fBookedNamedFilters)
@@ -462,6 +554,109 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Split the bulk loaders of the slot in the ones that load ranges of entries of the given tree (or of the data source
+/// if tree is null) and the ones that load the values entry by entry.
+/// Range loaders read the baskets of a branch with TBranch::GetBulkEntries, which takes the current basket away from
+/// the branch: if the same branch is also read entry by entry through the TTreeReader, e.g. as an RVec or with a
+/// different type, every basket would be read and decompressed twice. All the readers of such a branch load the
+/// values entry by entry instead.
+void RLoopManager::SplitBulkLoaders(unsigned int slot, TTree *tree)
+{
+   auto &bulkSlot = fBulkSlots[slot];
+   auto &rangeLoaders = bulkSlot.fRangeLoaders;
+   auto &entryLoaders = bulkSlot.fEntryLoaders;
+   rangeLoaders.clear();
+   entryLoaders.clear();
+   for (auto *loader : bulkSlot.fLoaders) {
+      if (loader->InitBulkRange(tree))
+         rangeLoaders.emplace_back(loader);
+      else
+         entryLoaders.emplace_back(loader);
+   }
+
+   std::set<std::string> entryBranches;
+   for (auto *loader : entryLoaders) {
+      if (const char *branchName = loader->GetTreeBranchName())
+         entryBranches.insert(branchName);
+   }
+   auto isRangeOnly = [&entryBranches](RDFInternal::RColumnReaderBulkLoader *loader) {
+      const char *branchName = loader->GetTreeBranchName();
+      return !branchName || entryBranches.count(branchName) == 0;
+   };
+   const auto firstShared = std::stable_partition(rangeLoaders.begin(), rangeLoaders.end(), isRangeOnly);
+   entryLoaders.insert(entryLoaders.end(), firstShared, rangeLoaders.end());
+   rangeLoaders.erase(firstShared, rangeLoaders.end());
+}
+
+/// Add the current entry to the bulk of the slot.
+/// At the beginning of a bulk, the column readers that support it load the values of the following entries of the
+/// current tree (with TBranch::GetBulkEntries) or data source (see RDataSource::GetNContiguousEntries) in one go.
+/// The other readers store the value of the entry in their bulk buffer. A bulk is processed early when the entries
+/// stop being consecutive, e.g. because of an entry list or at the end of a tree of a chain.
+void RLoopManager::LoadBulkValues(unsigned int slot, Long64_t entry)
+{
+   auto &bulkSlot = fBulkSlots[slot];
+   auto &bulk = bulkSlot.fBulk;
+
+   TTree *tree = nullptr;
+   Long64_t localEntry = entry;
+   if (bulkSlot.fReader) {
+      tree = bulkSlot.fReader->GetTree()->GetTree();
+      localEntry = tree->GetReadEntry();
+      const auto treeNumber = bulkSlot.fReader->GetTree()->GetTreeNumber();
+      if (treeNumber != bulkSlot.fTreeNumber) {
+         RunBulkAndCheckFilters(slot);
+         bulkSlot.fTreeNumber = treeNumber;
+         SplitBulkLoaders(slot, tree);
+      }
+   }
+   if (bulk.Size() > 0 && bulkSlot.fNRangeEntries > 0 && localEntry != bulkSlot.fNextEntry)
+      RunBulkAndCheckFilters(slot);
+
+   if (bulk.Size() == 0) {
+      std::size_t nRangeEntries = 0;
+      if (tree)
+         nRangeEntries = std::min<Long64_t>(fBulkSize, tree->GetEntries() - localEntry);
+      else if (fDataSource)
+         nRangeEntries = std::min(fBulkSize, fDataSource->GetNContiguousEntries(slot));
+      // a range of a single entry is not worth it, and the values of a data source are only valid until the next
+      // SetEntry call in that case
+      bulkSlot.fNRangeEntries = (nRangeEntries > 1 && !bulkSlot.fRangeLoaders.empty()) ? nRangeEntries : 0;
+      if (bulkSlot.fNRangeEntries > 0) {
+         for (auto *loader : bulkSlot.fRangeLoaders)
+            loader->LoadBulkRange(localEntry, nRangeEntries);
+      }
+   }
+
+   const auto idx = bulk.Size();
+   for (auto *loader : bulkSlot.fNRangeEntries > 0 ? bulkSlot.fEntryLoaders : bulkSlot.fLoaders)
+      loader->LoadBulkEntry(idx, entry);
+   bulkSlot.fNextEntry = localEntry + 1;
+   bulk.Push(entry);
+}
+
+/// Bulk counterpart of RunAndCheckFilters: run the computation graph on the entries accumulated by the slot.
+/// It must also be called at the end of each task, to process the last bulk, which might not be full.
+/// It is a no-op if the event loop does not run in bulk mode.
+void RLoopManager::RunBulkAndCheckFilters(unsigned int slot)
+{
+   if (!fIsBulkRun)
+      return;
+   auto &bulk = fBulkSlots[slot].fBulk;
+   if (bulk.Size() == 0)
+      return;
+
+   for (auto &actionPtr : fBookedActions)
+      actionPtr->RunBulk(slot, bulk);
+   for (auto &namedFilterPtr : fBookedNamedFilters)
+      namedFilterPtr->CheckFiltersBulk(slot, bulk);
+   for (std::size_t i = 0u; i < bulk.Size(); ++i) {
+      for (auto &callback : fCallbacks)
+         callback(slot);
+   }
+   bulk.Clear();
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitColumnReaders` methods. It is called once per node per slot, before
@@ -469,10 +664,31 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 /// a particular slot will be using.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
+   if (fTimingCollector)
+      fTimingCollector->StartTask(slot);
    for (auto &ptr : fBookedActions)
       ptr->InitSlot(r, slot);
    for (auto &ptr : fBookedFilters)
       ptr->InitSlot(r, slot);
+   if (fIsBulkRun) {
+      // collect the column readers that have to store the value of each entry: several nodes can share the same
+      // defined columns, hence the deduplication
+      auto &loaders = fBulkSlots[slot].fLoaders;
+      for (auto &ptr : fBookedActions)
+         ptr->CollectBulkLoaders(slot, loaders);
+      for (auto &ptr : fBookedFilters)
+         ptr->CollectBulkLoaders(slot, loaders);
+      std::sort(loaders.begin(), loaders.end());
+      loaders.erase(std::unique(loaders.begin(), loaders.end()), loaders.end());
+      for (auto *loader : loaders)
+         loader->AllocateBulk(fBulkSize);
+      // the readers of trees are split in range and entry loaders for each tree, see LoadBulkValues
+      auto &bulkSlot = fBulkSlots[slot];
+      bulkSlot.fReader = r;
+      bulkSlot.fTreeNumber = -1;
+      if (fDataSource)
+         SplitBulkLoaders(slot, nullptr);
+   }
    for (auto &callback : fCallbacksOnce)
       callback(slot);
 }
@@ -519,21 +735,101 @@ void RLoopManager::CleanUpNodes()
 /// Perform clean-up operations. To be called at the end of each task execution.
 void RLoopManager::CleanUpTask(unsigned int slot)
 {
+   if (fIsBulkRun) {
+      // the column readers are deleted below
+      auto &bulkSlot = fBulkSlots[slot];
+      bulkSlot.fBulk.Clear();
+      bulkSlot.fLoaders.clear();
+      bulkSlot.fRangeLoaders.clear();
+      bulkSlot.fEntryLoaders.clear();
+      bulkSlot.fReader = nullptr;
+   }
    for (auto &ptr : fBookedActions)
       ptr->FinalizeSlot(slot);
    for (auto &ptr : fBookedFilters)
       ptr->ClearTask(slot);
+   if (fTimingCollector)
+      fTimingCollector->StopTask(slot);
+}
+
+/// Create the collector of the timings of the next event loop if timing is enabled, and attach it to the nodes that
+/// run in the event loop: the booked filters and actions and the defined columns they use. Nodes are detached from
+/// the collector of a previous event loop otherwise. See SetTimingEnabled.
+void RLoopManager::SetUpTiming(double jitTime)
+{
+   // nodes share the ownership of the collector, there is nothing to do if no event loop was ever timed
+   if (!fIsTimingEnabled && !fTimingCollector)
+      return;
+
+   // in multi-process mode the nodes run in the worker processes, whose timings are not collected
+   fTimingCollector.reset();
+   if (fIsTimingEnabled && fNProcesses == 1)
+      fTimingCollector = std::make_shared<RDFInternal::RTimingCollector>(fNSlots, jitTime);
+
+   auto makeHandle = [this](const std::string &name, const std::string &kind) {
+      return fTimingCollector ? RDFInternal::RTimingCollector::AddNode(fTimingCollector, name, kind)
+                              : RDFInternal::RNodeTimingHandle{};
+   };
+
+   std::set<RDefineBase *> defines;
+   for (auto *filter : fBookedFilters)
+      filter->SetTimingHandle(makeHandle(filter->HasName() ? filter->GetName() : "Unnamed Filter", "Filter"));
+   for (auto *action : fBookedActions) {
+      action->SetTimingHandle(makeHandle(action->GetActionName(), "Action"));
+      for (auto &define : action->GetDefines().GetColumns()) {
+         if (defines.insert(define.second.get()).second)
+            define.second->SetTimingHandle(makeHandle(define.first, "Define"));
+      }
+   }
+}
+
+/// Load the given entry of the data source, timing the operation if the event loop is timed
+bool RLoopManager::SetDataSourceEntry(unsigned int slot, ULong64_t entry)
+{
+   if (!fTimingCollector)
+      return fDataSource->SetEntry(slot, entry);
+
+   const auto start = RDFInternal::RTimingCollector::Clock_t::now();
+   const bool isSelected = fDataSource->SetEntry(slot, entry);
+   const std::chrono::duration<double> ioTime = RDFInternal::RTimingCollector::Clock_t::now() - start;
+   fTimingCollector->AddIOTime(slot, ioTime.count());
+   return isSelected;
 }
 
 /// Add RDF nodes that require just-in-time compilation to the computation graph.
 /// This method also clears the contents of GetCodeToJit().
+/// The code is shared by all RLoopManagers, whose event loops can be started concurrently by RunGraphs: one of them
+/// may take and jit the code of the others. The jitting is thus serialized, so that a loop whose code is being jitted
+/// by another one waits for it to be compiled instead of starting without its jitted nodes. The code can still be
+/// booked meanwhile, as it is appended under a separate lock.
+/// If the cache of jitted code is enabled (see ROOT::RDF::Experimental::EnableJitCache), previously compiled code
+/// is loaded from the cache instead of being jitted, and newly jitted code is added to the cache.
 void RLoopManager::Jit()
 {
-   const std::string code = std::move(GetCodeToJit());
-   if (code.empty())
+   std::lock_guard<std::mutex> jitLock(GetJitMutex());
+   std::vector<RJitSnippet> snippets;
+   {
+      std::lock_guard<std::mutex> lock(GetCodeToJitMutex());
+      snippets = std::move(GetCodeToJit());
+      GetCodeToJit().clear();
+   }
+   if (snippets.empty())
+      return;
+
+   auto &cache = RDFInternal::GetJitCache();
+   if (cache.IsEnabled() && cache.Run(snippets))
       return;
 
+   std::string code;
+   for (const auto &s : snippets)
+      code += s.Render();
+
+   const auto start = std::chrono::steady_clock::now();
    RDFInternal::InterpreterCalc(code, "RLoopManager::Run");
+   const std::chrono::duration<double> jitTime = std::chrono::steady_clock::now() - start;
+
+   if (cache.IsEnabled())
+      cache.Store(snippets, jitTime.count());
 }
 
 /// Trigger counting of number of children nodes for each node of the functional graph.
@@ -550,27 +846,186 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Return the range of entries [begin, end) that this process must process, out of `nEntries` entries.
+/// This is the whole range except in the worker processes of a multi-process event loop, see SetNProcesses.
+std::pair<ULong64_t, ULong64_t> RLoopManager::GetProcessEntryRange(ULong64_t nEntries) const
+{
+   const auto idx = fProcessChunk.first;
+   const auto nChunks = fProcessChunk.second;
+   return {nEntries * idx / nChunks, nEntries * (idx + 1) / nChunks};
+}
+
+/// Throw if the booked computation graph cannot run in several processes, see SetNProcesses.
+/// Supported actions are the ones whose results can be merged through RMergeableValue: as their results are not
+/// filled yet, GetMergeableValue is only invoked to check that it is implemented.
+void RLoopManager::CheckMultiProcessRun() const
+{
+   if (!fBookedRanges.empty())
+      throw std::runtime_error("RDataFrame: Range is not supported when the event loop runs in several processes.");
+   if (fTree && fTree->GetEntryList())
+      throw std::runtime_error("RDataFrame: entry lists are not supported when the event loop runs in several "
+                               "processes.");
+   if (fTree && fTree->GetListOfFriends() && fTree->GetListOfFriends()->GetEntries() > 0)
+      throw std::runtime_error("RDataFrame: friend trees are not supported when the event loop runs in several "
+                               "processes.");
+   for (auto *actionPtr : fBookedActions) {
+      try {
+         actionPtr->GetMergeableValue();
+      } catch (const std::logic_error &) {
+         throw std::runtime_error("RDataFrame: one of the booked actions does not support running the event loop in "
+                                  "several processes. Only actions with mergeable results (e.g. Count, Sum, Mean, "
+                                  "histograms and graphs) are supported.");
+      }
+   }
+}
+
+/// Run the event loop in fNProcesses worker processes forked by TProcessExecutor, each of which processes a part of
+/// the dataset. Return the RMergeableValues of the results of the booked actions produced by the workers, one vector
+/// per booked action. The workers are isolated from each other and from this process: if one of them fails, e.g.
+/// because it crashes, the others complete their part of the event loop and this method throws.
+std::vector<std::vector<std::unique_ptr<RMergeableValueBase>>> RLoopManager::RunMultiProcess()
+{
+   std::vector<std::vector<std::unique_ptr<RMergeableValueBase>>> values(fBookedActions.size());
+#ifndef R__WIN32
+   // make sure that the number of entries of the trees of a chain is known before forking, so that the worker
+   // processes do not have to open all files to find out the range of entries they have to process
+   if (fTree)
+      fTree->GetEntries();
+
+   ROOT::TProcessExecutor pool(fNProcesses);
+   auto results = pool.Map([this](unsigned int chunk) { return RunProcessChunk(chunk); }, ROOT::TSeqU(fNProcesses));
+
+   auto *baseClass = TClass::GetClass<RMergeableValueBase>();
+   std::vector<int> isDone(fNProcesses, 0); // std::vector<bool> does not allow to take references to its elements
+   std::string errors;
+   for (auto &result : results) {
+      TBufferFile buf(TBuffer::kRead, result.size(), result.data(), /*adopt=*/false);
+      UInt_t chunk = 0u;
+      buf.ReadUInt(chunk);
+      isDone[chunk] = 1;
+      Bool_t isOk = false;
+      buf.ReadBool(isOk);
+      if (!isOk) {
+         std::string msg;
+         buf.ReadStdString(&msg);
+         errors += "\n  worker " + std::to_string(chunk) + ": " + msg;
+         continue;
+      }
+      for (auto &actionValues : values)
+         actionValues.emplace_back(static_cast<RMergeableValueBase *>(buf.ReadObjectAny(baseClass)));
+   }
+   for (auto chunk = 0u; chunk < fNProcesses; ++chunk) {
+      if (!isDone[chunk])
+         errors += "\n  worker " + std::to_string(chunk) + ": the process terminated abnormally";
+   }
+   if (!errors.empty())
+      throw std::runtime_error("RDataFrame: the event loop failed in some of the worker processes:" + errors);
+#endif
+   return values;
+}
+
+/// Run the event loop on the given part of the dataset and return the serialized RMergeableValues of the results of
+/// the booked actions, or the error that interrupted the event loop. Invoked in the worker processes of a
+/// multi-process event loop, see RunMultiProcess.
+std::vector<char> RLoopManager::RunProcessChunk(unsigned int chunk)
+{
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteUInt(chunk);
+   try {
+      fProcessChunk = {chunk, fNProcesses};
+      if (fTree)
+         fTree = MakeWorkerTree(fTree);
+
+      // the workers run the event loop sequentially, as the thread pool of the parent process is not usable after fork
+      const auto actions = fBookedActions;
+      switch (fLoopType) {
+      case ELoopType::kNoFiles:
+      case ELoopType::kNoFilesMT: RunEmptySource(); break;
+      case ELoopType::kROOTFiles:
+      case ELoopType::kROOTFilesMT: RunTreeReader(); break;
+      case ELoopType::kDataSource:
+      case ELoopType::kDataSourceMT: RunDataSource(); break;
+      }
+      CleanUpNodes();
+
+      std::vector<std::unique_ptr<RMergeableValueBase>> values;
+      std::vector<TClass *> classes;
+      for (auto *actionPtr : actions) {
+         values.emplace_back(actionPtr->GetMergeableValue());
+         auto &v = *values.back();
+         classes.emplace_back(TClass::GetClass(typeid(v)));
+         if (classes.back() == nullptr)
+            throw std::runtime_error(std::string("no dictionary is available for ") + typeid(v).name() + ".");
+      }
+
+      buf.WriteBool(true);
+      for (auto i = 0u; i < values.size(); ++i)
+         buf.WriteObjectAny(values[i].get(), classes[i]);
+   } catch (const std::exception &e) {
+      buf.WriteBool(false);
+      const std::string msg = e.what();
+      buf.WriteStdString(&msg);
+   }
+   return std::vector<char>(buf.Buffer(), buf.Buffer() + buf.Length());
+}
+
 /// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
 /// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
 void RLoopManager::Run()
 {
    ThrowIfPoolSizeChanged(GetNSlots());
 
+   const auto jitStart = std::chrono::steady_clock::now();
    Jit();
+   const std::chrono::duration<double> jitTime = std::chrono::steady_clock::now() - jitStart;
+
+   if (fNProcesses > 1)
+      CheckMultiProcessRun();
+
+   // bulk processing is only possible if all booked actions support it, see SetBulkSize
+   fIsBulkRun = fBulkSize > 1 && std::all_of(fBookedActions.begin(), fBookedActions.end(),
+                                             [](RDFInternal::RActionBase *a) { return a->SupportsBulk(); });
+   if (fBulkSize > 1 && !fIsBulkRun)
+      Warning("RLoopManager::Run",
+              "Some of the booked actions (e.g. Snapshot) do not support bulk processing: entries will be processed "
+              "one by one.");
+   if (fIsBulkRun) {
+      fBulkSlots.clear();
+      fBulkSlots.resize(fNSlots);
+      for (auto &bulkSlot : fBulkSlots)
+         bulkSlot.fBulk = RDFInternal::RMaskedEntryRange(fBulkSize);
+   }
 
    InitNodes();
+   SetUpTiming(jitTime.count());
 
-   switch (fLoopType) {
-   case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
-   case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
-   case ELoopType::kDataSourceMT: RunDataSourceMT(); break;
-   case ELoopType::kNoFiles: RunEmptySource(); break;
-   case ELoopType::kROOTFiles: RunTreeReader(); break;
-   case ELoopType::kDataSource: RunDataSource(); break;
+   // in multi-process mode, the results of the worker processes overwrite the results once these are finalized
+   const auto actions = fBookedActions;
+   std::vector<std::vector<std::unique_ptr<RMergeableValueBase>>> workerValues;
+   if (fNProcesses > 1) {
+      workerValues = RunMultiProcess();
+   } else {
+      switch (fLoopType) {
+      case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
+      case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
+      case ELoopType::kDataSourceMT: RunDataSourceMT(); break;
+      case ELoopType::kNoFiles: RunEmptySource(); break;
+      case ELoopType::kROOTFiles: RunTreeReader(); break;
+      case ELoopType::kDataSource: RunDataSource(); break;
+      }
    }
 
    CleanUpNodes();
 
+   if (fTimingCollector) {
+      fTimingCollector->Stop();
+      fTimingReport = fTimingCollector->MakeReport();
+   }
+
+   for (auto i = 0u; i < workerValues.size(); ++i)
+      actions[i]->SetMergedValue(workerValues[i]);
+
+   fIsBulkRun = false;
    fNRuns++;
 }
 
@@ -636,7 +1091,15 @@ void RLoopManager::Report(ROOT::RDF::RCutFlowReport &rep) const
 
 void RLoopManager::ToJitExec(const std::string &code) const
 {
-   GetCodeToJit().append(code);
+   RJitSnippet snippet;
+   snippet.AppendCode(code);
+   ToJitExec(snippet);
+}
+
+void RLoopManager::ToJitExec(const RJitSnippet &snippet) const
+{
+   std::lock_guard<std::mutex> lock(GetCodeToJitMutex());
+   GetCodeToJit().emplace_back(snippet);
 }
 
 void RLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f)
@@ -647,6 +1110,27 @@ void RLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(u
       fCallbacks.emplace_back(everyNEvents, std::move(f), fNSlots);
 }
 
+/// Set the number of entries that the computation graph processes together in the next event loops.
+/// A bulk size of 1 (the default) means that entries are processed one by one. Larger values enable bulk processing:
+/// filters evaluate selection masks for whole bulks of entries and actions process the selected entries in one go,
+/// which amortizes the per-entry overhead of the computation graph. Values of 0 are treated like 1.
+void RLoopManager::SetBulkSize(std::size_t bulkSize)
+{
+   fBulkSize = std::max(bulkSize, std::size_t(1));
+}
+
+/// Set the number of processes that run the event loop. With more than one process, the event loop runs in worker
+/// processes forked from this one, each processing a part of the dataset, and the results are merged in this process.
+/// Values of 0 are treated like 1. Throws on Windows, where multi-process event loops are not supported.
+void RLoopManager::SetNProcesses(unsigned int nProcesses)
+{
+#ifdef R__WIN32
+   if (nProcesses > 1)
+      throw std::runtime_error("RDataFrame: multi-process event loops are not supported on Windows.");
+#endif
+   fNProcesses = std::max(nProcesses, 1u);
+}
+
 std::vector<std::string> RLoopManager::GetFiltersNames()
 {
    std::vector<std::string> filters;
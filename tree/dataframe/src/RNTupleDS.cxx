@@ -13,12 +13,15 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <ROOT/RField.hxx>
 #include <ROOT/RNTuple.hxx>
 #include <ROOT/RNTupleDS.hxx>
 #include <ROOT/RStringView.hxx>
 
 #include <TError.h>
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 #include <typeinfo>
@@ -36,14 +39,38 @@ ROOT::Experimental::RNTupleDS::RNTupleDS(std::unique_ptr<ROOT::Experimental::RNT
    fReaders.emplace_back(std::move(ntuple));
 }
 
+/// The RNTuple is opened when the data source is first used, e.g. when its columns are looked up. Thus the data source
+/// can be created before the RNTuple is written, e.g. for the data frame returned by Snapshot.
+ROOT::Experimental::RNTupleDS::RNTupleDS(std::string_view ntupleName, std::string_view fileName)
+   : fNTupleName(ntupleName), fFileName(fileName)
+{
+}
+
+void RNTupleDS::Open()
+{
+   if (!fReaders.empty())
+      return;
+
+   auto ntuple = RNTupleReader::Open(fNTupleName, fFileName);
+   for (const auto& f : ntuple->GetDescriptor().GetTopLevelFields()) {
+      fColumnNames.push_back(f.GetFieldName());
+      fColumnTypes.push_back(f.GetTypeName());
+   }
+   fReaders.emplace_back(std::move(ntuple));
+   if (fNSlots > 0)
+      SetupSlots();
+}
+
 const std::vector<std::string>& RNTupleDS::GetColumnNames() const
 {
+   const_cast<RNTupleDS *>(this)->Open();
    return fColumnNames;
 }
 
 
 RDF::RDataSource::Record_t RNTupleDS::GetColumnReadersImpl(std::string_view name, const std::type_info& /* ti */)
 {
+   Open();
    const auto index = std::distance(
       fColumnNames.begin(), std::find(fColumnNames.begin(), fColumnNames.end(), name));
    // TODO(jblomer): check expected type info like in, e.g., RRootDS.cxx
@@ -58,16 +85,52 @@ RDF::RDataSource::Record_t RNTupleDS::GetColumnReadersImpl(std::string_view name
 
 bool RNTupleDS::SetEntry(unsigned int slot, ULong64_t entryIndex)
 {
-   fReaders[slot]->LoadEntry(entryIndex, *fEntries[slot]);
+   for (auto &value : *fEntries[slot]) {
+      if (!value.GetField()->IsSimple())
+         value.GetField()->Read(entryIndex, &value);
+   }
+
+   auto &windows = fMappedWindows[slot];
+   for (unsigned i = 0; i < windows.size(); ++i) {
+      auto &w = windows[i];
+      if (!w.fField)
+         continue;
+      if ((entryIndex < w.fFirstEntry) || (entryIndex >= w.fFirstEntry + w.fNEntries)) {
+         NTupleSize_t nEntries;
+         w.fBase = static_cast<unsigned char *>(w.fField->MapV(entryIndex, nEntries));
+         w.fFirstEntry = entryIndex;
+         w.fNEntries = nEntries;
+      }
+      fValuePtrs[slot][i] = w.fBase + (entryIndex - w.fFirstEntry) * w.fValueSize;
+   }
    return true;
 }
 
+/// The values of simple fields are mapped from the pages: they are contiguous up to the end of the mapped windows.
+/// The values of the other fields are read into the entry, which is overwritten by the next SetEntry call.
+std::size_t RNTupleDS::GetNContiguousEntries(unsigned int slot)
+{
+   const auto &windows = fMappedWindows[slot];
+   if (windows.empty())
+      return 1;
+   auto nEntries = std::numeric_limits<std::size_t>::max();
+   for (unsigned i = 0; i < windows.size(); ++i) {
+      const auto &w = windows[i];
+      if (!w.fField)
+         return 1;
+      const auto idx = (static_cast<unsigned char *>(fValuePtrs[slot][i]) - w.fBase) / w.fValueSize;
+      nEntries = std::min<std::size_t>(nEntries, w.fNEntries - idx);
+   }
+   return nEntries;
+}
+
 std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
 {
    // TODO(jblomer): use cluster boundaries for the entry ranges
    std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
    if (fHasSeenAllRanges) return ranges;
 
+   Open();
    auto nEntries = fReaders[0]->GetNEntries();
    const auto chunkSize = nEntries / fNSlots;
    const auto reminder = 1U == fNSlots ? 0 : nEntries % fNSlots;
@@ -87,6 +150,7 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
 
 std::string RNTupleDS::GetTypeName(std::string_view colName) const
 {
+   const_cast<RNTupleDS *>(this)->Open();
    const auto index = std::distance(
       fColumnNames.begin(), std::find(fColumnNames.begin(), fColumnNames.end(), colName));
    return fColumnTypes[index];
@@ -95,6 +159,7 @@ std::string RNTupleDS::GetTypeName(std::string_view colName) const
 
 bool RNTupleDS::HasColumn(std::string_view colName) const
 {
+   const_cast<RNTupleDS *>(this)->Open();
    return std::find(fColumnNames.begin(), fColumnNames.end(), colName) !=
           fColumnNames.end();
 }
@@ -102,6 +167,7 @@ bool RNTupleDS::HasColumn(std::string_view colName) const
 
 void RNTupleDS::Initialise()
 {
+   Open();
    fHasSeenAllRanges = false;
 }
 
@@ -112,6 +178,14 @@ void RNTupleDS::SetNSlots(unsigned int nSlots)
    R__ASSERT(nSlots > 0);
    fNSlots = nSlots;
 
+   // Otherwise the slots are set up once the RNTuple is opened
+   if (!fReaders.empty())
+      SetupSlots();
+}
+
+
+void RNTupleDS::SetupSlots()
+{
    for (unsigned int i = 1; i < fNSlots; ++i) {
       fReaders.emplace_back(fReaders[0]->Clone());
    }
@@ -119,8 +193,14 @@ void RNTupleDS::SetNSlots(unsigned int nSlots)
    for (unsigned int i = 0; i < fNSlots; ++i) {
       auto entry = fReaders[i]->GetModel()->CreateEntry();
       fValuePtrs.emplace_back(std::vector<void*>());
+      fMappedWindows.emplace_back(std::vector<RMappedWindow>(fColumnNames.size()));
       for (unsigned j = 0; j < fColumnNames.size(); ++j) {
-         fValuePtrs[i].emplace_back(entry->GetValue(fColumnNames[j]).GetRawPtr());
+         auto value = entry->GetValue(fColumnNames[j]);
+         fValuePtrs[i].emplace_back(value.GetRawPtr());
+         if (value.GetField()->IsSimple()) {
+            fMappedWindows[i][j].fField = value.GetField();
+            fMappedWindows[i][j].fValueSize = value.GetField()->GetValueSize();
+         }
       }
       fEntries.emplace_back(std::move(entry));
    }
@@ -22,6 +22,7 @@ void RRangeBase::ResetCounters()
    fLastCheckedEntry = -1;
    fNProcessedEntries = 0;
    fHasStopped = false;
+   fLastBulkEntry = -1;
 }
 
 // outlined to pin virtual table
@@ -0,0 +1,337 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RTimingReport.hxx"
+#include "TString.h" // Printf
+#include "TTimeStamp.h"
+#include "TVirtualPerfStats.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+using ROOT::Internal::RDF::RNodeTimingHandle;
+using ROOT::Internal::RDF::RTimingCollector;
+using ROOT::RDF::RNodeTiming;
+using ROOT::RDF::RTimingReport;
+
+namespace {
+
+/// Accumulates the time spent reading data from files and decompressing it, using the same hooks as TTreePerfStats.
+/// All events are forwarded to the perf stats object that was active before, if any.
+class RIOStats final : public TVirtualPerfStats {
+   double &fIOTime;
+   TVirtualPerfStats *fNext = nullptr;
+
+public:
+   RIOStats(double &ioTime) : fIOTime(ioTime) {}
+   void SetNext(TVirtualPerfStats *next) { fNext = next; }
+
+   void FileReadEvent(TFile *file, Int_t len, Double_t start) final
+   {
+      fIOTime += Double_t(TTimeStamp()) - start;
+      if (fNext)
+         fNext->FileReadEvent(file, len, start);
+   }
+
+   void UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen) final
+   {
+      fIOTime += Double_t(TTimeStamp()) - start;
+      if (fNext)
+         fNext->UnzipEvent(tree, pos, start, complen, objlen);
+   }
+
+   void SimpleEvent(EEventType type) final
+   {
+      if (fNext)
+         fNext->SimpleEvent(type);
+   }
+   void PacketEvent(const char *slave, const char *slavename, const char *filename, Long64_t eventsprocessed,
+                    Double_t latency, Double_t proctime, Double_t cputime, Long64_t bytesRead) final
+   {
+      if (fNext)
+         fNext->PacketEvent(slave, slavename, filename, eventsprocessed, latency, proctime, cputime, bytesRead);
+   }
+   void FileEvent(const char *slave, const char *slavename, const char *nodename, const char *filename,
+                  Bool_t isStart) final
+   {
+      if (fNext)
+         fNext->FileEvent(slave, slavename, nodename, filename, isStart);
+   }
+   void FileOpenEvent(TFile *file, const char *filename, Double_t start) final
+   {
+      if (fNext)
+         fNext->FileOpenEvent(file, filename, start);
+   }
+   void RateEvent(Double_t proctime, Double_t deltatime, Long64_t eventsprocessed, Long64_t bytesRead) final
+   {
+      if (fNext)
+         fNext->RateEvent(proctime, deltatime, eventsprocessed, bytesRead);
+   }
+   void SetBytesRead(Long64_t num) final
+   {
+      if (fNext)
+         fNext->SetBytesRead(num);
+   }
+   Long64_t GetBytesRead() const final { return fNext ? fNext->GetBytesRead() : 0; }
+   void SetNumEvents(Long64_t num) final
+   {
+      if (fNext)
+         fNext->SetNumEvents(num);
+   }
+   Long64_t GetNumEvents() const final { return fNext ? fNext->GetNumEvents() : 0; }
+   void PrintBasketInfo(Option_t *option = "") const final
+   {
+      if (fNext)
+         fNext->PrintBasketInfo(option);
+   }
+   void SetLoaded(TBranch *b, size_t basketNumber) final
+   {
+      if (fNext)
+         fNext->SetLoaded(b, basketNumber);
+   }
+   void SetLoaded(size_t bi, size_t basketNumber) final
+   {
+      if (fNext)
+         fNext->SetLoaded(bi, basketNumber);
+   }
+   void SetLoadedMiss(TBranch *b, size_t basketNumber) final
+   {
+      if (fNext)
+         fNext->SetLoadedMiss(b, basketNumber);
+   }
+   void SetLoadedMiss(size_t bi, size_t basketNumber) final
+   {
+      if (fNext)
+         fNext->SetLoadedMiss(bi, basketNumber);
+   }
+   void SetMissed(TBranch *b, size_t basketNumber) final
+   {
+      if (fNext)
+         fNext->SetMissed(b, basketNumber);
+   }
+   void SetMissed(size_t bi, size_t basketNumber) final
+   {
+      if (fNext)
+         fNext->SetMissed(bi, basketNumber);
+   }
+   void SetUsed(TBranch *b, size_t basketNumber) final
+   {
+      if (fNext)
+         fNext->SetUsed(b, basketNumber);
+   }
+   void SetUsed(size_t bi, size_t basketNumber) final
+   {
+      if (fNext)
+         fNext->SetUsed(bi, basketNumber);
+   }
+   void UpdateBranchIndices(TObjArray *branches) final
+   {
+      if (fNext)
+         fNext->UpdateBranchIndices(branches);
+   }
+};
+
+/// Escape the characters that cannot appear verbatim in a JSON string
+std::string JSONEscape(const std::string &s)
+{
+   std::string escaped;
+   for (const char c : s) {
+      switch (c) {
+      case '"': escaped += "\\\""; break;
+      case '\\': escaped += "\\\\"; break;
+      case '\n': escaped += "\\n"; break;
+      case '\t': escaped += "\\t"; break;
+      default:
+         if (static_cast<unsigned char>(c) < 0x20) {
+            std::ostringstream code;
+            code << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c);
+            escaped += code.str();
+         } else {
+            escaped += c;
+         }
+      }
+   }
+   return escaped;
+}
+
+/// Convert seconds to the microseconds used by the Chrome trace event format
+long long ToMicroseconds(double seconds)
+{
+   return static_cast<long long>(seconds * 1e6);
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+RTimingCollector::RSlotTimes::RSlotTimes() = default;
+RTimingCollector::RSlotTimes::RSlotTimes(RSlotTimes &&) = default;
+RTimingCollector::RSlotTimes::~RSlotTimes() = default;
+
+RTimingCollector::RTimingCollector(unsigned int nSlots, double jitTime) : fJitTime(jitTime), fSlots(nSlots)
+{
+   for (auto &slot : fSlots)
+      slot.fIOStats.reset(new RIOStats(slot.fIOTime));
+}
+
+RNodeTimingHandle RTimingCollector::AddNode(const std::shared_ptr<RTimingCollector> &collector,
+                                            const std::string &name, const std::string &kind)
+{
+   collector->fNodes.emplace_back(name, kind);
+   for (auto &slot : collector->fSlots) {
+      slot.fNodeTime.emplace_back(0.);
+      slot.fNodeCalls.emplace_back(0ull);
+   }
+   return RNodeTimingHandle{collector, static_cast<unsigned int>(collector->fNodes.size() - 1)};
+}
+
+/// Start timing a task of the given slot. The file reads and decompressions that the thread performs during the task
+/// are timed via gPerfStats, which is thread-local when ROOT is thread-safe.
+void RTimingCollector::StartTask(unsigned int slot)
+{
+   auto &s = fSlots[slot];
+   s.fTaskStart = Clock_t::now();
+   s.fPrevIOStats = gPerfStats;
+   static_cast<RIOStats &>(*s.fIOStats).SetNext(s.fPrevIOStats);
+   gPerfStats = s.fIOStats.get();
+}
+
+void RTimingCollector::StopTask(unsigned int slot)
+{
+   auto &s = fSlots[slot];
+   gPerfStats = s.fPrevIOStats;
+   const std::chrono::duration<double> start = s.fTaskStart - fStart;
+   const std::chrono::duration<double> end = Clock_t::now() - fStart;
+   s.fTasks.emplace_back(start.count(), end.count());
+}
+
+void RTimingCollector::Stop()
+{
+   const std::chrono::duration<double> elapsed = Clock_t::now() - fStart;
+   fEventLoopTime = elapsed.count();
+}
+
+ROOT::RDF::RTimingReport RTimingCollector::MakeReport() const
+{
+   ROOT::RDF::RTimingReport report;
+   report.fJitTime = fJitTime;
+   report.fEventLoopTime = fEventLoopTime;
+
+   for (auto i = 0u; i < fNodes.size(); ++i) {
+      RNodeTiming node;
+      node.fName = fNodes[i].first;
+      node.fKind = fNodes[i].second;
+      for (const auto &s : fSlots) {
+         node.fNCalls += s.fNodeCalls[i];
+         node.fTime += s.fNodeTime[i];
+      }
+      report.fNodes.emplace_back(std::move(node));
+   }
+
+   for (auto slotIdx = 0u; slotIdx < fSlots.size(); ++slotIdx) {
+      const auto &s = fSlots[slotIdx];
+      ROOT::RDF::RSlotTiming slot;
+      slot.fNTasks = s.fTasks.size();
+      for (const auto &task : s.fTasks) {
+         slot.fBusyTime += task.second - task.first;
+         report.fTasks.push_back({slotIdx, task.first, task.second});
+      }
+      slot.fIdleTime = std::max(fEventLoopTime - slot.fBusyTime, 0.);
+      slot.fIOTime = s.fIOTime;
+      report.fSlots.emplace_back(slot);
+   }
+   std::sort(report.fTasks.begin(), report.fTasks.end(),
+             [](const RTimingReport::RTask &a, const RTimingReport::RTask &b) { return a.fStart < b.fStart; });
+
+   return report;
+}
+
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+const RNodeTiming &RTimingReport::operator[](std::string_view nodeName) const
+{
+   auto it = std::find_if(fNodes.begin(), fNodes.end(), [&nodeName](const RNodeTiming &n) { return n.fName == nodeName; });
+   if (it == fNodes.end()) {
+      std::string err = "Cannot find a node called \"";
+      err += nodeName;
+      err += "\". Available nodes are: \n";
+      for (const auto &n : fNodes)
+         err += " - " + n.fName + " (" + n.fKind + ")\n";
+      throw std::runtime_error(err);
+   }
+   return *it;
+}
+
+void RTimingReport::Print() const
+{
+   Printf("Event loop: %.6f s, jitting: %.6f s", fEventLoopTime, fJitTime);
+   Printf("%-30s %-7s %15s %12s %15s", "Node", "Kind", "Calls", "Time [s]", "Time/call [ns]");
+   for (const auto &n : fNodes) {
+      const double timePerCall = n.fNCalls > 0 ? 1e9 * n.fTime / n.fNCalls : 0.;
+      Printf("%-30s %-7s %15llu %12.6f %15.1f", n.fName.c_str(), n.fKind.c_str(), n.fNCalls, n.fTime, timePerCall);
+   }
+   Printf("%-6s %8s %12s %12s %12s", "Slot", "Tasks", "Busy [s]", "Idle [s]", "I/O [s]");
+   for (auto i = 0u; i < fSlots.size(); ++i) {
+      const auto &s = fSlots[i];
+      Printf("%-6u %8llu %12.6f %12.6f %12.6f", i, s.fNTasks, s.fBusyTime, s.fIdleTime, s.fIOTime);
+   }
+}
+
+/// The jitting and the event loop are complete events of thread 0, each task is a complete event of the thread of
+/// its slot (shifted by one). The per-node times are attached to the event loop event as arguments.
+std::string RTimingReport::ToChromeTrace() const
+{
+   std::ostringstream trace;
+   trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+   trace << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"RDataFrame\"}}";
+   for (auto i = 0u; i < fSlots.size(); ++i) {
+      trace << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i + 1
+            << ",\"args\":{\"name\":\"slot " << i << "\"}}";
+   }
+
+   // the jitting happens right before the event loop starts, at time 0
+   const auto loopStart = ToMicroseconds(fJitTime);
+   trace << ",\n{\"name\":\"Jitting\",\"cat\":\"rdf\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":0,\"dur\":" << loopStart
+         << "}";
+   trace << ",\n{\"name\":\"Event loop\",\"cat\":\"rdf\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":" << loopStart
+         << ",\"dur\":" << ToMicroseconds(fEventLoopTime) << ",\"args\":{";
+   for (auto i = 0u; i < fNodes.size(); ++i) {
+      const auto &n = fNodes[i];
+      trace << (i == 0 ? "" : ",") << "\"" << JSONEscape(n.fKind + " " + n.fName) << "\":{\"calls\":" << n.fNCalls
+            << ",\"time_s\":" << n.fTime << "}";
+   }
+   trace << "}}";
+
+   for (const auto &task : fTasks) {
+      trace << ",\n{\"name\":\"Task\",\"cat\":\"rdf\",\"ph\":\"X\",\"pid\":1,\"tid\":" << task.fSlot + 1
+            << ",\"ts\":" << loopStart + ToMicroseconds(task.fStart)
+            << ",\"dur\":" << ToMicroseconds(task.fEnd - task.fStart) << "}";
+   }
+   trace << "\n]}\n";
+   return trace.str();
+}
+
+void RTimingReport::WriteChromeTrace(std::string_view fileName) const
+{
+   const std::string name(fileName);
+   std::ofstream out(name);
+   if (!out)
+      throw std::runtime_error("RTimingReport::WriteChromeTrace: cannot open file " + name + " for writing.");
+   out << ToChromeTrace();
+}
+
+} // namespace RDF
+} // namespace ROOT
@@ -0,0 +1,263 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RVec.hxx>
+#include <TChain.h>
+#include <TEntryList.h>
+#include <TFile.h>
+#include <TH1D.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace ROOT::VecOps;
+
+// Book the same computation graph on two RDataFrames, one of which runs in bulk mode, and compare results
+template <typename F>
+void CheckBulkVsEntryByEntry(ROOT::RDF::RNode df, ROOT::RDF::RNode bulkDf, F &&book)
+{
+   auto res = book(df);
+   auto bulkRes = book(bulkDf);
+   EXPECT_EQ(*res, *bulkRes);
+}
+
+TEST(RDFBulk, BulkSize)
+{
+   ROOT::RDataFrame df(1);
+   EXPECT_EQ(df.GetBulkSize(), 1u);
+   df.SetBulkSize(64);
+   EXPECT_EQ(df.GetBulkSize(), 64u);
+   df.SetBulkSize(0);
+   EXPECT_EQ(df.GetBulkSize(), 1u);
+}
+
+TEST(RDFBulk, FilterDefineSum)
+{
+   ROOT::RDataFrame df(1000);
+   ROOT::RDataFrame bulkDf(1000);
+   bulkDf.SetBulkSize(64); // does not divide the number of entries
+
+   auto book = [](ROOT::RDF::RNode d) {
+      return d.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+         .Filter([](double x) { return int(x) % 3 == 0; }, {"x"})
+         .Define("y", [](double x) { return x * 2; }, {"x"})
+         .Sum<double>("y");
+   };
+   CheckBulkVsEntryByEntry(df, bulkDf, book);
+
+   auto count = [](ROOT::RDF::RNode d) {
+      return d.Filter([](ULong64_t e) { return e > 100; }, {"rdfentry_"}).Count();
+   };
+   CheckBulkVsEntryByEntry(df, bulkDf, count);
+   EXPECT_EQ(*count(bulkDf), 899ull);
+}
+
+TEST(RDFBulk, SharedDefine)
+{
+   ROOT::RDataFrame df(100);
+   df.SetBulkSize(16);
+   int nCalls = 0;
+   auto d = df.Define("x", [&nCalls](ULong64_t e) {
+      ++nCalls;
+      return int(e);
+   }, {"rdfentry_"});
+   // the two branches select different entries: every value must be computed at most once
+   auto s1 = d.Filter([](int x) { return x < 60; }, {"x"}).Sum<int>("x");
+   auto s2 = d.Filter([](int x) { return x >= 40; }, {"x"}).Sum<int>("x");
+   auto s3 = d.Sum<int>("x");
+   EXPECT_EQ(*s1, 1770);
+   EXPECT_EQ(*s2, 4170);
+   EXPECT_EQ(*s3, 4950);
+   EXPECT_EQ(nCalls, 100);
+}
+
+TEST(RDFBulk, Histos)
+{
+   ROOT::RDataFrame df(1000);
+   ROOT::RDataFrame bulkDf(1000);
+   bulkDf.SetBulkSize(100);
+
+   auto define = [](ROOT::RDF::RNode d) {
+      return d.Define("x", [](ULong64_t e) { return float(e % 10); }, {"rdfentry_"})
+         .Define("w", [](ULong64_t e) { return double(e % 7); }, {"rdfentry_"});
+   };
+   auto d = define(df);
+   auto bulkD = define(bulkDf);
+
+   // FillParHelper, with and without weights
+   auto h = d.Histo1D<float>({"h", "h", 10, 0, 10}, "x");
+   auto bulkH = bulkD.Histo1D<float>({"h", "h", 10, 0, 10}, "x");
+   auto hw = d.Histo1D<float, double>({"hw", "hw", 10, 0, 10}, "x", "w");
+   auto bulkHw = bulkD.Histo1D<float, double>({"hw", "hw", 10, 0, 10}, "x", "w");
+   // FillHelper, with and without weights
+   auto h2 = d.Histo1D<float>("x");
+   auto bulkH2 = bulkD.Histo1D<float>("x");
+   auto h2w = d.Histo1D<float, double>("x", "w");
+   auto bulkH2w = bulkD.Histo1D<float, double>("x", "w");
+
+   std::vector<std::pair<TH1D *, TH1D *>> histos{
+      {h.GetPtr(), bulkH.GetPtr()}, {hw.GetPtr(), bulkHw.GetPtr()}, {h2.GetPtr(), bulkH2.GetPtr()},
+      {h2w.GetPtr(), bulkH2w.GetPtr()}};
+   for (auto &p : histos) {
+      auto &hist = *p.first;
+      auto &bulkHist = *p.second;
+      ASSERT_EQ(hist.GetNbinsX(), bulkHist.GetNbinsX());
+      EXPECT_EQ(hist.GetEntries(), bulkHist.GetEntries());
+      EXPECT_DOUBLE_EQ(hist.GetMean(), bulkHist.GetMean());
+      for (auto i = 0; i <= hist.GetNbinsX() + 1; ++i)
+         EXPECT_DOUBLE_EQ(hist.GetBinContent(i), bulkHist.GetBinContent(i));
+   }
+}
+
+TEST(RDFBulk, RangeAndReport)
+{
+   ROOT::RDataFrame df(100);
+   df.SetBulkSize(32);
+   auto f = df.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"}, "even");
+   auto r = f.Range(5, 20, 3).Take<ULong64_t>("rdfentry_");
+   auto rep = f.Filter([](ULong64_t e) { return e < 10; }, {"rdfentry_"}, "small").Report();
+
+   const std::vector<ULong64_t> expected{10, 16, 22, 28, 34};
+   EXPECT_EQ(*r, expected);
+   const auto even = rep->At("even");
+   EXPECT_EQ(even.GetAll(), 100ull);
+   EXPECT_EQ(even.GetPass(), 50ull);
+   const auto small = rep->At("small");
+   EXPECT_EQ(small.GetAll(), 50ull);
+   EXPECT_EQ(small.GetPass(), 5ull);
+}
+
+TEST(RDFBulk, EarlyStop)
+{
+   ROOT::RDataFrame df(1000);
+   df.SetBulkSize(64);
+   auto c = df.Range(10).Count();
+   auto m = df.Range(100).Max<ULong64_t>("rdfentry_");
+   EXPECT_EQ(*c, 10ull);
+   EXPECT_EQ(*m, 99ull);
+}
+
+TEST(RDFBulk, Jitted)
+{
+   ROOT::RDataFrame df(100);
+   ROOT::RDataFrame bulkDf(100);
+   bulkDf.SetBulkSize(8);
+   auto book = [](ROOT::RDF::RNode d) {
+      return d.Define("x", "rdfentry_ * 0.5").Filter("x > 10").Define("v", "ROOT::RVec<double>{x, 2 * x}").Take<RVec<double>>("v");
+   };
+   auto res = book(df);
+   auto bulkRes = book(bulkDf);
+   ASSERT_EQ(res->size(), bulkRes->size());
+   for (auto i = 0u; i < res->size(); ++i)
+      EXPECT_TRUE(All((*res)[i] == (*bulkRes)[i]));
+
+   auto mean = [](ROOT::RDF::RNode d) { return d.Define("x", "rdfentry_ * 0.5").Filter("x < 30").Mean("x"); };
+   CheckBulkVsEntryByEntry(df, bulkDf, mean);
+}
+
+TEST(RDFBulk, TTree)
+{
+   TTree t("t", "t");
+   int x = 0;
+   std::vector<float> v;
+   t.Branch("x", &x);
+   t.Branch("v", &v);
+   for (x = 0; x < 100; ++x) {
+      v.assign(x % 4, float(x));
+      t.Fill();
+   }
+
+   ROOT::RDataFrame df(t);
+   ROOT::RDataFrame bulkDf(t);
+   bulkDf.SetBulkSize(16);
+   auto book = [](ROOT::RDF::RNode d) {
+      return d.Filter([](int xx) { return xx > 7; }, {"x"})
+         .Define("s", [](const RVec<float> &vv) { return Sum(vv); }, {"v"})
+         .Sum<float>("s");
+   };
+   CheckBulkVsEntryByEntry(df, bulkDf, book);
+   auto sumX = [](ROOT::RDF::RNode d) { return d.Sum<int>("x"); };
+   CheckBulkVsEntryByEntry(df, bulkDf, sumX);
+}
+
+// Branches of fundamental type in baskets on disk are read basket by basket with TBranch::GetBulkEntries
+TEST(RDFBulk, TTreeFromFiles)
+{
+   const std::vector<std::string> fileNames{"dataframe_bulk_0.root", "dataframe_bulk_1.root"};
+   for (auto i = 0u; i < fileNames.size(); ++i) {
+      TFile f(fileNames[i].c_str(), "RECREATE");
+      TTree t("t", "t");
+      int x = 0;
+      double y = 0.;
+      std::vector<float> v;
+      // small baskets, so that bulks span several of them
+      t.Branch("x", &x, 256);
+      t.Branch("y", &y, 256);
+      t.Branch("v", &v);
+      for (auto e = 0; e < 1000; ++e) {
+         x = e + 1000 * i;
+         y = 0.5 * x;
+         v.assign(e % 3, float(x));
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TChain c("t");
+   for (const auto &fileName : fileNames)
+      c.Add(fileName.c_str());
+   ROOT::RDataFrame df(c);
+   ROOT::RDataFrame bulkDf(c);
+   bulkDf.SetBulkSize(100);
+   auto book = [](ROOT::RDF::RNode d) {
+      return d.Filter([](int xx) { return xx % 3 != 0; }, {"x"})
+         .Define("s", [](double yy, const RVec<float> &vv) { return yy + Sum(vv); }, {"y", "v"})
+         .Sum<double>("s");
+   };
+   CheckBulkVsEntryByEntry(df, bulkDf, book);
+   auto sumY = [](ROOT::RDF::RNode d) { return d.Sum<double>("y"); };
+   CheckBulkVsEntryByEntry(df, bulkDf, sumY);
+
+   // with an entry list, bulks are processed early whenever entries are skipped
+   TEntryList elist0("e", "e", "t", fileNames[0].c_str());
+   TEntryList elist1("e", "e", "t", fileNames[1].c_str());
+   for (auto e = 0; e < 1000; ++e) {
+      if (e % 7 != 0)
+         elist0.Enter(e);
+      if (e < 500)
+         elist1.Enter(e);
+   }
+   TEntryList elist;
+   elist.Add(&elist0);
+   elist.Add(&elist1);
+   c.SetEntryList(&elist);
+   ROOT::RDataFrame dfList(c);
+   ROOT::RDataFrame bulkDfList(c);
+   bulkDfList.SetBulkSize(100);
+   CheckBulkVsEntryByEntry(dfList, bulkDfList, sumY);
+   c.SetEntryList(nullptr);
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
+#ifdef R__USE_IMT
+TEST(RDFBulk, MT)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      ROOT::RDataFrame df(10000);
+      df.SetBulkSize(128);
+      auto s = df.Define("x", [](ULong64_t e) { return e; }, {"rdfentry_"})
+                  .Filter([](ULong64_t x) { return x % 2 == 1; }, {"x"})
+                  .Sum<ULong64_t>("x");
+      auto c = df.Count();
+      EXPECT_EQ(*s, 25000000ull);
+      EXPECT_EQ(*c, 10000ull);
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
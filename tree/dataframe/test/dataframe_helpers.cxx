@@ -275,3 +275,58 @@ TEST(RDFHelpers, SaveGraphToFile)
 
    gSystem->Unlink(outFileName);
 }
+
+TEST(RDFHelpers, RunGraphs)
+{
+   ROOT::RDataFrame df1(3);
+   auto df1a = df1.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto r1 = df1a.Sum<double>("x");
+   auto r2 = df1a.Count();
+   ROOT::RDataFrame df2(10);
+   auto r3 = df2.Define("x", "1.0").Sum("x");
+
+   std::vector<RResultHandle> handles{r1, r2, r3};
+   for (const auto &h : handles)
+      EXPECT_FALSE(h.IsReady());
+
+   RunGraphs(handles);
+
+   for (const auto &h : handles)
+      EXPECT_TRUE(h.IsReady());
+   EXPECT_EQ(df1.GetNRuns(), 1u);
+   EXPECT_EQ(df2.GetNRuns(), 1u);
+   EXPECT_DOUBLE_EQ(*r1, 3.);
+   EXPECT_EQ(*r2, 3ull);
+   EXPECT_DOUBLE_EQ(*r3, 10.);
+   EXPECT_DOUBLE_EQ(handles[0].GetValue<double>(), 3.);
+   EXPECT_THROW(handles[0].GetValue<float>(), std::runtime_error);
+
+   // Results that are already computed do not trigger another event loop
+   RunGraphs({r1, r3});
+   EXPECT_EQ(df1.GetNRuns(), 1u);
+   EXPECT_EQ(df2.GetNRuns(), 1u);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFHelpers, RunGraphsMT)
+{
+   ROOT::EnableImplicitMT(4);
+   std::vector<ROOT::RDataFrame> dfs;
+   std::vector<ROOT::RDF::RResultPtr<double>> sums;
+   std::vector<RResultHandle> handles;
+   for (unsigned int i = 0; i < 8; ++i)
+      dfs.emplace_back(1000 * (i + 1));
+   for (auto &df : dfs) {
+      sums.emplace_back(df.Define("x", "2.0").Sum<double>("x"));
+      handles.emplace_back(sums.back());
+   }
+
+   RunGraphs(handles);
+
+   for (unsigned int i = 0; i < 8; ++i) {
+      EXPECT_EQ(dfs[i].GetNRuns(), 1u);
+      EXPECT_DOUBLE_EQ(*sums[i], 2000. * (i + 1));
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -0,0 +1,113 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDFHelpers.hxx>
+#include <ROOT/RDF/RJitCache.hxx>
+#include <TSystem.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using ROOT::Internal::RDF::RJitSnippet;
+
+TEST(RDFJitCache, SnippetRendering)
+{
+   int a = 0;
+   double b = 0.;
+   RJitSnippet snippet;
+   snippet.AppendCode("f(reinterpret_cast<int*>(").AppendAddr(&a).AppendCode("), reinterpret_cast<double*>(");
+   snippet.AppendAddr(&b).AppendCode("));");
+
+   EXPECT_EQ(snippet.GetAddrs().size(), 2u);
+   EXPECT_EQ(snippet.RenderWithArgs("args", 3), "f(reinterpret_cast<int*>(args[3]), reinterpret_cast<double*>(args[4]));");
+   const auto expected = "f(reinterpret_cast<int*>(" + ROOT::Internal::RDF::PrettyPrintAddr(&a) +
+                         "), reinterpret_cast<double*>(" + ROOT::Internal::RDF::PrettyPrintAddr(&b) + "));";
+   EXPECT_EQ(snippet.Render(), expected);
+}
+
+namespace {
+/// A snippet calling the jitted lambda `name`, declared as RDataFrame declares the lambdas of jitted expressions
+RJitSnippet MakeLambdaSnippet(const std::string &name, const std::string &expr)
+{
+   RJitSnippet snippet;
+   snippet.SetDeclarations("namespace __rdf {\nauto " + name + " = " + expr + ";\nusing " + name +
+                           "_ret_t = typename ROOT::TypeTraits::CallableTraits<decltype(" + name +
+                           ")>::ret_type;\n}");
+   snippet.AppendCode("f(__rdf::" + name + ", ").AppendAddr(&snippet).AppendCode(");");
+   return snippet;
+}
+
+/// Wait for the library compiled in the background to show up in the cache directory (or for the failure marker)
+bool WaitForCacheEntry(const std::string &cacheDir)
+{
+   const std::string soExt = std::string(".") + gSystem->GetSoExt();
+   auto endsWith = [](const std::string &s, const std::string &suffix) {
+      return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+   };
+   for (int i = 0; i < 600; ++i) {
+      if (void *dirp = gSystem->OpenDirectory(cacheDir.c_str())) {
+         bool found = false;
+         while (const char *entry = gSystem->GetDirEntry(dirp))
+            found |= endsWith(entry, soExt) || endsWith(entry, ".fail");
+         gSystem->FreeDirectory(dirp);
+         if (found)
+            return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+   }
+   return false;
+}
+} // namespace
+
+// The key must not depend on the numbering of the jitted lambdas, which depends on what was jitted before
+TEST(RDFJitCache, KeyIgnoresLambdaNumbering)
+{
+   using ROOT::Internal::RDF::RJitCache;
+   const std::vector<RJitSnippet> first{MakeLambdaSnippet("lambda0", "[](double x) { return x > 1; }"),
+                                        MakeLambdaSnippet("lambda1", "[](double y) { return y * 2; }")};
+   const std::vector<RJitSnippet> later{MakeLambdaSnippet("lambda7", "[](double x) { return x > 1; }"),
+                                        MakeLambdaSnippet("lambda12", "[](double y) { return y * 2; }")};
+   const std::vector<RJitSnippet> other{MakeLambdaSnippet("lambda0", "[](double x) { return x > 2; }"),
+                                        MakeLambdaSnippet("lambda1", "[](double y) { return y * 2; }")};
+   EXPECT_EQ(RJitCache::GetKey(first), RJitCache::GetKey(later));
+   EXPECT_NE(RJitCache::GetKey(first), RJitCache::GetKey(other));
+}
+
+TEST(RDFJitCache, EnableFailure)
+{
+   EXPECT_THROW(ROOT::RDF::Experimental::EnableJitCache(""), std::runtime_error);
+}
+
+// The same graph is booked twice: the first time its code is jitted and compiled into the cache in the background,
+// the second time the code is loaded from the cache
+TEST(RDFJitCache, HitAfterMiss)
+{
+   const std::string cacheDir = std::string(gSystem->TempDirectory()) + "/dataframe_jitcache_" +
+                                std::to_string(gSystem->GetPid());
+   ROOT::RDF::Experimental::EnableJitCache(cacheDir);
+   const auto statsBefore = ROOT::RDF::Experimental::GetJitCacheStats();
+
+   auto run = [] {
+      ROOT::RDataFrame df(100);
+      auto d = df.Define("x", "rdfentry_ * 2.").Filter("x > 50");
+      auto s = d.Sum<double>("x");
+      auto h = d.Histo1D("x");
+      return std::make_pair(*s, h->GetEntries());
+   };
+   const auto res1 = run();
+   const auto statsMiss = ROOT::RDF::Experimental::GetJitCacheStats();
+   EXPECT_TRUE(WaitForCacheEntry(cacheDir));
+   const auto res2 = run();
+   const auto statsHit = ROOT::RDF::Experimental::GetJitCacheStats();
+   ROOT::RDF::Experimental::DisableJitCache();
+   gSystem->Exec(("rm -rf " + cacheDir).c_str());
+
+   EXPECT_EQ(res1, res2);
+   EXPECT_EQ(res1.second, 74.);
+   EXPECT_EQ(statsMiss.fNMisses, statsBefore.fNMisses + 1);
+   EXPECT_EQ(statsMiss.fNHits, statsBefore.fNHits);
+   EXPECT_EQ(statsHit.fNMisses, statsMiss.fNMisses);
+   EXPECT_EQ(statsHit.fNHits, statsMiss.fNHits + 1);
+}
@@ -0,0 +1,134 @@
+#include <ROOT/RDataFrame.hxx>
+#include <TH1D.h>
+#include <TSystem.h>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <tuple>
+
+#include "gtest/gtest.h"
+
+namespace {
+ROOT::RDF::RNode DefineX(ROOT::RDF::RNode df)
+{
+   return df.Define("x", [](ULong64_t e) { return double(e % 100); }, {"rdfentry_"});
+}
+
+// Book the same actions on two RDataFrames, one of which runs the event loop in several processes, and compare results
+void CheckMultiVsSingleProcess(ROOT::RDF::RNode df, ROOT::RDF::RNode mpDf)
+{
+   auto book = [](ROOT::RDF::RNode d) {
+      auto f = d.Filter([](double x) { return x > 10.; }, {"x"});
+      return std::make_tuple(f.Count(), f.Sum<double>("x"), f.Mean<double>("x"), f.StdDev<double>("x"),
+                             f.Min<double>("x"), f.Max<double>("x"), f.Histo1D<double>({"h", "h", 10, 0., 100.}, "x"));
+   };
+   auto res = book(df);
+   auto mpRes = book(mpDf);
+
+   EXPECT_EQ(*std::get<0>(mpRes), *std::get<0>(res));
+   EXPECT_DOUBLE_EQ(*std::get<1>(mpRes), *std::get<1>(res));
+   EXPECT_DOUBLE_EQ(*std::get<2>(mpRes), *std::get<2>(res));
+   EXPECT_NEAR(*std::get<3>(mpRes), *std::get<3>(res), 1e-9);
+   EXPECT_DOUBLE_EQ(*std::get<4>(mpRes), *std::get<4>(res));
+   EXPECT_DOUBLE_EQ(*std::get<5>(mpRes), *std::get<5>(res));
+   const auto &h = *std::get<6>(res);
+   const auto &mpH = *std::get<6>(mpRes);
+   EXPECT_EQ(mpH.GetEntries(), h.GetEntries());
+   for (auto i = 0; i <= h.GetNbinsX() + 1; ++i)
+      EXPECT_EQ(mpH.GetBinContent(i), h.GetBinContent(i));
+}
+} // anonymous namespace
+
+TEST(RDFMultiProc, NProcesses)
+{
+   ROOT::RDataFrame df(1);
+   EXPECT_EQ(df.GetNProcesses(), 1u);
+   df.SetNProcesses(4);
+   EXPECT_EQ(df.GetNProcesses(), 4u);
+   df.SetNProcesses(0);
+   EXPECT_EQ(df.GetNProcesses(), 1u);
+}
+
+TEST(RDFMultiProc, EmptySource)
+{
+   ROOT::RDataFrame df(1001);
+   ROOT::RDataFrame mpDf(1001);
+   mpDf.SetNProcesses(3);
+   CheckMultiVsSingleProcess(DefineX(df), DefineX(mpDf));
+   EXPECT_EQ(mpDf.GetNRuns(), 1u);
+}
+
+TEST(RDFMultiProc, MoreProcessesThanEntries)
+{
+   ROOT::RDataFrame df(2);
+   df.SetNProcesses(4);
+   auto c = df.Count();
+   auto s = df.Sum<ULong64_t>("rdfentry_");
+   EXPECT_EQ(*c, 2ull);
+   EXPECT_EQ(*s, 1ull);
+}
+
+TEST(RDFMultiProc, Tree)
+{
+   const auto fileName = "dataframe_multiproc_tree.root";
+   ROOT::RDataFrame(1000).Define("x", [](ULong64_t e) { return double(e % 100); }, {"rdfentry_"}).Snapshot<double>(
+      "t", fileName, {"x"});
+
+   ROOT::RDataFrame df("t", fileName);
+   ROOT::RDataFrame mpDf("t", fileName);
+   mpDf.SetNProcesses(4);
+   CheckMultiVsSingleProcess(df, mpDf);
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFMultiProc, Jitted)
+{
+   ROOT::RDataFrame df(100);
+   df.SetNProcesses(2);
+   auto f = df.Define("x", "rdfentry_ * 2.").Filter("x < 50");
+   auto c = f.Count();
+   auto h = f.Histo1D("x");
+   EXPECT_EQ(*c, 25ull);
+   EXPECT_EQ(h->GetEntries(), 25.);
+}
+
+TEST(RDFMultiProc, UnsupportedAction)
+{
+   ROOT::RDataFrame df(10);
+   df.SetNProcesses(2);
+   auto t = df.Take<ULong64_t>("rdfentry_");
+   EXPECT_THROW(t.GetValue(), std::runtime_error);
+}
+
+TEST(RDFMultiProc, WorkerFailure)
+{
+   ROOT::RDataFrame df(100);
+   df.SetNProcesses(2);
+   // the second worker throws, the first one completes its part of the event loop
+   auto c = df.Filter(
+                 [](ULong64_t e) {
+                    if (e == 99)
+                       throw std::runtime_error("error in the event loop");
+                    return true;
+                 },
+                 {"rdfentry_"})
+               .Count();
+   EXPECT_THROW(c.GetValue(), std::runtime_error);
+}
+
+TEST(RDFMultiProc, WorkerCrash)
+{
+   ROOT::RDataFrame df(100);
+   df.SetNProcesses(2);
+   // the second worker dies without sending its results: this process must survive and report the failure
+   auto c = df.Filter(
+                 [](ULong64_t e) {
+                    if (e == 99)
+                       std::_Exit(1);
+                    return true;
+                 },
+                 {"rdfentry_"})
+               .Count();
+   EXPECT_THROW(c.GetValue(), std::runtime_error);
+}
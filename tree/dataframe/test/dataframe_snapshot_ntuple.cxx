@@ -0,0 +1,117 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RVec.hxx>
+#include <TROOT.h>
+#include <TSystem.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using ROOT::RDF::ESnapshotOutputFormat;
+using ROOT::RDF::RSnapshotOptions;
+using ROOT::VecOps::RVec;
+
+namespace {
+RSnapshotOptions NTupleOptions()
+{
+   RSnapshotOptions opts;
+   opts.fOutputFormat = ESnapshotOutputFormat::kRNTuple;
+   return opts;
+}
+
+ROOT::RDF::RNode DefineColumns(ROOT::RDF::RNode df)
+{
+   return df.Define("i", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+      .Define("f", [](ULong64_t e) { return float(e) / 2; }, {"rdfentry_"})
+      .Define("v", [](ULong64_t e) { return RVec<double>(e % 3, double(e)); }, {"rdfentry_"});
+}
+
+// the entries written by several threads can be in any order: sort them by the entry number.
+// Note that RNTuple stores 64 bit integers as std::uint64_t, which is not necessarily the same type as ULong64_t.
+void CheckOutput(ROOT::RDF::RNode out, ULong64_t nEntries)
+{
+   auto e = out.Take<std::uint64_t>("e");
+   auto i = out.Take<int>("i");
+   auto f = out.Take<float>("f");
+   auto v = out.Take<std::vector<double>>("v");
+   ASSERT_EQ(e->size(), nEntries);
+   std::vector<std::size_t> order(nEntries);
+   for (auto k = 0u; k < nEntries; ++k)
+      order[k] = k;
+   std::sort(order.begin(), order.end(), [&e](std::size_t a, std::size_t b) { return (*e)[a] < (*e)[b]; });
+   for (auto k = 0u; k < nEntries; ++k) {
+      const auto idx = order[k];
+      EXPECT_EQ((*e)[idx], k);
+      EXPECT_EQ((*i)[idx], int(k));
+      EXPECT_FLOAT_EQ((*f)[idx], float(k) / 2);
+      EXPECT_EQ((*v)[idx], std::vector<double>(k % 3, double(k)));
+   }
+}
+} // anonymous namespace
+
+TEST(RDFSnapshotNTuple, SingleThread)
+{
+   const auto fileName = "dataframe_snapshot_ntuple_st.root";
+   ROOT::RDataFrame df(100);
+   auto out = DefineColumns(df.Define("e", [](ULong64_t e) { return std::uint64_t(e); }, {"rdfentry_"}))
+                 .Snapshot<std::uint64_t, int, float, RVec<double>>("ntpl", fileName, {"e", "i", "f", "v"},
+                                                                    NTupleOptions());
+   CheckOutput(*out, 100);
+
+   auto reader = ROOT::Experimental::RNTupleReader::Open("ntpl", fileName);
+   EXPECT_EQ(reader->GetNEntries(), 100u);
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFSnapshotNTuple, Jitted)
+{
+   const auto fileName = "dataframe_snapshot_ntuple_jit.root";
+   ROOT::RDataFrame df(10);
+   auto out = df.Define("e", "rdfentry_").Define("x", "float(rdfentry_) * 2.f").Snapshot("ntpl", fileName, {"e", "x"},
+                                                                                          NTupleOptions());
+   EXPECT_EQ(*out->Count(), 10ull);
+   EXPECT_FLOAT_EQ(*out->Max<float>("x"), 18.f);
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFSnapshotNTuple, Lazy)
+{
+   const auto fileName = "dataframe_snapshot_ntuple_lazy.root";
+   gSystem->Unlink(fileName);
+   auto opts = NTupleOptions();
+   opts.fLazy = true;
+   ROOT::RDataFrame df(10);
+   auto out = df.Define("x", [] { return 1; }).Snapshot<int>("ntpl", fileName, {"x"}, opts);
+   EXPECT_TRUE(gSystem->AccessPathName(fileName)); // the file is not there yet
+   EXPECT_EQ(*out->Sum<int>("x"), 10);
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFSnapshotNTuple, UnsupportedType)
+{
+   ROOT::RDataFrame df(1);
+   auto d = df.Define("x", [] { return Long64_t(1); });
+   EXPECT_THROW(d.Snapshot<Long64_t>("ntpl", "dataframe_snapshot_ntuple_unsupported.root", {"x"}, NTupleOptions()),
+                std::runtime_error);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFSnapshotNTuple, MultiThread)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      const auto fileName = "dataframe_snapshot_ntuple_mt.root";
+      ROOT::RDataFrame df(100000);
+      auto out = DefineColumns(df.Define("e", [](ULong64_t e) { return std::uint64_t(e); }, {"rdfentry_"}))
+                    .Snapshot<std::uint64_t, int, float, RVec<double>>("ntpl", fileName, {"e", "i", "f", "v"},
+                                                                   NTupleOptions());
+      CheckOutput(*out, 100000);
+      gSystem->Unlink(fileName);
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
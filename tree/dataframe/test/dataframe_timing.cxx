@@ -0,0 +1,125 @@
+#include <ROOT/RDataFrame.hxx>
+#include <TROOT.h>
+#include <TSystem.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+TEST(RDFTiming, DisabledByDefault)
+{
+   ROOT::RDataFrame df(10);
+   EXPECT_FALSE(df.IsTimingEnabled());
+   *df.Count();
+   EXPECT_TRUE(df.GetTimingReport().GetNodes().empty());
+   EXPECT_TRUE(df.GetTimingReport().GetSlots().empty());
+}
+
+TEST(RDFTiming, Nodes)
+{
+   ROOT::RDataFrame df(100);
+   df.SetTimingEnabled();
+   EXPECT_TRUE(df.IsTimingEnabled());
+   auto d = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto c = d.Filter([](double x) { return x < 50.; }, {"x"}, "xCut").Count();
+   auto s = d.Sum<double>("x");
+   EXPECT_EQ(*c, 50ull);
+   EXPECT_DOUBLE_EQ(*s, 4950.);
+
+   const auto &report = df.GetTimingReport();
+   EXPECT_EQ(report.GetNodes().size(), 4u);
+   EXPECT_EQ(report["x"].fKind, "Define");
+   EXPECT_EQ(report["x"].fNCalls, 100ull);
+   EXPECT_EQ(report["xCut"].fKind, "Filter");
+   EXPECT_EQ(report["xCut"].fNCalls, 100ull);
+   EXPECT_EQ(report["Count"].fNCalls, 50ull);
+   EXPECT_EQ(report["Sum"].fNCalls, 100ull);
+   for (const auto &node : report.GetNodes())
+      EXPECT_GE(node.fTime, 0.);
+   EXPECT_THROW(report["y"], std::runtime_error);
+
+   ASSERT_EQ(report.GetSlots().size(), 1u);
+   EXPECT_EQ(report.GetSlots()[0].fNTasks, 1ull);
+   EXPECT_LE(report.GetSlots()[0].fBusyTime, report.GetEventLoopTime());
+}
+
+TEST(RDFTiming, Disable)
+{
+   ROOT::RDataFrame df(10);
+   df.SetTimingEnabled();
+   *df.Count();
+   EXPECT_EQ(df.GetTimingReport()["Count"].fNCalls, 10ull);
+
+   // the report of the last timed event loop is kept
+   df.SetTimingEnabled(false);
+   *df.Filter([] { return true; }, {}, "f").Count();
+   EXPECT_EQ(df.GetTimingReport()["Count"].fNCalls, 10ull);
+   EXPECT_THROW(df.GetTimingReport()["f"], std::runtime_error);
+}
+
+TEST(RDFTiming, Jitted)
+{
+   ROOT::RDataFrame df(10);
+   df.SetTimingEnabled();
+   auto m = df.Define("x", "rdfentry_ * 2.").Filter("x > 4", "jittedCut").Max<double>("x");
+   EXPECT_DOUBLE_EQ(*m, 18.);
+   const auto &report = df.GetTimingReport();
+   EXPECT_EQ(report["jittedCut"].fNCalls, 10ull);
+   EXPECT_EQ(report["x"].fNCalls, 10ull);
+   EXPECT_EQ(report["Max"].fNCalls, 7ull);
+   EXPECT_GE(report.GetJitTime(), 0.);
+}
+
+TEST(RDFTiming, ChromeTrace)
+{
+   ROOT::RDataFrame df(10);
+   df.SetTimingEnabled();
+   *df.Define("x\"quoted", [] { return 1; }).Sum<int>("x\"quoted");
+   const auto trace = df.GetTimingReport().ToChromeTrace();
+   EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+   EXPECT_NE(trace.find("\"Event loop\""), std::string::npos);
+   EXPECT_NE(trace.find("x\\\"quoted"), std::string::npos);
+
+   const auto fileName = "dataframe_timing_trace.json";
+   df.GetTimingReport().WriteChromeTrace(fileName);
+   EXPECT_FALSE(gSystem->AccessPathName(fileName));
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFTiming, TreeIO)
+{
+   const auto fileName = "dataframe_timing_tree.root";
+   ROOT::RDataFrame(1000).Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"}).Snapshot<double>(
+      "t", fileName, {"x"});
+   {
+      ROOT::RDataFrame df("t", fileName);
+      df.SetTimingEnabled();
+      EXPECT_DOUBLE_EQ(*df.Sum<double>("x"), 499500.);
+      const auto &report = df.GetTimingReport();
+      ASSERT_EQ(report.GetSlots().size(), 1u);
+      EXPECT_GT(report.GetSlots()[0].fIOTime, 0.);
+   }
+   gSystem->Unlink(fileName);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFTiming, MultiThread)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      ROOT::RDataFrame df(100000);
+      df.SetTimingEnabled();
+      auto c = df.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"}).Count();
+      EXPECT_EQ(*c, 50000ull);
+      const auto &report = df.GetTimingReport();
+      EXPECT_EQ(report["Unnamed Filter"].fNCalls, 100000ull);
+      EXPECT_EQ(report["Count"].fNCalls, 50000ull);
+      ULong64_t nTasks = 0;
+      for (const auto &slot : report.GetSlots())
+         nTasks += slot.fNTasks;
+      EXPECT_GT(nTasks, 0ull);
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -0,0 +1,114 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDFHelpers.hxx>
+#include <ROOT/RVec.hxx>
+#include <TH1D.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+using namespace ROOT::RDF::Experimental;
+using namespace ROOT::VecOps;
+
+TEST(RDFVary, SimpleSum)
+{
+   ROOT::RDataFrame df(10);
+   auto sum = df.Define("x", [] { return 1.; })
+                 .Vary("x", [](double x) { return RVec<double>{x - 1., x + 1.}; }, {"x"}, {"down", "up"})
+                 .Sum<double>("x");
+   auto sums = VariationsFor(sum);
+
+   const std::vector<std::string> expectedKeys{"nominal", "x:down", "x:up"};
+   EXPECT_EQ(sums.GetKeys(), expectedKeys);
+   EXPECT_DOUBLE_EQ(sums["nominal"], 10.);
+   EXPECT_DOUBLE_EQ(sums["x:down"], 0.);
+   EXPECT_DOUBLE_EQ(sums["x:up"], 20.);
+   EXPECT_DOUBLE_EQ(*sum, 10.);
+   EXPECT_EQ(df.GetNRuns(), 1u);
+   EXPECT_THROW(sums["x:sideways"], std::runtime_error);
+}
+
+TEST(RDFVary, DefineFilterHisto)
+{
+   ROOT::RDataFrame df(10);
+   auto h = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+               .Vary("x", [](double x) { return RVec<double>{x + 10., x * 2.}; }, {"x"}, 2, "shift")
+               .Filter([](double x) { return x < 10.; }, {"x"})
+               .Define("y", [](double x) { return x + 0.5; }, {"x"})
+               .Histo1D<double>({"h", "h", 30, 0., 30.}, "y");
+   auto hs = VariationsFor(h);
+
+   EXPECT_EQ(hs["nominal"].GetEntries(), 10.);
+   EXPECT_EQ(hs["shift:0"].GetEntries(), 0.);
+   EXPECT_EQ(hs["shift:1"].GetEntries(), 5.);
+   EXPECT_DOUBLE_EQ(hs["shift:1"].GetMean(), 4.5);
+   EXPECT_EQ(df.GetNRuns(), 1u);
+}
+
+TEST(RDFVary, UnaffectedResult)
+{
+   ROOT::RDataFrame df(10);
+   auto c = df.Define("x", [] { return 1; })
+               .Vary("x", [](int x) { return RVec<int>{x, x}; }, {"x"}, {"a", "b"})
+               .Define("y", [] { return 2; })
+               .Sum<int>("y");
+   auto cs = VariationsFor(c);
+   const std::vector<std::string> expectedKeys{"nominal"};
+   EXPECT_EQ(cs.GetKeys(), expectedKeys);
+   EXPECT_EQ(cs["nominal"], 20);
+}
+
+TEST(RDFVary, Jitted)
+{
+   ROOT::RDataFrame df(10);
+   auto c = df.Define("x", [] { return 1.; })
+               .Vary("x", [](double x) { return RVec<double>{x - 1., x + 1.}; }, {"x"}, {"down", "up"})
+               .Filter("x > 0.5")
+               .Define("y", "x * 2")
+               .Sum<double>("y");
+   auto cs = VariationsFor(c);
+   EXPECT_DOUBLE_EQ(cs["nominal"], 20.);
+   EXPECT_DOUBLE_EQ(cs["x:down"], 0.);
+   EXPECT_DOUBLE_EQ(cs["x:up"], 40.);
+   EXPECT_EQ(df.GetNRuns(), 1u);
+}
+
+TEST(RDFVary, Range)
+{
+   ROOT::RDataFrame df(10);
+   auto c = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+               .Vary("x", [](double x) { return RVec<double>{x + 5.}; }, {"x"}, {"up"})
+               .Filter([](double x) { return x >= 5.; }, {"x"})
+               .Range(3)
+               .Count();
+   auto cs = VariationsFor(c);
+   EXPECT_EQ(cs["nominal"], 3ull);
+   EXPECT_EQ(cs["x:up"], 3ull);
+}
+
+TEST(RDFVary, Errors)
+{
+   ROOT::RDataFrame df(1);
+   auto d = df.Define("x", [] { return 1.; });
+   auto v = d.Vary("x", [](double x) { return RVec<double>{x}; }, {"x"}, {"a"});
+   EXPECT_THROW(d.Vary("x", [](double x) { return RVec<double>{x}; }, {"x"}, std::vector<std::string>{}),
+                std::runtime_error);
+   EXPECT_THROW(v.Vary("x", [](double x) { return RVec<double>{x}; }, {"x"}, {"b"}), std::runtime_error);
+
+   // the varied results must be requested before the event loop runs
+   auto s = v.Sum<double>("x");
+   *s;
+   EXPECT_THROW(VariationsFor(s), std::runtime_error);
+
+   // the expression must return one value per tag
+   ROOT::RDataFrame df2(1);
+   auto s2 = df2.Define("x", [] { return 1.; })
+                .Vary("x", [](double x) { return RVec<double>{x}; }, {"x"}, {"a", "b"})
+                .Sum<double>("x");
+   auto ss = VariationsFor(s2);
+   EXPECT_THROW(ss["x:b"], std::runtime_error);
+}
@@ -55,3 +55,47 @@ TEST_F(RNTupleDSTest, ColTypeNames)
    EXPECT_STREQ("std::string", tds.GetTypeName("tag").c_str());
    EXPECT_STREQ("float", tds.GetTypeName("energy").c_str());
 }
+
+TEST(RNTupleDS, Bulk)
+{
+   const std::string fileName = "RNTupleDS_test_bulk.root";
+   {
+      auto model = RNTupleModel::Create();
+      auto pt = model->MakeField<double>("pt");
+      auto n = model->MakeField<std::int32_t>("n");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileName);
+      for (int i = 0; i < 25000; ++i) {
+         *pt = 0.5 * i;
+         *n = i % 7;
+         ntuple->Fill();
+         // bulks are cut at page and cluster boundaries
+         if (i % 10000 == 9999)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto book = [](ROOT::RDF::RNode df) {
+      return df.Filter([](std::int32_t n) { return n > 2; }, {"n"}).Sum<double>("pt");
+   };
+   auto df = ROOT::Experimental::MakeNTupleDataFrame("ntuple", fileName);
+   auto bulkDf = ROOT::Experimental::MakeNTupleDataFrame("ntuple", fileName);
+   bulkDf.SetBulkSize(1000);
+   auto sum = book(df);
+   auto bulkSum = book(bulkDf);
+   auto bulkCount = bulkDf.Count();
+   EXPECT_DOUBLE_EQ(*sum, *bulkSum);
+   EXPECT_EQ(*bulkCount, 25000ull);
+
+   std::remove(fileName.c_str());
+}
+
+TEST_F(RNTupleDSTest, BulkNonSimpleFields)
+{
+   // the values of the entries are copied since not all fields are mapped from the pages
+   auto df = ROOT::RDataFrame(std::make_unique<RNTupleDS>(std::move(fNTuple)));
+   df.SetBulkSize(16);
+   auto sum = df.Sum<float>("pt");
+   auto jets = df.Define("njets", [](const std::vector<float> &j) { return j.size(); }, {"jets"}).Sum("njets");
+   EXPECT_FLOAT_EQ(*sum, 42.f);
+   EXPECT_EQ(*jets, 2u);
+}
@@ -26,6 +26,10 @@
 #include <vector>
 
 namespace ROOT {
+namespace Internal {
+class RRawFile;
+}
+
 namespace Experimental {
 namespace Detail {
 
@@ -142,6 +146,41 @@ public:
    ~ROnDiskPageMapHeap();
 };
 
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::ROnDiskPageMapMmap
+\ingroup NTuple
+\brief An ROnDiskPageMap whose pages point into a memory mapped file.
+
+The mapping itself is owned by the page source and outlives the page map.  The page map only keeps track of the
+mapped byte ranges of its pages.  When the cluster is evicted, the resident memory of these ranges is released.
+The content remains accessible, it is faulted in again from the file system page cache if necessary.
+*/
+// clang-format on
+class ROnDiskPageMapMmap : public ROnDiskPageMap {
+public:
+   /// A byte range within the file mapping
+   struct RRange {
+      void *fAddress = nullptr;
+      std::size_t fSize = 0;
+      RRange(void *address, std::size_t size) : fAddress(address), fSize(size) {}
+   };
+
+private:
+   /// The raw file that created the mapping, used to advise the kernel about the ranges' access patterns
+   ROOT::Internal::RRawFile *fFile;
+   std::vector<RRange> fRanges;
+
+public:
+   ROnDiskPageMapMmap(ROOT::Internal::RRawFile *file, const std::vector<RRange> &ranges)
+      : fFile(file), fRanges(ranges) {}
+   ROnDiskPageMapMmap(const ROnDiskPageMapMmap &other) = delete;
+   ROnDiskPageMapMmap(ROnDiskPageMapMmap &&other) = default;
+   ROnDiskPageMapMmap &operator =(const ROnDiskPageMapMmap &other) = delete;
+   ROnDiskPageMapMmap &operator =(ROnDiskPageMapMmap &&other) = default;
+   ~ROnDiskPageMapMmap();
+};
+
 // clang-format off
 /**
 \class ROOT::Experimental::Detail::RCluster
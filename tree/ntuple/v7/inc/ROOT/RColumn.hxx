@@ -177,6 +177,27 @@ public:
          (clusterIndex.GetIndex() - fCurrentPage.GetClusterRangeFirst()) * RColumnElement<CppT, ColumnT>::kSize);
    }
 
+   /// Bulk version of Map: returns the address of the element at the given index in the current page and sets
+   /// `nItems` to the number of consecutive elements available in that page from the given index onwards.
+   /// The memory is owned by the page and is valid until the column maps another page.
+   void *MapV(const NTupleSize_t globalIndex, NTupleSize_t &nItems) {
+      if (!fCurrentPage.Contains(globalIndex)) {
+         MapPage(globalIndex);
+      }
+      nItems = fCurrentPage.GetGlobalRangeLast() + 1 - globalIndex;
+      return static_cast<unsigned char *>(fCurrentPage.GetBuffer()) +
+             (globalIndex - fCurrentPage.GetGlobalRangeFirst()) * fElement->GetSize();
+   }
+
+   void *MapV(const RClusterIndex &clusterIndex, NTupleSize_t &nItems) {
+      if (!fCurrentPage.Contains(clusterIndex)) {
+         MapPage(clusterIndex);
+      }
+      nItems = fCurrentPage.GetClusterRangeLast() + 1 - clusterIndex.GetIndex();
+      return static_cast<unsigned char *>(fCurrentPage.GetBuffer()) +
+             (clusterIndex.GetIndex() - fCurrentPage.GetClusterRangeFirst()) * fElement->GetSize();
+   }
+
    NTupleSize_t GetGlobalIndex(const RClusterIndex &clusterIndex) {
       if (!fCurrentPage.Contains(clusterIndex)) {
          MapPage(clusterIndex);
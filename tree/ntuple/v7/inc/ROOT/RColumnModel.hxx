@@ -48,6 +48,14 @@ enum class EColumnType {
    kInt64,
    kInt32,
    kInt16,
+   // Byte-split encodings: on storage, byte 0 of all the elements of a page is followed by byte 1 of all the elements
+   // and so on.  In memory, the elements are laid out as their non-split counterparts.  The index column is
+   // delta-encoded before splitting.
+   kSplitIndex,
+   kSplitReal64,
+   kSplitReal32,
+   kSplitInt64,
+   kSplitInt32,
 };
 
 // clang-format off
@@ -85,6 +85,8 @@ private:
    std::size_t fNRepetitions;
    /// A field on a trivial type that maps as-is to a single column
    bool fIsSimple;
+   /// If set, the field's columns are written with byte-split encodings where available
+   bool fUseSplitEncoding = false;
 
 protected:
    /// Collections and classes own sub fields
@@ -100,6 +102,12 @@ protected:
 
    /// Creates the backing columns corresponsing to the field type and name
    virtual void GenerateColumnsImpl() = 0;
+   /// Creates the offset column of collection fields, which is delta-encoded and byte-split with split encoding
+   std::unique_ptr<RColumn> CreateIndexColumn(std::uint32_t index) const;
+
+   /// Copies the field and its sub fields using a possibly new name and a new, unconnected set of columns;
+   /// called by Clone(), which takes care of the settings common to all fields
+   virtual RFieldBase *CloneImpl(std::string_view newName) = 0;
 
    /// Operations on values of complex types, e.g. ones that involve multiple columns or for which no direct
    /// column type exists.
@@ -154,7 +162,7 @@ public:
    virtual ~RFieldBase();
 
    ///// Copies the field and its sub fields using a possibly new name and a new, unconnected set of columns
-   virtual RFieldBase *Clone(std::string_view newName) = 0;
+   RFieldBase *Clone(std::string_view newName);
 
    /// Factory method to resurrect a field from the stored on-disk type information
    static RFieldBase *Create(const std::string &fieldName, const std::string &typeName);
@@ -207,6 +215,19 @@ public:
       fPrincipalColumn->Read(clusterIndex, &value->fMappedElement);
    }
 
+   /// Zero-copy bulk access for simple fields.  Returns the memory location of the value at the given index inside
+   /// the page buffer and sets `nItems` to the number of consecutive values that follow in the same page, including
+   /// the given one.  The memory is valid until the field's column moves to a different page.
+   void *MapV(NTupleSize_t globalIndex, NTupleSize_t &nItems) {
+      R__ASSERT(fIsSimple);
+      return fPrincipalColumn->MapV(globalIndex, nItems);
+   }
+
+   void *MapV(const RClusterIndex &clusterIndex, NTupleSize_t &nItems) {
+      R__ASSERT(fIsSimple);
+      return fPrincipalColumn->MapV(clusterIndex, nItems);
+   }
+
    /// Ensure that all received items are written from page buffers to the storage.
    void Flush() const;
    /// Perform housekeeping tasks for global to cluster-local index translation
@@ -223,6 +244,11 @@ public:
    const RFieldBase *GetParent() const { return fParent; }
    std::vector<const RFieldBase *> GetSubFields() const;
    bool IsSimple() const { return fIsSimple; }
+   /// With split encoding, floating point and integer columns as well as the offset columns of collections are
+   /// stored byte-split, which usually compresses better.  The setting only affects writing; it needs to be set
+   /// before the field is connected to a page sink.  Readers use the encoding found on disk.
+   void SetSplitEncoding(bool val) { fUseSplitEncoding = val; }
+   bool GetSplitEncoding() const { return fUseSplitEncoding; }
 
    /// Indicates an evolution of the mapping scheme from C++ type to columns
    virtual RNTupleVersion GetFieldVersion() const { return RNTupleVersion(); }
@@ -258,7 +284,7 @@ public:
 class RFieldZero : public Detail::RFieldBase {
 public:
    RFieldZero() : Detail::RFieldBase("", "", ENTupleStructure::kRecord, false /* isSimple */) { }
-   RFieldBase* Clone(std::string_view newName);
+   RFieldBase* CloneImpl(std::string_view newName);
 
    void GenerateColumnsImpl() final {}
    using Detail::RFieldBase::GenerateValue;
@@ -287,7 +313,7 @@ public:
    RClassField(RClassField&& other) = default;
    RClassField& operator =(RClassField&& other) = default;
    ~RClassField() = default;
-   RFieldBase* Clone(std::string_view newName) final;
+   RFieldBase* CloneImpl(std::string_view newName) final;
 
    void GenerateColumnsImpl() final;
    using Detail::RFieldBase::GenerateValue;
@@ -315,7 +341,7 @@ public:
    RVectorField(RVectorField&& other) = default;
    RVectorField& operator =(RVectorField&& other) = default;
    ~RVectorField() = default;
-   RFieldBase* Clone(std::string_view newName) final;
+   RFieldBase* CloneImpl(std::string_view newName) final;
 
    void GenerateColumnsImpl() final;
    using Detail::RFieldBase::GenerateValue;
@@ -352,7 +378,7 @@ public:
    RArrayField(RArrayField &&other) = default;
    RArrayField& operator =(RArrayField &&other) = default;
    ~RArrayField() = default;
-   RFieldBase *Clone(std::string_view newName) final;
+   RFieldBase *CloneImpl(std::string_view newName) final;
 
    void GenerateColumnsImpl() final;
    using Detail::RFieldBase::GenerateValue;
@@ -391,7 +417,7 @@ public:
    RVariantField(RVariantField &&other) = default;
    RVariantField& operator =(RVariantField &&other) = default;
    ~RVariantField() = default;
-   RFieldBase *Clone(std::string_view newName) final;
+   RFieldBase *CloneImpl(std::string_view newName) final;
 
    void GenerateColumnsImpl() final;
    using Detail::RFieldBase::GenerateValue;
@@ -439,7 +465,7 @@ public:
    RCollectionField(RCollectionField&& other) = default;
    RCollectionField& operator =(RCollectionField&& other) = default;
    ~RCollectionField() = default;
-   RFieldBase* Clone(std::string_view newName) final;
+   RFieldBase* CloneImpl(std::string_view newName) final;
 
    void GenerateColumnsImpl() final;
 
@@ -470,7 +496,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase* CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    void GenerateColumnsImpl() final;
 
@@ -516,7 +542,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase *Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase *CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    void GenerateColumnsImpl() final;
 
@@ -553,7 +579,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase* CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    void GenerateColumnsImpl() final;
 
@@ -591,7 +617,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase* CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    void GenerateColumnsImpl() final;
 
@@ -628,7 +654,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase* CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    void GenerateColumnsImpl() final;
 
@@ -665,7 +691,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase* CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    void GenerateColumnsImpl() final;
 
@@ -702,7 +728,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase* CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    void GenerateColumnsImpl() final;
 
@@ -739,7 +765,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase* CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    void GenerateColumnsImpl() final;
 
@@ -786,7 +812,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase* CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    void GenerateColumnsImpl() final;
 
@@ -928,7 +954,7 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final { return new RField(newName); }
+   RFieldBase* CloneImpl(std::string_view newName) final { return new RField(newName); }
 
    using Detail::RFieldBase::GenerateValue;
    template <typename... ArgsT>
@@ -1008,15 +1034,13 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final {
+   RFieldBase* CloneImpl(std::string_view newName) final {
       auto newItemField = fSubFields[0]->Clone(fSubFields[0]->GetName());
       return new RField<ROOT::VecOps::RVec<ItemT>>(newName, std::unique_ptr<Detail::RFieldBase>(newItemField));
    }
 
    void GenerateColumnsImpl() final {
-      RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-         Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+      fColumns.emplace_back(CreateIndexColumn(0));
       fPrincipalColumn = fColumns[0].get();
    }
    void DestroyValue(const Detail::RFieldValue& value, bool dtorOnly = false) final {
@@ -1095,14 +1119,12 @@ public:
    RField(RField&& other) = default;
    RField& operator =(RField&& other) = default;
    ~RField() = default;
-   RFieldBase* Clone(std::string_view newName) final {
+   RFieldBase* CloneImpl(std::string_view newName) final {
       return new RField<ROOT::VecOps::RVec<bool>>(newName);
    }
 
    void GenerateColumnsImpl() final {
-      RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-         Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+      fColumns.emplace_back(CreateIndexColumn(0));
       fPrincipalColumn = fColumns[0].get();
    }
    void DestroyValue(const Detail::RFieldValue& value, bool dtorOnly = false) final {
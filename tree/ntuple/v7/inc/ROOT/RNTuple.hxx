@@ -22,13 +22,16 @@
 #include <ROOT/RNTupleOptions.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RNTupleView.hxx>
+#include <ROOT/RPageSinkBuf.hxx>
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RStringView.hxx>
 
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 class TFile;
 
@@ -76,6 +79,9 @@ Individual fields can be read as well by instantiating a tree view.
 // clang-format on
 class RNTupleReader {
 private:
+   /// Decompresses pages ahead of use if requested by the read options and IMT is enabled;
+   /// needs to be destructed after fSource
+   std::unique_ptr<Detail::RPageStorage::RTaskScheduler> fUnzipTasks;
    std::unique_ptr<Detail::RPageSource> fSource;
    /// Needs to be destructed before fSource
    std::unique_ptr<RNTupleModel> fModel;
@@ -87,6 +93,7 @@ private:
 
    void ConnectModel(const RNTupleModel &model);
    RNTupleReader *GetDisplayReader();
+   void InitPageSource();
 
 public:
    // Browse through the entries
@@ -195,6 +202,9 @@ triggered by Flush() or by destructing the ntuple.  On I/O errors, an exception
 class RNTupleWriter {
 private:
    static constexpr NTupleSize_t kDefaultClusterSizeEntries = 64000;
+   /// Packs and compresses pages in parallel if requested by the write options and IMT is enabled;
+   /// needs to be destructed after fSink
+   std::unique_ptr<Detail::RPageStorage::RTaskScheduler> fZipTasks;
    std::unique_ptr<Detail::RPageSink> fSink;
    /// Needs to be destructed before fSink
    std::unique_ptr<RNTupleModel> fModel;
@@ -232,6 +242,91 @@ public:
    void CommitCluster();
 };
 
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleFillContext
+\ingroup NTuple
+\brief A per-thread context to fill entries into an RNTupleParallelWriter
+
+A fill context works on its own clone of the ntuple model and builds its own clusters.  Pages are packed and
+compressed on the filling thread.  Complete clusters are committed to the shared page sink of the parallel writer.
+The entries of one cluster are consecutive in the resulting ntuple; the order of the clusters from different fill
+contexts is the order in which they are committed.  A fill context must be used by a single thread at a time.
+*/
+// clang-format on
+class RNTupleFillContext {
+   friend class RNTupleParallelWriter;
+
+private:
+   /// The buffered page sink that forwards complete clusters to the parallel writer's sink
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// Needs to be destructed before fSink
+   std::unique_ptr<RNTupleModel> fModel;
+   NTupleSize_t fClusterSizeEntries;
+   NTupleSize_t fLastCommitted = 0;
+   NTupleSize_t fNEntries = 0;
+
+   RNTupleFillContext(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink,
+                      NTupleSize_t clusterSizeEntries);
+
+public:
+   RNTupleFillContext(const RNTupleFillContext &) = delete;
+   RNTupleFillContext &operator=(const RNTupleFillContext &) = delete;
+   ~RNTupleFillContext();
+
+   /// The clone of the parallel writer's model that is used by this context, e.g. to obtain the default entry
+   RNTupleModel *GetModel() { return fModel.get(); }
+
+   void Fill() { Fill(*fModel->GetDefaultEntry()); }
+   void Fill(REntry &entry) {
+      for (auto& value : entry) {
+         value.GetField()->Append(value);
+      }
+      fNEntries++;
+      if ((fNEntries % fClusterSizeEntries) == 0)
+         CommitCluster();
+   }
+   /// Commits the entries filled so far as a new cluster to the shared page sink
+   void CommitCluster();
+};
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleParallelWriter
+\ingroup NTuple
+\brief An RNTuple that is filled concurrently from several threads
+
+Every thread obtains its own RNTupleFillContext.  The fill contexts share a single page sink, which receives
+complete clusters under a short lock.  Hence, there is no need to merge the output of several threads afterwards.
+The parallel writer commits the pending entries of the remaining fill contexts before committing the data set.
+Fill contexts may be destructed after the parallel writer but must not be filled any further; entries committed
+after the data set are discarded.
+*/
+// clang-format on
+class RNTupleParallelWriter {
+private:
+   static constexpr NTupleSize_t kDefaultClusterSizeEntries = 64000;
+   /// The shared page sink and its lock, co-owned by the buffered page sinks of the fill contexts.
+   /// The lock also protects fFillContexts.
+   std::shared_ptr<Detail::RPageSinkBuf::RSharedTarget> fTarget;
+   /// The prototype model of the fill contexts; needs to be destructed before the shared sink
+   std::unique_ptr<RNTupleModel> fModel;
+   std::vector<std::weak_ptr<RNTupleFillContext>> fFillContexts;
+
+public:
+   static std::unique_ptr<RNTupleParallelWriter> Recreate(std::unique_ptr<RNTupleModel> model,
+                                                          std::string_view ntupleName,
+                                                          std::string_view storage,
+                                                          const RNTupleWriteOptions &options = RNTupleWriteOptions());
+   RNTupleParallelWriter(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink);
+   RNTupleParallelWriter(const RNTupleParallelWriter&) = delete;
+   RNTupleParallelWriter& operator=(const RNTupleParallelWriter&) = delete;
+   ~RNTupleParallelWriter();
+
+   /// Creates a new fill context with a clone of the model; thread-safe
+   std::shared_ptr<RNTupleFillContext> CreateFillContext();
+};
+
 // clang-format off
 /**
 \class ROOT::Experimental::RCollectionNTuple
@@ -0,0 +1,56 @@
+/// \file ROOT/RNTupleImtTaskScheduler.hxx
+/// \ingroup NTuple ROOT7
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RNTupleImtTaskScheduler
+#define ROOT7_RNTupleImtTaskScheduler
+
+#include <RConfigure.h>
+
+#ifdef R__USE_IMT
+#include <ROOT/RPageStorage.hxx>
+#include <ROOT/TTaskGroup.hxx>
+
+#include <functional>
+#include <memory>
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RNTupleImtTaskScheduler
+\ingroup NTuple
+\brief A page storage task scheduler that runs the tasks on the IMT task arena
+
+Used by the page sinks and sources to (de)compress pages in parallel if implicit multi-threading is enabled.
+*/
+// clang-format on
+class RNTupleImtTaskScheduler : public RPageStorage::RTaskScheduler {
+private:
+   std::unique_ptr<TTaskGroup> fTaskGroup;
+
+public:
+   RNTupleImtTaskScheduler();
+   virtual ~RNTupleImtTaskScheduler() = default;
+   void Reset() final;
+   void AddTask(const std::function<void(void)> &taskFunc) final;
+   void Wait() final;
+};
+
+} // namespace Detail
+} // namespace Experimental
+} // namespace ROOT
+
+#endif // R__USE_IMT
+#endif
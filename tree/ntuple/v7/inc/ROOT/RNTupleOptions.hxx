@@ -18,6 +18,8 @@
 
 #include <Compression.h>
 
+#include <cstddef>
+
 namespace ROOT {
 namespace Experimental {
 
@@ -44,8 +46,17 @@ All page sink classes need to support the common options.
 */
 // clang-format on
 class RNTupleWriteOptions {
+public:
+  /// Default upper limit for the memory held by pages that are queued for packing and compression
+  static constexpr std::size_t kDefaultMaxInFlightBytes = 64 * 1024 * 1024;
+
+private:
   int fCompression{RCompressionSetting::EDefaults::kUseAnalysis};
   ENTupleContainerFormat fContainerFormat{ENTupleContainerFormat::kTFile};
+  /// If set and implicit multi-threading is enabled, pages are packed and compressed on the IMT task arena
+  bool fUseImplicitMT{false};
+  /// With implicit multi-threading, the writer blocks and flushes the queued pages once their size exceeds the limit
+  std::size_t fMaxInFlightBytes{kDefaultMaxInFlightBytes};
 
 public:
   int GetCompression() const { return fCompression; }
@@ -56,6 +67,12 @@ public:
 
   ENTupleContainerFormat GetContainerFormat() const { return fContainerFormat; }
   void SetContainerFormat(ENTupleContainerFormat val) { fContainerFormat = val; }
+
+  bool GetUseImplicitMT() const { return fUseImplicitMT; }
+  void SetUseImplicitMT(bool val) { fUseImplicitMT = val; }
+
+  std::size_t GetMaxInFlightBytes() const { return fMaxInFlightBytes; }
+  void SetMaxInFlightBytes(std::size_t val) { fMaxInFlightBytes = val; }
 };
 
 
@@ -78,10 +95,22 @@ public:
 
 private:
    EClusterCache fClusterCache = EClusterCache::kDefault;
+   /// If set and implicit multi-threading is enabled, the pages of freshly loaded clusters are decompressed and
+   /// unpacked ahead of use on the IMT task arena
+   bool fUseImplicitMT = false;
+   /// If set and supported by the file, the file is memory mapped and the pages are read directly from the mapping.
+   /// Uncompressed pages whose on-disk layout matches the in-memory layout are used without any copy.
+   bool fUseMmap = false;
 
 public:
    EClusterCache GetClusterCache() const { return fClusterCache; }
    void SetClusterCache(EClusterCache val) { fClusterCache = val; }
+
+   bool GetUseImplicitMT() const { return fUseImplicitMT; }
+   void SetUseImplicitMT(bool val) { fUseImplicitMT = val; }
+
+   bool GetUseMmap() const { return fUseMmap; }
+   void SetUseMmap(bool val) { fUseMmap = val; }
 };
 
 } // namespace Experimental
@@ -18,8 +18,11 @@
 
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RSpan.hxx>
 #include <ROOT/RStringView.hxx>
+#include <ROOT/RVec.hxx>
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <type_traits>
@@ -145,7 +148,9 @@ The view owns a field and its underlying columns in order to fill an ntuple valu
 accessed by index. For top-level fields, the index refers to the entry number. Fields that are part of
 nested collections have global index numbers that are derived from their parent indexes.
 
-Fields of simple types with a Map() method will use that and thus expose zero-copy access.
+Fields of simple types with a Map() method will use that and thus expose zero-copy access.  For these fields,
+MapV() provides zero-copy bulk access to all the values of a page at once.  ReadV() returns the values of an
+arbitrary index range; for mappable fields, it copies page-sized chunks rather than individual values.
 */
 // clang-format on
 template <typename T>
@@ -204,6 +209,50 @@ public:
       fField.Read(clusterIndex, &fValue);
       return *fValue.Get<T>();
    }
+
+   /// Returns the values from globalIndex up to the end of the page that contains globalIndex.  The span points into
+   /// the page buffer; it is valid until the view is used to access an index outside of the returned range.
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapV(NTupleSize_t globalIndex) {
+      NTupleSize_t nItems;
+      auto values = static_cast<const C *>(fField.MapV(globalIndex, nItems));
+      return std::span<const C>(values, nItems);
+   }
+
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapV(const RClusterIndex &clusterIndex) {
+      NTupleSize_t nItems;
+      auto values = static_cast<const C *>(fField.MapV(clusterIndex, nItems));
+      return std::span<const C>(values, nItems);
+   }
+
+   /// Returns a copy of the nItems values starting at globalIndex, which may span several pages
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, ROOT::VecOps::RVec<C>>
+   ReadV(NTupleSize_t globalIndex, NTupleSize_t nItems) {
+      ROOT::VecOps::RVec<C> result(nItems);
+      NTupleSize_t nRead = 0;
+      while (nRead < nItems) {
+         auto page = MapV(globalIndex + nRead);
+         auto nBatch = std::min(NTupleSize_t(page.size()), nItems - nRead);
+         std::copy(page.begin(), page.begin() + nBatch, result.begin() + nRead);
+         nRead += nBatch;
+      }
+      return result;
+   }
+
+   template <typename C = T>
+   typename std::enable_if_t<!Internal::IsMappable<FieldT>::value, ROOT::VecOps::RVec<C>>
+   ReadV(NTupleSize_t globalIndex, NTupleSize_t nItems) {
+      ROOT::VecOps::RVec<C> result(nItems);
+      for (NTupleSize_t i = 0; i < nItems; ++i) {
+         fField.Read(globalIndex + i, &fValue);
+         result[i] = *fValue.Get<T>();
+      }
+      return result;
+   }
 };
 
 
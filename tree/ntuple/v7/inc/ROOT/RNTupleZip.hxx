@@ -94,12 +94,20 @@ public:
    /// Returns the size of the compressed data block. The data is written into the zip buffer.
    /// This works only for small input buffer up to 16MB
    size_t operator() (const void *from, size_t nbytes, int compression) {
+      return Zip(from, nbytes, compression, fZipBuffer->data());
+   }
+
+   /// Returns the size of the compressed data block. The data is written into the given target buffer, which
+   /// must provide space for at least nbytes.  Does not touch the zip buffer and can thus be used concurrently,
+   /// e.g. by tasks that compress pages in parallel. This works only for small input buffer up to 16MB
+   static size_t Zip(const void *from, size_t nbytes, int compression, void *to) {
       R__ASSERT(from != nullptr);
+      R__ASSERT(to != nullptr);
       R__ASSERT(nbytes <= kMAXZIPBUF);
 
       auto cxLevel = compression % 100;
       if (cxLevel == 0) {
-         memcpy(fZipBuffer->data(), from, nbytes);
+         memcpy(to, from, nbytes);
          return nbytes;
       }
 
@@ -107,14 +115,14 @@ public:
       int szSource = nbytes;
       char *source = const_cast<char *>(static_cast<const char *>(from));
       int szTarget = nbytes;
-      char *target = reinterpret_cast<char *>(fZipBuffer->data());
+      char *target = static_cast<char *>(to);
       int szOut = 0;
       R__zipMultipleAlgorithm(cxLevel, &szSource, source, &szTarget, target, &szOut, cxAlgorithm);
       R__ASSERT(szOut >= 0);
       if ((szOut > 0) && (static_cast<unsigned int>(szOut) < nbytes))
          return szOut;
 
-      memcpy(fZipBuffer->data(), from, nbytes);
+      memcpy(to, from, nbytes);
       return nbytes;
    }
 
@@ -144,6 +152,13 @@ public:
     * The block is uncompressed iff nbytes == dataLen.
     */
    void operator() (const void *from, size_t nbytes, size_t dataLen, void *to) {
+      Unzip(from, nbytes, dataLen, to);
+   }
+
+   /**
+    * Thread-safe variant of the out-of-place decompression; it does not use the unzip buffer.
+    */
+   static void Unzip(const void *from, size_t nbytes, size_t dataLen, void *to) {
       if (dataLen == nbytes) {
          memcpy(to, from, nbytes);
          return;
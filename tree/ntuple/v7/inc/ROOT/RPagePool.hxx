@@ -21,6 +21,7 @@
 #include <ROOT/RNTupleUtil.hxx>
 
 #include <cstddef>
+#include <mutex>
 #include <vector>
 
 namespace ROOT {
@@ -39,8 +40,9 @@ pages is thread-safe. The page pool does not allocate the memory -- allocation a
 page storage, which might do it in a way optimized to the backing store (e.g., mmap()).
 Multiple page caches can coexist.
 
-TODO(jblomer): it should be possible to register pages and to find them by column and index; this would
-facilitate pre-filling a cache, e.g. by read-ahead.
+Pages can be preloaded, e.g. by the page source decompressing a freshly loaded cluster ahead of use.  Preloaded
+pages are owned by the pool until they are requested by GetPage(), after which they are reference counted as usual.
+Preloaded pages that are never requested are freed by EvictPreloadedPages() when their cluster is released.
 */
 // clang-format on
 class RPagePool {
@@ -53,16 +55,24 @@ private:
    std::vector<RPage> fPages;
    std::vector<std::uint32_t> fReferences;
    std::vector<RPageDeleter> fDeleters;
+   /// Protects the page vectors, which are accessed concurrently by the reader and the page preloading
+   std::mutex fLock;
 
 public:
    RPagePool() = default;
    RPagePool(const RPagePool&) = delete;
    RPagePool& operator =(const RPagePool&) = delete;
-   ~RPagePool() = default;
+   /// Frees the preloaded pages that have never been requested
+   ~RPagePool();
 
    /// Adds a new page to the pool together with the function to free its space. Upon registration,
    /// the page pool takes ownership of the page's memory. The new page has its reference counter set to 1.
    void RegisterPage(const RPage &page, const RPageDeleter &deleter);
+   /// Like RegisterPage() but the reference counter is set to 0, i.e. the page only increases its reference counter
+   /// once it is requested by GetPage()
+   void PreloadPage(const RPage &page, const RPageDeleter &deleter);
+   /// Frees the preloaded pages of the given cluster that have not been requested
+   void EvictPreloadedPages(DescriptorId_t clusterId);
    /// Tries to find the page corresponding to column and index in the cache. If the page is found, its reference
    /// counter is increased
    RPage GetPage(ColumnId_t columnId, NTupleSize_t globalIndex);
@@ -0,0 +1,86 @@
+/// \file ROOT/RPageSinkBuf.hxx
+/// \ingroup NTuple ROOT7
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RPageSinkBuf
+#define ROOT7_RPageSinkBuf
+
+#include <ROOT/RPageStorage.hxx>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RPageSinkBuf
+\ingroup NTuple
+\brief A page sink that seals and buffers the pages of a cluster and commits the cluster to a shared page sink
+
+Used by the fill contexts of the RNTupleParallelWriter.  Pages are packed and compressed on the thread that
+commits them.  On CommitCluster(), the buffered pages are handed as a whole to the shared page sink while holding
+the given lock.  Thus clusters are written atomically and the descriptor of the shared sink stays consistent.
+The column ids are issued in the same order as for the shared page sink, provided that the buffered sink is
+created from a clone of the model of the shared sink.  The buffered sink does not keep cluster meta-data of its own.
+*/
+// clang-format on
+class RPageSinkBuf : public RPageSink {
+public:
+   /// The shared page sink and its lock.  Co-owned by the owner of the shared sink and by the buffered sinks, so
+   /// that a buffered sink can safely outlive the owner.
+   struct RSharedTarget {
+      std::mutex fLock;
+      std::unique_ptr<RPageSink> fSink;
+      /// Set by the owner once the data set is committed; clusters committed afterwards are discarded
+      bool fIsDatasetCommitted = false;
+
+      explicit RSharedTarget(std::unique_ptr<RPageSink> sink) : fSink(std::move(sink)) {}
+   };
+
+private:
+   /// A packed and compressed page together with its memory
+   struct RBufferedPage {
+      std::unique_ptr<unsigned char[]> fBuffer;
+      RSealedPage fSealedPage;
+   };
+
+   /// The shared page sink that receives the complete clusters; access to it is serialized by its lock
+   std::shared_ptr<RSharedTarget> fTarget;
+   /// The sealed pages of the currently open cluster, indexed by column id
+   std::vector<std::vector<RBufferedPage>> fBufferedPages;
+
+protected:
+   void CreateImpl(const RNTupleModel &model) final;
+   RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) final;
+   RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) final;
+   void CommitDatasetImpl() final;
+
+public:
+   explicit RPageSinkBuf(std::shared_ptr<RSharedTarget> target);
+   RPageSinkBuf(const RPageSinkBuf &other) = delete;
+   RPageSinkBuf &operator =(const RPageSinkBuf &other) = delete;
+   virtual ~RPageSinkBuf();
+
+   RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements = 0) final;
+   void ReleasePage(RPage &page) final;
+};
+
+} // namespace Detail
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
@@ -25,8 +25,10 @@
 
 #include <atomic>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -38,6 +40,7 @@ namespace Detail {
 
 class RCluster;
 class RColumn;
+class RColumnElementBase;
 class RPagePool;
 class RFieldBase;
 class RNTupleMetrics;
@@ -58,8 +61,24 @@ an ntuple.  Concrete implementations can use a TFile, a raw file, an object stor
 */
 // clang-format on
 class RPageStorage {
+public:
+   /// The interface of a task scheduler to schedule page (de)compression tasks
+   class RTaskScheduler {
+   public:
+      virtual ~RTaskScheduler() = default;
+      /// Start a new set of tasks
+      virtual void Reset() = 0;
+      /// Take a callable that represents a task
+      virtual void AddTask(const std::function<void(void)> &taskFunc) = 0;
+      /// Blocks until all scheduled tasks finished
+      virtual void Wait() = 0;
+   };
+
 protected:
    std::string fNTupleName;
+   /// If set, the page storage uses the scheduler to distribute page (de)compression on several threads.
+   /// The task scheduler is owned by the caller and must outlive the page storage.
+   RTaskScheduler *fTaskScheduler = nullptr;
 
 public:
    explicit RPageStorage(std::string_view name);
@@ -69,6 +88,7 @@ public:
 
    /// Whether the concrete implementation is a sink or a source
    virtual EPageStorageType GetType() = 0;
+   const std::string &GetNTupleName() const { return fNTupleName; }
 
    struct RColumnHandle {
       DescriptorId_t fId = kInvalidDescriptorId;
@@ -94,6 +114,8 @@ public:
 
    /// Returns an empty metrics.  Page storage implementations usually have their own metrics.
    virtual RNTupleMetrics &GetMetrics();
+
+   void SetTaskScheduler(RTaskScheduler *taskScheduler) { fTaskScheduler = taskScheduler; }
 };
 
 // clang-format off
@@ -108,6 +130,22 @@ up to the given entry number are committed.
 */
 // clang-format on
 class RPageSink : public RPageStorage {
+public:
+   /// A sealed page contains the bytes of a page as written to storage (packed & compressed).  It is used
+   /// as input to CommitSealedPage().  The sealed page does not own the buffer.
+   struct RSealedPage {
+      const void *fBuffer = nullptr;
+      /// The size of the packed and compressed page
+      std::size_t fBytesOnStorage = 0;
+      /// The size of the packed page before compression
+      std::size_t fBytesPacked = 0;
+      std::uint32_t fNElements = 0;
+
+      RSealedPage() = default;
+      RSealedPage(const void *b, std::size_t bs, std::size_t bp, std::uint32_t n)
+         : fBuffer(b), fBytesOnStorage(bs), fBytesPacked(bp), fNElements(n) {}
+   };
+
 protected:
    RNTupleWriteOptions fOptions;
 
@@ -122,9 +160,13 @@ protected:
    /// Keeps track of the written pages in the currently open cluster. Indexed by column id.
    std::vector<RClusterDescriptor::RPageRange> fOpenPageRanges;
    RNTupleDescriptorBuilder fDescriptorBuilder;
+   /// Sinks that forward their clusters to another sink don't need to accumulate cluster descriptors
+   bool fKeepClusterDescriptors = true;
 
    virtual void CreateImpl(const RNTupleModel &model) = 0;
    virtual RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) = 0;
+   virtual RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId,
+                                                             const RSealedPage &sealedPage) = 0;
    virtual RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) = 0;
    virtual void CommitDatasetImpl() = 0;
 
@@ -135,6 +177,7 @@ public:
    static std::unique_ptr<RPageSink> Create(std::string_view ntupleName, std::string_view location,
                                             const RNTupleWriteOptions &options = RNTupleWriteOptions());
    EPageStorageType GetType() final { return EPageStorageType::kSink; }
+   const RNTupleWriteOptions &GetWriteOptions() const { return fOptions; }
 
    ColumnHandle_t AddColumn(DescriptorId_t fieldId, const RColumn &column) final;
    void DropColumn(ColumnHandle_t /*columnHandle*/) final {}
@@ -145,10 +188,20 @@ public:
    void Create(RNTupleModel &model);
    /// Write a page to the storage. The column must have been added before.
    void CommitPage(ColumnHandle_t columnHandle, const RPage &page);
+   /// Write a preprocessed page to storage. The column must have been added before.
+   void CommitSealedPage(DescriptorId_t columnId, const RSealedPage &sealedPage);
    /// Finalize the current cluster and create a new one for the following data.
    void CommitCluster(NTupleSize_t nEntries);
    /// Finalize the current cluster and the entrire data set.
    void CommitDataset() { CommitDatasetImpl(); }
+   /// The number of entries in the committed clusters
+   NTupleSize_t GetNEntries() const { return fPrevClusterNEntries; }
+
+   /// Packs and compresses the page into buf, which needs to provide at least page.GetSize() bytes.  Returns
+   /// the sealed page pointing into buf. Does not use any state of the page sink and can thus be used concurrently
+   /// by several threads, e.g. by the tasks that compress pages in parallel.
+   static RSealedPage SealPage(const RPage &page, const RColumnElementBase &element, int compressionSetting,
+                               void *buf);
 
    /// Get a new, empty page for the given column that can be filled with up to nElements.  If nElements is zero,
    /// the page sink picks an appropriate size.
@@ -186,6 +239,7 @@ public:
                                               const RNTupleReadOptions &options = RNTupleReadOptions());
    /// Open the same storage multiple time, e.g. for reading in multiple threads
    virtual std::unique_ptr<RPageSource> Clone() const = 0;
+   const RNTupleReadOptions &GetReadOptions() const { return fOptions; }
 
    EPageStorageType GetType() final { return EPageStorageType::kSource; }
    const RNTupleDescriptor &GetDescriptor() const { return fDescriptor; }
@@ -211,6 +265,27 @@ public:
    /// LoadCluster() is typically called from the I/O thread of a cluster pool, i.e. the method runs
    /// concurrently to other methods of the page source.
    virtual std::unique_ptr<RCluster> LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns) = 0;
+
+   /// Identifies a cluster and the subset of its columns requested by LoadClusters()
+   struct RClusterKey {
+      DescriptorId_t fClusterId = kInvalidDescriptorId;
+      ColumnSet_t fColumnSet;
+   };
+   /// Populates the pages of several clusters at once, in the order given by `clusterKeys`.  The semantics per
+   /// cluster are the same as for LoadCluster().  Page sources can override this method in order to issue the
+   /// reads for all the requested clusters in a single vector read; the default implementation calls LoadCluster()
+   /// for every key.
+   virtual std::vector<std::unique_ptr<RCluster>> LoadClusters(const std::vector<RClusterKey> &clusterKeys);
+
+   /// Called by the cluster pool's I/O thread for every loaded cluster before it is handed out to the reader.
+   /// Page sources with a task scheduler can use it to decompress and unpack the cluster's pages ahead of use
+   /// (unzip-ahead) and preload them into their page pool.  The decompression runs in the background; the call
+   /// does not block.  The default implementation does nothing.
+   virtual void UnzipCluster(RCluster * /* cluster */) {}
+   /// Called by the cluster pool before it releases the memory of a cluster that went through UnzipCluster().
+   /// Needs to wait for background work on the cluster's pages and may drop the pages that were preloaded but never
+   /// requested.  The default implementation does nothing.
+   virtual void ReleaseCluster(DescriptorId_t /* clusterId */) {}
 };
 
 } // namespace Detail
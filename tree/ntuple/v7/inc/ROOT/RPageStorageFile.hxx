@@ -20,26 +20,29 @@
 #include <ROOT/RMiniFile.hxx>
 #include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleZip.hxx>
+#include <ROOT/RRawFile.hxx>
 #include <ROOT/RStringView.hxx>
 
 #include <array>
+#include <condition_variable>
 #include <cstdio>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <vector>
 
 class TFile;
 
 namespace ROOT {
 
-namespace Internal {
-class RRawFile;
-}
-
 namespace Experimental {
 namespace Detail {
 
 class RCluster;
 class RClusterPool;
+class RColumnElementBase;
 class RPageAllocatorHeap;
 class RPagePool;
 
@@ -69,9 +72,31 @@ private:
    /// Helper for zipping keys and header / footer; comprises a 16MB zip buffer
    RNTupleCompressor fCompressor;
 
+   /// A page that got committed while implicit multi-threading is used. The page contents are copied into
+   /// fBuffer, which is sealed into fZipBuffer once the task scheduler ran the zip task.
+   struct RZipItem {
+      /// The page info in fOpenPageRanges that receives the locator once the sealed page is written
+      DescriptorId_t fColumnId = kInvalidDescriptorId;
+      std::size_t fPageIdx = 0;
+      std::unique_ptr<unsigned char[]> fBuffer;
+      /// Points into fZipBuffer once the page is packed and compressed
+      RSealedPage fSealedPage;
+      std::unique_ptr<unsigned char[]> fZipBuffer;
+   };
+   /// Pages handed over to the task scheduler; they are written in the order of CommitPage() calls
+   std::vector<std::unique_ptr<RZipItem>> fZipQueue;
+   /// Sum of the unpacked page sizes in fZipQueue
+   std::size_t fZipQueueBytes = 0;
+
+   /// Writes the sealed page to the file and returns its location; updates the cluster byte range
+   RClusterDescriptor::RLocator WriteSealedPage(const RSealedPage &sealedPage);
+   /// Waits for the in-flight zip tasks and writes their pages in commit order
+   void FlushZipQueue();
+
 protected:
    void CreateImpl(const RNTupleModel &model) final;
    RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) final;
    RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) final;
    void CommitDatasetImpl() final;
 
@@ -122,14 +147,16 @@ private:
       RNTupleAtomicCounter &fNRead;
       RNTupleAtomicCounter &fSzReadPayload ;
       RNTupleAtomicCounter &fSzReadOverhead;
-      RNTuplePlainCounter  &fSzUnzip;
+      RNTupleAtomicCounter &fSzUnzip;
       RNTupleAtomicCounter &fNClusterLoaded;
       RNTuplePlainCounter  &fNPageLoaded;
       RNTuplePlainCounter  &fNPagePopulated;
+      RNTupleAtomicCounter &fNPageUnzipAhead;
+      RNTuplePlainCounter  &fNPageMapped;
       RNTupleAtomicCounter &fTimeWallRead;
-      RNTuplePlainCounter  &fTimeWallUnzip;
+      RNTupleAtomicCounter &fTimeWallUnzip;
       RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuRead;
-      RNTupleTickCounter<RNTuplePlainCounter>  &fTimeCpuUnzip;
+      RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuUnzip;
    };
    std::unique_ptr<RCounters> fCounters;
    /// Wraps the I/O counters and is observed by the RNTupleReader metrics
@@ -147,12 +174,51 @@ private:
    std::unique_ptr<ROOT::Internal::RRawFile> fFile;
    /// Takes the fFile to read ntuple blobs from it
    Internal::RMiniFileReader fReader;
+   /// If memory mapping is used, the entire file is mapped at offset zero; pages are served from the mapping
+   unsigned char *fMmapRegion = nullptr;
+   std::size_t fMmapSize = 0;
    /// The cluster pool asynchronously preloads the next few clusters
    std::unique_ptr<RClusterPool> fClusterPool;
 
+   /// Identifies a page that is scheduled for being decompressed ahead of use
+   struct RUnzipAheadKey {
+      DescriptorId_t fClusterId;
+      DescriptorId_t fColumnId;
+      NTupleSize_t fPageNo;
+      bool operator <(const RUnzipAheadKey &other) const {
+         return std::tie(fClusterId, fColumnId, fPageNo) <
+                std::tie(other.fClusterId, other.fColumnId, other.fPageNo);
+      }
+   };
+   /// The state of a scheduled page; the task id tells apart tasks of a cluster that was released and loaded again
+   struct RUnzipAheadTask {
+      std::uint64_t fTaskId;
+      bool fIsRunning;
+   };
+   /// The pages scheduled by UnzipCluster().  A reader that needs a page whose task did not yet start claims the
+   /// page by removing it and populates it itself; a reader that needs a page whose task is running waits for the
+   /// task to preload the page into the page pool.
+   std::map<RUnzipAheadKey, RUnzipAheadTask> fUnzipAheadPages;
+   std::uint64_t fUnzipAheadNextTaskId = 0;
+   /// Protects fUnzipAheadPages, which is accessed by the reader, the cluster pool, and the unzip tasks
+   std::mutex fLockUnzipAhead;
+   /// Signals that an unzip task finished a page
+   std::condition_variable fCvUnzipAhead;
+
    RPageSourceFile(std::string_view ntupleName, const RNTupleReadOptions &options);
    RPage PopulatePageFromCluster(ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor,
                                  ClusterSize_t::ValueType clusterIndex);
+   /// Allocates the on-disk page buffer of the given cluster and appends the corresponding (coalesced) byte ranges
+   /// to `readRequests`.  The returned cluster is only usable once the read requests have been served.
+   /// Makes sure that fCurrentCluster is the given cluster; with unzip-ahead, pages are often found in the page
+   /// pool, so this is also called on page pool hits in order to keep the cluster pool's look-ahead window moving
+   void UpdateCurrentCluster(DescriptorId_t clusterId, DescriptorId_t columnId);
+   /// With a memory mapped file, uncompressed pages that are suitably aligned and that do not need unpacking can be
+   /// used as they are from the mapping
+   bool CanUseMappedPage(const void *onDiskAddress, std::size_t bytesOnStorage, std::size_t bytesPacked,
+                         const RColumnElementBase &element) const;
+   std::unique_ptr<RCluster> PrepareSingleCluster(const RClusterKey &clusterKey,
+                                                  std::vector<ROOT::Internal::RRawFile::RIOVec> &readRequests);
 
 protected:
    RNTupleDescriptor AttachImpl() final;
@@ -169,6 +235,9 @@ public:
    void ReleasePage(RPage &page) final;
 
    std::unique_ptr<RCluster> LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns) final;
+   std::vector<std::unique_ptr<RCluster>> LoadClusters(const std::vector<RClusterKey> &clusterKeys) final;
+   void UnzipCluster(RCluster *cluster) final;
+   void ReleaseCluster(DescriptorId_t clusterId) final;
 
    RNTupleMetrics &GetMetrics() final { return fMetrics; }
 };
@@ -14,6 +14,7 @@
  *************************************************************************/
 
 #include <ROOT/RCluster.hxx>
+#include <ROOT/RRawFile.hxx>
 
 #include <TError.h>
 
@@ -33,6 +34,16 @@ ROOT::Experimental::Detail::ROnDiskPageMapHeap::~ROnDiskPageMapHeap() = default;
 ////////////////////////////////////////////////////////////////////////////////
 
 
+ROOT::Experimental::Detail::ROnDiskPageMapMmap::~ROnDiskPageMapMmap()
+{
+   for (const auto &r : fRanges)
+      fFile->Advise(r.fAddress, r.fSize, ROOT::Internal::RRawFile::EMapAdvice::kDontNeed);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
 const ROOT::Experimental::Detail::ROnDiskPage *
 ROOT::Experimental::Detail::RCluster::GetOnDiskPage(const ROnDiskPage::Key &key) const
 {
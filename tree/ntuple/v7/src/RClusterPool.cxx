@@ -71,6 +71,17 @@ ROOT::Experimental::Detail::RClusterPool::~RClusterPool()
       fCvHasWork.notify_one();
    }
    fThreadIo.join();
+
+   // The page source may still work on the pages of the loaded clusters
+   for (auto &inFlight : fInFlightClusters) {
+      auto cptr = inFlight.fFuture.get();
+      if (cptr)
+         fPageSource.ReleaseCluster(cptr->GetId());
+   }
+   for (auto &cptr : fPool) {
+      if (cptr)
+         fPageSource.ReleaseCluster(cptr->GetId());
+   }
 }
 
 void ROOT::Experimental::Detail::RClusterPool::ExecLoadClusters()
@@ -86,12 +97,30 @@ void ROOT::Experimental::Detail::RClusterPool::ExecLoadClusters()
          }
       }
 
+      // Load all the queued clusters in one go, which gives the page source the chance to issue a single
+      // vector read for the lot.  The sentinel work item terminates the I/O thread after the preceding items
+      // have been served.
+      bool terminate = false;
+      std::vector<RPageSource::RClusterKey> clusterKeys;
       for (auto &item : workItems) {
-         if (item.fClusterId == kInvalidDescriptorId)
-            return;
+         if (item.fClusterId == kInvalidDescriptorId) {
+            terminate = true;
+            break;
+         }
+         RPageSource::RClusterKey key;
+         key.fClusterId = item.fClusterId;
+         key.fColumnSet = item.fColumns;
+         clusterKeys.emplace_back(key);
+      }
+
+      std::vector<std::unique_ptr<RCluster>> clusters;
+      if (!clusterKeys.empty())
+         clusters = fPageSource.LoadClusters(clusterKeys);
+      R__ASSERT(clusters.size() == clusterKeys.size());
 
-         // TODO(jblomer): the page source needs to be capable of loading multiple clusters in one go
-         auto cluster = fPageSource.LoadCluster(item.fClusterId, item.fColumns);
+      for (unsigned int i = 0; i < clusters.size(); ++i) {
+         auto &item = workItems[i];
+         auto &cluster = clusters[i];
 
          // Meanwhile, the user might have requested clusters outside the look-ahead window, so that we don't
          // need the cluster anymore, in which case we simply discard it right away, before moving it to the pool
@@ -107,9 +136,14 @@ void ROOT::Experimental::Detail::RClusterPool::ExecLoadClusters()
          }
          if (discard)
             cluster.reset();
+         else
+            fPageSource.UnzipCluster(cluster.get());
 
          item.fPromise.set_value(std::move(cluster));
       }
+
+      if (terminate)
+         return;
    } // while (true)
 }
 
@@ -215,6 +249,7 @@ ROOT::Experimental::Detail::RClusterPool::GetCluster(
          continue;
       if (keep.count(cptr->GetId()) > 0)
          continue;
+      fPageSource.ReleaseCluster(cptr->GetId());
       cptr.reset();
    }
 
@@ -241,6 +276,8 @@ ROOT::Experimental::Detail::RClusterPool::GetCluster(
          auto cptr = itr->fFuture.get();
          // If cptr is nullptr, the cluster expired previously and was released by the I/O thread
          if (!cptr || itr->fIsExpired) {
+            if (cptr)
+               fPageSource.ReleaseCluster(cptr->GetId());
             cptr.reset();
             itr = fInFlightClusters.erase(itr);
             continue;
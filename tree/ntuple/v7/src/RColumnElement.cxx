@@ -19,32 +19,164 @@
 
 #include <algorithm>
 #include <bitset>
+#include <cstring>
 #include <cstdint>
+#include <memory>
 
-ROOT::Experimental::Detail::RColumnElementBase
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/// Scalar byte-split kernel, also used for the tail of the vectorized kernels
+template <std::size_t N>
+void SplitPackScalar(unsigned char *dst, const unsigned char *src, std::size_t first, std::size_t count)
+{
+   for (std::size_t i = first; i < count; ++i) {
+      for (std::size_t b = 0; b < N; ++b)
+         dst[b * count + i] = src[i * N + b];
+   }
+}
+
+template <std::size_t N>
+void SplitUnpackScalar(unsigned char *dst, const unsigned char *src, std::size_t first, std::size_t count)
+{
+   for (std::size_t i = first; i < count; ++i) {
+      for (std::size_t b = 0; b < N; ++b)
+         dst[i * N + b] = src[b * count + i];
+   }
+}
+
+#if defined(__SSE2__)
+/// The vectorized kernels process blocks of 16 elements, i.e. N registers.  Enumerating the bytes of a block with
+/// the bits of the element index followed by the bits of the byte index, interleaving the bytes of the first and
+/// the second half of the registers rotates this enumeration by one bit.  Four rotations move the element index
+/// bits to the low end (split), log2(N) rotations move the byte index bits back to the low end (unsplit).
+template <std::size_t N>
+inline void Riffle(__m128i *r)
+{
+   __m128i t[N];
+   for (std::size_t k = 0; k < N / 2; ++k) {
+      t[2 * k] = _mm_unpacklo_epi8(r[k], r[k + N / 2]);
+      t[2 * k + 1] = _mm_unpackhi_epi8(r[k], r[k + N / 2]);
+   }
+   for (std::size_t k = 0; k < N; ++k)
+      r[k] = t[k];
+}
+
+template <std::size_t N>
+void SplitPackSIMD(unsigned char *dst, const unsigned char *src, std::size_t count)
+{
+   std::size_t i = 0;
+   for (; i + 16 <= count; i += 16) {
+      __m128i r[N];
+      for (std::size_t k = 0; k < N; ++k)
+         r[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * N + 16 * k));
+      for (int round = 0; round < 4; ++round)
+         Riffle<N>(r);
+      for (std::size_t b = 0; b < N; ++b)
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + b * count + i), r[b]);
+   }
+   SplitPackScalar<N>(dst, src, i, count);
+}
+
+template <std::size_t N>
+void SplitUnpackSIMD(unsigned char *dst, const unsigned char *src, std::size_t count)
+{
+   constexpr int nRounds = (N == 8) ? 3 : 2;
+   static_assert(N == 4 || N == 8, "unsupported element size");
+   std::size_t i = 0;
+   for (; i + 16 <= count; i += 16) {
+      __m128i r[N];
+      for (std::size_t b = 0; b < N; ++b)
+         r[b] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + b * count + i));
+      for (int round = 0; round < nRounds; ++round)
+         Riffle<N>(r);
+      for (std::size_t k = 0; k < N; ++k)
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * N + 16 * k), r[k]);
+   }
+   SplitUnpackScalar<N>(dst, src, i, count);
+}
+#endif
+
+} // anonymous namespace
+
+void ROOT::Experimental::Detail::SplitPackBytes(void *dst, const void *src, std::size_t count, std::size_t elementSize)
+{
+   auto dstBytes = static_cast<unsigned char *>(dst);
+   auto srcBytes = static_cast<const unsigned char *>(src);
+   switch (elementSize) {
+#if defined(__SSE2__)
+   case 4: SplitPackSIMD<4>(dstBytes, srcBytes, count); return;
+   case 8: SplitPackSIMD<8>(dstBytes, srcBytes, count); return;
+#else
+   case 4: SplitPackScalar<4>(dstBytes, srcBytes, 0, count); return;
+   case 8: SplitPackScalar<8>(dstBytes, srcBytes, 0, count); return;
+#endif
+   default:
+      for (std::size_t i = 0; i < count; ++i) {
+         for (std::size_t b = 0; b < elementSize; ++b)
+            dstBytes[b * count + i] = srcBytes[i * elementSize + b];
+      }
+   }
+}
+
+void ROOT::Experimental::Detail::SplitUnpackBytes(void *dst, const void *src, std::size_t count,
+                                                  std::size_t elementSize)
+{
+   auto dstBytes = static_cast<unsigned char *>(dst);
+   auto srcBytes = static_cast<const unsigned char *>(src);
+   switch (elementSize) {
+#if defined(__SSE2__)
+   case 4: SplitUnpackSIMD<4>(dstBytes, srcBytes, count); return;
+   case 8: SplitUnpackSIMD<8>(dstBytes, srcBytes, count); return;
+#else
+   case 4: SplitUnpackScalar<4>(dstBytes, srcBytes, 0, count); return;
+   case 8: SplitUnpackScalar<8>(dstBytes, srcBytes, 0, count); return;
+#endif
+   default:
+      for (std::size_t i = 0; i < count; ++i) {
+         for (std::size_t b = 0; b < elementSize; ++b)
+            dstBytes[i * elementSize + b] = srcBytes[b * count + i];
+      }
+   }
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
 ROOT::Experimental::Detail::RColumnElementBase::Generate(EColumnType type) {
    switch (type) {
    case EColumnType::kReal32:
-      return RColumnElement<float, EColumnType::kReal32>(nullptr);
+      return std::make_unique<RColumnElement<float, EColumnType::kReal32>>(nullptr);
    case EColumnType::kReal64:
-      return RColumnElement<double, EColumnType::kReal64>(nullptr);
+      return std::make_unique<RColumnElement<double, EColumnType::kReal64>>(nullptr);
    case EColumnType::kByte:
-      return RColumnElement<std::uint8_t, EColumnType::kByte>(nullptr);
+      return std::make_unique<RColumnElement<std::uint8_t, EColumnType::kByte>>(nullptr);
    case EColumnType::kInt32:
-      return RColumnElement<std::int32_t, EColumnType::kInt32>(nullptr);
+      return std::make_unique<RColumnElement<std::int32_t, EColumnType::kInt32>>(nullptr);
    case EColumnType::kInt64:
-      return RColumnElement<std::int64_t, EColumnType::kInt64>(nullptr);
+      return std::make_unique<RColumnElement<std::int64_t, EColumnType::kInt64>>(nullptr);
    case EColumnType::kBit:
-      return RColumnElement<bool, EColumnType::kBit>(nullptr);
+      return std::make_unique<RColumnElement<bool, EColumnType::kBit>>(nullptr);
    case EColumnType::kIndex:
-      return RColumnElement<ClusterSize_t, EColumnType::kIndex>(nullptr);
+      return std::make_unique<RColumnElement<ClusterSize_t, EColumnType::kIndex>>(nullptr);
    case EColumnType::kSwitch:
-      return RColumnElement<RColumnSwitch, EColumnType::kSwitch>(nullptr);
+      return std::make_unique<RColumnElement<RColumnSwitch, EColumnType::kSwitch>>(nullptr);
+   case EColumnType::kSplitIndex:
+      return std::make_unique<RColumnElement<ClusterSize_t, EColumnType::kSplitIndex>>(nullptr);
+   case EColumnType::kSplitReal64:
+      return std::make_unique<RColumnElement<double, EColumnType::kSplitReal64>>(nullptr);
+   case EColumnType::kSplitReal32:
+      return std::make_unique<RColumnElement<float, EColumnType::kSplitReal32>>(nullptr);
+   case EColumnType::kSplitInt64:
+      return std::make_unique<RColumnElement<std::int64_t, EColumnType::kSplitInt64>>(nullptr);
+   case EColumnType::kSplitInt32:
+      return std::make_unique<RColumnElement<std::int32_t, EColumnType::kSplitInt32>>(nullptr);
    default:
       R__ASSERT(false);
    }
    // never here
-   return RColumnElementBase();
+   return nullptr;
 }
 
 void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColumnType::kBit>::Pack(
@@ -80,3 +212,31 @@ void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColum
       }
    }
 }
+
+void ROOT::Experimental::Detail::RColumnElement<ROOT::Experimental::ClusterSize_t,
+                                                ROOT::Experimental::EColumnType::kSplitIndex>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   // Delta encoding and splitting in a single pass
+   auto offsets = reinterpret_cast<const ClusterSize_t *>(src);
+   auto splitBytes = reinterpret_cast<unsigned char *>(dst);
+   ClusterSize_t::ValueType prev = 0;
+   for (std::size_t i = 0; i < count; ++i) {
+      const ClusterSize_t::ValueType delta = offsets[i].fValue - prev;
+      prev = offsets[i].fValue;
+      unsigned char deltaBytes[kSize];
+      memcpy(deltaBytes, &delta, kSize);
+      for (std::size_t b = 0; b < kSize; ++b)
+         splitBytes[b * count + i] = deltaBytes[b];
+   }
+}
+
+void ROOT::Experimental::Detail::RColumnElement<ROOT::Experimental::ClusterSize_t,
+                                                ROOT::Experimental::EColumnType::kSplitIndex>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitUnpackBytes(dst, src, count, kSize);
+   auto offsets = reinterpret_cast<ClusterSize_t *>(dst);
+   for (std::size_t i = 1; i < count; ++i)
+      offsets[i].fValue += offsets[i - 1].fValue;
+}
@@ -136,6 +136,25 @@ ROOT::Experimental::Detail::RFieldBase::~RFieldBase()
 {
 }
 
+ROOT::Experimental::Detail::RFieldBase *ROOT::Experimental::Detail::RFieldBase::Clone(std::string_view newName)
+{
+   auto clone = CloneImpl(newName);
+   if (clone)
+      clone->fUseSplitEncoding = fUseSplitEncoding;
+   return clone;
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RColumn>
+ROOT::Experimental::Detail::RFieldBase::CreateIndexColumn(std::uint32_t index) const
+{
+   if (fUseSplitEncoding) {
+      RColumnModel model(EColumnType::kSplitIndex, true /* isSorted*/);
+      return std::unique_ptr<RColumn>(RColumn::Create<ClusterSize_t, EColumnType::kSplitIndex>(model, index));
+   }
+   RColumnModel model(EColumnType::kIndex, true /* isSorted*/);
+   return std::unique_ptr<RColumn>(RColumn::Create<ClusterSize_t, EColumnType::kIndex>(model, index));
+}
+
 ROOT::Experimental::Detail::RFieldBase*
 ROOT::Experimental::Detail::RFieldBase::Create(const std::string &fieldName, const std::string &typeName)
 {
@@ -307,7 +326,7 @@ void ROOT::Experimental::Detail::RFieldBase::RSchemaIterator::Advance()
 //------------------------------------------------------------------------------
 
 
-ROOT::Experimental::Detail::RFieldBase* ROOT::Experimental::RFieldZero::Clone(std::string_view /*newName*/)
+ROOT::Experimental::Detail::RFieldBase* ROOT::Experimental::RFieldZero::CloneImpl(std::string_view /*newName*/)
 {
    Detail::RFieldBase* result = new RFieldZero();
    for (auto &f : fSubFields) {
@@ -338,9 +357,7 @@ void ROOT::Experimental::RFieldZero::AcceptVisitor(Detail::RFieldVisitor &visito
 
 void ROOT::Experimental::RField<ROOT::Experimental::ClusterSize_t>::GenerateColumnsImpl()
 {
-   RColumnModel model(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(model, 0)));
+   fColumns.emplace_back(CreateIndexColumn(0));
    fPrincipalColumn = fColumns[0].get();
 }
 
@@ -385,9 +402,15 @@ void ROOT::Experimental::RField<bool>::AcceptVisitor(Detail::RFieldVisitor &visi
 
 void ROOT::Experimental::RField<float>::GenerateColumnsImpl()
 {
-   RColumnModel model(EColumnType::kReal32, false /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<float, EColumnType::kReal32>(model, 0)));
+   if (GetSplitEncoding()) {
+      RColumnModel model(EColumnType::kSplitReal32, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<float, EColumnType::kSplitReal32>(model, 0)));
+   } else {
+      RColumnModel model(EColumnType::kReal32, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<float, EColumnType::kReal32>(model, 0)));
+   }
    fPrincipalColumn = fColumns[0].get();
 }
 
@@ -401,9 +424,15 @@ void ROOT::Experimental::RField<float>::AcceptVisitor(Detail::RFieldVisitor &vis
 
 void ROOT::Experimental::RField<double>::GenerateColumnsImpl()
 {
-   RColumnModel model(EColumnType::kReal64, false /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<double, EColumnType::kReal64>(model, 0)));
+   if (GetSplitEncoding()) {
+      RColumnModel model(EColumnType::kSplitReal64, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<double, EColumnType::kSplitReal64>(model, 0)));
+   } else {
+      RColumnModel model(EColumnType::kReal64, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<double, EColumnType::kReal64>(model, 0)));
+   }
    fPrincipalColumn = fColumns[0].get();
 }
 
@@ -416,9 +445,15 @@ void ROOT::Experimental::RField<double>::AcceptVisitor(Detail::RFieldVisitor &vi
 
 void ROOT::Experimental::RField<std::int32_t>::GenerateColumnsImpl()
 {
-   RColumnModel model(EColumnType::kInt32, false /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(Detail::RColumn::Create<
-      std::int32_t, EColumnType::kInt32>(model, 0)));
+   if (GetSplitEncoding()) {
+      RColumnModel model(EColumnType::kSplitInt32, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(Detail::RColumn::Create<
+         std::int32_t, EColumnType::kSplitInt32>(model, 0)));
+   } else {
+      RColumnModel model(EColumnType::kInt32, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(Detail::RColumn::Create<
+         std::int32_t, EColumnType::kInt32>(model, 0)));
+   }
    fPrincipalColumn = fColumns[0].get();
 }
 
@@ -431,9 +466,15 @@ void ROOT::Experimental::RField<std::int32_t>::AcceptVisitor(Detail::RFieldVisit
 
 void ROOT::Experimental::RField<std::uint32_t>::GenerateColumnsImpl()
 {
-   RColumnModel model(EColumnType::kInt32, false /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<std::uint32_t, EColumnType::kInt32>(model, 0)));
+   if (GetSplitEncoding()) {
+      RColumnModel model(EColumnType::kSplitInt32, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::uint32_t, EColumnType::kSplitInt32>(model, 0)));
+   } else {
+      RColumnModel model(EColumnType::kInt32, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::uint32_t, EColumnType::kInt32>(model, 0)));
+   }
    fPrincipalColumn = fColumns[0].get();
 }
 
@@ -446,9 +487,15 @@ void ROOT::Experimental::RField<std::uint32_t>::AcceptVisitor(Detail::RFieldVisi
 
 void ROOT::Experimental::RField<std::uint64_t>::GenerateColumnsImpl()
 {
-   RColumnModel model(EColumnType::kInt64, false /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<std::uint64_t, EColumnType::kInt64>(model, 0)));
+   if (GetSplitEncoding()) {
+      RColumnModel model(EColumnType::kSplitInt64, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::uint64_t, EColumnType::kSplitInt64>(model, 0)));
+   } else {
+      RColumnModel model(EColumnType::kInt64, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::uint64_t, EColumnType::kInt64>(model, 0)));
+   }
    fPrincipalColumn = fColumns[0].get();
 }
 
@@ -462,9 +509,7 @@ void ROOT::Experimental::RField<std::uint64_t>::AcceptVisitor(Detail::RFieldVisi
 
 void ROOT::Experimental::RField<std::string>::GenerateColumnsImpl()
 {
-   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+   fColumns.emplace_back(CreateIndexColumn(0));
 
    RColumnModel modelChars(EColumnType::kByte, false /* isSorted*/);
    fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
@@ -527,9 +572,16 @@ ROOT::Experimental::RClassField::RClassField(std::string_view fieldName, std::st
    }
 }
 
-ROOT::Experimental::Detail::RFieldBase* ROOT::Experimental::RClassField::Clone(std::string_view newName)
+ROOT::Experimental::Detail::RFieldBase* ROOT::Experimental::RClassField::CloneImpl(std::string_view newName)
 {
-   return new RClassField(newName, GetType());
+   auto result = new RClassField(newName, GetType());
+   // The sub fields are recreated from the class type; carry over their settings
+   auto itrClone = result->begin();
+   for (auto &f : *this) {
+      itrClone->SetSplitEncoding(f.GetSplitEncoding());
+      ++itrClone;
+   }
+   return result;
 }
 
 void ROOT::Experimental::RClassField::AppendImpl(const Detail::RFieldValue& value) {
@@ -623,7 +675,7 @@ ROOT::Experimental::RVectorField::RVectorField(
    Attach(std::move(itemField));
 }
 
-ROOT::Experimental::Detail::RFieldBase* ROOT::Experimental::RVectorField::Clone(std::string_view newName)
+ROOT::Experimental::Detail::RFieldBase* ROOT::Experimental::RVectorField::CloneImpl(std::string_view newName)
 {
    auto newItemField = fSubFields[0]->Clone(fSubFields[0]->GetName());
    return new RVectorField(newName, std::unique_ptr<Detail::RFieldBase>(newItemField));
@@ -659,9 +711,7 @@ void ROOT::Experimental::RVectorField::ReadGlobalImpl(NTupleSize_t globalIndex,
 
 void ROOT::Experimental::RVectorField::GenerateColumnsImpl()
 {
-   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+   fColumns.emplace_back(CreateIndexColumn(0));
    fPrincipalColumn = fColumns[0].get();
 }
 
@@ -755,9 +805,7 @@ void ROOT::Experimental::RField<std::vector<bool>>::ReadGlobalImpl(NTupleSize_t
 
 void ROOT::Experimental::RField<std::vector<bool>>::GenerateColumnsImpl()
 {
-   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+   fColumns.emplace_back(CreateIndexColumn(0));
    fPrincipalColumn = fColumns[0].get();
 }
 
@@ -807,7 +855,7 @@ ROOT::Experimental::RArrayField::RArrayField(
    Attach(std::move(itemField));
 }
 
-ROOT::Experimental::Detail::RFieldBase *ROOT::Experimental::RArrayField::Clone(std::string_view newName)
+ROOT::Experimental::Detail::RFieldBase *ROOT::Experimental::RArrayField::CloneImpl(std::string_view newName)
 {
    auto newItemField = fSubFields[0]->Clone(fSubFields[0]->GetName());
    return new RArrayField(newName, std::unique_ptr<Detail::RFieldBase>(newItemField), fArrayLength);
@@ -916,7 +964,7 @@ ROOT::Experimental::RVariantField::RVariantField(
    fTagOffset = (fMaxItemSize < fMaxAlignment) ? fMaxAlignment : fMaxItemSize;
 }
 
-ROOT::Experimental::Detail::RFieldBase *ROOT::Experimental::RVariantField::Clone(std::string_view newName)
+ROOT::Experimental::Detail::RFieldBase *ROOT::Experimental::RVariantField::CloneImpl(std::string_view newName)
 {
    auto nFields = fSubFields.size();
    std::vector<Detail::RFieldBase *> itemFields;
@@ -1028,14 +1076,12 @@ ROOT::Experimental::RCollectionField::RCollectionField(
 
 void ROOT::Experimental::RCollectionField::GenerateColumnsImpl()
 {
-   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+   fColumns.emplace_back(CreateIndexColumn(0));
    fPrincipalColumn = fColumns[0].get();
 }
 
 
-ROOT::Experimental::Detail::RFieldBase* ROOT::Experimental::RCollectionField::Clone(std::string_view /*newName*/)
+ROOT::Experimental::Detail::RFieldBase* ROOT::Experimental::RCollectionField::CloneImpl(std::string_view /*newName*/)
 {
    // TODO(jblomer)
    return nullptr;
@@ -16,7 +16,9 @@
 #include "ROOT/RNTuple.hxx"
 
 #include "ROOT/RFieldVisitor.hxx"
+#include "ROOT/RNTupleImtTaskScheduler.hxx"
 #include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RPageSinkBuf.hxx"
 #include "ROOT/RPageStorage.hxx"
 #include "ROOT/RPageStorageFile.hxx"
 
@@ -29,10 +31,24 @@
 #include <unordered_map>
 #include <utility>
 
+#include <RConfigure.h>
 #include <TError.h>
 #include <TFile.h> // for RNTupleWriter::Append
+#include <TROOT.h> // for IsImplicitMTEnabled()
 
 
+void ROOT::Experimental::RNTupleReader::InitPageSource()
+{
+#ifdef R__USE_IMT
+   if (IsImplicitMTEnabled() && fSource->GetReadOptions().GetUseImplicitMT()) {
+      fUnzipTasks = std::make_unique<Detail::RNTupleImtTaskScheduler>();
+      fSource->SetTaskScheduler(fUnzipTasks.get());
+   }
+#endif
+   fSource->Attach();
+   fMetrics.ObserveMetrics(fSource->GetMetrics());
+}
+
 void ROOT::Experimental::RNTupleReader::ConnectModel(const RNTupleModel &model) {
    std::unordered_map<const Detail::RFieldBase *, DescriptorId_t> fieldPtr2Id;
    fieldPtr2Id[model.GetFieldZero()] = fSource->GetDescriptor().GetFieldZeroId();
@@ -52,9 +68,8 @@ ROOT::Experimental::RNTupleReader::RNTupleReader(
    , fModel(std::move(model))
    , fMetrics("RNTupleReader")
 {
-   fSource->Attach();
+   InitPageSource();
    ConnectModel(*fModel);
-   fMetrics.ObserveMetrics(fSource->GetMetrics());
 }
 
 ROOT::Experimental::RNTupleReader::RNTupleReader(std::unique_ptr<ROOT::Experimental::Detail::RPageSource> source)
@@ -62,8 +77,7 @@ ROOT::Experimental::RNTupleReader::RNTupleReader(std::unique_ptr<ROOT::Experimen
    , fModel(nullptr)
    , fMetrics("RNTupleReader")
 {
-   fSource->Attach();
-   fMetrics.ObserveMetrics(fSource->GetMetrics());
+   InitPageSource();
 }
 
 ROOT::Experimental::RNTupleReader::~RNTupleReader()
@@ -218,6 +232,12 @@ ROOT::Experimental::RNTupleWriter::RNTupleWriter(
    , fLastCommitted(0)
    , fNEntries(0)
 {
+#ifdef R__USE_IMT
+   if (IsImplicitMTEnabled() && fSink->GetWriteOptions().GetUseImplicitMT()) {
+      fZipTasks = std::make_unique<Detail::RNTupleImtTaskScheduler>();
+      fSink->SetTaskScheduler(fZipTasks.get());
+   }
+#endif
    fSink->Create(*fModel.get());
 }
 
@@ -262,6 +282,87 @@ void ROOT::Experimental::RNTupleWriter::CommitCluster()
 //------------------------------------------------------------------------------
 
 
+ROOT::Experimental::RNTupleFillContext::RNTupleFillContext(std::unique_ptr<RNTupleModel> model,
+                                                           std::unique_ptr<Detail::RPageSink> sink,
+                                                           NTupleSize_t clusterSizeEntries)
+   : fSink(std::move(sink)), fModel(std::move(model)), fClusterSizeEntries(clusterSizeEntries)
+{
+   fSink->Create(*fModel.get());
+}
+
+ROOT::Experimental::RNTupleFillContext::~RNTupleFillContext()
+{
+   CommitCluster();
+}
+
+void ROOT::Experimental::RNTupleFillContext::CommitCluster()
+{
+   if (fNEntries == fLastCommitted) return;
+   for (auto& field : *fModel->GetFieldZero()) {
+      field.Flush();
+      field.CommitCluster();
+   }
+   fSink->CommitCluster(fNEntries);
+   fLastCommitted = fNEntries;
+}
+
+
+//------------------------------------------------------------------------------
+
+
+ROOT::Experimental::RNTupleParallelWriter::RNTupleParallelWriter(
+   std::unique_ptr<ROOT::Experimental::RNTupleModel> model,
+   std::unique_ptr<ROOT::Experimental::Detail::RPageSink> sink)
+   : fTarget(std::make_shared<Detail::RPageSinkBuf::RSharedTarget>(std::move(sink)))
+   , fModel(std::move(model))
+{
+   fTarget->fSink->Create(*fModel.get());
+}
+
+ROOT::Experimental::RNTupleParallelWriter::~RNTupleParallelWriter()
+{
+   std::vector<std::weak_ptr<RNTupleFillContext>> fillContexts;
+   {
+      std::lock_guard<std::mutex> guard(fTarget->fLock);
+      std::swap(fillContexts, fFillContexts);
+   }
+   // Committing the clusters of the fill contexts takes the lock
+   for (auto &weakContext : fillContexts) {
+      if (auto context = weakContext.lock())
+         context->CommitCluster();
+   }
+   // A fill context that is destructed concurrently may still commit its last cluster; the shared sink itself
+   // is kept alive by the fill contexts' buffered sinks
+   std::lock_guard<std::mutex> guard(fTarget->fLock);
+   fTarget->fSink->CommitDataset();
+   fTarget->fIsDatasetCommitted = true;
+}
+
+std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter> ROOT::Experimental::RNTupleParallelWriter::Recreate(
+   std::unique_ptr<RNTupleModel> model,
+   std::string_view ntupleName,
+   std::string_view storage,
+   const RNTupleWriteOptions &options)
+{
+   return std::make_unique<RNTupleParallelWriter>(std::move(model),
+                                                  Detail::RPageSink::Create(ntupleName, storage, options));
+}
+
+std::shared_ptr<ROOT::Experimental::RNTupleFillContext> ROOT::Experimental::RNTupleParallelWriter::CreateFillContext()
+{
+   std::lock_guard<std::mutex> guard(fTarget->fLock);
+   auto model = std::unique_ptr<RNTupleModel>(fModel->Clone());
+   auto sink = std::make_unique<Detail::RPageSinkBuf>(fTarget);
+   auto context = std::shared_ptr<RNTupleFillContext>(
+      new RNTupleFillContext(std::move(model), std::move(sink), kDefaultClusterSizeEntries));
+   fFillContexts.emplace_back(context);
+   return context;
+}
+
+
+//------------------------------------------------------------------------------
+
+
 ROOT::Experimental::RCollectionNTuple::RCollectionNTuple(std::unique_ptr<REntry> defaultEntry)
    : fOffset(0), fDefaultEntry(std::move(defaultEntry))
 {
@@ -0,0 +1,38 @@
+/// \file RNTupleImtTaskScheduler.cxx
+/// \ingroup NTuple ROOT7
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RNTupleImtTaskScheduler.hxx>
+
+#ifdef R__USE_IMT
+
+ROOT::Experimental::Detail::RNTupleImtTaskScheduler::RNTupleImtTaskScheduler()
+{
+   Reset();
+}
+
+void ROOT::Experimental::Detail::RNTupleImtTaskScheduler::Reset()
+{
+   fTaskGroup = std::make_unique<TTaskGroup>();
+}
+
+void ROOT::Experimental::Detail::RNTupleImtTaskScheduler::AddTask(const std::function<void(void)> &taskFunc)
+{
+   fTaskGroup->Run(taskFunc);
+}
+
+void ROOT::Experimental::Detail::RNTupleImtTaskScheduler::Wait()
+{
+   fTaskGroup->Wait();
+}
+
+#endif
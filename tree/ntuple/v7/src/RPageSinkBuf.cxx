@@ -0,0 +1,103 @@
+/// \file RPageSinkBuf.cxx
+/// \ingroup NTuple ROOT7
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RColumn.hxx>
+#include <ROOT/RLogger.hxx>
+#include <ROOT/RPageSinkBuf.hxx>
+
+#include <cstring>
+#include <utility>
+
+
+ROOT::Experimental::Detail::RPageSinkBuf::RPageSinkBuf(std::shared_ptr<RSharedTarget> target)
+   : RPageSink(target->fSink->GetNTupleName(), target->fSink->GetWriteOptions()), fTarget(std::move(target))
+{
+   // The cluster meta-data is recorded by the shared sink
+   fKeepClusterDescriptors = false;
+}
+
+ROOT::Experimental::Detail::RPageSinkBuf::~RPageSinkBuf()
+{
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::CreateImpl(const RNTupleModel & /* model */)
+{
+   // The shared page sink has been created already; we only need to know the number of columns
+   fBufferedPages.resize(fLastColumnId);
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
+{
+   RBufferedPage bufPage;
+   bufPage.fBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[page.GetSize()]);
+   bufPage.fSealedPage =
+      SealPage(page, *columnHandle.fColumn->GetElement(), fOptions.GetCompression(), bufPage.fBuffer.get());
+   fBufferedPages[columnHandle.fId].emplace_back(std::move(bufPage));
+   // The location in the buffered sink is meaningless; the shared sink sets the actual locator
+   return RClusterDescriptor::RLocator();
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitSealedPageImpl(DescriptorId_t columnId,
+                                                              const RSealedPage &sealedPage)
+{
+   RBufferedPage bufPage;
+   bufPage.fBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[sealedPage.fBytesOnStorage]);
+   memcpy(bufPage.fBuffer.get(), sealedPage.fBuffer, sealedPage.fBytesOnStorage);
+   bufPage.fSealedPage = sealedPage;
+   bufPage.fSealedPage.fBuffer = bufPage.fBuffer.get();
+   fBufferedPages[columnId].emplace_back(std::move(bufPage));
+   return RClusterDescriptor::RLocator();
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitClusterImpl(NTupleSize_t nEntries)
+{
+   const auto nEntriesCluster = nEntries - fPrevClusterNEntries;
+   {
+      std::lock_guard<std::mutex> guard(fTarget->fLock);
+      auto &sink = *fTarget->fSink;
+      if (fTarget->fIsDatasetCommitted) {
+         R__ERROR_HERE("NTuple") << "discarding " << nEntriesCluster
+                                 << " entries committed after the shared page sink was closed";
+      } else {
+         for (DescriptorId_t columnId = 0; columnId < fBufferedPages.size(); ++columnId) {
+            for (const auto &bufPage : fBufferedPages[columnId])
+               sink.CommitSealedPage(columnId, bufPage.fSealedPage);
+         }
+         sink.CommitCluster(sink.GetNEntries() + nEntriesCluster);
+      }
+   }
+
+   for (auto &pages : fBufferedPages)
+      pages.clear();
+   return RClusterDescriptor::RLocator();
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::CommitDatasetImpl()
+{
+   // The data set is committed by the owner of the shared page sink
+}
+
+ROOT::Experimental::Detail::RPage
+ROOT::Experimental::Detail::RPageSinkBuf::ReservePage(ColumnHandle_t columnHandle, std::size_t nElements)
+{
+   // Page allocation of the shared sink does not touch the sink's state, so that we don't need to take the lock
+   return fTarget->fSink->ReservePage(columnHandle, nElements);
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::ReleasePage(RPage &page)
+{
+   fTarget->fSink->ReleasePage(page);
+}
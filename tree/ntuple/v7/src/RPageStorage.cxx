@@ -15,11 +15,14 @@
 
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageStorageFile.hxx>
+#include <ROOT/RCluster.hxx>
 #include <ROOT/RColumn.hxx>
+#include <ROOT/RColumnElement.hxx>
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleZip.hxx>
 #include <ROOT/RPagePool.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #include <ROOT/RStringView.hxx>
@@ -27,6 +30,7 @@
 #include <Compression.h>
 #include <TError.h>
 
+#include <memory>
 #include <unordered_map>
 #include <utility>
 
@@ -95,6 +99,15 @@ ROOT::Experimental::ColumnId_t ROOT::Experimental::Detail::RPageSource::GetColum
    return columnHandle.fId;
 }
 
+std::vector<std::unique_ptr<ROOT::Experimental::Detail::RCluster>>
+ROOT::Experimental::Detail::RPageSource::LoadClusters(const std::vector<RClusterKey> &clusterKeys)
+{
+   std::vector<std::unique_ptr<RCluster>> clusters;
+   for (const auto &key : clusterKeys)
+      clusters.emplace_back(LoadCluster(key.fClusterId, key.fColumnSet));
+   return clusters;
+}
+
 
 //------------------------------------------------------------------------------
 
@@ -179,16 +192,50 @@ void ROOT::Experimental::Detail::RPageSink::CommitPage(ColumnHandle_t columnHand
 }
 
 
+void ROOT::Experimental::Detail::RPageSink::CommitSealedPage(DescriptorId_t columnId, const RSealedPage &sealedPage)
+{
+   auto locator = CommitSealedPageImpl(columnId, sealedPage);
+
+   fOpenColumnRanges[columnId].fNElements += sealedPage.fNElements;
+   RClusterDescriptor::RPageRange::RPageInfo pageInfo;
+   pageInfo.fNElements = sealedPage.fNElements;
+   pageInfo.fLocator = locator;
+   fOpenPageRanges[columnId].fPageInfos.emplace_back(pageInfo);
+}
+
+
+ROOT::Experimental::Detail::RPageSink::RSealedPage
+ROOT::Experimental::Detail::RPageSink::SealPage(const RPage &page, const RColumnElementBase &element,
+                                                int compressionSetting, void *buf)
+{
+   unsigned char *pageBuf = reinterpret_cast<unsigned char *>(page.GetBuffer());
+   std::unique_ptr<unsigned char[]> packedBuffer;
+   auto packedBytes = page.GetSize();
+   if (!element.IsMappable()) {
+      packedBytes = (page.GetNElements() * element.GetBitsOnStorage() + 7) / 8;
+      packedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[packedBytes]);
+      element.Pack(packedBuffer.get(), page.GetBuffer(), page.GetNElements());
+      pageBuf = packedBuffer.get();
+   }
+
+   auto zippedBytes = RNTupleCompressor::Zip(pageBuf, packedBytes, compressionSetting, buf);
+   return RSealedPage{buf, zippedBytes, packedBytes, page.GetNElements()};
+}
+
+
 void ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experimental::NTupleSize_t nEntries)
 {
    auto locator = CommitClusterImpl(nEntries);
 
    R__ASSERT((nEntries - fPrevClusterNEntries) < ClusterSize_t(-1));
-   fDescriptorBuilder.AddCluster(fLastClusterId, RNTupleVersion(), fPrevClusterNEntries,
-                                 ClusterSize_t(nEntries - fPrevClusterNEntries));
-   fDescriptorBuilder.SetClusterLocator(fLastClusterId, locator);
+   if (fKeepClusterDescriptors) {
+      fDescriptorBuilder.AddCluster(fLastClusterId, RNTupleVersion(), fPrevClusterNEntries,
+                                    ClusterSize_t(nEntries - fPrevClusterNEntries));
+      fDescriptorBuilder.SetClusterLocator(fLastClusterId, locator);
+   }
    for (auto &range : fOpenColumnRanges) {
-      fDescriptorBuilder.AddClusterColumnRange(fLastClusterId, range);
+      if (fKeepClusterDescriptors)
+         fDescriptorBuilder.AddClusterColumnRange(fLastClusterId, range);
       range.fFirstElementIndex += range.fNElements;
       range.fNElements = 0;
    }
@@ -196,7 +243,8 @@ void ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experimental::NT
       RClusterDescriptor::RPageRange fullRange;
       std::swap(fullRange, range);
       range.fColumnId = fullRange.fColumnId;
-      fDescriptorBuilder.AddClusterPageRange(fLastClusterId, std::move(fullRange));
+      if (fKeepClusterDescriptors)
+         fDescriptorBuilder.AddClusterPageRange(fLastClusterId, std::move(fullRange));
    }
    ++fLastClusterId;
    fPrevClusterNEntries = nEntries;
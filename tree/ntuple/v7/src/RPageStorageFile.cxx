@@ -15,6 +15,7 @@
 
 #include <ROOT/RCluster.hxx>
 #include <ROOT/RClusterPool.hxx>
+#include <ROOT/RColumnElement.hxx>
 #include <ROOT/RField.hxx>
 #include <ROOT/RLogger.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
@@ -25,15 +26,20 @@
 #include <ROOT/RPagePool.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #include <ROOT/RRawFile.hxx>
+#include <ROOT/RReadVPlanner.hxx>
 
 #include <RVersion.h>
 #include <TError.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <utility>
+#include <vector>
 
 
 ROOT::Experimental::Detail::RPageSinkFile::RPageSinkFile(std::string_view ntupleName, std::string_view path,
@@ -78,6 +84,9 @@ ROOT::Experimental::Detail::RPageSinkFile::RPageSinkFile(std::string_view ntuple
 
 ROOT::Experimental::Detail::RPageSinkFile::~RPageSinkFile()
 {
+   // Zip tasks must not outlive the buffers they are writing into
+   if (!fZipQueue.empty())
+      fTaskScheduler->Wait();
 }
 
 
@@ -96,47 +105,87 @@ void ROOT::Experimental::Detail::RPageSinkFile::CreateImpl(const RNTupleModel &
 
 
 ROOT::Experimental::RClusterDescriptor::RLocator
-ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
+ROOT::Experimental::Detail::RPageSinkFile::WriteSealedPage(const RSealedPage &sealedPage)
 {
-   unsigned char *buffer = reinterpret_cast<unsigned char *>(page.GetBuffer());
-   bool isAdoptedBuffer = true;
-   auto packedBytes = page.GetSize();
-   auto element = columnHandle.fColumn->GetElement();
-   const auto isMappable = element->IsMappable();
-
-   if (!isMappable) {
-      packedBytes = (page.GetNElements() * element->GetBitsOnStorage() + 7) / 8;
-      buffer = new unsigned char[packedBytes];
-      isAdoptedBuffer = false;
-      element->Pack(buffer, page.GetBuffer(), page.GetNElements());
-   }
-   auto zippedBytes = packedBytes;
-
-   if (fOptions.GetCompression() != 0) {
-      zippedBytes = fCompressor(buffer, packedBytes, fOptions.GetCompression());
-      if (!isAdoptedBuffer)
-         delete[] buffer;
-      buffer = const_cast<unsigned char *>(reinterpret_cast<const unsigned char *>(fCompressor.GetZipBuffer()));
-      isAdoptedBuffer = true;
-   }
-
-   auto offsetData = fWriter->WriteBlob(buffer, zippedBytes, packedBytes);
+   auto offsetData = fWriter->WriteBlob(sealedPage.fBuffer, sealedPage.fBytesOnStorage, sealedPage.fBytesPacked);
    fClusterMinOffset = std::min(offsetData, fClusterMinOffset);
-   fClusterMaxOffset = std::max(offsetData + zippedBytes, fClusterMaxOffset);
-
-   if (!isAdoptedBuffer)
-      delete[] buffer;
+   fClusterMaxOffset = std::max(offsetData + sealedPage.fBytesOnStorage, fClusterMaxOffset);
 
    RClusterDescriptor::RLocator result;
    result.fPosition = offsetData;
-   result.fBytesOnStorage = zippedBytes;
+   result.fBytesOnStorage = sealedPage.fBytesOnStorage;
    return result;
 }
 
 
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkFile::CommitSealedPageImpl(DescriptorId_t /* columnId */,
+                                                               const RSealedPage &sealedPage)
+{
+   return WriteSealedPage(sealedPage);
+}
+
+
+void ROOT::Experimental::Detail::RPageSinkFile::FlushZipQueue()
+{
+   if (fZipQueue.empty())
+      return;
+
+   fTaskScheduler->Wait();
+   for (const auto &item : fZipQueue) {
+      auto &pageInfo = fOpenPageRanges[item->fColumnId].fPageInfos[item->fPageIdx];
+      pageInfo.fLocator = WriteSealedPage(item->fSealedPage);
+   }
+   fZipQueue.clear();
+   fZipQueueBytes = 0;
+   fTaskScheduler->Reset();
+}
+
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
+{
+   auto element = columnHandle.fColumn->GetElement();
+
+   if (fTaskScheduler && fOptions.GetUseImplicitMT()) {
+      // Bound the memory held by queued pages.  All the queued pages have their page info registered by now,
+      // so that their locators can be set.
+      if (fZipQueueBytes >= fOptions.GetMaxInFlightBytes())
+         FlushZipQueue();
+
+      auto item = std::make_unique<RZipItem>();
+      item->fColumnId = columnHandle.fId;
+      item->fPageIdx = fOpenPageRanges[columnHandle.fId].fPageInfos.size();
+      // The column continues to use the page memory for the following elements, so we need a copy
+      item->fBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[page.GetSize()]);
+      memcpy(item->fBuffer.get(), page.GetBuffer(), page.GetSize());
+      fZipQueueBytes += page.GetSize();
+
+      auto zipItem = item.get();
+      RPage bufPage(page.GetColumnId(), zipItem->fBuffer.get(), page.GetSize(), page.GetElementSize());
+      bufPage.TryGrow(page.GetNElements());
+      const auto compression = fOptions.GetCompression();
+      fTaskScheduler->AddTask([zipItem, bufPage, element, compression]() {
+         zipItem->fZipBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[bufPage.GetSize()]);
+         zipItem->fSealedPage = SealPage(bufPage, *element, compression, zipItem->fZipBuffer.get());
+      });
+      fZipQueue.emplace_back(std::move(item));
+
+      // The locator is set in FlushZipQueue(), at the latest when the cluster is committed
+      return RClusterDescriptor::RLocator();
+   }
+
+   // The zip buffer of fCompressor is only used by the thread committing the pages
+   auto zipBuffer = const_cast<void *>(fCompressor.GetZipBuffer());
+   return WriteSealedPage(SealPage(page, *element, fOptions.GetCompression(), zipBuffer));
+}
+
+
 ROOT::Experimental::RClusterDescriptor::RLocator
 ROOT::Experimental::Detail::RPageSinkFile::CommitClusterImpl(ROOT::Experimental::NTupleSize_t /* nEntries */)
 {
+   FlushZipQueue();
+
    RClusterDescriptor::RLocator result;
    result.fPosition = fClusterMinOffset;
    result.fBytesOnStorage = fClusterMaxOffset - fClusterMinOffset;
@@ -148,6 +197,8 @@ ROOT::Experimental::Detail::RPageSinkFile::CommitClusterImpl(ROOT::Experimental:
 
 void ROOT::Experimental::Detail::RPageSinkFile::CommitDatasetImpl()
 {
+   FlushZipQueue();
+
    const auto &descriptor = fDescriptorBuilder.GetDescriptor();
    auto szFooter = descriptor.SerializeFooter(nullptr);
    auto buffer = std::unique_ptr<unsigned char []>(new unsigned char[szFooter]);
@@ -211,15 +262,19 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nRead", "", "number of byte ranges read"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("szReadPayload", "B", "volume read from file (required)"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("szReadOverhead", "B", "volume read from file (overhead)"),
-      *fMetrics.MakeCounter<RNTuplePlainCounter*> ("szUnzip", "B", "volume after unzipping"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("szUnzip", "B", "volume after unzipping"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nClusterLoaded", "",
                                                    "number of partial clusters preloaded from storage"),
       *fMetrics.MakeCounter<RNTuplePlainCounter*> ("nPageLoaded", "", "number of pages loaded from storage"),
       *fMetrics.MakeCounter<RNTuplePlainCounter*> ("nPagePopulated", "", "number of populated pages"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nPageUnzipAhead", "",
+                                                   "number of pages decompressed ahead of use"),
+      *fMetrics.MakeCounter<RNTuplePlainCounter*> ("nPageMapped", "",
+                                                   "number of pages used in place from the file mapping"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("timeWallRead", "ns", "wall clock time spent reading"),
-      *fMetrics.MakeCounter<RNTuplePlainCounter*> ("timeWallUnzip", "ns", "wall clock time spent decompressing"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("timeWallUnzip", "ns", "wall clock time spent decompressing"),
       *fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter>*>("timeCpuRead", "ns", "CPU time spent reading"),
-      *fMetrics.MakeCounter<RNTupleTickCounter<RNTuplePlainCounter>*> ("timeCpuUnzip", "ns",
+      *fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter>*>("timeCpuUnzip", "ns",
                                                                        "CPU time spent decompressing")
    });
 }
@@ -237,6 +292,13 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
 
 ROOT::Experimental::Detail::RPageSourceFile::~RPageSourceFile()
 {
+   // The page maps of the cached clusters may refer to the file mapping.  Releasing the clusters waits for the
+   // running unzip tasks; the tasks that have not yet started find their pages claimed and only need to drain.
+   fClusterPool.reset();
+   if (fTaskScheduler)
+      fTaskScheduler->Wait();
+   if (fMmapRegion)
+      fFile->Unmap(fMmapRegion, fMmapSize);
 }
 
 
@@ -257,10 +319,27 @@ ROOT::Experimental::RNTupleDescriptor ROOT::Experimental::Detail::RPageSourceFil
    fDecompressor(zipBuffer.get(), ntpl.fNBytesFooter, ntpl.fLenFooter, buffer.get());
    descBuilder.AddClustersFromFooter(buffer.get());
 
+   if (fOptions.GetUseMmap() && (fFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasMmap)) {
+      fMmapSize = fFile->GetSize();
+      std::uint64_t mapdOffset;
+      fMmapRegion = static_cast<unsigned char *>(fFile->Map(fMmapSize, 0, mapdOffset));
+      R__ASSERT(mapdOffset == 0);
+   }
+
    return descBuilder.MoveDescriptor();
 }
 
 
+void ROOT::Experimental::Detail::RPageSourceFile::UpdateCurrentCluster(DescriptorId_t clusterId,
+                                                                       DescriptorId_t columnId)
+{
+   if (fCurrentCluster && (fCurrentCluster->GetId() == clusterId) && fCurrentCluster->ContainsColumn(columnId))
+      return;
+   fCurrentCluster = fClusterPool->GetCluster(clusterId, fActiveColumns);
+   R__ASSERT(fCurrentCluster->ContainsColumn(columnId));
+}
+
+
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::PopulatePageFromCluster(
    ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor, ClusterSize_t::ValueType clusterIndex)
 {
@@ -285,30 +364,72 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    R__ASSERT(firstInPage <= clusterIndex);
    R__ASSERT((firstInPage + pageInfo.fNElements) > clusterIndex);
 
-   const auto element = columnHandle.fColumn->GetElement();
+   auto element = columnHandle.fColumn->GetElement();
+   // The in-memory column of the reader does not know about the on-disk encoding, e.g. byte-split columns; if the
+   // column types differ, the page is unpacked according to the column type on storage
+   std::unique_ptr<RColumnElementBase> onDiskElement;
+   const auto onDiskType = fDescriptor.GetColumnDescriptor(columnId).GetModel().GetType();
+   if (columnHandle.fColumn->GetModel().GetType() != onDiskType) {
+      onDiskElement = RColumnElementBase::Generate(onDiskType);
+      R__ASSERT(onDiskElement->GetSize() == element->GetSize());
+      element = onDiskElement.get();
+   }
    const auto elementSize = element->GetSize();
 
    const auto bytesOnStorage = pageInfo.fLocator.fBytesOnStorage;
    const auto bytesPacked = (element->GetBitsOnStorage() * pageInfo.fNElements + 7) / 8;
    const auto pageSize = elementSize * pageInfo.fNElements;
 
-   auto pageBuffer = new unsigned char[bytesPacked];
+   // Without the cluster cache, the page is read from the file unless the file is memory mapped
+   const void *onDiskAddress = nullptr;
    if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
-      fReader.ReadBuffer(pageBuffer, bytesOnStorage, pageInfo.fLocator.fPosition);
       fCounters->fNPageLoaded.Inc();
+      if (fMmapRegion)
+         onDiskAddress = fMmapRegion + pageInfo.fLocator.fPosition;
    } else {
-      if (!fCurrentCluster || (fCurrentCluster->GetId() != clusterId) || !fCurrentCluster->ContainsColumn(columnId))
-         fCurrentCluster = fClusterPool->GetCluster(clusterId, fActiveColumns);
-      R__ASSERT(fCurrentCluster->ContainsColumn(columnId));
+      UpdateCurrentCluster(clusterId, columnId);
+      if (fTaskScheduler) {
+         // The page may be scheduled for unzip-ahead.  If its task did not yet start, we take over the page;
+         // otherwise we wait for the task to finish.
+         std::unique_lock<std::mutex> lock(fLockUnzipAhead);
+         RUnzipAheadKey unzipKey{clusterId, columnId, pageNo};
+         auto itr = fUnzipAheadPages.find(unzipKey);
+         if ((itr != fUnzipAheadPages.end()) && !itr->second.fIsRunning) {
+            fUnzipAheadPages.erase(itr);
+         } else {
+            fCvUnzipAhead.wait(lock, [&]() { return fUnzipAheadPages.count(unzipKey) == 0; });
+         }
+      }
+      // While waiting for the cluster, its pages may have been decompressed ahead of use
+      auto cachedPage = fPagePool->GetPage(columnId, RClusterIndex(clusterId, clusterIndex));
+      if (!cachedPage.IsNull())
+         return cachedPage;
       ROnDiskPage::Key key(columnId, pageNo);
       auto onDiskPage = fCurrentCluster->GetOnDiskPage(key);
       R__ASSERT(onDiskPage);
       R__ASSERT(bytesOnStorage == onDiskPage->GetSize());
-      memcpy(pageBuffer, onDiskPage->GetAddress(), onDiskPage->GetSize());
+      onDiskAddress = onDiskPage->GetAddress();
    }
 
+   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
+   if (CanUseMappedPage(onDiskAddress, bytesOnStorage, bytesPacked, *element)) {
+      // Zero-copy: the page memory is owned by the file mapping
+      fCounters->fNPageMapped.Inc();
+      auto newPage = fPageAllocator->NewPage(columnId, const_cast<void *>(onDiskAddress), elementSize,
+                                             pageInfo.fNElements);
+      newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
+      fPagePool->RegisterPage(newPage, RPageDeleter([](const RPage & /*page*/, void * /*userData*/) {}, nullptr));
+      return newPage;
+   }
+
+   auto pageBuffer = new unsigned char[bytesPacked];
+   if (onDiskAddress)
+      memcpy(pageBuffer, onDiskAddress, bytesOnStorage);
+   else
+      fReader.ReadBuffer(pageBuffer, bytesOnStorage, pageInfo.fLocator.fPosition);
+
    if (bytesOnStorage != bytesPacked) {
-      RNTuplePlainTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
+      RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
       fDecompressor(pageBuffer, bytesOnStorage, bytesPacked);
       fCounters->fSzUnzip.Add(bytesPacked);
    }
@@ -320,7 +441,6 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
       pageBuffer = unpackedBuffer;
    }
 
-   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
    auto newPage = fPageAllocator->NewPage(columnId, pageBuffer, elementSize, pageInfo.fNElements);
    newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
    fPagePool->RegisterPage(newPage,
@@ -337,8 +457,11 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
 {
    const auto columnId = columnHandle.fId;
    auto cachedPage = fPagePool->GetPage(columnId, globalIndex);
-   if (!cachedPage.IsNull())
+   if (!cachedPage.IsNull()) {
+      if (fTaskScheduler && (fOptions.GetClusterCache() != RNTupleReadOptions::EClusterCache::kOff))
+         UpdateCurrentCluster(cachedPage.GetClusterInfo().GetId(), columnId);
       return cachedPage;
+   }
 
    const auto clusterId = fDescriptor.FindClusterId(columnId, globalIndex);
    R__ASSERT(clusterId != kInvalidDescriptorId);
@@ -356,8 +479,11 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    const auto index = clusterIndex.GetIndex();
    const auto columnId = columnHandle.fId;
    auto cachedPage = fPagePool->GetPage(columnId, clusterIndex);
-   if (!cachedPage.IsNull())
+   if (!cachedPage.IsNull()) {
+      if (fTaskScheduler && (fOptions.GetClusterCache() != RNTupleReadOptions::EClusterCache::kOff))
+         UpdateCurrentCluster(clusterId, columnId);
       return cachedPage;
+   }
 
    R__ASSERT(clusterId != kInvalidDescriptorId);
    const auto &clusterDescriptor = fDescriptor.GetClusterDescriptor(clusterId);
@@ -377,11 +503,26 @@ std::unique_ptr<ROOT::Experimental::Detail::RPageSource> ROOT::Experimental::Det
    return std::unique_ptr<RPageSourceFile>(clone);
 }
 
+bool ROOT::Experimental::Detail::RPageSourceFile::CanUseMappedPage(const void *onDiskAddress,
+   std::size_t bytesOnStorage, std::size_t bytesPacked, const RColumnElementBase &element) const
+{
+   if (!fMmapRegion || !onDiskAddress)
+      return false;
+   // Compressed or packed pages need to be transformed into a new buffer
+   if ((bytesOnStorage != bytesPacked) || !element.IsMappable())
+      return false;
+   return (reinterpret_cast<std::uintptr_t>(onDiskAddress) % element.GetSize()) == 0;
+}
+
 std::unique_ptr<ROOT::Experimental::Detail::RCluster>
-ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns)
+ROOT::Experimental::Detail::RPageSourceFile::PrepareSingleCluster(
+   const RClusterKey &clusterKey, std::vector<ROOT::Internal::RRawFile::RIOVec> &readRequests)
 {
    fCounters->fNClusterLoaded.Inc();
 
+   const auto clusterId = clusterKey.fClusterId;
+   const auto &columns = clusterKey.fColumnSet;
+
    const auto &clusterDesc = GetDescriptor().GetClusterDescriptor(clusterId);
    auto clusterLocator = clusterDesc.GetLocator();
    auto clusterSize = clusterLocator.fBytesOnStorage;
@@ -398,110 +539,229 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
       std::size_t fBufPos = 0;
    };
 
-   // Collect the page necessary page meta-data and sum up the total size of the compressed and packed pages
+   // Collect the page necessary page meta-data
    std::vector<ROnDiskPageLocator> onDiskPages;
-   auto activeSize = 0;
    for (auto columnId : columns) {
       const auto &pageRange = clusterDesc.GetPageRange(columnId);
       NTupleSize_t pageNo = 0;
       for (const auto &pageInfo : pageRange.fPageInfos) {
          const auto &pageLocator = pageInfo.fLocator;
-         activeSize += pageLocator.fBytesOnStorage;
          onDiskPages.emplace_back(ROnDiskPageLocator(
             columnId, pageNo, pageLocator.fPosition, pageLocator.fBytesOnStorage));
          ++pageNo;
       }
    }
 
-   // Linearize the page requests by file offset
-   std::sort(onDiskPages.begin(), onDiskPages.end(),
-      [](const ROnDiskPageLocator &a, const ROnDiskPageLocator &b) {return a.fOffset < b.fOffset;});
-
-   // In order to coalesce close-by pages, we collect the sizes of the gaps between pages on disk.  We then order
-   // the gaps by size, sum them up and find a cutoff for the largest gap that we tolerate when coalescing pages.
-   // The size of the cutoff is given by the fraction of extra bytes we are willing to read in order to reduce
-   // the number of read requests.  We thus schedule the lowest number of requests given a tolerable fraction
-   // of extra bytes.
-   // TODO(jblomer): Eventually we may want to select the parameter at runtime according to link latency and speed,
+   // Close-by pages are coalesced into a single read request, as long as the tolerated extra bytes read in the gaps
+   // between pages stay below a certain fraction of the payload.  The requests are laid out consecutively in the
+   // cluster buffer.
+   // TODO(jblomer): Eventually we may want to select the parameters at runtime according to link latency and speed,
    // memory consumption, device block size.
-   float maxOverhead = 0.25 * float(activeSize);
-   std::vector<std::size_t> gaps;
-   for (unsigned i = 1; i < onDiskPages.size(); ++i) {
-      gaps.emplace_back(onDiskPages[i].fOffset - (onDiskPages[i-1].fSize + onDiskPages[i-1].fOffset));
+   std::vector<ROOT::Internal::RRawFile::RIOVec> pageRanges(onDiskPages.size());
+   for (unsigned i = 0; i < onDiskPages.size(); ++i) {
+      R__ASSERT(onDiskPages[i].fSize > 0);
+      pageRanges[i].fOffset = onDiskPages[i].fOffset;
+      pageRanges[i].fSize = onDiskPages[i].fSize;
    }
-   std::sort(gaps.begin(), gaps.end());
-   std::size_t gapCut = 0;
-   float szExtra = 0.0;
-   for (auto g : gaps) {
-      szExtra += g;
-      if (szExtra  > maxOverhead)
-         break;
-      gapCut = g;
+   const auto plan = ROOT::Internal::RReadVPlanner().Plan(pageRanges.data(), pageRanges.size());
+   for (unsigned i = 0; i < onDiskPages.size(); ++i)
+      onDiskPages[i].fBufPos = plan.fRangePos[i];
+
+   // Prepare the input vector for the RRawFile::ReadV() call; the buffer addresses are first relative to the
+   // cluster buffer and fixed up once the cluster buffer is allocated
+   const auto firstReq = readRequests.size();
+   for (const auto &block : plan.fBlocks) {
+      ROOT::Internal::RRawFile::RIOVec req;
+      req.fBuffer = reinterpret_cast<unsigned char *>(block.fBufferPos);
+      req.fOffset = block.fOffset;
+      req.fSize = block.fSize;
+      readRequests.emplace_back(req);
    }
+   fCounters->fSzReadPayload.Add(plan.fSzRequested);
+   fCounters->fSzReadOverhead.Add(plan.fSzRead - plan.fSzRequested);
 
-   // Prepare the input vector for the RRawFile::ReadV() call
-   struct RReadRequest {
-      RReadRequest() = default;
-      RReadRequest(std::size_t b, std::uint64_t o, std::uint64_t s) : fBufPos(b), fOffset(o), fSize(s) {}
-      std::size_t fBufPos = 0;
-      std::uint64_t fOffset = 0;
-      std::uint64_t fSize = 0;
-   };
-   std::vector<ROOT::Internal::RRawFile::RIOVec> readRequests;
-
-   ROOT::Internal::RRawFile::RIOVec req;
-   std::size_t szPayload = 0;
-   std::size_t szOverhead = 0;
-   for (auto &s : onDiskPages) {
-      R__ASSERT(s.fSize > 0);
-      auto readUpTo = req.fOffset + req.fSize;
-      R__ASSERT(s.fOffset >= readUpTo);
-      auto overhead = s.fOffset - readUpTo;
-      szPayload += s.fSize;
-      if (overhead <= gapCut) {
-         szOverhead += overhead;
-         s.fBufPos = reinterpret_cast<intptr_t>(req.fBuffer) + req.fSize + overhead;
-         req.fSize += overhead + s.fSize;
-         continue;
+   // Register the on disk pages in a page map
+   std::unique_ptr<ROnDiskPageMap> pageMap;
+   if (fMmapRegion) {
+      // The pages are used in place in the file mapping; the read requests become prefetch hints
+      std::vector<ROnDiskPageMapMmap::RRange> ranges;
+      for (auto i = firstReq; i < readRequests.size(); ++i) {
+         auto &r = readRequests[i];
+         r.fBuffer = fMmapRegion + r.fOffset;
+         ranges.emplace_back(r.fBuffer, r.fSize);
+      }
+      pageMap = std::make_unique<ROnDiskPageMapMmap>(fFile.get(), ranges);
+      for (const auto &s : onDiskPages) {
+         ROnDiskPage::Key key(s.fColumnId, s.fPageNo);
+         pageMap->Register(key, ROnDiskPage(fMmapRegion + s.fOffset, s.fSize));
       }
+   } else {
+      auto buffer = new unsigned char[plan.fSzRead];
+      pageMap = std::make_unique<ROnDiskPageMapHeap>(std::unique_ptr<unsigned char []>(buffer));
+      for (const auto &s : onDiskPages) {
+         ROnDiskPage::Key key(s.fColumnId, s.fPageNo);
+         pageMap->Register(key, ROnDiskPage(buffer + s.fBufPos, s.fSize));
+      }
+      for (auto i = firstReq; i < readRequests.size(); ++i) {
+         auto &r = readRequests[i];
+         r.fBuffer = buffer + reinterpret_cast<intptr_t>(r.fBuffer);
+      }
+   }
+   fCounters->fNPageLoaded.Add(onDiskPages.size());
 
-      // close the current request and open new one
-      if (req.fSize > 0)
-         readRequests.emplace_back(req);
+   auto cluster = std::make_unique<RCluster>(clusterId);
+   cluster->Adopt(std::move(pageMap));
+   for (auto colId : columns)
+      cluster->SetColumnAvailable(colId);
+   return cluster;
+}
 
-      req.fBuffer = reinterpret_cast<unsigned char *>(req.fBuffer) + req.fSize;
-      s.fBufPos = reinterpret_cast<intptr_t>(req.fBuffer);
+std::unique_ptr<ROOT::Experimental::Detail::RCluster>
+ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns)
+{
+   RClusterKey clusterKey;
+   clusterKey.fClusterId = clusterId;
+   clusterKey.fColumnSet = columns;
+   auto clusters = LoadClusters(std::vector<RClusterKey>{clusterKey});
+   return std::move(clusters[0]);
+}
 
-      req.fOffset = s.fOffset;
-      req.fSize = s.fSize;
-   }
-   readRequests.emplace_back(req);
-   fCounters->fSzReadPayload.Add(szPayload);
-   fCounters->fSzReadOverhead.Add(szOverhead);
+std::vector<std::unique_ptr<ROOT::Experimental::Detail::RCluster>>
+ROOT::Experimental::Detail::RPageSourceFile::LoadClusters(const std::vector<RClusterKey> &clusterKeys)
+{
+   std::vector<std::unique_ptr<RCluster>> clusters;
+   std::vector<ROOT::Internal::RRawFile::RIOVec> readRequests;
 
-   // Register the on disk pages in a page map
-   auto buffer = new unsigned char[reinterpret_cast<intptr_t>(req.fBuffer) + req.fSize];
-   auto pageMap = std::make_unique<ROnDiskPageMapHeap>(std::unique_ptr<unsigned char []>(buffer));
-   for (const auto &s : onDiskPages) {
-      ROnDiskPage::Key key(s.fColumnId, s.fPageNo);
-      pageMap->Register(key, ROnDiskPage(buffer + s.fBufPos, s.fSize));
-   }
-   fCounters->fNPageLoaded.Add(onDiskPages.size());
-   for (auto &r : readRequests) {
-      r.fBuffer = buffer + reinterpret_cast<intptr_t>(r.fBuffer);
-   }
+   for (const auto &key : clusterKeys)
+      clusters.emplace_back(PrepareSingleCluster(key, readRequests));
 
+   // The read requests of all the clusters are issued in a single vector read, which allows for a raw file with
+   // asynchronous I/O capabilities (e.g., io_uring) to keep many requests in flight at the same time
    auto nReqs = readRequests.size();
-   {
+   if (nReqs > 0) {
       RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
-      fFile->ReadV(&readRequests[0], nReqs);
+      if (fMmapRegion) {
+         // The mapped pages are faulted in on first access; let the kernel read them ahead in the background
+         for (const auto &r : readRequests)
+            fFile->Advise(r.fBuffer, r.fSize, ROOT::Internal::RRawFile::EMapAdvice::kWillNeed);
+      } else {
+         fFile->ReadV(&readRequests[0], nReqs);
+      }
    }
    fCounters->fNReadV.Inc();
    fCounters->fNRead.Add(nReqs);
 
-   auto cluster = std::make_unique<RCluster>(clusterId);
-   cluster->Adopt(std::move(pageMap));
-   for (auto colId : columns)
-      cluster->SetColumnAvailable(colId);
-   return cluster;
+   return clusters;
+}
+
+void ROOT::Experimental::Detail::RPageSourceFile::UnzipCluster(RCluster *cluster)
+{
+   if (!fTaskScheduler)
+      return;
+
+   const auto clusterId = cluster->GetId();
+   const auto &clusterDescriptor = fDescriptor.GetClusterDescriptor(clusterId);
+
+   for (const auto columnId : cluster->GetAvailColumns()) {
+      const auto &columnDesc = fDescriptor.GetColumnDescriptor(columnId);
+      // The column element is used to unpack the pages and shared by the tasks of the column
+      std::shared_ptr<RColumnElementBase> element = RColumnElementBase::Generate(columnDesc.GetModel().GetType());
+
+      const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
+      const auto &pageRange = clusterDescriptor.GetPageRange(columnId);
+      NTupleSize_t pageNo = 0;
+      NTupleSize_t firstInPage = 0;
+      for (const auto &pi : pageRange.fPageInfos) {
+         ROnDiskPage::Key key(columnId, pageNo);
+         auto onDiskPage = cluster->GetOnDiskPage(key);
+         R__ASSERT(onDiskPage);
+         R__ASSERT(pi.fLocator.fBytesOnStorage == onDiskPage->GetSize());
+         const auto nElements = pi.fNElements;
+         RUnzipAheadKey unzipKey{clusterId, columnId, pageNo};
+         firstInPage += nElements;
+         ++pageNo;
+
+         // Pages that can be used in place from the file mapping are populated on demand without copy
+         const auto bytesPacked = (element->GetBitsOnStorage() * nElements + 7) / 8;
+         if (CanUseMappedPage(onDiskPage->GetAddress(), onDiskPage->GetSize(), bytesPacked, *element))
+            continue;
+
+         std::uint64_t taskId;
+         {
+            std::lock_guard<std::mutex> lock(fLockUnzipAhead);
+            taskId = fUnzipAheadNextTaskId++;
+            if (!fUnzipAheadPages.emplace(unzipKey, RUnzipAheadTask{taskId, false}).second)
+               continue;
+         }
+
+         // The on-disk page is captured by value: when partial clusters are merged in the cluster pool, the page
+         // memory stays in place but the cluster's page index is rebuilt
+         const auto windowFirst = indexOffset + firstInPage - nElements;
+         auto taskFunc = [this, unzipKey, taskId, windowFirst, onDiskPage = *onDiskPage, element, nElements,
+                          indexOffset]() {
+            {
+               std::lock_guard<std::mutex> lock(fLockUnzipAhead);
+               auto itr = fUnzipAheadPages.find(unzipKey);
+               // The page has been claimed by the reader or its cluster has been released
+               if ((itr == fUnzipAheadPages.end()) || (itr->second.fTaskId != taskId))
+                  return;
+               itr->second.fIsRunning = true;
+            }
+
+            RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
+            const auto bytesOnStorage = onDiskPage.GetSize();
+            const auto bytesPacked = (element->GetBitsOnStorage() * nElements + 7) / 8;
+            const auto pageSize = element->GetSize() * nElements;
+
+            auto pageBuffer = new unsigned char[bytesPacked];
+            RNTupleDecompressor::Unzip(onDiskPage.GetAddress(), bytesOnStorage, bytesPacked, pageBuffer);
+            if (bytesOnStorage != bytesPacked)
+               fCounters->fSzUnzip.Add(bytesPacked);
+
+            if (!element->IsMappable()) {
+               auto unpackedBuffer = new unsigned char[pageSize];
+               element->Unpack(unpackedBuffer, pageBuffer, nElements);
+               delete[] pageBuffer;
+               pageBuffer = unpackedBuffer;
+            }
+
+            auto newPage = RPageAllocatorFile::NewPage(unzipKey.fColumnId, pageBuffer, element->GetSize(), nElements);
+            newPage.SetWindow(windowFirst, RPage::RClusterInfo(unzipKey.fClusterId, indexOffset));
+            fPagePool->PreloadPage(newPage,
+               RPageDeleter([](const RPage &page, void * /*userData*/)
+               {
+                  RPageAllocatorFile::DeletePage(page);
+               }, nullptr));
+            fCounters->fNPageUnzipAhead.Inc();
+
+            std::lock_guard<std::mutex> lock(fLockUnzipAhead);
+            fUnzipAheadPages.erase(unzipKey);
+            fCvUnzipAhead.notify_all();
+         };
+         fTaskScheduler->AddTask(taskFunc);
+      }
+   }
+}
+
+void ROOT::Experimental::Detail::RPageSourceFile::ReleaseCluster(DescriptorId_t clusterId)
+{
+   if (!fTaskScheduler)
+      return;
+
+   {
+      // Pages whose task did not yet start are dropped; the tasks working on the cluster's memory are waited for
+      std::unique_lock<std::mutex> lock(fLockUnzipAhead);
+      auto fnFirst = [&]() { return fUnzipAheadPages.lower_bound(RUnzipAheadKey{clusterId, 0, 0}); };
+      for (auto itr = fnFirst(); (itr != fUnzipAheadPages.end()) && (itr->first.fClusterId == clusterId); ) {
+         if (itr->second.fIsRunning)
+            ++itr;
+         else
+            itr = fUnzipAheadPages.erase(itr);
+      }
+      fCvUnzipAhead.wait(lock, [&]() {
+         auto itr = fnFirst();
+         return (itr == fUnzipAheadPages.end()) || (itr->first.fClusterId != clusterId);
+      });
+   }
+   fPagePool->EvictPreloadedPages(clusterId);
 }
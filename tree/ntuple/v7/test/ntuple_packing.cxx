@@ -32,3 +32,176 @@ TEST(Packing, Bitfield)
       EXPECT_EQ(b9[i], e9[i]);
    }
 }
+
+TEST(Packing, Split)
+{
+   ROOT::Experimental::Detail::RColumnElement<std::uint32_t, ROOT::Experimental::EColumnType::kSplitInt32> element(
+      nullptr);
+   element.Pack(nullptr, nullptr, 0);
+   element.Unpack(nullptr, nullptr, 0);
+
+   std::uint32_t u[] = {0x04030201, 0x08070605, 0x0c0b0a09};
+   unsigned char split[12];
+   element.Pack(split, u, 3);
+   unsigned char expected[] = {0x01, 0x05, 0x09, 0x02, 0x06, 0x0a, 0x03, 0x07, 0x0b, 0x04, 0x08, 0x0c};
+   for (unsigned i = 0; i < 12; ++i) {
+      EXPECT_EQ(expected[i], split[i]);
+   }
+
+   // Cover both the vectorized blocks and the remainder
+   for (std::size_t count : {1, 15, 16, 17, 33, 1000}) {
+      std::vector<double> d(count);
+      std::vector<float> f(count);
+      std::vector<std::int64_t> i64(count);
+      for (std::size_t i = 0; i < count; ++i) {
+         d[i] = i * 3.14159;
+         f[i] = -1.0 * i / 7.0;
+         i64[i] = (std::int64_t(1) << 40) - 7 * i;
+      }
+
+      ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64> elemDouble(
+         nullptr);
+      std::vector<unsigned char> bufDouble(count * sizeof(double));
+      elemDouble.Pack(bufDouble.data(), d.data(), count);
+      std::vector<double> dUnpacked(count);
+      elemDouble.Unpack(dUnpacked.data(), bufDouble.data(), count);
+      EXPECT_EQ(d, dUnpacked);
+
+      ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32> elemFloat(
+         nullptr);
+      std::vector<unsigned char> bufFloat(count * sizeof(float));
+      elemFloat.Pack(bufFloat.data(), f.data(), count);
+      std::vector<float> fUnpacked(count);
+      elemFloat.Unpack(fUnpacked.data(), bufFloat.data(), count);
+      EXPECT_EQ(f, fUnpacked);
+
+      ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64> elemInt(
+         nullptr);
+      std::vector<unsigned char> bufInt(count * sizeof(std::int64_t));
+      elemInt.Pack(bufInt.data(), i64.data(), count);
+      std::vector<std::int64_t> i64Unpacked(count);
+      elemInt.Unpack(i64Unpacked.data(), bufInt.data(), count);
+      EXPECT_EQ(i64, i64Unpacked);
+   }
+}
+
+TEST(Packing, SplitIndex)
+{
+   using ClusterSize_t = ROOT::Experimental::ClusterSize_t;
+   ROOT::Experimental::Detail::RColumnElement<ClusterSize_t, ROOT::Experimental::EColumnType::kSplitIndex> element(
+      nullptr);
+   element.Pack(nullptr, nullptr, 0);
+   element.Unpack(nullptr, nullptr, 0);
+
+   std::vector<ClusterSize_t> offsets{ClusterSize_t(1), ClusterSize_t(3), ClusterSize_t(3), ClusterSize_t(0x10003)};
+   std::vector<unsigned char> packed(offsets.size() * sizeof(ClusterSize_t));
+   element.Pack(packed.data(), offsets.data(), offsets.size());
+   // Deltas 1, 2, 0, 0x10000, byte-split
+   unsigned char expected[] = {1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0};
+   for (unsigned i = 0; i < 16; ++i) {
+      EXPECT_EQ(expected[i], packed[i]);
+   }
+
+   std::vector<ClusterSize_t> unpacked(offsets.size());
+   element.Unpack(unpacked.data(), packed.data(), offsets.size());
+   for (unsigned i = 0; i < offsets.size(); ++i) {
+      EXPECT_EQ(offsets[i], unpacked[i]);
+   }
+}
+
+TEST(Packing, SplitCompression)
+{
+   // Compare the compressed size of a page of typical floating point and offset data with and without splitting
+   constexpr std::size_t kNElements = 8192;
+   constexpr int kCompression = 505;
+   TRandom3 rnd(42);
+
+   std::vector<double> values(kNElements);
+   std::vector<ROOT::Experimental::ClusterSize_t> offsets(kNElements);
+   std::uint32_t offset = 0;
+   for (std::size_t i = 0; i < kNElements; ++i) {
+      values[i] = rnd.Exp(10.);
+      offset += rnd.Integer(10);
+      offsets[i] = offset;
+   }
+
+   std::vector<unsigned char> packed(kNElements * sizeof(double));
+   std::vector<unsigned char> zipped(kNElements * sizeof(double));
+   auto szPlain = RNTupleCompressor::Zip(values.data(), kNElements * sizeof(double), kCompression, zipped.data());
+   ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64> elemDouble(
+      nullptr);
+   elemDouble.Pack(packed.data(), values.data(), kNElements);
+   auto szSplit = RNTupleCompressor::Zip(packed.data(), kNElements * sizeof(double), kCompression, zipped.data());
+   EXPECT_LT(szSplit, szPlain);
+
+   auto szOffsetsPlain = RNTupleCompressor::Zip(offsets.data(), kNElements * sizeof(std::uint32_t), kCompression,
+                                                zipped.data());
+   ROOT::Experimental::Detail::RColumnElement<ROOT::Experimental::ClusterSize_t,
+                                              ROOT::Experimental::EColumnType::kSplitIndex> elemIndex(nullptr);
+   elemIndex.Pack(packed.data(), offsets.data(), kNElements);
+   auto szOffsetsSplit = RNTupleCompressor::Zip(packed.data(), kNElements * sizeof(std::uint32_t), kCompression,
+                                                zipped.data());
+   EXPECT_LT(szOffsetsSplit, szOffsetsPlain / 2);
+}
+
+TEST(Packing, SplitEncodingRoundTrip)
+{
+   FileRaii fileGuard("test_ntuple_packing_split.root");
+
+   auto model = RNTupleModel::Create();
+   auto fieldPt = std::make_unique<RField<float>>("pt");
+   fieldPt->SetSplitEncoding(true);
+   model->AddField(std::move(fieldPt));
+   auto fieldEnergy = std::make_unique<RField<double>>("energy");
+   fieldEnergy->SetSplitEncoding(true);
+   model->AddField(std::move(fieldEnergy));
+   auto fieldTracks = std::make_unique<RField<std::vector<std::uint64_t>>>("tracks");
+   fieldTracks->SetSplitEncoding(true);
+   fieldTracks->begin()->SetSplitEncoding(true);
+   model->AddField(std::move(fieldTracks));
+   auto fieldPlain = model->MakeField<double>("plain");
+
+   auto wrPt = model->GetDefaultEntry()->Get<float>("pt");
+   auto wrEnergy = model->GetDefaultEntry()->Get<double>("energy");
+   auto wrTracks = model->GetDefaultEntry()->Get<std::vector<std::uint64_t>>("tracks");
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath());
+      for (unsigned i = 0; i < 1000; ++i) {
+         *wrPt = i / 3.f;
+         *wrEnergy = i * 1.5;
+         wrTracks->resize(i % 5);
+         for (unsigned j = 0; j < i % 5; ++j)
+            (*wrTracks)[j] = i + j;
+         *fieldPlain = -1.0 * i;
+         ntuple->Fill();
+         if (i == 500)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   auto columnType = [&desc](const std::string &fieldName, std::uint32_t columnIndex) {
+      auto columnId = desc.FindColumnId(desc.FindFieldId(fieldName), columnIndex);
+      return desc.GetColumnDescriptor(columnId).GetModel().GetType();
+   };
+   EXPECT_EQ(EColumnType::kSplitReal32, columnType("pt", 0));
+   EXPECT_EQ(EColumnType::kSplitReal64, columnType("energy", 0));
+   EXPECT_EQ(EColumnType::kSplitIndex, columnType("tracks", 0));
+   EXPECT_EQ(EColumnType::kReal64, columnType("plain", 0));
+
+   auto rdPt = ntuple->GetModel()->GetDefaultEntry()->Get<float>("pt");
+   auto rdEnergy = ntuple->GetModel()->GetDefaultEntry()->Get<double>("energy");
+   auto rdTracks = ntuple->GetModel()->GetDefaultEntry()->Get<std::vector<std::uint64_t>>("tracks");
+   auto rdPlain = ntuple->GetModel()->GetDefaultEntry()->Get<double>("plain");
+   EXPECT_EQ(1000U, ntuple->GetNEntries());
+   for (auto i : *ntuple) {
+      ntuple->LoadEntry(i);
+      EXPECT_EQ(i / 3.f, *rdPt);
+      EXPECT_EQ(i * 1.5, *rdEnergy);
+      ASSERT_EQ(i % 5, rdTracks->size());
+      for (unsigned j = 0; j < i % 5; ++j)
+         EXPECT_EQ(i + j, (*rdTracks)[j]);
+      EXPECT_EQ(-1.0 * i, *rdPlain);
+   }
+}
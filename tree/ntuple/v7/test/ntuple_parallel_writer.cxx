@@ -0,0 +1,76 @@
+#include "ntuple_test.hxx"
+
+TEST(RNTupleParallelWriter, Basics)
+{
+   FileRaii fileGuard("test_ntuple_parallel_writer.root");
+
+   auto model = RNTupleModel::Create();
+   model->MakeField<std::uint64_t>("id");
+   model->MakeField<std::vector<float>>("values");
+
+   constexpr unsigned int nThreads = 4;
+   constexpr unsigned int nEntriesPerThread = 10000;
+   {
+      auto writer = RNTupleParallelWriter::Recreate(std::move(model), "f", fileGuard.GetPath());
+      std::vector<std::thread> threads;
+      for (unsigned int t = 0; t < nThreads; ++t) {
+         threads.emplace_back([&writer, t]() {
+            auto context = writer->CreateFillContext();
+            auto id = context->GetModel()->Get<std::uint64_t>("id");
+            auto values = context->GetModel()->Get<std::vector<float>>("values");
+            for (unsigned int i = 0; i < nEntriesPerThread; ++i) {
+               *id = t * nEntriesPerThread + i;
+               values->assign(i % 5, static_cast<float>(*id));
+               context->Fill();
+               if (i % 1000 == 999)
+                  context->CommitCluster();
+            }
+         });
+      }
+      for (auto &t : threads)
+         t.join();
+   }
+
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath());
+   EXPECT_EQ(nThreads * nEntriesPerThread, ntuple->GetNEntries());
+   EXPECT_EQ(nThreads * nEntriesPerThread / 1000, ntuple->GetDescriptor().GetNClusters());
+
+   auto viewId = ntuple->GetView<std::uint64_t>("id");
+   auto viewValues = ntuple->GetView<std::vector<float>>("values");
+   std::vector<bool> seen(nThreads * nEntriesPerThread, false);
+   for (auto i : ntuple->GetEntryRange()) {
+      auto id = viewId(i);
+      ASSERT_LT(id, seen.size());
+      EXPECT_FALSE(seen[id]);
+      seen[id] = true;
+      const auto &values = viewValues(i);
+      EXPECT_EQ((id % nEntriesPerThread) % 5, values.size());
+      for (auto v : values)
+         EXPECT_EQ(static_cast<float>(id), v);
+   }
+}
+
+TEST(RNTupleParallelWriter, PendingContext)
+{
+   FileRaii fileGuard("test_ntuple_parallel_writer_pending.root");
+
+   auto model = RNTupleModel::Create();
+   model->MakeField<float>("pt");
+
+   std::shared_ptr<ROOT::Experimental::RNTupleFillContext> context;
+   {
+      auto writer = RNTupleParallelWriter::Recreate(std::move(model), "f", fileGuard.GetPath());
+      context = writer->CreateFillContext();
+      *context->GetModel()->Get<float>("pt") = 42.0;
+      context->Fill();
+      // The writer commits the pending entry of the still existing fill context
+   }
+
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath());
+   EXPECT_EQ(1U, ntuple->GetNEntries());
+   auto viewPt = ntuple->GetView<float>("pt");
+   EXPECT_EQ(42.0, viewPt(0));
+
+   // The fill context outlives the writer; its destruction must not touch the writer's state
+   context.reset();
+}
@@ -27,3 +27,37 @@ TEST(RNTuple, RDF)
    auto rdf = ROOT::Experimental::MakeNTupleDataFrame("myNTuple", fileGuard.GetPath());
    EXPECT_EQ(42.0, *rdf.Min("pt"));
 }
+
+TEST(RNTuple, RDFMappedColumns)
+{
+   FileRaii fileGuard("test_ntuple_rdf_mapped.root");
+
+   auto modelWrite = RNTupleModel::Create();
+   auto wrPt = modelWrite->MakeField<float>("pt");
+   auto wrId = modelWrite->MakeField<std::uint64_t>("id");
+   auto wrJets = modelWrite->MakeField<std::vector<float>>("jets");
+
+   constexpr unsigned int nEvents = 35000;
+   double sumJets = 0.0;
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(modelWrite), "myNTuple", fileGuard.GetPath());
+      for (unsigned int i = 0; i < nEvents; ++i) {
+         *wrPt = i;
+         *wrId = i;
+         wrJets->assign(i % 3, 0.5);
+         sumJets += 0.5 * (i % 3);
+         ntuple->Fill();
+      }
+   }
+
+   auto rdf = ROOT::Experimental::MakeNTupleDataFrame("myNTuple", fileGuard.GetPath());
+   auto nMismatch = rdf.Filter([](float pt, std::uint64_t id) { return static_cast<std::uint64_t>(pt) != id; },
+                               {"pt", "id"}).Count();
+   auto sumId = rdf.Sum<std::uint64_t>("id");
+   auto sumJetsRead = rdf.Define("sumJets", [](const std::vector<float> &jets) {
+      return std::accumulate(jets.begin(), jets.end(), 0.0);
+   }, {"jets"}).Sum<double>("sumJets");
+   EXPECT_EQ(0U, *nMismatch);
+   EXPECT_EQ(std::uint64_t(nEvents) * (nEvents - 1) / 2, *sumId);
+   EXPECT_DOUBLE_EQ(sumJets, *sumJetsRead);
+}
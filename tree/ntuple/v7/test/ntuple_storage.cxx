@@ -70,3 +70,167 @@ TEST(RNTuple, Extended)
    }
    EXPECT_EQ(chksumRead, chksumWrite);
 }
+
+TEST(RNTuple, Mmap)
+{
+   FileRaii fileGuard("test_ntuple_mmap.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrEnergy = model->MakeField<double>("energy");
+   auto wrCharge = model->MakeField<std::uint8_t>("charge");
+   auto wrFlag = model->MakeField<bool>("flag");
+   auto wrTag = model->MakeField<std::string>("tag");
+   auto wrJets = model->MakeField<std::vector<float>>("jets");
+
+   constexpr unsigned int nEvents = 30000;
+   {
+      RNTupleWriteOptions options;
+      options.SetCompression(0);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath(), options);
+      for (unsigned int i = 0; i < nEvents; ++i) {
+         *wrEnergy = i;
+         *wrCharge = i % 256;
+         *wrFlag = (i % 3) == 0;
+         *wrTag = std::to_string(i);
+         wrJets->assign(i % 4, i);
+         ntuple->Fill();
+         if (i % 10000 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   for (auto clusterCache : {RNTupleReadOptions::EClusterCache::kOn, RNTupleReadOptions::EClusterCache::kOff}) {
+      RNTupleReadOptions options;
+      options.SetUseMmap(true);
+      options.SetClusterCache(clusterCache);
+      auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath(), options);
+      ntuple->EnableMetrics();
+      EXPECT_EQ(nEvents, ntuple->GetNEntries());
+      auto rdEnergy = ntuple->GetModel()->GetDefaultEntry()->Get<double>("energy");
+      auto rdCharge = ntuple->GetModel()->GetDefaultEntry()->Get<std::uint8_t>("charge");
+      auto rdFlag = ntuple->GetModel()->GetDefaultEntry()->Get<bool>("flag");
+      auto rdTag = ntuple->GetModel()->GetDefaultEntry()->Get<std::string>("tag");
+      auto rdJets = ntuple->GetModel()->GetDefaultEntry()->Get<std::vector<float>>("jets");
+
+      for (auto i : *ntuple) {
+         ntuple->LoadEntry(i);
+         EXPECT_EQ(static_cast<double>(i), *rdEnergy);
+         EXPECT_EQ(i % 256, *rdCharge);
+         EXPECT_EQ((i % 3) == 0, *rdFlag);
+         EXPECT_EQ(std::to_string(i), *rdTag);
+         EXPECT_EQ(std::vector<float>(i % 4, i), *rdJets);
+      }
+
+      auto ctrMapped = ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nPageMapped");
+      ASSERT_NE(nullptr, ctrMapped);
+      EXPECT_GT(ctrMapped->GetValueAsInt(), 0);
+   }
+}
+
+#ifdef R__USE_IMT
+TEST(RNTuple, ParallelCompression)
+{
+   FileRaii fileGuard("test_ntuple_parallel_compression.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   auto wrVector = model->MakeField<std::vector<double>>("vector");
+
+   ROOT::EnableImplicitMT(4);
+   TRandom3 rnd(42);
+   double chksumWrite = 0.0;
+   {
+      RNTupleWriteOptions options;
+      options.SetUseImplicitMT(true);
+      // Force the writer to flush the zip queue several times per cluster
+      options.SetMaxInFlightBytes(100000);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath(), options);
+      constexpr unsigned int nEvents = 20000;
+      for (unsigned int i = 0; i < nEvents; ++i) {
+         *wrPt = i;
+         auto nVec = 1 + floor(rnd.Rndm() * 10.);
+         wrVector->resize(nVec);
+         for (unsigned int n = 0; n < nVec; ++n) {
+            auto val = rnd.Rndm();
+            (*wrVector)[n] = val;
+            chksumWrite += val;
+         }
+         ntuple->Fill();
+         if (i % 5000 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+   ROOT::DisableImplicitMT();
+
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath());
+   EXPECT_EQ(20000U, ntuple->GetNEntries());
+   auto rdPt = ntuple->GetModel()->GetDefaultEntry()->Get<float>("pt");
+   auto rdVector = ntuple->GetModel()->GetDefaultEntry()->Get<std::vector<double>>("vector");
+
+   double chksumRead = 0.0;
+   for (auto entryId : *ntuple) {
+      ntuple->LoadEntry(entryId);
+      EXPECT_EQ(static_cast<float>(entryId), *rdPt);
+      for (auto v : *rdVector)
+         chksumRead += v;
+   }
+   EXPECT_EQ(chksumRead, chksumWrite);
+}
+
+TEST(RNTuple, UnzipAhead)
+{
+   FileRaii fileGuard("test_ntuple_unzip_ahead.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   auto wrFlag = model->MakeField<bool>("flag");
+   auto wrVector = model->MakeField<std::vector<double>>("vector");
+
+   constexpr unsigned int nEvents = 20000;
+   TRandom3 rnd(42);
+   double chksumWrite = 0.0;
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath());
+      for (unsigned int i = 0; i < nEvents; ++i) {
+         *wrPt = i;
+         *wrFlag = (i % 3) == 0;
+         auto nVec = 1 + floor(rnd.Rndm() * 10.);
+         wrVector->resize(nVec);
+         for (unsigned int n = 0; n < nVec; ++n) {
+            auto val = rnd.Rndm();
+            (*wrVector)[n] = val;
+            chksumWrite += val;
+         }
+         ntuple->Fill();
+         if (i % 5000 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   ROOT::EnableImplicitMT(4);
+   RNTupleReadOptions options;
+   options.SetUseImplicitMT(true);
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath(), options);
+   ntuple->EnableMetrics();
+   EXPECT_EQ(nEvents, ntuple->GetNEntries());
+   auto rdPt = ntuple->GetModel()->GetDefaultEntry()->Get<float>("pt");
+   auto rdFlag = ntuple->GetModel()->GetDefaultEntry()->Get<bool>("flag");
+   auto rdVector = ntuple->GetModel()->GetDefaultEntry()->Get<std::vector<double>>("vector");
+
+   double chksumRead = 0.0;
+   for (auto entryId : *ntuple) {
+      ntuple->LoadEntry(entryId);
+      EXPECT_EQ(static_cast<float>(entryId), *rdPt);
+      EXPECT_EQ((entryId % 3) == 0, *rdFlag);
+      for (auto v : *rdVector)
+         chksumRead += v;
+   }
+   EXPECT_EQ(chksumRead, chksumWrite);
+
+   auto ctrUnzipAhead = ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nPageUnzipAhead");
+   ASSERT_NE(nullptr, ctrUnzipAhead);
+   EXPECT_GT(ctrUnzipAhead->GetValueAsInt(), 0);
+   ntuple.reset();
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -121,3 +121,65 @@ TEST(RNTuple, Composable)
    }
    EXPECT_EQ(8, nEv);
 }
+
+TEST(RNTuple, ViewBulk)
+{
+   FileRaii fileGuard("test_ntuple_view_bulk.root");
+
+   auto model = RNTupleModel::Create();
+   auto fieldPt = model->MakeField<float>("pt");
+   auto fieldFlag = model->MakeField<bool>("flag");
+   auto fieldTag = model->MakeField<std::string>("tag");
+
+   constexpr unsigned int nEvents = 50000;
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath());
+      for (unsigned int i = 0; i < nEvents; ++i) {
+         *fieldPt = i;
+         *fieldFlag = (i % 2) == 0;
+         *fieldTag = std::to_string(i % 10);
+         ntuple->Fill();
+         if (i % 15000 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewFlag = ntuple->GetView<bool>("flag");
+   auto viewTag = ntuple->GetView<std::string>("tag");
+
+   // Walk through the pages; every slice ends at a page boundary and does not span pages
+   NTupleSize_t nSlices = 0;
+   NTupleSize_t idx = 0;
+   while (idx < nEvents) {
+      auto slice = viewPt.MapV(idx);
+      ASSERT_GT(slice.size(), 0U);
+      EXPECT_LE(idx + slice.size(), nEvents);
+      EXPECT_LE(slice.size(), RPageSinkFile::kDefaultElementsPerPage);
+      for (std::size_t i = 0; i < slice.size(); ++i)
+         EXPECT_EQ(static_cast<float>(idx + i), slice[i]);
+      auto flags = viewFlag.MapV(idx);
+      for (std::size_t i = 0; i < std::min(flags.size(), slice.size()); ++i)
+         EXPECT_EQ(((idx + i) % 2) == 0, flags[i]);
+      idx += slice.size();
+      nSlices++;
+   }
+   EXPECT_EQ(nEvents, idx);
+   EXPECT_GT(nSlices, 1U);
+
+   // The zero-copy slice points to the same memory as the single-value access
+   auto slice = viewPt.MapV(RClusterIndex(1, 10));
+   EXPECT_EQ(&viewPt(RClusterIndex(1, 10)), slice.data());
+
+   // Entry ranges spanning several pages and clusters
+   auto range = viewPt.ReadV(14000, 22000);
+   ASSERT_EQ(22000U, range.size());
+   for (std::size_t i = 0; i < range.size(); ++i)
+      EXPECT_EQ(static_cast<float>(14000 + i), range[i]);
+
+   auto tags = viewTag.ReadV(5, 20);
+   ASSERT_EQ(20U, tags.size());
+   for (std::size_t i = 0; i < tags.size(); ++i)
+      EXPECT_EQ(std::to_string((5 + i) % 10), tags[i]);
+}
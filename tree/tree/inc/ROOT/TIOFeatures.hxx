@@ -51,7 +51,8 @@ namespace Experimental {
 // usage of this mechanism somehow involves baskets currently.
 enum class EIOFeatures {
    kGenerateOffsetMap = BIT(0),
-   kSupported = kGenerateOffsetMap  // Union of all features in this enum.
+   kZstdDictionary = BIT(1),  // Compress the baskets of ZSTD-compressed branches with a per-branch dictionary.
+   kSupported = kGenerateOffsetMap | kZstdDictionary  // Union of all features in this enum.
 };
 
 
@@ -86,7 +87,7 @@ public:
    void Print() const;
 
    // The number of known, defined IO features (supported / unsupported / experimental).
-   static constexpr int kIOFeatureCount = 1;
+   static constexpr int kIOFeatureCount = 2;
 
 private:
    // These methods allow access to the raw bitset underlying
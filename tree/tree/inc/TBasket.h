@@ -58,6 +58,10 @@ private:
    void   DisownBuffer();
    void   AdoptBuffer(TBuffer *user_buffer);
 
+   // Allocate the key and write the prepared buffer; see WriteBuffer.
+   Int_t  WriteKeyAndBuffer(TFile *file, Int_t nout);
+   Int_t  WriteBufferBehind(Int_t nout);
+
 protected:
    Int_t       fBufferSize{0};                    ///< fBuffer length in bytes
    Int_t       fNevBufSize{0};                    ///< Length in Int_t of fEntryOffset OR fixed length of each entry if fEntryOffset is null!
@@ -67,6 +71,8 @@ protected:
    UChar_t     fIOBits{0};                        ///<!IO feature flags.  Serialized in custom portion of streamer to avoid forward compat issues unless needed.
    Bool_t      fOwnsCompressedBuffer{kFALSE};     ///<! Whether or not we own the compressed buffer.
    Bool_t      fReadEntryOffset{kFALSE};          ///<!Set to true if offset array was read from a file.
+   Bool_t      fWriteBehind{kFALSE};              ///<!Set to true while the basket is written in the background (see TTree::SetWriteBehind).
+   UInt_t      fZstdDictID{0};                    ///<!ID of the zstd dictionary the basket was compressed with in the background, if any.
    Int_t      *fDisplacement{nullptr};            ///<![fNevBuf] Displacement of entries in fBuffer(TKey)
    Int_t      *fEntryOffset{nullptr};             ///<[fNevBuf] Offset of entries in fBuffer(TKey); generated at runtime.  Special value
                                                   /// of `-1` indicates that the offset generation MUST be performed on first read.
@@ -95,11 +101,12 @@ public:
    // in the fIOBits -- then the zombie flag will be set for this object.
    //
    enum class EIOBits : Char_t {
-      // The following to bits are reserved for now; when supported, set
-      // kSupported = kGenerateOffsetMap | kBasketClassMap
       kGenerateOffsetMap = BIT(0),
-      // kBasketClassMap = BIT(1),
-      kSupported = kGenerateOffsetMap
+      kZstdDictionary = BIT(1),
+      // The following bit is reserved for now; when supported, set
+      // kSupported = kGenerateOffsetMap | kZstdDictionary | kBasketClassMap
+      // kBasketClassMap = BIT(2),
+      kSupported = kGenerateOffsetMap | kZstdDictionary
    };
    // This enum covers IOBits that are known to this ROOT release but
    // not supported; provides a mechanism for us to have experimental
@@ -108,7 +115,7 @@ public:
    // (kUnsupported | kSupported) should result in the '|' of all IOBits.
    enum class EUnsupportedIOBits : Char_t { kUnsupported = 0 };
    // The number of known, defined IOBits.
-   static constexpr int kIOBitCount = 1;
+   static constexpr int kIOBitCount = 2;
 
    TBasket();
    TBasket(TDirectory *motherDir);
@@ -31,6 +31,10 @@
 #include "Compression.h"
 #include "ROOT/TIOFeatures.hxx"
 
+#include <memory>
+#include <vector>
+
+struct R__ZSTDDict;
 class TTree;
 class TBasket;
 class TBranchElement;
@@ -71,9 +75,11 @@ class TBulkBranchRead {
 
 public:
    Int_t GetBulkEntries(Long64_t evt, TBuffer &user_buf);
+   Int_t GetBulkEntriesJagged(Long64_t evt, TBuffer &user_buf, TBuffer &offset_buf);
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf);
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf, TBuffer *count_buf);
    Bool_t SupportsBulkRead() const;
+   Bool_t SupportsBulkJaggedRead() const;
 
 private:
    TBulkBranchRead(TBranch &parent)
@@ -90,6 +96,7 @@ class TBranch : public TNamed , public TAttFill {
    using TIOFeatures = ROOT::TIOFeatures;
 
 protected:
+   friend class TBasket;
    friend class TTreeCache;
    friend class TTreeCloner;
    friend class TTree;
@@ -153,6 +160,14 @@ protected:
    using CacheInfo_t = ROOT::Internal::TBranchCacheInfo;
    CacheInfo_t fCacheInfo;        ///<! Hold info about which basket are in the cache and if they have been retrieved from the cache.
 
+   std::vector<char>   fZstdDictSamples;          ///<! Content of the first baskets, to train the zstd dictionary
+   std::vector<size_t> fZstdDictSampleSizes;      ///<! Size of each sample in fZstdDictSamples
+   std::vector<char>   fZstdDict;                 ///<! Content of the zstd dictionary of this branch
+   UInt_t              fZstdDictID{0};            ///<! ID of the zstd dictionary of this branch, 0 if none
+   std::shared_ptr<R__ZSTDDict> fZstdDictDigest;  ///<! The zstd dictionary of this branch, digested for compression
+   Bool_t              fZstdDictTrained{kFALSE};  ///<! True once the training of the zstd dictionary was attempted
+   TDirectory         *fZstdDictDirectory{nullptr}; ///<! Directory the zstd dictionary was last written to
+
    typedef void (TBranch::*ReadLeaves_t)(TBuffer &b);
    ReadLeaves_t fReadLeaves;      ///<! Pointer to the ReadLeaves implementation to use.
    typedef void (TBranch::*FillLeaves_t)(TBuffer &b);
@@ -172,16 +187,25 @@ protected:
 
    TString  GetRealFileName() const;
 
+   UInt_t   TrainZstdDictionary(const char *buffer, Int_t size);
+   Bool_t   WriteZstdDictionary();
+   static void LoadZstdDictionaries(TDirectory *dir, const char *treeName,
+                                    std::vector<std::shared_ptr<R__ZSTDDict>> &dicts);
+
    virtual void SetAddressImpl(void *addr, Bool_t /* implied */) { SetAddress(addr); }
 
 private:
    Int_t    GetBasketAndFirst(TBasket*& basket, Long64_t& first, TBuffer* user_buffer);
    TBasket *GetBasketImpl(Int_t basket, TBuffer* user_buffer);
    Int_t    GetBulkEntries(Long64_t, TBuffer&);
+   Int_t    GetBulkEntriesJagged(Long64_t, TBuffer&, TBuffer&);
    Int_t    GetEntriesSerialized(Long64_t N, TBuffer& user_buf) {return GetEntriesSerialized(N, user_buf, nullptr);}
    Int_t    GetEntriesSerialized(Long64_t, TBuffer&, TBuffer*);
    Int_t    FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
    Int_t    WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
+   Int_t    WriteBasketBehind(TBasket* basket);
+   void     WriteBasketBehindDone(TBasket* basket, Int_t where, Int_t &nout);
+   void     UpdateEntryOffsetLen(Int_t nevbuf);
    TBranch(const TBranch&) = delete;             // not implemented
    TBranch& operator=(const TBranch&) = delete;  // not implemented
 
@@ -232,6 +256,7 @@ public:
            Int_t     GetReadBasket()  const {return fReadBasket;}
            Long64_t  GetReadEntry()   const {return fReadEntry;}
            Int_t     GetWriteBasket() const {return fWriteBasket;}
+   const R__ZSTDDict *GetZstdDictionary(UInt_t id) const;
            Long64_t  GetTotalSize(Option_t *option="")   const;
            Long64_t  GetTotBytes(Option_t *option="")    const;
            Long64_t  GetZipBytes(Option_t *option="")    const;
@@ -283,6 +308,7 @@ public:
    virtual void      SetTree(TTree *tree) { fTree = tree;}
    virtual void      SetupAddresses();
            Bool_t    SupportsBulkRead() const;
+           Bool_t    SupportsBulkJaggedRead() const;
    virtual void      UpdateAddress() {;}
    virtual void      UpdateFile();
 
@@ -314,9 +340,11 @@ namespace Experimental {
 namespace Internal {
 
 inline Int_t  TBulkBranchRead::GetBulkEntries(Long64_t evt, TBuffer& user_buf) { return fParent.GetBulkEntries(evt, user_buf); }
+inline Int_t  TBulkBranchRead::GetBulkEntriesJagged(Long64_t evt, TBuffer& user_buf, TBuffer& offset_buf) { return fParent.GetBulkEntriesJagged(evt, user_buf, offset_buf); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf) { return fParent.GetEntriesSerialized(evt, user_buf); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf, TBuffer* count_buf) { return fParent.GetEntriesSerialized(evt, user_buf, count_buf); }
 inline Bool_t TBulkBranchRead::SupportsBulkRead() const { return fParent.SupportsBulkRead(); }
+inline Bool_t TBulkBranchRead::SupportsBulkJaggedRead() const { return fParent.SupportsBulkJaggedRead(); }
 
 }  // Internal
 }  // Experimental
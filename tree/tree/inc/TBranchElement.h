@@ -34,8 +34,17 @@ class TVirtualCollectionIterators;
 class TVirtualCollectionPtrIterators;
 class TVirtualArray;
 
+#ifdef R__USE_IMT
+namespace ROOT {
+class TThreadExecutor;
+}
+#endif
+
 #include "TStreamerInfoActions.h"
 
+#include <memory>
+#include <vector>
+
 class TBranchElement : public TBranch {
 
 // Friends
@@ -101,6 +110,11 @@ protected:
    TVirtualCollectionIterators           *fIterators;      ///<! holds the iterators when the branch is of fType==4.
    TVirtualCollectionIterators           *fWriteIterators; ///<! holds the read (non-staging) iterators when the branch is of fType==4 and associative containers.
    TVirtualCollectionPtrIterators        *fPtrIterators;   ///<! holds the iterators when the branch is of fType==4 and it is a split collection of pointers.
+   std::vector<TBranch*>                  fSeqDaughters;   ///<! Sub-branches to be read sequentially when IMT is on, before the others
+   std::vector<TBranch*>                  fParDaughters;   ///<! Sub-branches to be read in parallel when IMT is on
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> fDaughtersPool;  ///<! Reads fParDaughters, only created if it is worth it
+#endif
 
 // Not implemented
 private:
@@ -112,6 +126,10 @@ private:
 // Implementation use only functions.
 protected:
    void                     BuildTitle(const char* name);
+#ifdef R__USE_IMT
+   Int_t                    GetEntryDaughtersMT(Long64_t entry, Int_t getall);
+#endif
+   void                     InitializeDaughterLists();
    virtual void             InitializeOffsets();
    virtual void             InitInfo();
    Bool_t                   IsMissingCollection() const;
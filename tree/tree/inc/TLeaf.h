@@ -42,6 +42,7 @@
 
 
 #include "TNamed.h"
+#include "TDataType.h"
 
 #include <vector>
 
@@ -115,6 +116,10 @@ public:
    TBranch         *GetBranch() const { return fBranch; }
    virtual DeserializeType GetDeserializeType() const { return DeserializeType::kDestructive; }
    virtual TString  GetFullName() const;
+   ///  If the entries of this leaf are variable-size arrays of a fundamental type that TBranch::GetBulkEntriesJagged
+   ///  can read, return kTRUE together with the type of the elements and the number of bytes that precede the elements
+   ///  of each entry in the baskets. Return kFALSE otherwise.
+   virtual Bool_t   GetJaggedLayout(EDataType & /*type*/, Int_t & /*headerBytes*/) const { return kFALSE; }
    ///  If this leaf stores a variable-sized array or a multi-dimensional array whose last dimension has variable size,
    ///  return a pointer to the TLeaf that stores such size. Return a nullptr otherwise.
    virtual TLeaf   *GetLeafCount() const { return fLeafCount; }
@@ -49,6 +49,7 @@ public:
    virtual Bool_t   CanGenerateOffsetArray() { return fLeafCount && fLenType; }
    virtual Int_t   *GenerateOffsetArrayBase(Int_t /*base*/, Int_t /*events*/) { return nullptr; }
    virtual DeserializeType GetDeserializeType() const;
+   virtual Bool_t   GetJaggedLayout(EDataType &type, Int_t &headerBytes) const;
 
    virtual TString  GetFullName() const;
    virtual Int_t    GetLen() const {return ((TBranchElement*)fBranch)->GetNdata()*fLen;}
@@ -50,6 +50,7 @@ class TList;
 
 #include <array>
 #include <atomic>
+#include <memory>
 #include <vector>
 #include <utility>
 
@@ -76,6 +77,12 @@ class TTreeCloner;
 class TFileMergeInfo;
 class TVirtualPerfStats;
 
+namespace ROOT {
+namespace Internal {
+class TBasketWriteBehind;
+}
+}
+
 class TTree : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
    using TIOFeatures = ROOT::TIOFeatures;
@@ -140,6 +147,7 @@ protected:
    UInt_t         fNEntriesSinceSorting;  ///<! Number of entries processed since the last re-sorting of branches
    std::vector<std::pair<Long64_t,TBranch*>> fSortedBranches; ///<! Branches to be processed in parallel when IMT is on, sorted by average task time
    std::vector<TBranch*> fSeqBranches;    ///<! Branches to be processed sequentially when IMT is on
+   std::vector<std::shared_ptr<R__ZSTDDict>> fZstdDicts; ///<! zstd dictionaries stored with this tree in its directory
    Float_t fTargetMemoryRatio{1.1f};      ///<! Ratio for memory usage in uncompressed buffers versus actual occupancy.  1.0
                                            /// indicates basket should be resized to exact memory usage, but causes significant
 /// memory churn.
@@ -156,7 +164,9 @@ private:
    mutable Bool_t fIMTFlush{false};               ///<! True if we are doing a multithreaded flush.
    mutable std::atomic<Long64_t> fIMTTotBytes;    ///<! Total bytes for the IMT flush baskets
    mutable std::atomic<Long64_t> fIMTZipBytes;    ///<! Zip bytes for the IMT flush baskets.
+   std::unique_ptr<ROOT::Internal::TBasketWriteBehind> fWriteBehind; ///<! Writes the full baskets in the background, see SetWriteBehind
 
+   Int_t            CollectWriteBehind(Bool_t wait);
    void             InitializeBranchLists(bool checkLeafCount);
    void             SortBranchesByTime();
    Int_t            FlushBasketsImpl() const;
@@ -202,6 +212,8 @@ protected:
    friend class TChainIndex;
    // So that the TTreeCloner can access the protected interfaces
    friend class TTreeCloner;
+   // So that the branches can hand their full baskets over to fWriteBehind
+   friend class TBranch;
 
    // use to update fFriendLockStatus
    enum ELockStatusBits {
@@ -537,7 +549,9 @@ public:
    virtual Double_t       *GetV4()   { return GetPlayer()->GetV4(); }
    virtual Double_t       *GetW()    { return GetPlayer()->GetW(); }
    virtual Double_t        GetWeight() const   { return fWeight; }
+           Long64_t        GetWriteBehind() const;
    virtual Long64_t        GetZipBytes() const { return fZipBytes; }
+   const R__ZSTDDict      *GetZstdDictionary(UInt_t id) const;
    virtual void            IncrementTotalBuffers(Int_t nbytes) { fTotalBuffers += nbytes; }
    Bool_t                  IsFolder() const { return kTRUE; }
    virtual Int_t           LoadBaskets(Long64_t maxmemory = 2000000000);
@@ -639,6 +653,7 @@ public:
    virtual void            SetTimerInterval(Int_t msec = 333) { fTimerInterval=msec; }
    virtual void            SetTreeIndex(TVirtualIndex* index);
    virtual void            SetWeight(Double_t w = 1, Option_t* option = "");
+           void            SetWriteBehind(Long64_t maxBytes);
    virtual void            SetUpdate(Int_t freq = 0) { fUpdate = freq; }
    virtual void            Show(Long64_t entry = -1, Int_t lenmax = 20);
    virtual void            StartViewer(); // *MENU*
@@ -24,6 +24,10 @@ class TBranch;
 class TMutex;
 class TTree;
 
+namespace ROOT {
+class TRWSpinLock;
+}
+
 #ifdef R__USE_IMT
 namespace ROOT {
 namespace Experimental {
@@ -77,19 +81,41 @@ protected:
    typedef struct UnzipState UnzipState_t;
    UnzipState_t fUnzipState;
 
+   // A basket of the cluster that follows the one in the cache: FillBuffer reads it and it is unzipped
+   // in the background while the current cluster is processed (see ReadAhead)
+   struct ReadAheadBasket {
+      Long64_t                 fPos;       ///<! Position of the basket in the file
+      Int_t                    fLen;       ///<! Length of the zipped basket
+      Long64_t                 fOffset;    ///<! Offset of the zipped basket in fReadAheadBuffer
+      std::unique_ptr<char[]>  fUnzipped;  ///<! The unzipped basket, null if it could not be unzipped
+      Int_t                    fUnzipLen;  ///<! Length of the unzipped basket
+   };
+
+   std::vector<ReadAheadBasket> fReadAhead;            ///<! Baskets of the next cluster, sorted by position
+   std::unique_ptr<char[]>      fReadAheadBuffer;      ///<! The zipped baskets of fReadAhead
+   Long64_t                     fReadAheadEntry = -1;  ///<! First entry of the cluster of fReadAhead, -1 if none
+   TTree                       *fReadAheadTree = nullptr; ///<! Tree of the cluster of fReadAhead
+   /// Unzipped baskets of the cluster in the cache, taken over from fReadAhead by FillBuffer and sorted by
+   /// position: they are not read again from the file.
+   std::vector<ReadAheadBasket> fReady;                ///<!
+
    // Members for paral. managing
    Bool_t      fAsyncReading;
-   Bool_t      fEmpty;
+   std::atomic<Bool_t> fEmpty;
    Int_t       fCycle;
    Bool_t      fParallel; ///< Indicate if we want to activate the parallelism (for this instance)
 
    std::unique_ptr<TMutex> fIOMutex;
+   /// Lets a branch pick its basket from the cache while the unzipping tasks run, while a refill of the cache
+   /// excludes all readers.
+   std::unique_ptr<ROOT::TRWSpinLock> fUnzipLock; ///<!
 
    static TTreeCacheUnzip::EParUnzipMode fgParallel;  ///< Indicate if we want to activate the parallelism
 
    // IMT TTaskGroup Manager
 #ifdef R__USE_IMT
    std::unique_ptr<ROOT::Experimental::TTaskGroup> fUnzipTaskGroup;
+   std::unique_ptr<ROOT::Experimental::TTaskGroup> fReadAheadTaskGroup; ///<! Unzips the baskets of fReadAhead
 #endif
 
    // Unzipping related members
@@ -100,10 +126,10 @@ protected:
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
    // Members use to keep statistics
-   Int_t       fNFound;           ///<! number of blocks that were found in the cache
-   Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
-   Int_t       fNStalls;          ///<! number of hits which caused a stall
-   Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   std::atomic<Int_t> fNFound;    ///<! number of blocks that were found in the cache
+   std::atomic<Int_t> fNMissed;   ///<! number of blocks that were not found in the cache and were unzipped
+   std::atomic<Int_t> fNStalls;   ///<! number of hits which caused a stall
+   std::atomic<Int_t> fNUnzip;    ///<! number of blocks that were unzipped
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &);            //this class cannot be copied
@@ -114,6 +140,14 @@ private:
 
    // Private methods
    void  Init();
+   void   ClearReadAhead();
+   Bool_t IsInPrefetchBuffer() const;
+   Bool_t IsReady(Long64_t pos) const;
+   Int_t  GetReadyChunk(char **buf, Long64_t pos, Bool_t *free);
+   Int_t  GetUnzippedChunk(char **buf, Long64_t pos, Bool_t *free);
+#ifdef R__USE_IMT
+   void   ReadAhead(TTree *tree);
+#endif
 
 public:
    TTreeCacheUnzip();
@@ -618,7 +618,12 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
             goto AfterBuffer;
          }
 
-         R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
+         if (UInt_t dictID = R__getZSTDDictIDFromBuffer(nin, rawCompressedObjectBuffer)) {
+            R__unzipZSTDDict(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout,
+                             fBranch->GetZstdDictionary(dictID));
+         } else {
+            R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
+         }
          if (!nout) break;
          noutot += nout;
          nintot += nin;
@@ -1127,6 +1132,11 @@ void TBasket::Update(Int_t offset, Int_t skipped)
 /// The function returns the number of bytes committed to the memory.
 /// If a write error occurs, the number of bytes returned is -1.
 /// If no data are written, the number of bytes returned is 0.
+///
+/// For a basket written in the background (see TTree::SetWriteBehind), this
+/// only serializes and compresses the content, without touching the file: it
+/// returns the number of bytes of data to write, and WriteBufferBehind writes
+/// them from the thread filling the tree.
 
 Int_t TBasket::WriteBuffer()
 {
@@ -1144,8 +1154,10 @@ Int_t TBasket::WriteBuffer()
    //
    // The only parallelism we'd like to exploit (right now!) is the compression
    // step - everything else should be serialized at the TFile level.
+   // A basket written in the background does not touch the file here.
 #ifdef R__USE_IMT
-   std::unique_lock<std::mutex> sentry(file->fWriteMutex);
+   std::unique_lock<std::mutex> sentry(file->fWriteMutex, std::defer_lock);
+   if (!fWriteBehind) sentry.lock();
 #endif  // R__USE_IMT
 
    if (R__unlikely(fBufferRef->TestBit(TBufferFile::kNotDecompressed))) {
@@ -1209,7 +1221,8 @@ Int_t TBasket::WriteBuffer()
    fObjlen    = lbuf - fKeylen;
 
    fHeaderOnly = kTRUE;
-   fCycle = fBranch->GetWriteBasket();
+   // In write-behind mode, the branch set the cycle when handing over the basket and is already filling the next one.
+   if (!fWriteBehind) fCycle = fBranch->GetWriteBasket();
    Int_t cxlevel = fBranch->GetCompressionLevel();
    ROOT::RCompressionSetting::EAlgorithm::EValues cxAlgorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(fBranch->GetCompressionAlgorithm());
    if (cxlevel > 0) {
@@ -1224,6 +1237,24 @@ Int_t TBasket::WriteBuffer()
       fBuffer = fCompressedBufferRef->Buffer();
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       char *bufcur = &fBuffer[fKeylen];
+      UInt_t zstdDictID = 0;
+      if ((fIOBits & static_cast<UChar_t>(TBasket::EIOBits::kZstdDictionary)) &&
+          cxAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+         // The training only touches the branch, only storing the dictionary needs the file.
+#ifdef R__USE_IMT
+         if (sentry.owns_lock()) sentry.unlock();
+#endif  // R__USE_IMT
+         zstdDictID = fBranch->TrainZstdDictionary(objbuf, fObjlen);
+#ifdef R__USE_IMT
+         if (!fWriteBehind) sentry.lock();
+#endif  // R__USE_IMT
+         if (fWriteBehind) {
+            // The dictionary is stored by WriteBufferBehind.
+            fZstdDictID = zstdDictID;
+         } else if (zstdDictID && !fBranch->WriteZstdDictionary()) {
+            zstdDictID = 0;
+         }
+      }
       noutot = 0;
       nzip   = 0;
       for (Int_t i = 0; i < nbuffers; ++i) {
@@ -1233,14 +1264,18 @@ Int_t TBasket::WriteBuffer()
          // for a given TFile: that's because the compression buffer when we use IMT is no longer
          // shared amongst several threads.
 #ifdef R__USE_IMT
-         sentry.unlock();
+         if (sentry.owns_lock()) sentry.unlock();
 #endif  // R__USE_IMT
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         if (zstdDictID) {
+            R__zipZSTDDict(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, fBranch->fZstdDictDigest.get());
+         } else {
+            R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         }
 #ifdef R__USE_IMT
-         sentry.lock();
+         if (!fWriteBehind) sentry.lock();
 #endif  // R__USE_IMT
 
          // test if buffer has really been compressed. In case of small buffers
@@ -1251,10 +1286,6 @@ Int_t TBasket::WriteBuffer()
             // We used to delete fBuffer here, we no longer want to since
             // the buffer (held by fCompressedBufferRef) might be re-used later.
             fBuffer = fBufferRef->Buffer();
-            Create(fObjlen,file);
-            fBufferRef->SetBufferOffset(0);
-
-            Streamer(*fBufferRef);         //write key itself again
             if ((nout+fKeylen)>buflen) {
                Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fNbytes=%d, fObjLen=%d, fKeylen=%d",
                   (nout+fKeylen-buflen),buflen,fNbytes,fObjlen,fKeylen);
@@ -1267,22 +1298,63 @@ Int_t TBasket::WriteBuffer()
          nzip   += kMAXZIPBUF;
       }
       nout = noutot;
-      Create(noutot,file);
-      fBufferRef->SetBufferOffset(0);
-
-      Streamer(*fBufferRef);         //write key itself again
-      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
    } else {
       fBuffer = fBufferRef->Buffer();
-      Create(fObjlen,file);
-      fBufferRef->SetBufferOffset(0);
-
-      Streamer(*fBufferRef);         //write key itself again
       nout = fObjlen;
    }
 
 WriteFile:
+   if (fWriteBehind) {
+      return nout;
+   }
+   return WriteKeyAndBuffer(file, nout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the key of this basket in `file` for the `nout` bytes of data in
+/// fBuffer, compressed unless fBuffer is the buffer of the basket content, and
+/// write the key and the data.
+///
+/// Returns the number of bytes written, or -1 in case of error.
+
+Int_t TBasket::WriteKeyAndBuffer(TFile *file, Int_t nout)
+{
+   Create(nout,file);
+   fBufferRef->SetBufferOffset(0);
+
+   Streamer(*fBufferRef);         //write key itself again
+   if (fBuffer != fBufferRef->Buffer()) {
+      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
+   }
+
    Int_t nBytes = WriteFileKeepBuffer();
    fHeaderOnly = kFALSE;
    return nBytes>0 ? fKeylen+nout : -1;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the key and the `nout` bytes of data of a basket prepared in the
+/// background by WriteBuffer (see TTree::SetWriteBehind). This allocates space
+/// in the file, so it is called by the thread filling the tree, like all the
+/// other writes to the file.
+///
+/// Returns the number of bytes written, or -1 in case of error.
+
+Int_t TBasket::WriteBufferBehind(Int_t nout)
+{
+   const Int_t kWrite = 1;
+
+   TFile *file = fBranch->GetFile(kWrite);
+   if (!file || !file->IsWritable()) {
+      return -1;
+   }
+#ifdef R__USE_IMT
+   std::lock_guard<std::mutex> sentry(file->fWriteMutex);
+#endif  // R__USE_IMT
+   if (fZstdDictID && !fBranch->WriteZstdDictionary()) {
+      Error("WriteBufferBehind", "The zstd dictionary %u of branch %s could not be written.", fZstdDictID,
+            fBranch->GetName());
+      return -1;
+   }
+   return WriteKeyAndBuffer(file, nout);
+}
@@ -0,0 +1,120 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TBasketWriteBehind.h"
+
+#include "ROOT/RConfig.hxx"
+#include "TBasket.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#endif
+
+namespace ROOT {
+namespace Internal {
+
+TBasketWriteBehind::TBasketWriteBehind(Long64_t maxBytes) : fMaxBytes(maxBytes)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled())
+      fGroup.reset(new ROOT::Experimental::TTaskGroup());
+#endif
+}
+
+TBasketWriteBehind::~TBasketWriteBehind()
+{
+   // The tree collects all the writes before deleting us; this is only a safety net.
+   Collect(kTRUE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the pending baskets of `branch` in order, until there are none left.
+
+void TBasketWriteBehind::WriteBaskets(TBranch *branch)
+{
+   while (true) {
+      RWrite write;
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         auto &queue = fQueues[branch];
+         if (queue.fPending.empty()) {
+            queue.fRunning = false;
+            return;
+         }
+         write = queue.fPending.front();
+         queue.fPending.pop_front();
+      }
+      write.fNout = write.fBasket->WriteBuffer();
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fDone.push_back(write);
+         ++fNDone;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Schedule the write of the full basket number `where` of `branch`, which
+/// holds `size` bytes of memory until it is collected.
+
+void TBasketWriteBehind::Submit(TBranch *branch, TBasket *basket, Int_t where, Long64_t size)
+{
+   fBytesInFlight += size;
+   bool launch = false;
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      auto &queue = fQueues[branch];
+      RWrite write;
+      write.fBranch = branch;
+      write.fBasket = basket;
+      write.fWhere = where;
+      write.fSize = size;
+      queue.fPending.push_back(write);
+      launch = !queue.fRunning;
+      queue.fRunning = true;
+   }
+   if (!launch)
+      return; // the task writing the previous baskets of the branch will also write this one
+
+#ifdef R__USE_IMT
+   if (fGroup) {
+      fGroup->Run([this, branch]() { WriteBaskets(branch); });
+      return;
+   }
+#endif
+   WriteBaskets(branch);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the writes completed since the last call, after waiting for all the
+/// submitted ones if `wait` is true.
+
+std::vector<TBasketWriteBehind::RWrite> TBasketWriteBehind::Collect(Bool_t wait)
+{
+#ifdef R__USE_IMT
+   if (wait && fGroup)
+      fGroup->Wait();
+#endif
+   std::vector<RWrite> done;
+   if (!wait && fNDone.load(std::memory_order_relaxed) == 0)
+      return done;
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      done.swap(fDone);
+      fNDone = 0;
+   }
+   for (const auto &write : done)
+      fBytesInFlight -= write.fSize;
+   return done;
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,81 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketWriteBehind
+#define ROOT_TBasketWriteBehind
+
+#include "RtypesCore.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class TBasket;
+class TBranch;
+
+namespace ROOT {
+namespace Experimental {
+class TTaskGroup;
+}
+
+namespace Internal {
+
+/// Writes the full baskets of a tree in the background while TTree::Fill goes on, see TTree::SetWriteBehind.
+///
+/// The baskets of different branches are compressed in parallel, the baskets of a given branch one after the
+/// other. Submit and Collect are only called by the thread filling the tree, which writes the compressed baskets
+/// to the file and updates the branches itself: the background tasks only touch the baskets (see
+/// TBasket::WriteBuffer), never the file.
+class TBasketWriteBehind {
+public:
+   struct RWrite {
+      TBranch *fBranch = nullptr;
+      TBasket *fBasket = nullptr;
+      Int_t fWhere = 0;   ///< Number of the basket in its branch
+      Long64_t fSize = 0; ///< Memory held by the basket
+      Int_t fNout = 0;    ///< Value returned by TBasket::WriteBuffer
+   };
+
+private:
+   struct RBranchQueue {
+      std::deque<RWrite> fPending;
+      bool fRunning = false; ///< True if a task is writing the baskets of the branch
+   };
+
+   const Long64_t fMaxBytes;
+   Long64_t fBytesInFlight = 0; ///< Memory held by the baskets submitted and not collected yet
+   std::mutex fMutex;           ///< Protects fQueues and fDone
+   std::unordered_map<TBranch *, RBranchQueue> fQueues;
+   std::vector<RWrite> fDone;
+   std::atomic<Int_t> fNDone{0};
+   /// Runs the writes; null if implicit multi-threading was disabled, in which case the writes are synchronous
+   std::unique_ptr<ROOT::Experimental::TTaskGroup> fGroup;
+
+   void WriteBaskets(TBranch *branch);
+
+public:
+   explicit TBasketWriteBehind(Long64_t maxBytes);
+   ~TBasketWriteBehind();
+   TBasketWriteBehind(const TBasketWriteBehind &) = delete;
+   TBasketWriteBehind &operator=(const TBasketWriteBehind &) = delete;
+
+   Long64_t GetMaxBytes() const { return fMaxBytes; }
+   Bool_t IsOverBudget() const { return fBytesInFlight > fMaxBytes; }
+   void Submit(TBranch *branch, TBasket *basket, Int_t where, Long64_t size);
+   std::vector<RWrite> Collect(Bool_t wait);
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -15,6 +15,7 @@
 
 #include "Bytes.h"
 #include "Compression.h"
+#include "TArrayC.h"
 #include "TBasket.h"
 #include "TBranchBrowsable.h"
 #include "TBrowser.h"
@@ -23,6 +24,7 @@
 #include "TBufferFile.h"
 #include "TClonesArray.h"
 #include "TFile.h"
+#include "TKey.h"
 #include "TLeaf.h"
 #include "TLeafB.h"
 #include "TLeafC.h"
@@ -45,17 +47,22 @@
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
 #include "TVirtualPerfStats.h"
+#include "RZip.h"
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#include "TBasketWriteBehind.h"
 #include "TBranchIMTHelper.h"
 
 #include "ROOT/TIOFeatures.hxx"
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <cstdio>
+#include <memory>
+#include <mutex>
 
 
 Int_t TBranch::fgCount = 0;
@@ -78,6 +85,48 @@ See also specialized branches:
 
 ClassImp(TBranch);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Size of the fundamental types that the bulk IO can deserialize, 0 for the others.
+
+Int_t GetBulkElementSize(EDataType type)
+{
+   switch (type) {
+   case kChar_t:
+   case kUChar_t:
+   case kBool_t: return 1;
+   case kShort_t:
+   case kUShort_t: return 2;
+   case kInt_t:
+   case kUInt_t:
+   case kFloat_t: return 4;
+   case kLong64_t:
+   case kULong64_t:
+   case kDouble_t: return 8;
+   default: return 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check that an entry of entryBytes bytes starts with the header of a
+/// collection of nElements elements: its byte count, its version and its size.
+
+Bool_t IsCollectionHeader(char *header, Int_t entryBytes, Int_t nElements)
+{
+   const UInt_t kByteCountMask = 0x40000000; // as in TBufferFile
+   UInt_t byteCount;
+   Version_t version;
+   Int_t size;
+   frombuf(header, &byteCount);
+   frombuf(header, &version);
+   frombuf(header, &size);
+   return (byteCount & kByteCountMask) && Int_t(byteCount & ~kByteCountMask) == entryBytes - Int_t(sizeof(UInt_t)) &&
+          size == nElements;
+}
+
+} // anonymous namespace
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -901,7 +950,10 @@ Int_t TBranch::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
    if (noFlushAtCluster && !fTree->TestBit(TTree::kCircular) &&
        ((fSkipZip && (lnew >= TBuffer::kMinimalSize)) || (buf->TestBit(TBufferFile::kNotDecompressed)) ||
         ((lnew + (2 * nsize) + nbytes) >= fBasketSize))) {
-      Int_t nout = WriteBasketImpl(basket, fWriteBasket, imtHelper);
+      // The baskets holding already compressed data are written right away.
+      Int_t nout = (fTree->fWriteBehind && !buf->TestBit(TBufferFile::kNotDecompressed))
+                      ? WriteBasketBehind(basket)
+                      : WriteBasketImpl(basket, fWriteBasket, imtHelper);
       if (nout < 0) Error("TBranch::Fill", "Failed to write out basket.\n");
       return (nout >= 0) ? nbytes : -1;
    }
@@ -1481,7 +1533,136 @@ Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
    return N;
 }
 
-// TODO: Template this and the call above; only difference is the TLeaf function (ReadBasketFast vs
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if this branch supports bulk IO of variable-size arrays with
+/// GetBulkEntriesJagged, false otherwise.
+///
+/// This is the case for variable-size arrays of a leaflist (e.g. `x[n]/F`),
+/// for std::vector of fundamental types and for the data members of fundamental
+/// type of split STL collections and TClonesArrays, see TLeaf::GetJaggedLayout.
+
+Bool_t TBranch::SupportsBulkJaggedRead() const {
+   if (fNleaves != 1) return kFALSE;
+   EDataType type;
+   Int_t headerBytes;
+   return static_cast<TLeaf*>(fLeaves.UncheckedAt(0))->GetJaggedLayout(type, headerBytes) &&
+          GetBulkElementSize(type) > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read as many events as possible into the given buffer, for a branch whose
+/// entries are variable-size arrays of a fundamental type.
+///
+/// Returns -1 in case of a failure.  On success, returns the (non-zero) number of
+/// events now in the buffer, N.
+///
+/// On success, the elements of all the events are contiguous and deserialized:
+/// the caller can access them as
+///
+/// static_cast<T*>(buf.GetCurrent())
+///
+/// where T is the type of the elements.  offset_buf holds N + 1 Int_t: the
+/// elements of the event i are those between the offsets i (included) and i + 1
+/// (excluded), so that the last offset is the total number of elements:
+///
+/// reinterpret_cast<Int_t*>(offset_buf.Buffer())
+///
+/// NOTES:
+/// - This interface is meant to be used by higher-level, type-safe wrappers, not
+///   by end-users.
+/// - As for GetBulkEntries, the entry must be the first one of a basket.
+
+Int_t TBranch::GetBulkEntriesJagged(Long64_t entry, TBuffer &user_buf, TBuffer &offset_buf)
+{
+   if (R__unlikely(fNleaves != 1)) return -1;
+   TLeaf *leaf = static_cast<TLeaf*>(fLeaves.UncheckedAt(0));
+   EDataType type;
+   Int_t headerBytes = 0;
+   if (R__unlikely(!leaf->GetJaggedLayout(type, headerBytes))) return -1;
+   const Int_t elementSize = GetBulkElementSize(type);
+   if (R__unlikely(elementSize == 0)) return -1;
+
+   // Remember which entry we are reading.
+   fReadEntry = entry;
+
+   Bool_t enabled = !TestBit(kDoNotProcess);
+   if (R__unlikely(!enabled)) return -1;
+   TBasket *basket = nullptr;
+   Long64_t first;
+   Int_t result = GetBasketAndFirst(basket, first, &user_buf);
+   if (R__unlikely(result <= 0)) return -1;
+   // Only support reading from full clusters.
+   if (R__unlikely(entry != first)) {
+      return -1;
+   }
+
+   basket->PrepareBasket(entry);
+   TBuffer* buf = basket->GetBufferRef();
+
+   // Test for very old ROOT files.
+   if (R__unlikely(!buf)) {
+      Error("GetBulkEntriesJagged", "Failed to get a new buffer.\n");
+      return -1;
+   }
+   // Test for displacements, which aren't supported in fast mode.
+   if (R__unlikely(basket->GetDisplacement())) {
+      Error("GetBulkEntriesJagged", "Basket has displacement.\n");
+      return -1;
+   }
+
+   Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
+   Int_t *entryOffsets = basket->GetEntryOffset();
+   if (R__unlikely(!entryOffsets || basket->GetNevBuf() != N)) {
+      Error("GetBulkEntriesJagged", "Basket has no usable entry offsets.\n");
+      return -1;
+   }
+
+   const Int_t offsetsLen = (N + 1) * sizeof(Int_t);
+   if (offset_buf.BufferSize() < offsetsLen) {
+      offset_buf.Expand(offsetsLen);
+   }
+   offset_buf.SetBufferOffset(0);
+   Int_t *elementOffsets = reinterpret_cast<Int_t*>(offset_buf.Buffer());
+
+   // Drop the headers, if any, to make the elements of all the entries contiguous.
+   // As the elements only move towards the beginning of the buffer, this is done in place.
+   Int_t bufbegin = basket->GetKeylen();
+   char *data = buf->Buffer();
+   Int_t dest = bufbegin;
+   elementOffsets[0] = 0;
+   for (Int_t i = 0; i < N; ++i) {
+      const Int_t begin = entryOffsets[i];
+      const Int_t end = (i + 1 < N) ? entryOffsets[i + 1] : basket->GetLast();
+      const Int_t nbytes = end - begin - headerBytes;
+      if (R__unlikely(nbytes < 0 || nbytes % elementSize ||
+                      (headerBytes && !IsCollectionHeader(data + begin, headerBytes + nbytes, nbytes / elementSize)))) {
+         Error("GetBulkEntriesJagged", "Unexpected layout of entry %lld.\n", first + i);
+         return -1;
+      }
+      if (dest != begin + headerBytes) {
+         memmove(data + dest, data + begin + headerBytes, nbytes);
+      }
+      dest += nbytes;
+      elementOffsets[i + 1] = elementOffsets[i] + nbytes / elementSize;
+   }
+
+   buf->SetBufferOffset(bufbegin);
+   if (elementSize > 1 && R__unlikely(!buf->ByteSwapBuffer(elementOffsets[N], type))) {
+      Error("GetBulkEntriesJagged", "Leaf failed to read.\n");
+      return -1;
+   }
+   user_buf.SetBufferOffset(bufbegin);
+
+   fCurrentBasket = nullptr;
+   fBaskets[fReadBasket] = nullptr;
+   R__ASSERT(fExtraBasket == nullptr && "fExtraBasket should have been set to nullptr by GetFreshBasket");
+   fExtraBasket = basket;
+   basket->DisownBuffer();
+
+   return N;
+}
+
+// TODO: Template this and GetBulkEntries; only difference is the TLeaf function (ReadBasketFast vs
 // ReadBasketSerialized
 Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *count_buf)
 {
@@ -3032,20 +3213,163 @@ void TBranch::Streamer(TBuffer& b)
    }
 }
 
+namespace {
+/// Name of the keys holding the zstd dictionaries of the branches, followed by the tree name and the dictionary ID.
+const char *const kZstdDictKeyPrefix = "ZstdDict_";
+/// Serializes the choice of the IDs of the dictionaries trained by the branches of a tree, which can be concurrent
+/// when the baskets are flushed in parallel.
+std::mutex gZstdDictIDMutex;
+/// The dictionary is trained once this many bytes or baskets were collected.
+constexpr size_t kZstdDictTrainingBytes = 256 * 1024;
+constexpr size_t kZstdDictTrainingBaskets = 64;
+constexpr Int_t kZstdDictMaxSize = 16 * 1024;
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the ID of the zstd dictionary to compress the basket content `buffer`
+/// with, or 0 if it must be compressed without dictionary.
+///
+/// Used by TBasket::WriteBuffer for the branches compressed with ZSTD when the
+/// kZstdDictionary IO feature is enabled: the content of the first baskets is
+/// kept, and once there is enough of it a dictionary is trained on it and
+/// used for this and all the following baskets. Small baskets compress much
+/// better with a dictionary, since they do not have to learn the structure
+/// of the data from scratch. If the training fails (e.g. for incompressible
+/// data), the baskets are compressed without dictionary.
+///
+/// This only touches the state of this branch, so it does not need the
+/// file's write lock.
+
+UInt_t TBranch::TrainZstdDictionary(const char *buffer, Int_t size)
+{
+   if (fZstdDictTrained) {
+      return fZstdDictID;
+   }
+   const size_t sampleSize = std::min<size_t>(size, kZstdDictTrainingBytes);
+   fZstdDictSamples.insert(fZstdDictSamples.end(), buffer, buffer + sampleSize);
+   fZstdDictSampleSizes.push_back(sampleSize);
+   if (fZstdDictSamples.size() < kZstdDictTrainingBytes && fZstdDictSampleSizes.size() < kZstdDictTrainingBaskets) {
+      return 0;
+   }
+
+   fZstdDictTrained = kTRUE;
+   fZstdDict.resize(kZstdDictMaxSize);
+   Int_t dictSize = R__trainZSTDDict(fZstdDictSamples.data(), fZstdDictSampleSizes.data(),
+                                     fZstdDictSampleSizes.size(), fZstdDict.data(), kZstdDictMaxSize);
+   fZstdDict.resize(dictSize);
+   if (dictSize) {
+      // The dictionary gets a new ID if another dictionary of the tree already uses the trained one: the baskets
+      // of a tree find their dictionary by ID, see GetZstdDictionary.
+      std::lock_guard<std::mutex> lock(gZstdDictIDMutex);
+      std::vector<unsigned> usedIDs;
+      for (const auto &dict : fTree->fZstdDicts) {
+         usedIDs.push_back(R__getZSTDDictID(dict.get()));
+      }
+      for (auto leaf : ROOT::Detail::TRangeStaticCast<TLeaf>(*fTree->GetListOfLeaves())) {
+         if (leaf->GetBranch()->fZstdDictID) {
+            usedIDs.push_back(leaf->GetBranch()->fZstdDictID);
+         }
+      }
+      fZstdDictDigest.reset(R__createNewZSTDDict(fZstdDict.data(), dictSize, usedIDs.data(), usedIDs.size()),
+                            R__deleteZSTDDict);
+      if (fZstdDictDigest) {
+         fZstdDictID = R__getZSTDDictID(fZstdDictDigest.get());
+      }
+   }
+   std::vector<char>().swap(fZstdDictSamples);
+   std::vector<size_t>().swap(fZstdDictSampleSizes);
+   return fZstdDictID;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure that the zstd dictionary of this branch is stored in the
+/// directory of the tree, under the name `ZstdDict_<tree>_<ID>`, so that the baskets
+/// compressed with it can be read back (see LoadZstdDictionaries). The
+/// dictionary is written again if the tree moved to another file, e.g. in
+/// TTree::ChangeFile.
+///
+/// Returns false if the dictionary could not be written, in which case the
+/// baskets must be compressed without dictionary. Must be called with the
+/// file's write lock held.
+
+Bool_t TBranch::WriteZstdDictionary()
+{
+   TDirectory *dir = fTree->GetDirectory();
+   if (!dir) {
+      return kFALSE;
+   }
+   if (dir == fZstdDictDirectory) {
+      return kTRUE;
+   }
+   TString name = TString::Format("%s%s_%u", kZstdDictKeyPrefix, fTree->GetName(), fZstdDictID);
+   if (!dir->GetKey(name)) {
+      TArrayC content(fZstdDict.size(), fZstdDict.data());
+      if (dir->WriteObjectAny(&content, TArrayC::Class(), name) <= 0) {
+         return kFALSE;
+      }
+   }
+   fZstdDictDirectory = dir;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the zstd dictionaries stored in `dir` by WriteZstdDictionary for the
+/// branches of the tree `treeName`, so that the baskets compressed with them
+/// can be decompressed, including by TTreeCacheUnzip's tasks. Called when a
+/// tree written with the kZstdDictionary IO feature is attached to a directory;
+/// the dictionaries are appended to `dicts`, which the tree owns.
+///
+/// The zstd frames only record the ID of their dictionary, which is unique
+/// among the dictionaries of a tree but not across trees or files: each tree
+/// only resolves the IDs of its baskets among its own dictionaries.
+
+void TBranch::LoadZstdDictionaries(TDirectory *dir, const char *treeName,
+                                   std::vector<std::shared_ptr<R__ZSTDDict>> &dicts)
+{
+   TList *keys = dir->GetListOfKeys();
+   if (!keys) {
+      return;
+   }
+   const TString prefix = TString::Format("%s%s_", kZstdDictKeyPrefix, treeName);
+   for (auto key : ROOT::Detail::TRangeStaticCast<TKey>(*keys)) {
+      if (strncmp(key->GetName(), prefix.Data(), prefix.Length()) != 0) {
+         continue;
+      }
+      std::unique_ptr<TArrayC> content(key->ReadObject<TArrayC>());
+      if (!content) {
+         continue;
+      }
+      std::shared_ptr<R__ZSTDDict> dict(R__createZSTDDict(content->GetArray(), content->GetSize()),
+                                        R__deleteZSTDDict);
+      if (dict) {
+         dicts.push_back(std::move(dict));
+      } else {
+         ::Error("TBranch::LoadZstdDictionaries", "The key %s of %s does not contain a zstd dictionary.",
+                 key->GetName(), dir->GetPath());
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the zstd dictionary with the given ID to decompress the baskets of
+/// this branch: the one this branch trained, or one stored with its tree (see
+/// TTree::GetZstdDictionary). Returns null if there is none.
+
+const R__ZSTDDict *TBranch::GetZstdDictionary(UInt_t id) const
+{
+   if (fZstdDictDigest && fZstdDictID == id) {
+      return fZstdDictDigest.get();
+   }
+   return fTree ? fTree->GetZstdDictionary(id) : nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write the current basket to disk and return the number of bytes
 /// written to the file.
 
 Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *imtHelper)
 {
-   Int_t nevbuf = basket->GetNevBuf();
-   if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
-      // Make sure that the fEntryOffset array does not stay large unnecessarily.
-      fEntryOffsetLen = nevbuf < 3 ? 10 : 4*nevbuf; // assume some fluctuations.
-   } else if (fEntryOffsetLen && nevbuf > fEntryOffsetLen) {
-      // Increase the array ...
-      fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
-   }
+   UpdateEntryOffsetLen(basket->GetNevBuf());
 
    // Note: captures `basket`, `where`, and `this` by value; modifies the TBranch and basket,
    // as we make a copy of the pointer.  We cannot capture `basket` by reference as the pointer
@@ -3109,6 +3433,93 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Adapt the initial length of the fEntryOffset table of the next baskets to
+/// the number of entries `nevbuf` of the basket being written.
+
+void TBranch::UpdateEntryOffsetLen(Int_t nevbuf)
+{
+   if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
+      // Make sure that the fEntryOffset array does not stay large unnecessarily.
+      fEntryOffsetLen = nevbuf < 3 ? 10 : 4*nevbuf; // assume some fluctuations.
+   } else if (fEntryOffsetLen && nevbuf > fEntryOffsetLen) {
+      // Increase the array ...
+      fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the full current basket over to the background writer of the tree
+/// (see TTree::SetWriteBehind) and go on filling a new basket.
+///
+/// The writer only serializes and compresses the basket; it belongs to the
+/// writer until the tree collects it and calls WriteBasketBehindDone, which
+/// writes it to the file. In the meantime it is neither in fBaskets nor on
+/// file, so the branch cannot be read back before TTree::FlushBaskets.
+
+Int_t TBranch::WriteBasketBehind(TBasket* basket)
+{
+   const Int_t where = fWriteBasket;
+   UpdateEntryOffsetLen(basket->GetNevBuf());
+
+   // The basket is compressed while this branch fills the next one, so it
+   // cannot use the compression buffer shared by the baskets of the branch.
+   if (!basket->fOwnsCompressedBuffer) {
+      basket->fCompressedBufferRef = nullptr;
+   }
+   basket->fWriteBehind = kTRUE;
+   basket->fCycle = where;
+
+   fBaskets[where] = 0;
+   if (basket == fCurrentBasket) {
+      fCurrentBasket    = 0;
+      fFirstBasketEntry = -1;
+      fNextBasketEntry  = -1;
+   }
+   ++fWriteBasket;
+   if (fWriteBasket >= fMaxBaskets) {
+      ExpandBasketArrays();
+   }
+   fBaskets.AddAtAndExpand(nullptr, fWriteBasket);
+   fBasketEntry[fWriteBasket] = fEntryNumber;
+
+   fTree->fWriteBehind->Submit(this, basket, where, basket->GetBufferRef()->BufferSize());
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write to the file the basket number `where` prepared in the background (see
+/// WriteBasketBehind), and record the result; `nout` is the value returned by
+/// its WriteBuffer. Called by the thread filling the tree, so that all the
+/// writes to the file happen on that thread.
+
+void TBranch::WriteBasketBehindDone(TBasket* basket, Int_t where, Int_t &nout)
+{
+   if (nout > 0) {
+      nout = basket->WriteBufferBehind(nout);
+   }
+   basket->fWriteBehind = kFALSE;
+   basket->fZstdDictID = 0;
+   if (nout < 0) Error("TBranch::WriteBasketBehindDone", "basket's WriteBuffer failed.\n");
+   fBasketBytes[where]  = basket->GetNbytes();
+   fBasketSeek[where]   = basket->GetSeekKey();
+   if (nout == 0) {
+      // Nothing was written (e.g. there is no file): keep the basket in memory, as WriteBasketImpl does.
+      fBaskets.AddAtAndExpand(basket, where);
+      return;
+   }
+   if (nout > 0) {
+      Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+      fZipBytes += nout;
+      fTotBytes += addbytes;
+      fTree->AddTotBytes(addbytes);
+      fTree->AddZipBytes(nout);
+   }
+   --fNBaskets;
+   basket->DropBuffers();
+   delete basket;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///set the first entry number (case of TBranchSTL)
 
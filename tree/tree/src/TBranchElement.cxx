@@ -44,12 +44,29 @@ A Branch for the case of an object.
 #include "TBufferFile.h"
 #include "TInterpreter.h"
 #include "TROOT.h"
+#include "TTreeCacheUnzip.h"
 
 #include "TStreamerInfoActions.h"
 #include "TSchemaRuleSet.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/RMakeUnique.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <atomic>
+#include <unordered_map>
+
 ClassImp(TBranchElement);
 
+namespace {
+/// The sub-branches of a split object are only read in parallel if there are at least this many of them that do not
+/// depend on each other...
+constexpr std::size_t kMinParDaughters = 2;
+/// ...and if they amount to at least this many bytes per entry, otherwise the tasks cost more than they save.
+constexpr Long64_t kMinParDaughtersBytesPerEntry = 4096;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace {
@@ -2628,6 +2645,23 @@ Int_t TBranchElement::GetEntry(Long64_t entry, Int_t getall)
             break;
          default:
             ValidateAddress(); // There is no ReadLeave for this node, so we need to do the validation here.
+#ifdef R__USE_IMT
+            // The data members of a top-level split object are deserialized in parallel. As in TTree::GetEntry,
+            // not with parallel unzipping: the TTreeCacheUnzip does not support concurrent basket reads.
+            if (nbranches > 1 && fType == 0 && fID < 0 && !fOnfileObject && !bref && ROOT::IsImplicitMTEnabled() &&
+                fTree->GetImplicitMT() && !TTreeCacheUnzip::IsParallelUnzip()) {
+               if (fSeqDaughters.empty() && fParDaughters.empty())
+                  InitializeDaughterLists();
+               if (fDaughtersPool) {
+                  Int_t nb = GetEntryDaughtersMT(entry, getall);
+                  if (nb < 0) {
+                     return nb;
+                  }
+                  nbytes += nb;
+                  break;
+               }
+            }
+#endif
             for (Int_t i = 0; i < nbranches; ++i) {
                TBranch* branch = (TBranch*) fBranches.UncheckedAt(i);
                Int_t nb = branch->GetEntry(entry, getall);
@@ -2701,6 +2735,112 @@ Int_t TBranchElement::GetEntry(Long64_t entry, Int_t getall)
    return nbytes;
 }
 
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// Read the sub-branches of a split object for the given entry, in parallel
+/// when possible. The sub-branches that others depend on are read first and
+/// sequentially, see InitializeDaughterLists.
+/// Returns the number of bytes read, or a negative number in case of error.
+
+Int_t TBranchElement::GetEntryDaughtersMT(Long64_t entry, Int_t getall)
+{
+   Int_t nbytes = 0;
+   for (auto branch : fSeqDaughters) {
+      Int_t nb = branch->GetEntry(entry, getall);
+      if (nb < 0) {
+         return nb;
+      }
+      nbytes += nb;
+   }
+
+   // Enable this IMT use case (activate its locks)
+   ROOT::Internal::TParBranchProcessingRAII pbpRAII;
+
+   std::atomic<Int_t> errnb(0);
+   std::atomic<Int_t> nbpar(0);
+   auto readDaughter = [&](TBranch *branch) {
+      Int_t nb = branch->GetEntry(entry, getall);
+      if (nb < 0)
+         errnb = nb;
+      else
+         nbpar += nb;
+   };
+   fDaughtersPool->Foreach(readDaughter, fParDaughters);
+
+   if (errnb < 0) {
+      return errnb;
+   }
+   nbytes += nbpar;
+
+   return nbytes;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Split the sub-branches in those that can be read in parallel and those that
+/// must be read sequentially before them: a sub-branch is read sequentially if
+/// a branch of another sub-branch hierarchy uses it (or one of its own
+/// sub-branches) as its branch count, e.g. the size of a variable-size array.
+/// The executor that reads them in parallel is only created if there are at
+/// least kMinParDaughters of them, with at least kMinParDaughtersBytesPerEntry
+/// uncompressed bytes per entry.
+
+void TBranchElement::InitializeDaughterLists()
+{
+   fSeqDaughters.clear();
+   fParDaughters.clear();
+
+   // Map all the branches of the hierarchy to the sub-branch they belong to
+   const Int_t nbranches = fBranches.GetEntriesFast();
+   std::unordered_map<TBranch *, Int_t> daughterOf;
+   std::vector<TBranch *> toVisit;
+   for (Int_t i = 0; i < nbranches; ++i) {
+      toVisit.push_back((TBranch *)fBranches.UncheckedAt(i));
+      while (!toVisit.empty()) {
+         TBranch *branch = toVisit.back();
+         toVisit.pop_back();
+         daughterOf[branch] = i;
+         TObjArray *subbranches = branch->GetListOfBranches();
+         for (Int_t j = 0; j < subbranches->GetEntriesFast(); ++j)
+            toVisit.push_back((TBranch *)subbranches->UncheckedAt(j));
+      }
+   }
+
+   std::vector<bool> isSeq(nbranches, false);
+   for (const auto &branchAndDaughter : daughterOf) {
+      auto element = dynamic_cast<TBranchElement *>(branchAndDaughter.first);
+      if (!element)
+         continue;
+      for (TBranch *count : {(TBranch *)element->GetBranchCount(), (TBranch *)element->GetBranchCount2()}) {
+         if (!count)
+            continue;
+         auto countDaughter = daughterOf.find(count);
+         if (countDaughter != daughterOf.end() && countDaughter->second != branchAndDaughter.second)
+            isSeq[countDaughter->second] = true;
+      }
+   }
+
+   for (Int_t i = 0; i < nbranches; ++i) {
+      auto branch = (TBranch *)fBranches.UncheckedAt(i);
+      if (isSeq[i])
+         fSeqDaughters.push_back(branch);
+      else
+         fParDaughters.push_back(branch);
+   }
+
+#ifdef R__USE_IMT
+   // Only read the independent sub-branches in parallel if they are enough, and big enough, to pay off the tasks
+   fDaughtersPool.reset();
+   Long64_t parBytes = 0;
+   for (auto branch : fParDaughters)
+      parBytes += branch->GetTotBytes("*");
+   const Long64_t nentries = GetEntries();
+   if (fParDaughters.size() >= kMinParDaughters && nentries > 0 &&
+       parBytes / nentries >= kMinParDaughtersBytesPerEntry)
+      fDaughtersPool = std::make_unique<ROOT::TThreadExecutor>();
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill expectedClass and expectedType with information on the data type of the
 /// object/values contained in this branch (and thus the type of pointers
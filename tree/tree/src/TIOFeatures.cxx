@@ -46,6 +46,13 @@ using namespace ROOT;
  *
  * The method `TTree::SetIOFeatures` creates a copy of the feature set; subsequent changes
  * to the `TIOFeatures` object do not propogate to the `TTree`.
+ *
+ * The experimental features are:
+ *  - `kGenerateOffsetMap`: the entry offsets of the baskets are regenerated when reading
+ *    instead of being stored, when possible.
+ *  - `kZstdDictionary`: the baskets of the branches compressed with ZSTD are compressed with
+ *    a dictionary trained on the first baskets of each branch, and stored in the directory
+ *    of the tree as `ZstdDict_<tree>_<ID>`. This greatly improves the compression of small baskets.
  */
 
 
@@ -135,6 +135,17 @@ bool TLeafD::ReadBasketFast(TBuffer &input_buf, Long64_t N) {
    return input_buf.ByteSwapBuffer(fLen*N, kDouble_t);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Variable-size arrays of doubles are stored without any header.
+
+Bool_t TLeafD::GetJaggedLayout(EDataType &type, Int_t &headerBytes) const
+{
+   if (!fLeafCount) return kFALSE;
+   type = kDouble_t;
+   headerBytes = 0;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
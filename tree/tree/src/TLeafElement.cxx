@@ -19,6 +19,8 @@ a TStreamerInfo (i.e. using TBranchElement).
 #include "TLeafElement.h"
 
 #include "TVirtualStreamerInfo.h"
+#include "TClass.h"
+#include "TVirtualCollectionProxy.h"
 #include "Bytes.h"
 #include "TBuffer.h"
 
@@ -139,6 +141,44 @@ TLeafElement::GetDeserializeType() const
    return DeserializeType::kDestructive;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Determine if the entries of this leaf can be read in bulk as variable-size
+/// arrays, see TLeaf::GetJaggedLayout. This is the case for:
+///  - the data members of fundamental type of the content of a split
+///    TClonesArray or STL collection: the values of the entry are contiguous;
+///  - the std::vector of fundamental type: each entry starts with the
+///    byte count (4 bytes) and the version (2 bytes) of the collection, followed
+///    by its size (4 bytes).
+
+Bool_t TLeafElement::GetJaggedLayout(EDataType &type, Int_t &headerBytes) const
+{
+   auto branch = static_cast<TBranchElement *>(fBranch);
+   const Int_t btype = branch->GetType();
+   if (btype == 31 || btype == 41) {
+      if (GetDeserializeType() == DeserializeType::kDestructive)
+         return kFALSE;
+      type = fDataTypeCache.load(std::memory_order_consume);
+      headerBytes = 0;
+      return kTRUE;
+   }
+   if (btype != 0 || branch->GetListOfBranches()->GetEntriesFast())
+      return kFALSE;
+
+   TClass *clptr = nullptr;
+   EDataType exptype = EDataType::kOther_t;
+   if (branch->GetExpectedType(clptr, exptype) || !clptr)
+      return kFALSE;
+   TVirtualCollectionProxy *proxy = clptr->GetCollectionProxy();
+   if (!proxy || proxy->HasPointers() || proxy->GetCollectionType() != ROOT::kSTLvector)
+      return kFALSE;
+   const EDataType valuetype = proxy->GetType();
+   if (valuetype == kNoType_t || valuetype == kOther_t || valuetype == kFloat16_t || valuetype == kDouble32_t)
+      return kFALSE;
+   type = valuetype;
+   headerBytes = 10;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Deserialize N events from an input buffer.
 Bool_t TLeafElement::ReadBasketFast(TBuffer &input_buf, Long64_t N)
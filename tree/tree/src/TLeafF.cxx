@@ -139,6 +139,17 @@ bool TLeafF::ReadBasketFast(TBuffer &input_buf, Long64_t N) {
   return input_buf.ByteSwapBuffer(fLen*N, kFloat_t);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Variable-size arrays of floats are stored without any header.
+
+Bool_t TLeafF::GetJaggedLayout(EDataType &type, Int_t &headerBytes) const
+{
+   if (!fLeafCount) return kFALSE;
+   type = kFloat_t;
+   headerBytes = 0;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
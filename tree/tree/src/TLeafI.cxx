@@ -190,6 +190,17 @@ bool TLeafI::ReadBasketFast(TBuffer& input_buf, Long64_t N)
    return input_buf.ByteSwapBuffer(fLen*N, kInt_t);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Variable-size arrays of integers are stored without any header.
+
+Bool_t TLeafI::GetJaggedLayout(EDataType &type, Int_t &headerBytes) const
+{
+   if (!fLeafCount) return kFALSE;
+   type = fIsUnsigned ? kUInt_t : kInt_t;
+   headerBytes = 0;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
@@ -356,6 +356,7 @@ End_Macro
 #include "TTree.h"
 
 #include "ROOT/TIOFeatures.hxx"
+#include "RZip.h"
 #include "TArrayC.h"
 #include "TBufferFile.h"
 #include "TBaseClass.h"
@@ -377,6 +378,7 @@ End_Macro
 #include "TEnv.h"
 #include "TEventList.h"
 #include "TFile.h"
+#include "TFileCacheWrite.h"
 #include "TFolder.h"
 #include "TFriendElement.h"
 #include "TInterpreter.h"
@@ -416,6 +418,7 @@ End_Macro
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#include "TBasketWriteBehind.h"
 #include "TBranchIMTHelper.h"
 #include "TNotifyLink.h"
 
@@ -907,6 +910,10 @@ TTree::TTree(const char* name, const char* title, Int_t splitlevel /* = 99 */,
 
 TTree::~TTree()
 {
+   // The baskets written in the background refer to our branches.
+   CollectWriteBehind(kTRUE);
+   fWriteBehind.reset();
+   fZstdDicts.clear();
    if (auto link = dynamic_cast<TNotifyLinkBase*>(fNotify)) {
       link->Clear();
    }
@@ -2789,6 +2796,9 @@ TFile* TTree::ChangeFile(TFile* file)
       if (newfile) newfile->Append(obj);
       file->Remove(obj);
    }
+   if (fWriteBehind && newfile && !newfile->GetCacheWrite()) {
+      new TFileCacheWrite(newfile, 0); // see SetWriteBehind
+   }
    delete file;
    file = 0;
    delete[] fname;
@@ -3451,7 +3461,9 @@ namespace {
 ///
 /// If 'option' contains the word 'fast' and nentries is -1, the cloning will be
 /// done without unzipping or unstreaming the baskets (i.e., a direct copy of the
-/// raw bytes on disk).
+/// raw bytes on disk). The entries of the trees written with the kZstdDictionary
+/// IO feature are still copied one by one, since their baskets need the zstd
+/// dictionaries of their input file.
 ///
 /// When 'fast' is specified, 'option' can also contains a sorting order for the
 /// baskets in the output file.
@@ -3525,6 +3537,19 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
    if (fastClone && (nentries < 0 || nentries == tree->GetEntriesFast())) {
       // Quickly copy the basket without decompression and streaming.
       Long64_t totbytes = GetTotBytes();
+      auto copyLocalEntries = [this, tree]() {
+         TTree *localtree = tree->GetTree();
+         Long64_t tentries = localtree->GetEntries();
+         for (Long64_t ii = 0; ii < tentries; ii++) {
+            if (localtree->GetEntry(ii) <= 0) {
+               break;
+            }
+            this->Fill();
+         }
+         if (this->GetTreeIndex()) {
+            this->GetTreeIndex()->Append(tree->GetTree()->GetTreeIndex(), kTRUE);
+         }
+      };
       for (Long64_t i = 0; i < nentries; i += tree->GetTree()->GetEntries()) {
          if (tree->LoadTree(i) < 0) {
             break;
@@ -3540,6 +3565,12 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
                }
             }
          }
+         if (tree->GetTree()->GetIOFeatures().Test(ROOT::Experimental::EIOFeatures::kZstdDictionary)) {
+            // The baskets may be compressed with zstd dictionaries stored next to the tree, which
+            // the output file does not have: copy the entries instead of the baskets.
+            copyLocalEntries();
+            continue;
+         }
          TTreeCloner cloner(tree->GetTree(), this, option, TTreeCloner::kNoWarnings);
          if (cloner.IsValid()) {
             this->SetEntries(this->GetEntries() + tree->GetTree()->GetEntries());
@@ -3553,17 +3584,7 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
                return -1;
             } else {
                if (cloner.NeedConversion()) {
-                  TTree *localtree = tree->GetTree();
-                  Long64_t tentries = localtree->GetEntries();
-                  for (Long64_t ii = 0; ii < tentries; ii++) {
-                     if (localtree->GetEntry(ii) <= 0) {
-                        break;
-                     }
-                     this->Fill();
-                  }
-                  if (this->GetTreeIndex()) {
-                     this->GetTreeIndex()->Append(tree->GetTree()->GetTreeIndex(), kTRUE);
-                  }
+                  copyLocalEntries();
                } else {
                   Warning("CopyEntries","%s",cloner.GetWarning());
                   if (tree->GetDirectory() && tree->GetDirectory()->GetFile()) {
@@ -3763,6 +3784,10 @@ void TTree::DirectoryAutoAdd(TDirectory* dir)
       fBranchRef->UpdateFile();
    }
    if (fDirectory) fDirectory->Append(this);
+   fZstdDicts.clear();
+   if (fDirectory && fIOFeatures.Test(ROOT::Experimental::EIOFeatures::kZstdDictionary)) {
+      TBranch::LoadZstdDictionaries(fDirectory, GetName(), fZstdDicts);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4594,6 +4619,11 @@ Int_t TTree::Fill()
    }
 #endif
 
+   if (fWriteBehind) {
+      // Only wait for the baskets written in the background if they hold too much memory.
+      nerror += CollectWriteBehind(fWriteBehind->IsOverBudget());
+   }
+
    if (fBranchRef)
       fBranchRef->Fill();
 
@@ -5062,9 +5092,10 @@ Int_t TTree::FlushBaskets(Bool_t create_cluster) const
 ///
 Int_t TTree::FlushBasketsImpl() const
 {
-   if (!fDirectory) return 0;
+   const Int_t nerrorBehind = const_cast<TTree*>(this)->CollectWriteBehind(kTRUE);
+   if (!fDirectory) return nerrorBehind ? -1 : 0;
    Int_t nbytes = 0;
-   Int_t nerror = 0;
+   Int_t nerror = nerrorBehind;
    TObjArray *lb = const_cast<TTree*>(this)->GetListOfBranches();
    Int_t nb = lb->GetEntriesFast();
 
@@ -5116,7 +5147,7 @@ Int_t TTree::FlushBasketsImpl() const
       const_cast<TTree*>(this)->AddTotBytes(fIMTTotBytes);
       const_cast<TTree*>(this)->AddZipBytes(fIMTZipBytes);
 
-      return nerrpar ? -1 : nbpar.load();
+      return (nerrpar || nerrorBehind) ? -1 : nbpar.load();
    }
 #endif
    for (Int_t j = 0; j < nb; j++) {
@@ -6824,6 +6855,10 @@ Long64_t TTree::Merge(TCollection* li, Option_t *options)
 /// this TTree object (so that this TTree object is now the appropriate to
 /// use for further merging).
 ///
+/// When implicit multi-threading is enabled and the baskets are not fast
+/// cloned, the baskets are compressed in the background during the merge,
+/// see SetWriteBehind.
+///
 /// Returns the total number of entries in the merged tree.
 
 Long64_t TTree::Merge(TCollection* li, TFileMergeInfo *info)
@@ -6852,12 +6887,24 @@ Long64_t TTree::Merge(TCollection* li, TFileMergeInfo *info)
    // Also since this is part of a merging operation, the output file is not as precious as in
    // the general case since the input file should still be around.
    fAutoSave = 0;
+   // Unless the baskets are fast cloned, compress the baskets of the copied entries
+   // on the implicit multi-threading pool while the next entries are read.
+   Bool_t writeBehind = kFALSE;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && fIMTEnabled && !fWriteBehind &&
+       !TString(options).Contains("fast", TString::kIgnoreCase)) {
+      constexpr Long64_t kMergeWriteBehindBytes = 64 * 1024 * 1024;
+      SetWriteBehind(kMergeWriteBehindBytes);
+      writeBehind = kTRUE;
+   }
+#endif
    TIter next(li);
    TTree *tree;
    while ((tree = (TTree*)next())) {
       if (tree==this) continue;
       if (!tree->InheritsFrom(TTree::Class())) {
          Error("Add","Attempt to add object of class: %s to a %s", tree->ClassName(), ClassName());
+         if (writeBehind) SetWriteBehind(0);
          fAutoSave = storeAutoSave;
          return -1;
       }
@@ -6871,6 +6918,7 @@ Long64_t TTree::Merge(TCollection* li, TFileMergeInfo *info)
 
       tree->ResetBranchAddresses();
    }
+   if (writeBehind) SetWriteBehind(0);
    fAutoSave = storeAutoSave;
    return GetEntries();
 }
@@ -7865,6 +7913,7 @@ void TTree::RemoveFriend(TTree* oldFriend)
 
 void TTree::Reset(Option_t* option)
 {
+   CollectWriteBehind(kTRUE);
    fNotify        = 0;
    fEntries       = 0;
    fNClusterRange = 0;
@@ -8807,6 +8856,10 @@ void TTree::SetDirectory(TDirectory* dir)
    while((b = (TBranch*) next())) {
       b->SetFile(file);
    }
+   fZstdDicts.clear();
+   if (fDirectory && fIOFeatures.Test(ROOT::Experimental::EIOFeatures::kZstdDictionary)) {
+      TBranch::LoadZstdDictionaries(fDirectory, GetName(), fZstdDicts);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -9166,6 +9219,92 @@ void TTree::SetWeight(Double_t w, Option_t*)
    fWeight = w;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the write-behind mode if maxBytes is positive, disable it otherwise.
+///
+/// In write-behind mode, the baskets that become full during Fill are handed
+/// over to tasks of the ROOT thread pool, which serialize and compress them
+/// while Fill goes on with new baskets. The baskets of different branches are
+/// compressed in parallel, those of a given branch in order. The compressed
+/// baskets are written to the file by the thread filling the tree, when the
+/// next calls to Fill collect them: the tasks never touch the file, so the
+/// other objects of the file can be written meanwhile as usual. Fill only
+/// waits for the tasks when the full baskets not written yet hold more than
+/// maxBytes bytes of memory. If the file of the tree has no write cache, one
+/// is created (see TFileCacheWrite): the baskets are all appended at the end
+/// of the file, so the cache coalesces them into large writes.
+///
+/// FlushBaskets, AutoSave, Write, Reset and ChangeFile wait for the baskets
+/// written in the background. The tree must not be read while it is being
+/// filled in this mode, unless FlushBaskets was called.
+///
+/// The writes are asynchronous only if implicit multi-threading is enabled
+/// (see ROOT::EnableImplicitMT) when this method is called.
+
+void TTree::SetWriteBehind(Long64_t maxBytes)
+{
+   CollectWriteBehind(kTRUE);
+   fWriteBehind.reset();
+   if (maxBytes <= 0) {
+      return;
+   }
+#ifndef R__USE_IMT
+   Warning("SetWriteBehind", "ROOT was built without implicit multi-threading: the baskets are written synchronously.");
+#endif
+   fWriteBehind.reset(new ROOT::Internal::TBasketWriteBehind(maxBytes));
+   TFile *file = GetCurrentFile();
+   if (file && file->IsWritable() && !file->GetCacheWrite()) {
+      new TFileCacheWrite(file, 0); // owned by the file
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the memory budget of the write-behind mode, 0 if it is disabled.
+/// See SetWriteBehind.
+
+Long64_t TTree::GetWriteBehind() const
+{
+   return fWriteBehind ? fWriteBehind->GetMaxBytes() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the zstd dictionary with the given ID stored with this tree in its
+/// directory, or null if there is none. Each tree resolves the dictionaries of
+/// its baskets among its own: dictionary IDs are only unique within a tree.
+/// See also TBranch::GetZstdDictionary.
+
+const R__ZSTDDict *TTree::GetZstdDictionary(UInt_t id) const
+{
+   for (const auto &dict : fZstdDicts) {
+      if (R__getZSTDDictID(dict.get()) == id) {
+         return dict.get();
+      }
+   }
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Apply to the branches the result of the baskets written in the background
+/// since the last call, after waiting for all of them if `wait` is true. See
+/// SetWriteBehind.
+///
+/// Return the number of baskets that could not be written.
+
+Int_t TTree::CollectWriteBehind(Bool_t wait)
+{
+   if (!fWriteBehind) {
+      return 0;
+   }
+   Int_t nerror = 0;
+   for (auto &write : fWriteBehind->Collect(wait)) {
+      write.fBranch->WriteBasketBehindDone(write.fBasket, write.fWhere, write.fNout);
+      if (write.fNout < 0) {
+         ++nerror;
+      }
+   }
+   return nerror;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print values of all active leaves for entry.
 ///
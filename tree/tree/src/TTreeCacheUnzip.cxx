@@ -16,6 +16,23 @@
 
 A TTreeCache which exploits parallelized decompression of its own content.
 
+When the cache is filled with the baskets of a new cluster, they are read from
+the file at once and, if implicit multi-threading is enabled, all of them are
+unzipped in parallel right away. The unzipping tasks decompress the baskets
+directly from the prefetch buffer, without copying them and without taking any
+lock. Each unzipped basket is handed over to its branch through its own atomic
+state, so that a branch can pick its basket while the others are being unzipped.
+TTree::GetEntry still reads the branches sequentially when parallel unzipping is
+enabled: TBasket reads the baskets that are not unzipped through ReadBuffer,
+which does not exclude the other branches from the cache.
+
+With implicit multi-threading, the cache also reads ahead the baskets of the
+next cluster and unzips them in the background while the current cluster is
+processed: a task reads them from the file, under the same lock as the other
+reads of the cache, and unzips them in parallel. When the entries reach the
+next cluster, its unzipped baskets are ready to be picked up and are not read
+again from the file.
+
 */
 
 #include "TTreeCacheUnzip.h"
@@ -28,14 +45,21 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "TROOT.h"
 #include "TMutex.h"
 #include "ROOT/RMakeUnique.hxx"
+#include "ROOT/TRWSpinLock.hxx"
 
 #ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <algorithm>
+
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
+extern "C" unsigned R__getZSTDDictIDFromBuffer(int srcsize, const unsigned char *src);
+extern "C" void R__unzipZSTDDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep,
+                                 const R__ZSTDDict *dict);
 
 TTreeCacheUnzip::EParUnzipMode TTreeCacheUnzip::fgParallel = TTreeCacheUnzip::kDisable;
 
@@ -86,10 +110,9 @@ Bool_t TTreeCacheUnzip::UnzipState::IsUnzipped(Int_t index) const {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Reset all baskets' state arrays. This function is only called by main
-/// thread and parallel processing from upper layers should be disabled such
-/// as IMT in TTree::GetEntry(). Other threads should not call this function 
-/// since it is not thread-safe.
+/// Reset all baskets' state arrays. This function is not thread-safe: it is
+/// only called while no unzipping task is running and while the branches that
+/// read in parallel are excluded by fUnzipLock (see GetUnzipBuffer).
 
 void TTreeCacheUnzip::UnzipState::Reset(Int_t oldSize, Int_t newSize) {
    std::vector<Int_t>       aUnzipLen    = std::vector<Int_t>(newSize, 0);
@@ -198,6 +221,7 @@ void TTreeCacheUnzip::Init()
    fUnzipTaskGroup.reset();
 #endif
    fIOMutex = std::make_unique<TMutex>(kTRUE);
+   fUnzipLock = std::make_unique<ROOT::TRWSpinLock>();
 
    fCompBuffer = new char[16384];
    fCompBufferSize = 16384;
@@ -233,6 +257,15 @@ void TTreeCacheUnzip::Init()
 
 TTreeCacheUnzip::~TTreeCacheUnzip()
 {
+#ifdef R__USE_IMT
+   // The unzipping tasks must not outlive the buffers they work on
+   if (fUnzipTaskGroup) {
+      fUnzipTaskGroup->Cancel();
+      fUnzipTaskGroup.reset();
+   }
+#endif
+   ClearReadAhead();
+   fReady.clear();
    ResetCache();
    fUnzipState.Clear(fNseekMax);
 }
@@ -268,9 +301,6 @@ Bool_t TTreeCacheUnzip::FillBuffer()
 
    if (fNbranches <= 0) return kFALSE;
 
-   // Fill the cache buffer with the branches in the cache.
-   fIsTransferred = kFALSE;
-
    TTree *tree = ((TBranch*)fBranches->UncheckedAt(0))->GetTree();
    Long64_t entry = tree->GetReadEntry();
 
@@ -280,6 +310,17 @@ Bool_t TTreeCacheUnzip::FillBuffer()
    // the end of the training phase).
    if (fEntryCurrent <= entry  && entry < fEntryNext) return kFALSE;
 
+#ifdef R__USE_IMT
+   // The unzipping tasks of the previous cluster read the prefetch buffer we are about to refill
+   if (fUnzipTaskGroup) {
+      fUnzipTaskGroup->Cancel();
+      fUnzipTaskGroup.reset();
+   }
+#endif
+
+   // Fill the cache buffer with the branches in the cache.
+   fIsTransferred = kFALSE;
+
    // Triggered by the user, not the learning phase
    if (entry == -1)  entry = 0;
 
@@ -291,6 +332,22 @@ Bool_t TTreeCacheUnzip::FillBuffer()
    if (fEntryMax <= 0) fEntryMax = tree->GetEntries();
    if (fEntryNext > fEntryMax) fEntryNext = fEntryMax;
 
+   // Take over the baskets of this cluster that were unzipped while the previous one was processed
+   fReady.clear();
+#ifdef R__USE_IMT
+   if (fReadAheadTaskGroup) {
+      fReadAheadTaskGroup->Wait();
+      fReadAheadTaskGroup.reset();
+   }
+#endif
+   if (fReadAheadTree == tree && fReadAheadEntry == fEntryCurrent) {
+      for (auto &basket : fReadAhead) {
+         if (basket.fUnzipped)
+            fReady.emplace_back(std::move(basket));
+      }
+   }
+   ClearReadAhead();
+
    // Check if owner has a TEventList set. If yes we optimize for this
    // Special case reading only the baskets containing entries in the
    // list.
@@ -326,6 +383,7 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          Long64_t pos = b->GetBasketSeek(j);
          Int_t len = lbaskets[j];
          if (pos <= 0 || len <= 0) continue;
+         if (IsReady(pos)) continue;
          //important: do not try to read fEntryNext, otherwise you jump to the next autoflush
          if (entries[j] >= fEntryNext) continue;
          if (entries[j] < entry && (j < nb - 1 && entries[j+1] <= entry)) continue;
@@ -345,9 +403,162 @@ Bool_t TTreeCacheUnzip::FillBuffer()
    ResetCache();
    fIsLearning = kFALSE;
 
+#ifdef R__USE_IMT
+   // Read all the baskets of the cluster now and start unzipping them all in parallel, rather than waiting
+   // for the first basket request of a branch.
+   if (fParallel && fNseek > 0 && ROOT::IsImplicitMTEnabled()) {
+      Int_t loc = -1;
+      if (ReadBufferExt(nullptr, fSeek[0], 0, loc) >= 0)
+         CreateTasks();
+   }
+
+   // Read the baskets of the next cluster now, so that they are unzipped while this one is processed
+   if (fParallel && !elist && ROOT::IsImplicitMTEnabled())
+      ReadAhead(tree);
+#endif
+
    return kTRUE;
 }
 
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// Start reading the baskets of the cluster that follows the one in the cache
+/// and unzipping them in the background. The reading task takes fIOMutex, like
+/// the other reads of the cache, as the TFile does not support concurrent reads;
+/// the total size of the baskets is limited by the size of the cache. FillBuffer
+/// takes them over when the entries reach that cluster.
+
+void TTreeCacheUnzip::ReadAhead(TTree *tree)
+{
+   if (fEntryNext >= fEntryMax || TFileCacheRead::fAsyncReading || fEnablePrefetching || fFile->GetCacheWrite())
+      return;
+
+   TTree::TClusterIterator clusterIter = tree->GetClusterIterator(fEntryNext);
+   const Long64_t first = clusterIter();
+   const Long64_t last = TMath::Min(clusterIter.GetNextEntry(), fEntryMax);
+   if (first >= last)
+      return;
+
+   Long64_t total = 0;
+   for (Int_t i = 0; i < fNbranches; i++) {
+      TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
+      if (b->GetDirectory() == 0) continue;
+      if (b->GetDirectory()->GetFile() != fFile) continue;
+      Int_t nb = b->GetMaxBaskets();
+      Int_t *lbaskets   = b->GetBasketBytes();
+      Long64_t *entries = b->GetBasketEntry();
+      if (!lbaskets || !entries) continue;
+      Int_t blistsize = b->GetListOfBaskets()->GetSize();
+      for (Int_t j = 0; j < nb; j++) {
+         if (j < blistsize && b->GetListOfBaskets()->UncheckedAt(j)) continue;
+         Long64_t pos = b->GetBasketSeek(j);
+         Int_t len = lbaskets[j];
+         if (pos <= 0 || len <= 0) continue;
+         // Baskets that start before the cluster were read with the current one
+         if (entries[j] < first || entries[j] >= last) continue;
+         if (total + len > GetBufferSize()) continue;
+         fReadAhead.push_back({pos, len, 0, nullptr, 0});
+         total += len;
+      }
+   }
+   if (fReadAhead.empty())
+      return;
+
+   std::sort(fReadAhead.begin(), fReadAhead.end(),
+             [](const ReadAheadBasket &a, const ReadAheadBasket &b) { return a.fPos < b.fPos; });
+   std::vector<Long64_t> pos(fReadAhead.size());
+   std::vector<Int_t> len(fReadAhead.size());
+   Long64_t offset = 0;
+   for (std::size_t i = 0; i < fReadAhead.size(); ++i) {
+      fReadAhead[i].fOffset = offset;
+      pos[i] = fReadAhead[i].fPos;
+      len[i] = fReadAhead[i].fLen;
+      offset += fReadAhead[i].fLen;
+   }
+   fReadAheadBuffer.reset(new char[total]);
+   fReadAheadEntry = first;
+   fReadAheadTree = tree;
+
+   auto unzipAll = [this, pos, len]() mutable {
+      {
+         // If the baskets cannot be read, none of them is unzipped and FillBuffer reads them again
+         R__LOCKGUARD(fIOMutex.get());
+         if (fFile->ReadBuffers(fReadAheadBuffer.get(), pos.data(), len.data(), fReadAhead.size()))
+            return;
+      }
+      auto unzipBasket = [this](std::size_t i) {
+         auto &basket = fReadAhead[i];
+         char *ptr = nullptr;
+         Int_t loclen = UnzipBuffer(&ptr, &fReadAheadBuffer[basket.fOffset]);
+         if (loclen > 0) {
+            basket.fUnzipped.reset(ptr);
+            basket.fUnzipLen = loclen;
+            fNUnzip++;
+         } else {
+            delete [] ptr;
+         }
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(unzipBasket, ROOT::TSeq<std::size_t>(fReadAhead.size()));
+   };
+   fReadAheadTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
+   fReadAheadTaskGroup->Run(unzipAll);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Drop the baskets read ahead, waiting for the tasks that unzip them.
+
+void TTreeCacheUnzip::ClearReadAhead()
+{
+#ifdef R__USE_IMT
+   if (fReadAheadTaskGroup) {
+      fReadAheadTaskGroup->Wait();
+      fReadAheadTaskGroup.reset();
+   }
+#endif
+   fReadAhead.clear();
+   fReadAheadBuffer.reset();
+   fReadAheadEntry = -1;
+   fReadAheadTree = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the basket at position pos was unzipped in advance and is
+/// waiting in fReady.
+
+Bool_t TTreeCacheUnzip::IsReady(Long64_t pos) const
+{
+   auto it = std::lower_bound(fReady.begin(), fReady.end(), pos,
+                              [](const ReadAheadBasket &b, Long64_t p) { return b.fPos < p; });
+   return it != fReady.end() && it->fPos == pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand over the basket at position pos if it was unzipped in advance.
+/// Returns the length of the unzipped buffer, or 0 if it is not available.
+/// The caller must hold fUnzipLock, at least for reading: each basket belongs
+/// to a single branch, hence no two threads hand over the same basket.
+
+Int_t TTreeCacheUnzip::GetReadyChunk(char **buf, Long64_t pos, Bool_t *free)
+{
+   auto it = std::lower_bound(fReady.begin(), fReady.end(), pos,
+                              [](const ReadAheadBasket &b, Long64_t p) { return b.fPos < p; });
+   if (it == fReady.end() || it->fPos != pos || !it->fUnzipped)
+      return 0;
+
+   if (!(*buf)) {
+      *buf = it->fUnzipped.release();
+      *free = kTRUE;
+   } else {
+      memcpy(*buf, it->fUnzipped.get(), it->fUnzipLen);
+      it->fUnzipped.reset();
+      *free = kFALSE;
+   }
+   fNFound++;
+   return it->fUnzipLen;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change the underlying buffer size of the cache.
 /// Returns:
@@ -373,6 +584,7 @@ Int_t TTreeCacheUnzip::SetBufferSize(Int_t buffersize)
 
 void TTreeCacheUnzip::SetEntryRange(Long64_t emin, Long64_t emax)
 {
+   ClearReadAhead();
    TTreeCache::SetEntryRange(emin, emax);
 }
 
@@ -390,6 +602,9 @@ void TTreeCacheUnzip::StopLearningPhase()
 
 void TTreeCacheUnzip::UpdateBranches(TTree *tree)
 {
+   // The baskets read ahead belong to the previous tree
+   ClearReadAhead();
+   fReady.clear();
    TTreeCache::UpdateBranches(tree);
 }
 
@@ -513,6 +728,15 @@ void TTreeCacheUnzip::ResetCache()
    fEmpty = kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the zipped baskets of the cache are available in the
+/// prefetch buffer, i.e. they were read synchronously in one go.
+
+Bool_t TTreeCacheUnzip::IsInPrefetchBuffer() const
+{
+   return fIsTransferred && !TFileCacheRead::fAsyncReading && !fEnablePrefetching && !fFile->GetCacheWrite();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This inflates a basket in the cache.. passing the data to a new
 /// buffer that will only wait there to be read...
@@ -548,22 +772,34 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
       return 1;
    }
 
-   // Prepare a memory buffer of adequate size
-   char* locbuff = 0;
-   if (rdlen > 16384) {
-      locbuff = new char[rdlen];
-   } else if (rdlen * 3 < 16384) {
-      locbuff = new char[rdlen * 2];
+   char *locbuff = nullptr;
+   std::unique_ptr<char[]> ownedbuff;
+   if (IsInPrefetchBuffer()) {
+      // The zipped basket can be unzipped straight from the prefetch buffer: no copy and no lock needed, as the
+      // buffer is not modified before all the unzipping tasks are over (see FillBuffer)
+      loc = (Int_t)TMath::BinarySearch(fNseek, fSeekSort, rdoffs);
+      if (loc < 0 || loc >= fNseek || fSeekSort[loc] != rdoffs) {
+         fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
+         return -1;
+      }
+      locbuff = &fBuffer[fSeekPos[loc]];
    } else {
-      locbuff = new char[16384];
-   }
+      // Prepare a memory buffer of adequate size
+      if (rdlen > 16384) {
+         ownedbuff.reset(new char[rdlen]);
+      } else if (rdlen * 3 < 16384) {
+         ownedbuff.reset(new char[rdlen * 2]);
+      } else {
+         ownedbuff.reset(new char[16384]);
+      }
+      locbuff = ownedbuff.get();
 
-   readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
+      readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
 
-   if (readbuf <= 0) {
-      fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-      if (locbuff) delete [] locbuff;
-      return -1;
+      if (readbuf <= 0) {
+         fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
+         return -1;
+      }
    }
 
    GetRecordHeader(locbuff, hlen, nbytes, objlen, keylen);
@@ -578,7 +814,6 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
                    Info("UnzipCache", "Block %d is too big, skipping.", index);
 
            fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-           if (locbuff) delete [] locbuff;
            return 0;
    }
 
@@ -588,16 +823,16 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    if ((loclen > 0) && (loclen == objlen + keylen)) {
       if ((myCycle != fCycle) || !fIsTransferred) {
          fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-         if (locbuff) delete [] locbuff;
+         delete [] ptr;
          return 1;
       }
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
       fNUnzip++;
    } else {
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
+      delete [] ptr;
    }
 
-   if (locbuff) delete [] locbuff;
    return 0;
 }
 
@@ -606,6 +841,7 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 /// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
 /// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping 
 /// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// It is called by FillBuffer, as soon as the baskets of a new cluster are in the cache.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
@@ -652,6 +888,93 @@ Int_t TTreeCacheUnzip::CreateTasks()
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Hand over the unzipped basket at position pos if it is in the cache,
+/// waiting for it (or unzipping it) if it is not ready yet.
+/// Returns the length of the unzipped buffer, or 0 if the basket must be read
+/// and unzipped by the caller. buf and free are as in GetUnzipBuffer.
+/// The caller must hold fUnzipLock, at least for reading: several branches
+/// can pick their baskets concurrently, as each basket has its own state.
+
+Int_t TTreeCacheUnzip::GetUnzippedChunk(char **buf, Long64_t pos, Bool_t *free)
+{
+   Int_t readyLen = GetReadyChunk(buf, pos, free);
+   if (readyLen > 0)
+      return readyLen;
+
+   // The state arrays are too small for the content of the cache, see ResetCache
+   if (fNseekMax < fNseek)
+      return 0;
+
+   Int_t myCycle = fCycle;
+   Int_t loc = (Int_t)TMath::BinarySearch(fNseek, fSeekSort, pos);
+   if ((loc < 0) || (loc >= fNseek) || (pos != fSeekSort[loc]))
+      return 0;
+
+   // The buffer is, at minimum, in the file cache. We must know its index in the requests list
+   // In order to get its info
+   Int_t seekidx = fSeekIndex[loc];
+   Bool_t stalled = kFALSE;
+
+   // If no task picked the basket yet, we unzip it ourselves.
+   if (fUnzipState.IsUntouched(seekidx) && fUnzipState.TryUnzipping(seekidx)) {
+      stalled = kTRUE;
+      UnzipCache(seekidx);
+   }
+
+   // If the requested basket is being unzipped by a background task, we try to steal a blk to unzip.
+   while (fUnzipState.IsProgress(seekidx)) {
+      stalled = kTRUE;
+      if (fEmpty) {
+         Int_t reqi = -1;
+         for (Int_t ii = 0; ii < fNseek; ++ii) {
+            Int_t idx = (seekidx + 1 + ii) % fNseek;
+            if (fUnzipState.IsUntouched(idx)) {
+               if (fUnzipState.TryUnzipping(idx)) {
+                  reqi = idx;
+                  break;
+               }
+            }
+         }
+         if (reqi < 0) {
+            fEmpty = kFALSE;
+         } else {
+            UnzipCache(reqi);
+         }
+      }
+
+      if (myCycle != fCycle) {
+         if (gDebug > 0)
+            Info("GetUnzippedChunk", "Sudden paging Break!!! fNseek: %d, fIsLearning:%d", fNseek, fIsLearning);
+         return 0;
+      }
+   }
+
+   // Here the block is not pending. It could be done or aborted.
+   if (!fUnzipState.IsUnzipped(seekidx)) {
+      // This is a complete miss. We want to avoid the background tasks
+      // to try unzipping this block in the future.
+      fUnzipState.SetMissed(seekidx);
+      return 0;
+   }
+
+   const Int_t unzipLen = fUnzipState.fUnzipLen[seekidx];
+   if (!(*buf)) {
+      *buf = fUnzipState.fUnzipChunks[seekidx].release();
+      *free = kTRUE;
+   } else {
+      memcpy(*buf, fUnzipState.fUnzipChunks[seekidx].get(), unzipLen);
+      fUnzipState.fUnzipChunks[seekidx].reset();
+      *free = kFALSE;
+   }
+
+   if (stalled)
+      fNStalls++;
+   else
+      fNFound++;
+   return unzipLen;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// We try to read a buffer that has already been unzipped
 /// Returns -1 in case of read failure, 0 in case it's not in the
@@ -661,26 +984,43 @@ Int_t TTreeCacheUnzip::CreateTasks()
 /// Note!! : If *buf == 0 we will allocate the buffer and it will be the
 /// responsability of the caller to free it... it is useful for example
 /// to pass it to the creator of TBuffer
+///
+/// This function can be called concurrently by several branches of the tree.
 
 Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_t *free)
 {
-   Int_t res = 0;
-   Int_t loc = -1;
-
-   // We go straight to TTreeCache/TfileCacheRead, in order to get the info we need
-   //  pointer to the original zipped chunk
-   //  its index in the original unsorted offsets lists
-   //
-   // Actually there are situations in which copying the buffer is not
-   // useful. But the choice is among doing once more a small memcpy or a binary search in a large array. I prefer the former.
-   // Also, here we prefer not to trigger the (re)population of the chunks in the TFileCacheRead. That is
-   // better to be done in the main thread.
+   if (fParallel && !fIsLearning) {
+      ROOT::TRWSpinLockReadGuard guard(*fUnzipLock);
+      Int_t unzipLen = GetUnzippedChunk(buf, pos, free);
+      if (unzipLen > 0)
+         return unzipLen;
+
+      // The basket was not unzipped in advance, but if it is in the prefetch buffer we can unzip it
+      // without excluding the other branches: the buffer is only refilled under the write lock.
+      if (IsInPrefetchBuffer()) {
+         Int_t loc = (Int_t)TMath::BinarySearch(fNseek, fSeekSort, pos);
+         if (loc >= 0 && loc < fNseek && fSeekSort[loc] == pos) {
+            const Bool_t alloc = !(*buf);
+            unzipLen = UnzipBuffer(buf, &fBuffer[fSeekPos[loc]]);
+            if (unzipLen > 0) {
+               *free = alloc;
+               fNMissed++;
+               return unzipLen;
+            }
+            if (alloc) {
+               delete [] *buf;
+               *buf = nullptr;
+            }
+         }
+      }
+   }
 
-   Int_t myCycle = fCycle;
+   // We have to read the basket ourselves, which might refill the cache: the other branches
+   // must not look into it in the meantime.
+   ROOT::TRWSpinLockWriteGuard guard(*fUnzipLock);
 
    if (fParallel && !fIsLearning) {
-
-      if(fNseekMax < fNseek){
+      if (fNseekMax < fNseek) {
          if (gDebug > 0)
             Info("GetUnzipBuffer", "Changing fNseekMax from:%d to:%d", fNseekMax, fNseek);
 
@@ -688,89 +1028,10 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
          fNseekMax = fNseek;
       }
 
-      loc = (Int_t)TMath::BinarySearch(fNseek, fSeekSort, pos);
-      if ((fCycle == myCycle) && (loc >= 0) && (loc < fNseek) && (pos == fSeekSort[loc])) {
-
-         // The buffer is, at minimum, in the file cache. We must know its index in the requests list
-         // In order to get its info
-         Int_t seekidx = fSeekIndex[loc];
-
-         do {
-
-            // If the block is ready we get it immediately.
-            // And also we don't have to alloc the blks. This is supposed to be
-            // the main thread of the app.
-            if (fUnzipState.IsUnzipped(seekidx)) {
-               if(!(*buf)) {
-                  *buf = fUnzipState.fUnzipChunks[seekidx].get();
-                  fUnzipState.fUnzipChunks[seekidx].release();
-                  *free = kTRUE;
-               } else {
-                  memcpy(*buf, fUnzipState.fUnzipChunks[seekidx].get(), fUnzipState.fUnzipLen[seekidx]);
-                  fUnzipState.fUnzipChunks[seekidx].reset();
-                  *free = kFALSE;
-               }
-
-               fNFound++;
-               return fUnzipState.fUnzipLen[seekidx];
-            }
-
-            // If the requested basket is being unzipped by a background task, we try to steal a blk to unzip.
-            Int_t reqi = -1;
-            
-            if (fUnzipState.IsProgress(seekidx)) {
-               if (fEmpty) {
-                  for (Int_t ii = 0; ii < fNseek; ++ii) {
-                     Int_t idx = (seekidx + 1 + ii) % fNseek;
-                     if (fUnzipState.IsUntouched(idx)) {
-                        if(fUnzipState.TryUnzipping(idx)) {
-                           reqi = idx;
-                           break;
-                        }
-                     }
-                  }
-                  if (reqi < 0) {
-                     fEmpty = kFALSE;
-                  } else {
-                     UnzipCache(reqi);
-                  }
-               }
- 
-               if ( myCycle != fCycle ) {
-                  if (gDebug > 0)
-                     Info("GetUnzipBuffer", "Sudden paging Break!!! fNseek: %d, fIsLearning:%d",
-                          fNseek, fIsLearning);
-
-                  seekidx = -1;
-                  break;
-               }
-            }
-
-         } while (fUnzipState.IsProgress(seekidx));
-
-         // Here the block is not pending. It could be done or aborted or not yet being processed.
-         if ( (seekidx >= 0) && (fUnzipState.IsUnzipped(seekidx)) ) {
-            if(!(*buf)) {
-              *buf = fUnzipState.fUnzipChunks[seekidx].get();
-               fUnzipState.fUnzipChunks[seekidx].release();
-               *free = kTRUE;
-            } else {
-               memcpy(*buf, fUnzipState.fUnzipChunks[seekidx].get(), fUnzipState.fUnzipLen[seekidx]);
-               fUnzipState.fUnzipChunks[seekidx].reset();
-               *free = kFALSE;
-            }
-
-            fNStalls++;
-            return fUnzipState.fUnzipLen[seekidx];
-         } else {
-            // This is a complete miss. We want to avoid the background tasks
-            // to try unzipping this block in the future.
-            fUnzipState.SetMissed(seekidx);
-         }
-      } else {
-         loc = -1;
-         fIsTransferred = kFALSE;
-      }
+      // Another branch might have refilled the cache with our basket while we were waiting for the lock
+      Int_t unzipLen = GetUnzippedChunk(buf, pos, free);
+      if (unzipLen > 0)
+         return unzipLen;
    }
 
    if (len > fCompBufferSize) {
@@ -785,9 +1046,14 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
       }
    }
 
-   res = 0;
-   if (!ReadBufferExt(fCompBuffer, pos, len, loc)) {
-      // Cache is invalidated and we need to wait for all unzipping tasks to befinished before fill new baskets in cache.
+   Int_t res = 0;
+   Int_t loc = -1;
+   Int_t st = ReadBufferExt(fCompBuffer, pos, len, loc);
+   if (st < 0) {
+      res = -1;
+   } else if (st == 0) {
+      // The basket is not in the current cluster: the cache will be refilled (see FillBuffer), we stop
+      // unzipping the baskets it contains now.
 #ifdef R__USE_IMT
       if(ROOT::IsImplicitMTEnabled() && fUnzipTaskGroup) {
          fUnzipTaskGroup->Cancel();
@@ -797,14 +1063,9 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
       {
          // Fill new baskets into cache.
          R__LOCKGUARD(fIOMutex.get());
-	      fFile->Seek(pos);
-	      res = fFile->ReadBuffer(fCompBuffer, len);
+         fFile->Seek(pos);
+         res = fFile->ReadBuffer(fCompBuffer, len);
       } // end of lock scope
-#ifdef R__USE_IMT
-      if(ROOT::IsImplicitMTEnabled()) {
-         CreateTasks();
-      }
-#endif
    }
 
    if (res) res = -1;
@@ -817,7 +1078,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
    if (!fIsLearning) {
       fNMissed++;
    }
-   
+
    return res;
 }
 
@@ -908,7 +1169,19 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
             return uzlen;
          }
 
-         R__unzip(&nin, bufcur, &nbuf, objbuf, &nout);
+         if (UInt_t dictID = R__getZSTDDictIDFromBuffer(nin, bufcur)) {
+            // Only the dictionaries stored with the tree are known here: the baskets compressed with the dictionary
+            // of a branch that is being written are left to TBasket::ReadBasketBuffers, see TBranch::GetZstdDictionary
+            const R__ZSTDDict *dict = fTree ? fTree->GetZstdDictionary(dictID) : nullptr;
+            if (!dict) {
+               if (alloc) delete [] *dest;
+               *dest = 0;
+               return -1;
+            }
+            R__unzipZSTDDict(&nin, bufcur, &nbuf, (UChar_t *) objbuf, &nout, dict);
+         } else {
+            R__unzip(&nin, bufcur, &nbuf, objbuf, &nout);
+         }
 
          if (gDebug > 2)
             Info("UnzipBuffer", "R__unzip nin:%d, bufcur:%p, nbuf:%d, objbuf:%p, nout:%d",
@@ -945,10 +1218,10 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
    printf("Max allowed mem for pending buffers: %lld\n", fUnzipBufferSize);
-   printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
-   printf("Number of hits: %d\n", fNFound);
-   printf("Number of stalls: %d\n", fNStalls);
-   printf("Number of misses: %d\n", fNMissed);
+   printf("Number of blocks unzipped by threads: %d\n", fNUnzip.load());
+   printf("Number of hits: %d\n", fNFound.load());
+   printf("Number of stalls: %d\n", fNStalls.load());
+   printf("Number of misses: %d\n", fNMissed.load());
 
    TTreeCache::Print(option);
 }
@@ -1,11 +1,15 @@
 #include <stdio.h>
 
 #include "Bytes.h"
+#include "SillyStruct.h"
 #include "TBranch.h"
+#include "TBranchElement.h"
 #include "TBufferFile.h"
+#include "TClonesArray.h"
 #include "TFile.h"
 #include "TTree.h"
 #include "TStopwatch.h"
+#include "TSystem.h"
 #include "TTreeReader.h"
 #include "TTreeReaderValue.h"
 #include "TTreeReaderArray.h"
@@ -15,6 +19,8 @@
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 class BulkApiVariableTest : public ::testing::Test {
 public:
    static constexpr Long64_t fClusterSize = 1e5;
@@ -235,3 +241,176 @@ TEST_F(BulkApiVariableTest, serializedRead)
    printf("Bulk Serialized API: Successful read of all events.\n");
    printf("Bulk Serialized API: Total elapsed time (seconds) for API: %.2f\n", sw.RealTime());
 }
+
+TEST_F(BulkApiVariableTest, jaggedRead)
+{
+   auto hfile = TFile::Open(fFileName.c_str());
+   auto tree = dynamic_cast<TTree*>(hfile->Get("T"));
+   ASSERT_TRUE(tree);
+   auto branchFloat = tree->GetBranch("f");
+   ASSERT_TRUE(branchFloat);
+   auto branchDouble = tree->GetBranch("d");
+   ASSERT_TRUE(branchDouble);
+   ASSERT_TRUE(branchFloat->GetBulkRead().SupportsBulkJaggedRead());
+   ASSERT_TRUE(branchDouble->GetBulkRead().SupportsBulkJaggedRead());
+   ASSERT_FALSE(tree->GetBranch("myLen")->GetBulkRead().SupportsBulkJaggedRead());
+
+   float idx_f = 0;
+   double idx_d = 2;
+   Long64_t evt_idx = 0;
+   TBufferFile floatBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile doubleBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile floatOffsets(TBuffer::kWrite, 32*1024);
+   TBufferFile doubleOffsets(TBuffer::kWrite, 32*1024);
+
+   while (evt_idx < fEventCount) {
+      auto count = branchFloat->GetBulkRead().GetBulkEntriesJagged(evt_idx, floatBuf, floatOffsets);
+      ASSERT_GT(count, 0);
+      ASSERT_EQ(branchDouble->GetBulkRead().GetBulkEntriesJagged(evt_idx, doubleBuf, doubleOffsets), count);
+
+      auto float_buf = reinterpret_cast<float*>(floatBuf.GetCurrent());
+      auto double_buf = reinterpret_cast<double*>(doubleBuf.GetCurrent());
+      auto float_offsets = reinterpret_cast<Int_t*>(floatOffsets.Buffer());
+      auto double_offsets = reinterpret_cast<Int_t*>(doubleOffsets.Buffer());
+      ASSERT_EQ(float_offsets[0], 0);
+      for (Int_t idx = 0; idx < count; idx++) {
+         const auto entry_count = (evt_idx + idx + 1) % 10;
+         ASSERT_EQ(float_offsets[idx + 1] - float_offsets[idx], entry_count);
+         ASSERT_EQ(double_offsets[idx + 1], float_offsets[idx + 1]);
+         for (auto elem = float_offsets[idx]; elem < float_offsets[idx + 1]; elem++) {
+            ASSERT_EQ(float_buf[elem], idx_f++);
+            ASSERT_EQ(double_buf[elem], idx_d++);
+         }
+      }
+      evt_idx += count;
+   }
+   ASSERT_EQ(evt_idx, fEventCount);
+}
+
+TEST(BulkApiJagged, stdVector)
+{
+   const auto fileName = "BulkApiTestStdVector.root";
+   const Long64_t eventCount = 10000;
+   {
+      TFile f(fileName, "RECREATE");
+      TTree tree("T", "A tree with a std::vector branch");
+      std::vector<float> v;
+      tree.Branch("v", &v);
+      for (Long64_t ev = 0; ev < eventCount; ev++) {
+         v.assign(ev % 7, float(ev));
+         tree.Fill();
+      }
+      tree.Write();
+   }
+
+   TFile f(fileName);
+   auto tree = f.Get<TTree>("T");
+   ASSERT_TRUE(tree);
+   auto branch = tree->GetBranch("v");
+   ASSERT_TRUE(branch->GetBulkRead().SupportsBulkJaggedRead());
+
+   TBufferFile valueBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile offsetBuf(TBuffer::kWrite, 32*1024);
+   Long64_t evt_idx = 0;
+   while (evt_idx < eventCount) {
+      auto count = branch->GetBulkRead().GetBulkEntriesJagged(evt_idx, valueBuf, offsetBuf);
+      ASSERT_GT(count, 0);
+      auto values = reinterpret_cast<float*>(valueBuf.GetCurrent());
+      auto offsets = reinterpret_cast<Int_t*>(offsetBuf.Buffer());
+      for (Int_t idx = 0; idx < count; idx++) {
+         const auto ev = evt_idx + idx;
+         ASSERT_EQ(offsets[idx + 1] - offsets[idx], ev % 7);
+         for (auto elem = offsets[idx]; elem < offsets[idx + 1]; elem++)
+            ASSERT_EQ(values[elem], float(ev));
+      }
+      evt_idx += count;
+   }
+   ASSERT_EQ(evt_idx, eventCount);
+   gSystem->Unlink(fileName);
+}
+
+TEST(BulkApiJagged, splitClonesArrayMembers)
+{
+   const auto fileName = "BulkApiTestSplitClones.root";
+   const Long64_t eventCount = 10000;
+   {
+      TFile f(fileName, "RECREATE");
+      TTree tree("T", "A tree with a split TClonesArray branch");
+      TClonesArray arr("SillyStruct");
+      TClonesArray *arrPtr = &arr;
+      tree.Branch("arr", &arrPtr, 32000, 99);
+      for (Long64_t ev = 0; ev < eventCount; ev++) {
+         arr.Clear();
+         for (Int_t idx = 0; idx < ev % 5; idx++) {
+            auto s = static_cast<SillyStruct *>(arr.ConstructedAt(idx));
+            s->f = ev + idx;
+            s->i = 2 * ev + idx;
+            s->d = 3 * ev + idx;
+         }
+         tree.Fill();
+      }
+      tree.Write();
+   }
+
+   TFile f(fileName);
+   auto tree = f.Get<TTree>("T");
+   ASSERT_TRUE(tree);
+   auto branchFloat = dynamic_cast<TBranchElement *>(tree->GetBranch("arr.f"));
+   auto branchInt = dynamic_cast<TBranchElement *>(tree->GetBranch("arr.i"));
+   auto branchDouble = dynamic_cast<TBranchElement *>(tree->GetBranch("arr.d"));
+   ASSERT_TRUE(branchFloat && branchInt && branchDouble);
+   ASSERT_EQ(branchFloat->GetType(), 31);
+   ASSERT_TRUE(branchFloat->GetBulkRead().SupportsBulkJaggedRead());
+   ASSERT_TRUE(branchInt->GetBulkRead().SupportsBulkJaggedRead());
+   ASSERT_TRUE(branchDouble->GetBulkRead().SupportsBulkJaggedRead());
+   ASSERT_FALSE(tree->GetBranch("arr")->GetBulkRead().SupportsBulkJaggedRead());
+
+   TBufferFile floatBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile intBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile doubleBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile floatOffsets(TBuffer::kWrite, 32*1024);
+   TBufferFile intOffsets(TBuffer::kWrite, 32*1024);
+   TBufferFile doubleOffsets(TBuffer::kWrite, 32*1024);
+   Long64_t evt_idx = 0;
+   while (evt_idx < eventCount) {
+      auto count = branchFloat->GetBulkRead().GetBulkEntriesJagged(evt_idx, floatBuf, floatOffsets);
+      ASSERT_GT(count, 0);
+      auto float_buf = reinterpret_cast<float*>(floatBuf.GetCurrent());
+      auto float_offsets = reinterpret_cast<Int_t*>(floatOffsets.Buffer());
+      for (Int_t idx = 0; idx < count; idx++) {
+         const auto ev = evt_idx + idx;
+         ASSERT_EQ(float_offsets[idx + 1] - float_offsets[idx], ev % 5);
+         for (auto elem = float_offsets[idx]; elem < float_offsets[idx + 1]; elem++)
+            ASSERT_EQ(float_buf[elem], float(ev + elem - float_offsets[idx]));
+      }
+      evt_idx += count;
+   }
+   ASSERT_EQ(evt_idx, eventCount);
+
+   // The baskets of the other members need not be aligned with those of arr.f
+   for (auto branch : {branchInt, branchDouble}) {
+      const bool isInt = (branch == branchInt);
+      auto &valueBuf = isInt ? intBuf : doubleBuf;
+      auto &offsetBuf = isInt ? intOffsets : doubleOffsets;
+      evt_idx = 0;
+      while (evt_idx < eventCount) {
+         auto count = branch->GetBulkRead().GetBulkEntriesJagged(evt_idx, valueBuf, offsetBuf);
+         ASSERT_GT(count, 0);
+         auto offsets = reinterpret_cast<Int_t*>(offsetBuf.Buffer());
+         for (Int_t idx = 0; idx < count; idx++) {
+            const auto ev = evt_idx + idx;
+            ASSERT_EQ(offsets[idx + 1] - offsets[idx], ev % 5);
+            for (auto elem = offsets[idx]; elem < offsets[idx + 1]; elem++) {
+               const auto member = elem - offsets[idx];
+               if (isInt)
+                  ASSERT_EQ(reinterpret_cast<int*>(valueBuf.GetCurrent())[elem], int(2 * ev + member));
+               else
+                  ASSERT_EQ(reinterpret_cast<double*>(valueBuf.GetCurrent())[elem], double(3 * ev + member));
+            }
+         }
+         evt_idx += count;
+      }
+      ASSERT_EQ(evt_idx, eventCount);
+   }
+   gSystem->Unlink(fileName);
+}
@@ -1,7 +1,11 @@
 #include "TFile.h"
+#include "TH1D.h"
+#include "TNamed.h"
 #include "TROOT.h"
+#include "TString.h"
 #include "TSystem.h"
 #include "TTree.h"
+#include "TTreeCacheUnzip.h"
 
 #include "gtest/gtest.h"
 
@@ -28,4 +32,203 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+// The branches are read in parallel while their baskets are unzipped in parallel by the cache
+TEST(TTreeImplicitMT, parallelUnzip)
+{
+   const auto ofileName = "parallelUnzipMT.root";
+   const auto nEntries = 20000;
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(1000);
+      int i1 = 0;
+      double d2 = 0.;
+      float f3 = 0.f;
+      t.Branch("i1", &i1);
+      t.Branch("d2", &d2);
+      t.Branch("f3", &f3);
+      for (auto e = 0; e < nEntries; ++e) {
+         i1 = e;
+         d2 = 2. * e;
+         f3 = e % 100;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile f(ofileName);
+      auto t = f.Get<TTree>("t");
+      t->SetParallelUnzip(true);
+      int i1 = 0;
+      double d2 = 0.;
+      float f3 = 0.f;
+      t->SetBranchAddress("i1", &i1);
+      t->SetBranchAddress("d2", &d2);
+      t->SetBranchAddress("f3", &f3);
+      for (auto e = 0; e < nEntries; ++e) {
+         EXPECT_GT(t->GetEntry(e), 0);
+         EXPECT_EQ(i1, e);
+         EXPECT_EQ(d2, 2. * e);
+         EXPECT_EQ(f3, e % 100);
+      }
+   }
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(ofileName);
+}
+
+// Baskets are compressed and written in the background while the tree is filled
+TEST(TTreeImplicitMT, writeBehind)
+{
+   const auto ofileName = "writeBehindMT.root";
+   const auto nEntries = 50000;
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(0);
+      t.SetWriteBehind(64 * 1024);
+      EXPECT_EQ(t.GetWriteBehind(), 64 * 1024);
+      int i1 = 0;
+      double d2 = 0.;
+      t.Branch("i1", &i1)->SetBasketSize(4096);
+      t.Branch("d2", &d2)->SetBasketSize(4096);
+      for (auto e = 0; e < nEntries; ++e) {
+         i1 = e;
+         d2 = 2. * e;
+         EXPECT_GT(t.Fill(), 0);
+      }
+      t.Write();
+   }
+   ROOT::DisableImplicitMT();
+
+   TFile f(ofileName);
+   auto t = f.Get<TTree>("t");
+   ASSERT_EQ(t->GetEntries(), nEntries);
+   EXPECT_GT(t->GetBranch("i1")->GetWriteBasket(), 1);
+   int i1 = 0;
+   double d2 = 0.;
+   t->SetBranchAddress("i1", &i1);
+   t->SetBranchAddress("d2", &d2);
+   for (auto e = 0; e < nEntries; ++e) {
+      EXPECT_GT(t->GetEntry(e), 0);
+      EXPECT_EQ(i1, e);
+      EXPECT_EQ(d2, 2. * e);
+   }
+   f.Close();
+   gSystem->Unlink(ofileName);
+}
+
+// The baskets compressed in the background are written while other objects of the file are written
+TEST(TTreeImplicitMT, writeBehindOtherWrites)
+{
+   const auto ofileName = "writeBehindOtherWritesMT.root";
+   const auto nEntries = 50000;
+   const auto saveEvery = 5000;
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(0);
+      t.SetWriteBehind(64 * 1024);
+      TTree t2("t2", "t2");
+      int i1 = 0;
+      double d2 = 0.;
+      t.Branch("i1", &i1)->SetBasketSize(4096);
+      t.Branch("d2", &d2)->SetBasketSize(4096);
+      t2.Branch("i1", &i1)->SetBasketSize(4096);
+      TH1D h("h", "h", 10, 0, nEntries);
+      for (auto e = 0; e < nEntries; ++e) {
+         i1 = e;
+         d2 = 2. * e;
+         EXPECT_GT(t.Fill(), 0);
+         EXPECT_GT(t2.Fill(), 0);
+         if (e % saveEvery == saveEvery - 1) {
+            h.Fill(e);
+            h.Write("", TObject::kOverwrite);
+            t2.AutoSave("SaveSelf");
+            TNamed named(TString::Format("named%d", e).Data(), "");
+            f.WriteTObject(&named);
+            f.WriteStreamerInfo();
+         }
+      }
+      t.Write();
+      t2.Write("", TObject::kOverwrite);
+   }
+   ROOT::DisableImplicitMT();
+
+   TFile f(ofileName);
+   auto h = f.Get<TH1D>("h");
+   ASSERT_NE(h, nullptr);
+   EXPECT_EQ(h->GetEntries(), nEntries / saveEvery);
+   for (auto e = saveEvery - 1; e < nEntries; e += saveEvery)
+      EXPECT_NE(f.Get<TNamed>(TString::Format("named%d", e)), nullptr);
+   for (auto name : {"t", "t2"}) {
+      auto t = f.Get<TTree>(name);
+      ASSERT_NE(t, nullptr);
+      ASSERT_EQ(t->GetEntries(), nEntries);
+      int i1 = 0;
+      t->SetBranchAddress("i1", &i1);
+      for (auto e = 0; e < nEntries; ++e) {
+         EXPECT_GT(t->GetEntry(e), 0);
+         EXPECT_EQ(i1, e);
+      }
+      t->ResetBranchAddresses();
+   }
+   f.Close();
+   gSystem->Unlink(ofileName);
+}
+
+// The data members of a split object are read in parallel (see TBranchElement::GetEntryDaughtersMT). With parallel
+// unzipping they are read sequentially, while the baskets of the next cluster are unzipped in the background.
+TEST(TTreeImplicitMT, splitObject)
+{
+   const auto ofileName = "splitObjectMT.root";
+   const auto nEntries = 2000;
+   // large enough for the data members to be worth reading in parallel
+   const TString padding('x', 5000);
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(500);
+      TNamed named;
+      TNamed *namedPtr = &named;
+      t.Branch("named", &namedPtr, 32000, 99);
+      for (auto e = 0; e < nEntries; ++e) {
+         named.SetName(TString::Format("name%d", e));
+         named.SetTitle(TString::Format("title%d", 2 * e) + padding);
+         named.SetUniqueID(e);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT(4);
+   for (auto parallelUnzip : {false, true}) {
+      TFile f(ofileName);
+      auto t = f.Get<TTree>("t");
+      TTreeCacheUnzip::SetParallelUnzip(parallelUnzip ? TTreeCacheUnzip::kEnable : TTreeCacheUnzip::kDisable);
+      t->SetParallelUnzip(parallelUnzip);
+      // a single top-level branch, so that TTree::GetEntry does not read the branches in parallel itself
+      ASSERT_EQ(t->GetListOfBranches()->GetEntries(), 1);
+      auto branch = static_cast<TBranch *>(t->GetListOfBranches()->At(0));
+      EXPECT_GT(branch->GetListOfBranches()->GetEntries(), 2);
+      TNamed *named = nullptr;
+      t->SetBranchAddress("named", &named);
+      for (auto e = 0; e < nEntries; ++e) {
+         EXPECT_GT(t->GetEntry(e), 0);
+         ASSERT_NE(named, nullptr);
+         EXPECT_STREQ(named->GetName(), TString::Format("name%d", e).Data());
+         EXPECT_STREQ(named->GetTitle(), (TString::Format("title%d", 2 * e) + padding).Data());
+         EXPECT_EQ(named->GetUniqueID(), (UInt_t)e);
+      }
+      t->ResetBranchAddresses();
+      delete named;
+   }
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(ofileName);
+}
+
 #endif // R__USE_IMT
@@ -1,5 +1,6 @@
 
 #include "ROOT/TIOFeatures.hxx"
+#include "RZip.h"
 #include "TBasket.h"
 #include "TBranch.h"
 #include "TEnum.h"
@@ -9,6 +10,10 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
 #include <vector>
 
 static const Int_t gSampleEvents = 100;
@@ -403,3 +408,148 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+TEST(TBasket, ZstdDictionary)
+{
+   // Small baskets of ZSTD-compressed branches: the dictionary trained on the first
+   // baskets must make the following ones smaller, and must be stored in the file.
+   struct {
+      Float_t x, y;
+      Int_t id, flag;
+   } point;
+   const char *leaflist = "x/F:y/F:id/I:flag/I";
+   const Int_t nEntries = 20000;
+   auto checkEntries = [&](TTree *tree) {
+      ASSERT_NE(tree, nullptr);
+      tree->SetBranchAddress("point", &point);
+      ASSERT_EQ(tree->GetEntries(), nEntries);
+      for (Int_t idx = 0; idx < nEntries; idx++) {
+         ASSERT_GT(tree->GetEntry(idx), 0);
+         EXPECT_FLOAT_EQ(point.x, (idx % 17) * 0.5f);
+         EXPECT_FLOAT_EQ(point.y, (idx % 5) * 1.25f);
+         EXPECT_EQ(point.id, idx);
+         EXPECT_EQ(point.flag, idx % 3 == 0);
+      }
+   };
+
+   std::vector<char> memBuffer;
+   {
+      TMemFile f("tbasket_zstd_dict.root", "CREATE", "", 505);
+      ASSERT_FALSE(f.IsZombie());
+      {
+         TTree t1("t1", "Tree compressed with a zstd dictionary.");
+         TTree t2("t2", "Tree compressed without dictionary.");
+         ROOT::TIOFeatures settings;
+         settings.Set(ROOT::Experimental::EIOFeatures::kZstdDictionary);
+         t1.SetIOFeatures(settings);
+         t1.Branch("point", &point, leaflist, 2000);
+         t2.Branch("point", &point, leaflist, 2000);
+         for (Int_t idx = 0; idx < nEntries; idx++) {
+            point.x = (idx % 17) * 0.5f;
+            point.y = (idx % 5) * 1.25f;
+            point.id = idx;
+            point.flag = idx % 3 == 0;
+            t1.Fill();
+            t2.Fill();
+         }
+         EXPECT_LT(t1.GetZipBytes(), t2.GetZipBytes());
+         t1.Write();
+         t2.Write();
+      }
+      f.Close();
+      memBuffer.resize(f.GetSize());
+      f.CopyTo(memBuffer.data(), memBuffer.size());
+   }
+
+   std::vector<char> cloneBuffer;
+   {
+      TMemFile f2("tbasket_zstd_dict.root", memBuffer.data(), memBuffer.size(), "READ");
+      UInt_t dictID = 0;
+      for (auto key : *f2.GetListOfKeys()) {
+         if (TString(key->GetName()).BeginsWith("ZstdDict_t1_"))
+            dictID = TString(key->GetName() + strlen("ZstdDict_t1_")).Atoi();
+      }
+      ASSERT_NE(dictID, 0u);
+
+      // The writing tree is gone: the dictionary must be loaded from the file, by the tree only.
+      TTree *saved_t1 = nullptr;
+      TTree *saved_t2 = nullptr;
+      f2.GetObject("t1", saved_t1);
+      f2.GetObject("t2", saved_t2);
+      ASSERT_NE(saved_t2, nullptr);
+      EXPECT_NE(saved_t1->GetZstdDictionary(dictID), nullptr);
+      EXPECT_EQ(saved_t2->GetZstdDictionary(dictID), nullptr);
+      checkEntries(saved_t1);
+
+      // Fast cloning must not copy baskets that need the dictionaries of the input file.
+      TMemFile f3("tbasket_zstd_dict_clone.root", "CREATE", "", 505);
+      TTree *cloned = saved_t1->CloneTree(-1, "fast");
+      ASSERT_NE(cloned, nullptr);
+      cloned->Write();
+      f3.Close();
+      cloneBuffer.resize(f3.GetSize());
+      f3.CopyTo(cloneBuffer.data(), cloneBuffer.size());
+      f2.Close();
+   }
+
+   TMemFile f4("tbasket_zstd_dict_clone.root", cloneBuffer.data(), cloneBuffer.size(), "READ");
+   TTree *clonedTree = nullptr;
+   f4.GetObject("t1", clonedTree);
+   checkEntries(clonedTree);
+}
+
+TEST(TBasket, ZstdDictionarySameID)
+{
+   // Two different dictionaries with the same ID, as can happen for the trees of two files: each buffer must be
+   // decompressed with the dictionary of its owner, whatever other dictionary with that ID exists.
+   auto train = [](char first) {
+      std::vector<char> samples;
+      std::vector<size_t> sizes;
+      for (int i = 0; i < 2000; ++i) {
+         const std::string sample = std::string(1, first) + "sample " + std::to_string(i % 37) + " of dictionary " +
+                                    std::string(1, first) + " value=" + std::to_string(i * 7 % 101);
+         samples.insert(samples.end(), sample.begin(), sample.end());
+         sizes.push_back(sample.size());
+      }
+      std::vector<char> dict(16 * 1024);
+      const int size = R__trainZSTDDict(samples.data(), sizes.data(), sizes.size(), dict.data(), dict.size());
+      dict.resize(size);
+      return dict;
+   };
+   auto dictA = train('a');
+   auto dictB = train('b');
+   ASSERT_GT(dictA.size(), 8u);
+   ASSERT_GT(dictB.size(), 8u);
+   // give B the ID of A
+   std::copy(dictA.begin() + 4, dictA.begin() + 8, dictB.begin() + 4);
+   std::unique_ptr<R__ZSTDDict, decltype(&R__deleteZSTDDict)> a(R__createZSTDDict(dictA.data(), dictA.size()),
+                                                                &R__deleteZSTDDict);
+   std::unique_ptr<R__ZSTDDict, decltype(&R__deleteZSTDDict)> b(R__createZSTDDict(dictB.data(), dictB.size()),
+                                                                &R__deleteZSTDDict);
+   ASSERT_NE(a, nullptr);
+   ASSERT_NE(b, nullptr);
+   ASSERT_EQ(R__getZSTDDictID(a.get()), R__getZSTDDictID(b.get()));
+
+   auto roundTrip = [](std::string content, R__ZSTDDict *dict) {
+      std::vector<char> zipped(content.size() + 64);
+      int srcSize = content.size();
+      int tgtSize = zipped.size();
+      int nout = 0;
+      R__zipZSTDDict(1, &srcSize, &content[0], &tgtSize, zipped.data(), &nout, dict);
+      EXPECT_GT(nout, 0);
+      EXPECT_EQ(R__getZSTDDictIDFromBuffer(nout, reinterpret_cast<unsigned char *>(zipped.data())),
+                R__getZSTDDictID(dict));
+      std::string unzipped(content.size(), '\0');
+      int unzippedSize = unzipped.size();
+      int nin = nout;
+      int nunzipped = 0;
+      R__unzipZSTDDict(&nin, reinterpret_cast<unsigned char *>(zipped.data()), &unzippedSize,
+                       reinterpret_cast<unsigned char *>(&unzipped[0]), &nunzipped, dict);
+      EXPECT_EQ(nunzipped, static_cast<int>(content.size()));
+      return unzipped;
+   };
+   const std::string contentA = "asample 3 of dictionary a value=21asample 4 of dictionary a value=28";
+   const std::string contentB = "bsample 3 of dictionary b value=21bsample 4 of dictionary b value=28";
+   EXPECT_EQ(roundTrip(contentA, a.get()), contentA);
+   EXPECT_EQ(roundTrip(contentB, b.get()), contentB);
+}
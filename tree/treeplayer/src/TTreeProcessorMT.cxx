@@ -22,11 +22,20 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+Each worker thread processes the clusters of one file at a time, in order, and only opens a new file when it runs out
+of clusters to process: files are opened as they are needed rather than all at the beginning. When all files have been
+opened, idle workers steal clusters from the files with the most entries left to process, so that the load stays
+balanced until the end even if files and clusters have very different sizes.
 */
 
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
 using namespace ROOT;
 
 namespace {
@@ -171,53 +180,201 @@ MakeClusters(const std::vector<std::string> &treeNames, const std::vector<std::s
       entriesPerFile.emplace_back(entries);
    }
 
-   // Here we "fuse" together clusters if the number of clusters is to big with respect to
-   // the number of slots, otherwise we can incurr in an overhead which is so big to make
-   // the parallelisation detrimental for performance.
-   // For example, this is the case when following a merging of many small files a file
-   // contains a tree with many entries and with clusters of just a few entries.
-   // The criterion according to which we fuse clusters together is to have at most
-   // TTreeProcessorMT::GetMaxTasksPerFilePerWorker() clusters per file per slot.
-   // For example: given 2 files and 16 workers, at most
-   // 16 * 2 * TTreeProcessorMT::GetMaxTasksPerFilePerWorker() clusters will be created, at most
-   // 16 * TTreeProcessorMT::GetMaxTasksPerFilePerWorker() per file.
+   return std::make_pair(std::move(clustersPerFile), std::move(entriesPerFile));
+}
+
+/// A task of TTreeProcessorMT::Process: a run of contiguous clusters of a file, processed by a single call to the
+/// user-defined function
+using ClusterTask = std::vector<EntryCluster>;
 
+////////////////////////////////////////////////////////////////////////
+/// Group the clusters of a file in tasks.
+/// Here we "fuse" together clusters if the number of clusters is to big with respect to
+/// the number of slots, otherwise we can incurr in an overhead which is so big to make
+/// the parallelisation detrimental for performance.
+/// For example, this is the case when following a merging of many small files a file
+/// contains a tree with many entries and with clusters of just a few entries.
+/// The criterion according to which we fuse clusters together is to have at most
+/// TTreeProcessorMT::GetMaxTasksPerFilePerWorker() tasks per file per slot.
+/// For example: given 2 files and 16 workers, at most
+/// 16 * 2 * TTreeProcessorMT::GetMaxTasksPerFilePerWorker() tasks will be created, at most
+/// 16 * TTreeProcessorMT::GetMaxTasksPerFilePerWorker() per file.
+static std::vector<ClusterTask> MakeTasks(const std::vector<EntryCluster> &clusters)
+{
    const auto maxTasksPerFile = TTreeProcessorMT::GetMaxTasksPerFilePerWorker() * ROOT::GetThreadPoolSize();
-   std::vector<std::vector<EntryCluster>> eventRangesPerFile(clustersPerFile.size());
-   auto clustersPerFileIt = clustersPerFile.begin();
-   auto eventRangesPerFileIt = eventRangesPerFile.begin();
-   for (; clustersPerFileIt != clustersPerFile.end(); clustersPerFileIt++, eventRangesPerFileIt++) {
-      const auto clustersInThisFileSize = clustersPerFileIt->size();
-      const auto nFolds = clustersInThisFileSize / maxTasksPerFile;
-      // If the number of clusters is less than maxTasksPerFile
-      // we take the clusters as they are
-      if (nFolds == 0) {
-         std::for_each(
-            clustersPerFileIt->begin(), clustersPerFileIt->end(),
-            [&eventRangesPerFileIt](const EntryCluster &clust) { eventRangesPerFileIt->emplace_back(clust); });
-         continue;
+   const auto nClusters = clusters.size();
+   // If the number of clusters is less than maxTasksPerFile we take the clusters as they are, otherwise we lump
+   // together nFolds clusters per task, distributing the reminder evenly onto the first tasks
+   const auto nFolds = nClusters / maxTasksPerFile;
+   auto nReminderClusters = nClusters % maxTasksPerFile;
+   std::vector<ClusterTask> tasks;
+   for (std::size_t i = 0u; i < nClusters;) {
+      auto nClustersInTask = std::max<std::size_t>(nFolds, 1u);
+      if (nFolds > 0 && nReminderClusters > 0) {
+         ++nClustersInTask;
+         --nReminderClusters;
       }
-      // Otherwise, we have to merge clusters, distributing the reminder evenly
-      // onto the first clusters
-      auto nReminderClusters = clustersInThisFileSize % maxTasksPerFile;
-      const auto clustersInThisFile = *clustersPerFileIt;
-      for (auto i = 0ULL; i < clustersInThisFileSize; ++i) {
-         const auto start = clustersInThisFile[i].start;
-         // We lump together at least nFolds clusters, therefore
-         // we need to jump ahead of nFolds-1.
-         i += (nFolds - 1);
-         // We now add a cluster if we have some reminder left
-         if (nReminderClusters > 0) {
-            i += 1U;
-            nReminderClusters--;
-         }
-         const auto end = clustersInThisFile[i].end;
-         eventRangesPerFileIt->emplace_back(EntryCluster({start, end}));
+      tasks.emplace_back(clusters.begin() + i, clusters.begin() + i + nClustersInTask);
+      i += nClustersInTask;
+   }
+   return tasks;
+}
+
+/// Tasks with fewer entries than this are never split, see TClusterScheduler::StealTask
+constexpr Long64_t kMinEntriesPerSplitTask = 1000ll;
+
+/**
+\class TClusterScheduler
+\brief Hands out the tasks of TTreeProcessorMT::Process to its workers.
+
+Each worker keeps taking the tasks of the same file, in order, so that its TTreeView stays on that file. When the file
+has no tasks left, the worker opens the next file that no worker has opened yet: files are opened lazily, when a
+worker needs new tasks, rather than all up front. When all files have been opened, idle workers steal the last task of
+the file with the most entries still to be processed, and keep stealing from the back of the files afterwards, so
+that they never compete with the owners for the first tasks. A stolen task made of several clusters is split in two
+at a cluster boundary, so that no entries are read twice, and the first half is left to the owner of the file: the
+tail of the processing is thus shared among the workers even if the files have very uneven sizes.
+
+A worker that finds nothing to steal while other files are still being opened does not wait for them: it retires, so
+that its thread goes back to the pool, and AddFile tells the worker that opened the next file how many retired workers
+to resume.
+*/
+class TClusterScheduler {
+public:
+   /// A range of entries of a file to be processed
+   struct Task {
+      std::size_t fFileIdx;
+      Long64_t fStart;
+      Long64_t fEnd;
+      Long64_t fFileEntries; ///< Number of entries in the file
+   };
+
+private:
+   std::mutex fMutex;
+   const std::size_t fNFiles;
+   std::vector<std::deque<ClusterTask>> fPendingTasks; ///< Per file, the tasks that no worker has taken yet
+   std::vector<Long64_t> fPendingEntries;              ///< Per file, the number of entries of the pending tasks
+   std::vector<Long64_t> fFileEntries;                 ///< Per file, the number of entries
+   std::vector<std::size_t> fFilesWithTasks;           ///< The opened files that still have pending tasks
+   std::size_t fNextFile = 0u;                         ///< The next file to open
+   unsigned int fNOpeningFiles = 0u;                   ///< Number of files that workers are currently opening
+   unsigned int fNIdleWorkers = 0u; ///< Number of workers that retired while files were being opened
+   bool fIsAborted = false;
+
+   Task PopTask(std::size_t fileIdx, bool fromBack)
+   {
+      auto &tasks = fPendingTasks[fileIdx];
+      ClusterTask clusters;
+      if (fromBack) {
+         clusters = std::move(tasks.back());
+         tasks.pop_back();
+      } else {
+         clusters = std::move(tasks.front());
+         tasks.pop_front();
       }
+      const Task task{fileIdx, clusters.front().start, clusters.back().end, fFileEntries[fileIdx]};
+      fPendingEntries[fileIdx] -= task.fEnd - task.fStart;
+      return task;
    }
 
-   return std::make_pair(std::move(eventRangesPerFile), std::move(entriesPerFile));
-}
+public:
+   /// The outcome of StealTask
+   enum class EStealStatus {
+      kStolen,  ///< A task was stolen
+      kRetired, ///< No task is pending but files are being opened: the worker must return, it is resumed by AddFile
+      kDone     ///< There is nothing left to process
+   };
+
+   TClusterScheduler(std::size_t nFiles)
+      : fNFiles(nFiles), fPendingTasks(nFiles), fPendingEntries(nFiles, 0ll), fFileEntries(nFiles, 0ll)
+   {
+   }
+
+   /// Claim the next file that no worker has opened yet. Return false if all files have been claimed already.
+   bool ClaimFile(std::size_t &fileIdx)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fIsAborted || fNextFile == fNFiles)
+         return false;
+      fileIdx = fNextFile++;
+      ++fNOpeningFiles;
+      return true;
+   }
+
+   /// Add the tasks of a file claimed with ClaimFile. Return the number of retired workers that the caller must
+   /// resume to share the new tasks.
+   unsigned int AddFile(std::size_t fileIdx, std::vector<ClusterTask> &&tasks, Long64_t fileEntries)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      for (auto &t : tasks) {
+         fPendingEntries[fileIdx] += t.back().end - t.front().start;
+         fPendingTasks[fileIdx].emplace_back(std::move(t));
+      }
+      fFileEntries[fileIdx] = fileEntries;
+      if (!fPendingTasks[fileIdx].empty())
+         fFilesWithTasks.emplace_back(fileIdx);
+      --fNOpeningFiles;
+      if (fIsAborted)
+         return 0u;
+      // the caller processes the tasks too: resume at most one worker per other task
+      const auto nResume =
+         std::min<std::size_t>(fNIdleWorkers, fPendingTasks[fileIdx].empty() ? 0u : fPendingTasks[fileIdx].size() - 1u);
+      fNIdleWorkers -= nResume;
+      return nResume;
+   }
+
+   /// Take the next task of the given file. Return false if the file has no pending tasks.
+   bool TakeTask(std::size_t fileIdx, Task &task)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fIsAborted || fPendingTasks[fileIdx].empty())
+         return false;
+      task = PopTask(fileIdx, /*fromBack=*/false);
+      return true;
+   }
+
+   /// Steal a task from the file with the most pending entries. If no task is pending while files are being opened,
+   /// the worker is counted as retired instead of waiting for them, see AddFile.
+   EStealStatus StealTask(Task &task)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fIsAborted)
+         return EStealStatus::kDone;
+      // forget the files that ran out of tasks
+      fFilesWithTasks.erase(std::remove_if(fFilesWithTasks.begin(), fFilesWithTasks.end(),
+                                           [this](std::size_t f) { return fPendingTasks[f].empty(); }),
+                            fFilesWithTasks.end());
+      if (fFilesWithTasks.empty()) {
+         if (fNOpeningFiles == 0u && fNextFile == fNFiles)
+            return EStealStatus::kDone;
+         ++fNIdleWorkers;
+         return EStealStatus::kRetired;
+      }
+
+      const auto victim = *std::max_element(fFilesWithTasks.begin(), fFilesWithTasks.end(),
+                                            [this](std::size_t a, std::size_t b) {
+                                               return fPendingEntries[a] < fPendingEntries[b];
+                                            });
+      auto &last = fPendingTasks[victim].back();
+      const auto nEntries = last.back().end - last.front().start;
+      if (last.size() > 1u && nEntries >= 2 * kMinEntriesPerSplitTask) {
+         // leave the first half of the clusters to the owner of the file, which processes them in order
+         ClusterTask secondHalf(last.begin() + last.size() / 2, last.end());
+         last.erase(last.begin() + last.size() / 2, last.end());
+         fPendingTasks[victim].emplace_back(std::move(secondHalf));
+      }
+      task = PopTask(victim, /*fromBack=*/true);
+      return EStealStatus::kStolen;
+   }
+
+   /// Make all workers stop taking tasks, e.g. because one of them failed
+   void Abort()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fIsAborted = true;
+   }
+};
+
 
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector containing the number of entries of each file of each friend TChain
@@ -587,37 +744,68 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const auto friendEntries =
       hasFriends ? GetFriendEntries(friendNames, friendFileNames) : std::vector<std::vector<Long64_t>>{};
 
-   // Parent task, spawns tasks that process each of the entry clusters for each input file
-   // TODO: for readability we should have two versions of this lambda, for shouldRetrieveAllClusters == true/false
-   auto processFile = [&](std::size_t fileIdx) {
-      // theseFiles contains either all files or just the single file to process
-      const auto &theseFiles = shouldRetrieveAllClusters ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
-      // either all tree names or just the single tree to process
-      const auto &theseTrees = shouldRetrieveAllClusters ? fTreeNames : std::vector<std::string>({fTreeNames[fileIdx]});
-      // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
-      const auto theseClustersAndEntries =
-         shouldRetrieveAllClusters ? ClustersAndEntries{} : MakeClusters(theseTrees, theseFiles);
-
-      // All clusters for the file to process, either with global or local entry numbers
-      const auto &thisFileClusters = shouldRetrieveAllClusters ? clusters[fileIdx] : theseClustersAndEntries.first[0];
-
-      // Either all number of entries or just the ones for this file
-      const auto &theseEntries =
-         shouldRetrieveAllClusters ? entries : std::vector<Long64_t>({theseClustersAndEntries.second[0]});
-
-      auto processCluster = [&](const EntryCluster &c) {
-         auto r = fTreeView->GetTreeReader(c.start, c.end, theseTrees, theseFiles, fFriendInfo, fEntryList,
-                                           theseEntries, friendEntries);
-         func(*r);
-      };
+   TClusterScheduler scheduler(fFileNames.size());
+
+   // Retrieve the clusters of a file claimed from the scheduler, opening it if needed, and hand its tasks to the
+   // scheduler. The clusters contain global entry numbers if they were retrieved for all files, local ones otherwise.
+   // Return the number of retired workers to resume.
+   auto addFile = [&](std::size_t fileIdx) {
+      if (shouldRetrieveAllClusters)
+         return scheduler.AddFile(fileIdx, MakeTasks(clusters[fileIdx]), entries[fileIdx]);
+      const auto thisFileClustersAndEntries = MakeClusters({fTreeNames[fileIdx]}, {fFileNames[fileIdx]});
+      return scheduler.AddFile(fileIdx, MakeTasks(thisFileClustersAndEntries.first[0]),
+                               thisFileClustersAndEntries.second[0]);
+   };
 
-      fPool.Foreach(processCluster, thisFileClusters);
+   auto processTask = [&](const TClusterScheduler::Task &t) {
+      if (shouldRetrieveAllClusters) {
+         auto r = fTreeView->GetTreeReader(t.fStart, t.fEnd, fTreeNames, fFileNames, fFriendInfo, fEntryList, entries,
+                                           friendEntries);
+         func(*r);
+      } else {
+         auto r = fTreeView->GetTreeReader(t.fStart, t.fEnd, {fTreeNames[t.fFileIdx]}, {fFileNames[t.fFileIdx]},
+                                           fFriendInfo, fEntryList, {t.fFileEntries}, friendEntries);
+         func(*r);
+      }
    };
 
-   std::vector<std::size_t> fileIdxs(fFileNames.size());
-   std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
+   // Each worker processes the tasks of a file, then opens the next one, then steals tasks from the back of the other
+   // files. A worker with nothing to steal returns instead of blocking its thread while other files are being opened:
+   // the worker that adds the tasks of the next file resumes it, together with itself, in a nested Foreach. Workers
+   // only retire once all files have been claimed, so the nesting is bounded by the number of files being opened.
+   std::function<void(std::size_t, bool)> runWorker = [&](std::size_t currentFile, bool hasFile) {
+      TClusterScheduler::Task task;
+      try {
+         while (true) {
+            if (hasFile && scheduler.TakeTask(currentFile, task)) {
+               processTask(task);
+               continue;
+            }
+            if (scheduler.ClaimFile(currentFile)) {
+               const auto nResume = addFile(currentFile);
+               hasFile = true;
+               if (nResume == 0u)
+                  continue;
+               const std::size_t fileIdx = currentFile;
+               fPool.Foreach([&](unsigned int i) { i == 0u ? runWorker(fileIdx, true) : runWorker(0u, false); },
+                             ROOT::TSeqU(nResume + 1u));
+               break;
+            }
+            const auto status = scheduler.StealTask(task);
+            if (status != TClusterScheduler::EStealStatus::kStolen)
+               break;
+            // the tasks of our own file are over: keep stealing rather than taking the first tasks of the file of the
+            // stolen task, which its owner is processing in order
+            hasFile = false;
+            processTask(task);
+         }
+      } catch (...) {
+         scheduler.Abort();
+         throw;
+      }
+   };
 
-   fPool.Foreach(processFile, fileIdxs);
+   fPool.Foreach([&]() { runWorker(0u, false); }, fPool.GetPoolSize());
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -430,6 +430,55 @@ TEST(TreeProcessorMT, ChainWithFriendChain)
    ROOT::DisableImplicitMT();
 }
 
+TEST(TreeProcessorMT, UnevenFiles)
+{
+   // a large file with many clusters, whose tasks are shared among the workers, followed by many small files
+   const std::string treename = "t";
+   std::vector<std::string> filenames{"treeprocmt_unevenfiles_large.root"};
+   {
+      TFile file(filenames[0].c_str(), "recreate");
+      TTree t(treename.c_str(), treename.c_str());
+      int v = 0;
+      t.Branch("v", &v);
+      t.SetAutoFlush(1000);
+      for (v = 1; v <= 100000; ++v)
+         t.Fill();
+      t.Write();
+   }
+   const auto nSmallFiles = 20u;
+   for (auto i = 0u; i < nSmallFiles; ++i)
+      filenames.emplace_back("treeprocmt_unevenfiles_small" + std::to_string(i) + ".root");
+   WriteFiles(std::vector<std::string>(nSmallFiles, treename),
+              std::vector<std::string>(filenames.begin() + 1, filenames.end()));
+
+   std::vector<std::string_view> fnames;
+   for (const auto &f : filenames)
+      fnames.emplace_back(f);
+
+   std::mutex m;
+   std::map<std::string, std::vector<std::pair<Long64_t, Long64_t>>> rangesPerFile;
+   std::atomic<Long64_t> sum(0);
+   auto f = [&](TTreeReader &r) {
+      TTreeReaderValue<int> v(r, "v");
+      while (r.Next())
+         sum += *v;
+      std::lock_guard<std::mutex> lg(m);
+      rangesPerFile[r.GetTree()->GetCurrentFile()->GetName()].emplace_back(r.GetEntriesRange());
+   };
+
+   ROOT::EnableImplicitMT(4);
+   ROOT::TTreeProcessorMT proc(fnames, treename);
+   proc.Process(f);
+   ROOT::DisableImplicitMT();
+
+   // every entry is processed exactly once: 100000 * 100001 / 2 for the large file, 1..200 for the small ones
+   EXPECT_EQ(sum.load(), 5000050000ll + 20100ll);
+   ASSERT_EQ(rangesPerFile.size(), filenames.size());
+   CheckClusters(rangesPerFile[filenames[0]], 100000);
+
+   DeleteFiles(filenames);
+}
+
 TEST(TreeProcessorMT, SetNThreads)
 {
    EXPECT_EQ(ROOT::GetThreadPoolSize(), 0u);